@@ -7,8 +7,14 @@
 #ifndef CF_RDM_CellLoop_hpp
 #define CF_RDM_CellLoop_hpp
 
+#include <map>
+
+#include "Common/StringConversion.hpp"
+
 #include "Mesh/Field.hpp"
 
+#include "Solver/Actions/CLoop.hpp"
+
 #include "RDM/ElementLoop.hpp"
 #include "RDM/SupportedCells.hpp"
 #include "RDM/CellTerm.hpp"
@@ -24,7 +30,12 @@ namespace RDM {
 struct CellLoop : public ElementLoop
 {
   /// Constructor
-  CellLoop( const std::string& name ) : ElementLoop(name) {  regist_typeinfo(this); }
+  CellLoop( const std::string& name ) :
+    ElementLoop(name),
+    m_pass(Solver::Actions::CLoop::ALL_ELEMENTS)
+  {
+    regist_typeinfo(this);
+  }
 
   /// Get the class name
   static std::string type_name () { return "CellLoop"; }
@@ -45,6 +56,10 @@ struct CellLoop : public ElementLoop
       term->configure_option_recursively( Tags::solution(),   parent().as_type<CellTerm>().solution().uri()   );
       term->configure_option_recursively( Tags::residual(),   parent().as_type<CellTerm>().residual().uri()   );
       term->configure_option_recursively( Tags::wave_speed(), parent().as_type<CellTerm>().wave_speed().uri() );
+
+      // the CellTerm keeps the option in sync once the term exists
+      if( term->options().check("cache_geometry") )
+        term->configure_option( "cache_geometry", parent().as_type<CellTerm>().cache_geometry() );
     }
     else
       term = cterm->as_ptr_checked<TermT>();
@@ -52,6 +67,76 @@ struct CellLoop : public ElementLoop
     return *term;
   }
 
+  /// Access the terms executed by every thread of the pool.
+  /// The copies of the term are created when needed, and configured with its options when these changed.
+  template < typename TermT > std::vector<TermT*> access_thread_terms()
+  {
+    TermT& term = this->template access_term<TermT>();
+    std::vector<TermT*> terms(1,&term);
+
+    const Uint version = Solver::Actions::CLoop::options_version( term );
+    Uint& copied_version = m_copied_options_version[ TermT::type_name() ];
+    const bool options_changed = version != copied_version;
+    copied_version = version;
+
+    const Uint nb_threads = Common::Core::instance().thread_pool().nb_threads();
+    for( Uint t = 1; t < nb_threads; ++t )
+    {
+      const std::string name = TermT::type_name() + "_" + Common::to_str(t);
+      Common::Component::Ptr cterm = parent().get_child_ptr( name );
+      typename TermT::Ptr copy;
+      if( is_null( cterm ) )
+      {
+        copy = parent().template create_component_ptr< TermT >( name );
+        Solver::Actions::CLoop::copy_options( term, *copy );
+      }
+      else
+      {
+        copy = cterm->as_ptr_checked<TermT>();
+        if( options_changed )
+          Solver::Actions::CLoop::copy_options( term, *copy );
+      }
+      terms.push_back( copy.get() );
+    }
+    return terms;
+  }
+
+protected: // functions
+
+  /// runs the loop over the types, with an overlapping synchronization the interior
+  /// elements are visited first and the halo elements after completing it,
+  /// otherwise a synchronization in progress is completed before visiting all elements
+  template < typename TYPES, typename LOOP >
+  void execute_passes( LOOP& loop )
+  {
+    CellTerm& cterm = parent().as_type<CellTerm>();
+    if( cterm.overlap_synchronization() )
+    {
+      m_pass = Solver::Actions::CLoop::INTERIOR_ELEMENTS;
+      boost::mpl::for_each< TYPES >( boost::ref(loop) );
+
+      cterm.synchronize_end();
+
+      m_pass = Solver::Actions::CLoop::HALO_ELEMENTS;
+      boost::mpl::for_each< TYPES >( boost::ref(loop) );
+    }
+    else
+    {
+      cterm.synchronize_end();
+
+      m_pass = Solver::Actions::CLoop::ALL_ELEMENTS;
+      boost::mpl::for_each< TYPES >( boost::ref(loop) );
+    }
+  }
+
+protected: // data
+
+  /// elements visited by the current pass
+  Solver::Actions::CLoop::ElementsPass m_pass;
+
+  /// options_version() of every term when its copies were last configured
+  std::map<std::string,Uint> m_copied_options_version;
+
 }; // CellLoop
 
 
@@ -72,7 +157,7 @@ struct CellLoopT1 : public CellLoop
   /// execute the action
   virtual void execute ()
   {
-    boost::mpl::for_each< typename RDM::AllCellTypes >( boost::ref(*this) );
+    execute_passes< typename RDM::AllCellTypes >( *this );
   }
 
   /// operator needed for the loop over element types (SF)
@@ -93,17 +178,13 @@ struct CellLoopT1 : public CellLoop
                   Common::find_components_recursively_with_filter<Mesh::CElements>(*current_region,IsElementType<SF>()))
     {
 
-      TermT& term = this->access_term<TermT>();
+      std::vector<TermT*> terms = this->template access_thread_terms<TermT>();
 
-      // point the term to the elements of the (sub)region
-      term.set_elements(elements);
+      // point the terms to the elements of the (sub)region
+      boost_foreach( TermT* term, terms )
+        term->set_elements(elements);
 
-      const Uint nb_elem = elements.size();
-      for ( Uint elem = 0; elem != nb_elem; ++elem )
-      {
-        term.select_loop_idx(elem);
-        term.execute();
-      }
+      Solver::Actions::CLoop::loop_elements( terms, elements, m_pass, parent().as_type<CellTerm>().deterministic() );
     }
   }
 
@@ -126,7 +207,7 @@ struct CellLoopT : public CellLoop
   /// execute the action
   virtual void execute ()
   {
-    boost::mpl::for_each< typename RDM::CellTypes< PHYS::MODEL::_ndim >::Cells >( boost::ref(*this) );
+    execute_passes< typename RDM::CellTypes< PHYS::MODEL::_ndim >::Cells >( *this );
   }
 
   /// operator needed for the loop over element types (SF)
@@ -147,17 +228,14 @@ struct CellLoopT : public CellLoop
                   Common::find_components_recursively_with_filter<Mesh::CElements>(*current_region,IsElementType<SF>()))
     {
 
-      TermT& term = this->access_term<TermT>();
+      std::vector<TermT*> terms = this->template access_thread_terms<TermT>();
 
-      // point the term to the elements of the (sub)region
-      term.set_elements(elements);
+      // point the terms to the elements of the (sub)region,
+      // the first term fills the geometry cache that the others share
+      boost_foreach( TermT* term, terms )
+        term->set_elements(elements);
 
-      const Uint nb_elem = elements.size();
-      for ( Uint elem = 0; elem != nb_elem; ++elem )
-      {
-        term.select_loop_idx(elem);
-        term.execute();
-      }
+      Solver::Actions::CLoop::loop_elements( terms, elements, m_pass, parent().as_type<CellTerm>().deterministic() );
     }
   }
 
@@ -4,20 +4,26 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include "Common/FindComponents.hpp"
+#include "Common/Foreach.hpp"
 #include "Common/Signal.hpp"
 #include "Common/OptionComponent.hpp"
+#include "Common/OptionT.hpp"
 
 #include "Mesh/Field.hpp"
 
 #include "Physics/PhysModel.hpp"
 #include "Physics/Variables.hpp"
 
+#include "Solver/Actions/CSynchronizeFields.hpp"
+
 #include "RDM/RDSolver.hpp"
 #include "RDM/CellLoop.hpp"
 #include "RDM/CellTerm.hpp"
 
 using namespace CF::Common;
 using namespace CF::Mesh;
+using namespace CF::Solver::Actions;
 
 namespace CF {
 namespace RDM {
@@ -25,7 +31,10 @@ namespace RDM {
 /////////////////////////////////////////////////////////////////////////////////////
 
 CellTerm::CellTerm ( const std::string& name ) :
-  CF::Solver::Action(name)
+  CF::Solver::Action(name),
+  m_overlap_synchronization(false),
+  m_deterministic(false),
+  m_cache_geometry(false)
 {
   mark_basic();
 
@@ -37,6 +46,27 @@ CellTerm::CellTerm ( const std::string& name ) :
 
   m_options.add_option(OptionComponent<Field>::create( RDM::Tags::residual(), &m_residual))
       ->pretty_name("Residual Field");
+
+  m_options.add_option< OptionT<bool> >( "overlap_synchronization", m_overlap_synchronization )
+      ->description("Loop first the elements using only owned nodes, then complete the synchronization "
+                    "of the solver action Synchronize (configured as split_phase), then loop the others")
+      ->pretty_name("Overlap Synchronization")
+      ->link_to(&m_overlap_synchronization);
+
+  m_options.add_option< OptionT<bool> >( "deterministic", m_deterministic )
+      ->description("Visit the elements colour by colour also with a single thread, "
+                    "so that the residuals do not depend on the number of threads")
+      ->pretty_name("Deterministic")
+      ->link_to(&m_deterministic);
+
+  m_options.add_option< OptionT<bool> >( "cache_geometry", m_cache_geometry )
+      ->description("Compute the jacobians and shape function gradients at the quadrature points once, "
+                    "and store them with the elements until the mesh changes. "
+                    "Saves most of the geometric work of every iteration, at the cost of "
+                    "(dim*(nb_nodes+1)+2) reals per quadrature point and element")
+      ->pretty_name("Cache Geometry")
+      ->link_to(&m_cache_geometry)
+      ->attach_trigger ( boost::bind ( &CellTerm::config_cache_geometry, this ) );
 }
 
 CellTerm::~CellTerm() {}
@@ -66,6 +96,24 @@ void CellTerm::link_fields()
   }
 }
 
+void CellTerm::config_cache_geometry()
+{
+  // the terms and their copies for the threads are children of this action,
+  // they use the option when their elements are set
+
+  boost_foreach( Component& term, find_components(*this) )
+  {
+    if( term.options().check("cache_geometry") )
+      term.configure_option( "cache_geometry", m_cache_geometry );
+  }
+}
+
+void CellTerm::synchronize_end()
+{
+  solver().as_type<RDM::RDSolver>().actions()
+          .get_child("Synchronize").as_type<CSynchronizeFields>().synchronize_end();
+}
+
 ElementLoop& CellTerm::access_element_loop( const std::string& type_name )
 {
   // ensure that the fields are present
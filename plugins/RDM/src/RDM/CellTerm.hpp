@@ -43,6 +43,19 @@ public: // functions
 
   ElementLoop& access_element_loop( const std::string& type_name );
 
+  /// true if the loops first visit the interior elements, while the split-phase
+  /// synchronization started by the solver action "Synchronize" is in flight
+  bool overlap_synchronization() const { return m_overlap_synchronization; }
+
+  /// completes the synchronization started by the solver action "Synchronize"
+  void synchronize_end();
+
+  /// true if the loops visit the elements colour by colour also with one thread
+  bool deterministic() const { return m_deterministic; }
+
+  /// true if the terms store the geometric values of the elements at the quadrature points
+  bool cache_geometry() const { return m_cache_geometry; }
+
   /// @name ACCESSORS
   //@{
 
@@ -58,6 +71,9 @@ protected: // function
 
   void link_fields();
 
+  /// configures the option cache_geometry of the terms
+  void config_cache_geometry();
+
 protected: // data
 
   boost::weak_ptr<Mesh::Field> m_solution;     ///< access to the solution field
@@ -66,6 +82,12 @@ protected: // data
 
   boost::weak_ptr<Mesh::Field> m_wave_speed;   ///< access to the wave_speed field
 
+  bool m_overlap_synchronization;              ///< loop interior elements before completing synchronization
+
+  bool m_deterministic;                        ///< visit elements colour by colour also with one thread
+
+  bool m_cache_geometry;                       ///< store the geometric values of the elements
+
 };
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -65,6 +65,29 @@ void FwdEuler::execute()
 
   const Uint nbdofs = solution.size();
   const Uint nbvars = solution.row_size();
+
+  if ( solution.has_contiguous_columns() && residual.has_contiguous_columns() && wave_speed.row_size() == 1 )
+  {
+    // variable by variable over all nodes, which vectorizes
+    m_update_coeff.resize(nbdofs);
+    for ( Uint i=0; i< nbdofs; ++i )
+    {
+      if ( is_zero(wave_speed[i][0]) )
+      {
+        for ( Uint j=0; j< nbvars; ++j )
+          if( is_not_zero(residual[i][j]) )
+            CFwarn << "residual not null but wave_speed null at node [" << i << "] variable [" << j << "]" << CFendl;
+        m_update_coeff[i] = 0.;
+      }
+      else
+        m_update_coeff[i] = CFL / wave_speed[i][0];
+    }
+
+    for ( Uint j=0; j< nbvars; ++j )
+      solution.column(j).array() -= m_update_coeff.array() * residual.column(j).array();
+    return;
+  }
+
   for ( Uint i=0; i< nbdofs; ++i )
   {
     if ( is_zero(wave_speed[i][0]) )
@@ -7,6 +7,8 @@
 #ifndef CF_RDM_FwdEuler_hpp
 #define CF_RDM_FwdEuler_hpp
 
+#include "Math/MatrixTypes.hpp"
+
 #include "Solver/Action.hpp"
 
 #include "RDM/LibRDM.hpp"
@@ -47,6 +49,8 @@ private: // data
   boost::weak_ptr<Mesh::Field> m_residual;
   /// wave_speed field pointer
   boost::weak_ptr<Mesh::Field> m_wave_speed;
+  /// update coefficient of every node, for fields with contiguous variables
+  RealVector m_update_coeff;
 
 };
 
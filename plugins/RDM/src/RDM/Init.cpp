@@ -72,9 +72,10 @@ void Init::execute()
   //  std::cout << "   field.size() == " << field.size() << std::endl;
   //  std::cout << "   coordinates.size() == " << mesh().geometry().coordinates().size() << std::endl;
 
-  std::vector<Real> vars( DIM_3D, 0.);
-
-  RealVector return_val( field.row_size() );
+  // The function is evaluated for batches of nodes at once, with one row per node in vars and values
+  const Uint batch_size = 4096u;
+  RealMatrix vars;
+  RealMatrix values;
 
   boost_foreach(CRegion::Ptr& region, m_loop_regions)
   {
@@ -82,20 +83,31 @@ void Init::execute()
 
     Geometry& nodes = mesh().geometry();
 
-    boost_foreach(const Uint node, CElements::used_nodes(*region).array())
+    const CList<Uint>::ListT& used_nodes = CElements::used_nodes(*region).array();
+    const Uint nb_nodes = used_nodes.size();
+    for (Uint begin=0; begin<nb_nodes; begin+=batch_size)
     {
-      cf_assert(node < field.size());
-
-      CTable<Real>::ConstRow coords = nodes.coordinates()[node];
-
-      for (Uint i=0; i<coords.size(); ++i)
-        vars[i] = coords[i];
-
-      m_function.evaluate(vars,return_val);
-
-      CTable<Real>::Row data_row = field[node];
-      for (Uint i=0; i<data_row.size(); ++i)
-        data_row[i] = return_val[i];
+      const Uint nb_batch_nodes = std::min(batch_size, nb_nodes-begin);
+      if (vars.rows() != nb_batch_nodes)
+        vars = RealMatrix::Zero(nb_batch_nodes, DIM_3D);
+      for (Uint n=0; n<nb_batch_nodes; ++n)
+      {
+        CTable<Real>::ConstRow coords = nodes.coordinates()[used_nodes[begin+n]];
+        for (Uint i=0; i<coords.size(); ++i)
+          vars(n,i) = coords[i];
+      }
+
+      m_function.evaluate(vars,values);
+
+      for (Uint n=0; n<nb_batch_nodes; ++n)
+      {
+        const Uint node = used_nodes[begin+n];
+        cf_assert(node < field.size());
+
+        CTable<Real>::Row data_row = field[node];
+        for (Uint i=0; i<data_row.size(); ++i)
+          data_row[i] = values(n,i);
+      }
     }
 
   }
@@ -14,6 +14,8 @@
 #include "Mesh/CMesh.hpp"
 #include "Mesh/CRegion.hpp"
 
+#include "Solver/Actions/CSynchronizeFields.hpp"
+
 #include "RDM/Tags.hpp"
 
 //#include "Mesh/Actions/CInitFieldFunction.hpp"
@@ -70,10 +72,11 @@ void InitialConditions::execute()
 
   // synchronize fields to insure consistency of parallel data
 
-  CAction& synchronize =
-      access_component( "cpath:../Actions/Synchronize" ).as_type<CAction>();
+  Solver::Actions::CSynchronizeFields& synchronize =
+      access_component( "cpath:../Actions/Synchronize" ).as_type<Solver::Actions::CSynchronizeFields>();
 
   synchronize.execute();
+  synchronize.synchronize_end();
 }
 
 
@@ -98,7 +98,7 @@ void IterativeSolver::execute()
   CActionDirector& domain_discretization =
       access_component( "cpath:../DomainDiscretization" ).as_type<CActionDirector>();
 
-  CAction& synchronize = mysolver.actions().get_child("Synchronize").as_type<CAction>();
+  CSynchronizeFields& synchronize = mysolver.actions().get_child("Synchronize").as_type<CSynchronizeFields>();
 
   Component& cnorm = post_actions().get_child("ComputeNorm");
   cnorm.configure_option("Field", mysolver.fields().get_child( RDM::Tags::residual() ).follow()->uri() );
@@ -118,21 +118,24 @@ void IterativeSolver::execute()
 
     pre_actions().execute();
 
-    // (2) domain discretization
+    // (2) synchronize, in split phase the cell terms complete it
+    //     after looping the elements that do not read ghost values
 
-    domain_discretization.execute();
+    synchronize.execute();
 
-    // (3) apply boundary conditions
+    // (3) domain discretization
 
-    boundary_conditions.execute();
+    domain_discretization.execute();
 
-    // (4) update
+    synchronize.synchronize_end();
 
-    update().execute();
+    // (4) apply boundary conditions
+
+    boundary_conditions.execute();
 
     // (5) update
 
-    synchronize.execute();
+    update().execute();
 
     // (6) the post actions - compute norm, post-process something, etc
 
@@ -147,6 +150,11 @@ void IterativeSolver::execute()
     property("iteration") = ++iter; // update the iteration number
 
   }
+
+  // the ghost values of the last update
+
+  synchronize.execute();
+  synchronize.synchronize_end();
 }
 
 void IterativeSolver::raise_iteration_done()
@@ -102,6 +102,15 @@ void RK::execute()
 
   const Uint nbdofs = solution_k.size();
   const Uint nbvars = solution_k.row_size();
+
+  if ( solution_k.has_contiguous_columns() && residual.has_contiguous_columns() && dual_area.row_size() == 1 )
+  {
+    // variable by variable over all nodes, which vectorizes
+    for ( Uint j=0; j< nbvars; ++j )
+      solution_k.column(j).array() -= residual.column(j).array() / dual_area.column(0).array();
+    return;
+  }
+
   for ( Uint i=0; i< nbdofs; ++i )
     for ( Uint j=0; j< nbvars; ++j )
       solution_k[i][j] += - residual[i][j] / dual_area[i][0];
@@ -17,6 +17,7 @@
 #include "Common/OptionT.hpp"
 #include "Common/OptionComponent.hpp"
 #include "Common/BasicExceptions.hpp"
+#include "Common/StringConversion.hpp"
 
 #include "Math/MatrixTypes.hpp"
 
@@ -66,6 +67,7 @@ public: // functions
   static std::string type_name () { return "SchemeBase<" + SF::type_name() + ">"; }
 
   /// interpolates the shape functions and gradient values
+  /// @pre with a geometry cache, nodes_idx are the nodes of element idx()
   /// @post zeros the local residual matrix
   void interpolate ( const Mesh::CTable<Uint>::ConstRow& nodes_idx );
 
@@ -86,8 +88,29 @@ protected: // helper functions
     solution   = csolution.lock();
     residual   = cresidual.lock();
     wave_speed = cwave_speed.lock();
+
+    geometry_cache.reset();
+    if( m_cache_geometry )
+    {
+      const std::string key = "geometry_cache_" + SF::type_name() + "_gauss" + Common::to_str(QD::order);
+      bool created = false;
+      geometry_cache = Mesh::CEntities::geometry_cache( elements(), key, cache_row_size, created )
+                         .template as_ptr< Mesh::CTable<Real> >();
+      if( created )
+        fill_geometry_cache();
+    }
   }
 
+  /// computes the values that only depend on the geometry from X_n:
+  /// X_q, dNdX, jacob and wj
+  void compute_geometry();
+
+  /// computes the geometric values of all elements into the geometry cache
+  void fill_geometry_cache();
+
+  /// copies the geometric values of one element from the geometry cache
+  void load_geometry( const Uint elem );
+
 protected: // typedefs
 
   typedef typename SF::NodeMatrixT                                               NodeMT;
@@ -116,6 +139,10 @@ protected: // typedefs
 
   typedef Eigen::Matrix<Real, PHYS::MODEL::_neqs, PHYS::MODEL::_ndim>            QSolutionVT;
 
+  /// number of values per element in the geometry cache: for every quadrature point the coordinates,
+  /// the gradients of the shape functions in physical space, the jacobian and the integration factor
+  enum { cache_row_size = QD::nb_points * ( PHYS::MODEL::_ndim * ( 1 + SF::nb_nodes ) + 2 ) };
+
 protected: // data
 
   boost::weak_ptr< Mesh::Field > csolution;   ///< solution field
@@ -132,6 +159,11 @@ protected: // data
   Mesh::Field::Ptr residual;
   /// pointer to solution table, may reset when iterating over element types
   Mesh::Field::Ptr wave_speed;
+  /// pointer to the geometric values of the elements, null if they are not cached
+  Mesh::CTable<Real>::Ptr geometry_cache;
+
+  /// if true, the geometric values at the quadrature points are computed once and stored in the elements
+  bool m_cache_geometry;
 
   /// helper object to compute the quadrature information
   const QD& m_quadrature;
@@ -193,6 +225,7 @@ protected:
 template<typename SF, typename QD, typename PHYS>
 SchemeBase<SF,QD,PHYS>::SchemeBase ( const std::string& name ) :
   CLoopOperation(name),
+  m_cache_geometry(false),
   m_quadrature( QD::instance() )
 {
   regist_typeinfo(this); // template class so must force type registration @ construction
@@ -206,6 +239,13 @@ SchemeBase<SF,QD,PHYS>::SchemeBase ( const std::string& name ) :
   m_options.add_option(
         Common::OptionComponent<Mesh::Field>::create( RDM::Tags::residual(), &cresidual));
 
+  m_options.add_option< Common::OptionT<bool> >( "cache_geometry", m_cache_geometry )
+      ->description("Compute the jacobians and shape function gradients at the quadrature points once, "
+                    "and store them with the elements instead of recomputing them every iteration. "
+                    "Takes effect when the elements are set")
+      ->pretty_name("Cache Geometry")
+      ->link_to(&m_cache_geometry);
+
 
   m_options["elements"]
       .attach_trigger ( boost::bind ( &SchemeBase<SF,QD,PHYS>::change_elements, this ) );
@@ -266,14 +306,36 @@ void SchemeBase<SF, QD,PHYS>::interpolate( const Mesh::CTable<Uint>::ConstRow& n
     for (Uint v=0; v < PHYS::MODEL::_neqs; ++v)
       U_n(n,v) = (*solution)[ nodes_idx[n] ][v];
 
-  // coordinates of quadrature points in physical space
+  // geometric values, computed once for all iterations if cached
 
-  X_q  = Ni * X_n;
+  if( is_not_null(geometry_cache) )
+    load_geometry( idx() );
+  else
+    compute_geometry();
 
   // solution at all quadrature points in physical space
 
   U_q = Ni * U_n;
 
+  // solution derivatives in physical space at quadrature point
+
+  for(Uint dim = 0; dim < PHYS::MODEL::_ndim; ++dim)
+    dUdX[dim] = dNdX[dim] * U_n;
+
+  // zero element residuals
+
+  Phi_n.setZero();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename SF,typename QD, typename PHYS>
+void SchemeBase<SF, QD,PHYS>::compute_geometry()
+{
+  // coordinates of quadrature points in physical space
+
+  X_q  = Ni * X_n;
+
   // Jacobian of transformation phys -> ref:
   //    |   dx/dksi    dx/deta    |
   //    |   dy/dksi    dy/deta    |
@@ -320,17 +382,57 @@ void SchemeBase<SF, QD,PHYS>::interpolate( const Mesh::CTable<Uint>::ConstRow& n
 
   for(Uint q = 0; q < QD::nb_points; ++q)
     wj[q] = jacob[q] * m_quadrature.weights[q];
+}
 
-  // solution derivatives in physical space at quadrature point
+////////////////////////////////////////////////////////////////////////////////////////////
 
-  for(Uint dim = 0; dim < PHYS::MODEL::_ndim; ++dim)
-    dUdX[dim] = dNdX[dim] * U_n;
+template<typename SF,typename QD, typename PHYS>
+void SchemeBase<SF, QD,PHYS>::fill_geometry_cache()
+{
+  Mesh::CTable<Real>& cache = *geometry_cache;
+  const Uint nb_elems = elements().size();
+  for(Uint e = 0; e < nb_elems; ++e)
+  {
+    Mesh::fill(X_n, *coordinates, (*connectivity)[e] );
+    compute_geometry();
+
+    Mesh::CTable<Real>::Row row = cache[e];
+    Uint i = 0;
+    for(Uint q = 0; q < QD::nb_points; ++q)
+      for(Uint dim = 0; dim < PHYS::MODEL::_ndim; ++dim)
+        row[i++] = X_q(q,dim);
+    for(Uint dim = 0; dim < PHYS::MODEL::_ndim; ++dim)
+      for(Uint q = 0; q < QD::nb_points; ++q)
+        for(Uint n = 0; n < SF::nb_nodes; ++n)
+          row[i++] = dNdX[dim](q,n);
+    for(Uint q = 0; q < QD::nb_points; ++q)
+      row[i++] = jacob[q];
+    for(Uint q = 0; q < QD::nb_points; ++q)
+      row[i++] = wj[q];
+  }
+}
 
-  // zero element residuals
+////////////////////////////////////////////////////////////////////////////////////////////
 
-  Phi_n.setZero();
+template<typename SF,typename QD, typename PHYS>
+void SchemeBase<SF, QD,PHYS>::load_geometry( const Uint elem )
+{
+  const Mesh::CTable<Real>::ConstRow row = (*geometry_cache)[elem];
+  Uint i = 0;
+  for(Uint q = 0; q < QD::nb_points; ++q)
+    for(Uint dim = 0; dim < PHYS::MODEL::_ndim; ++dim)
+      X_q(q,dim) = row[i++];
+  for(Uint dim = 0; dim < PHYS::MODEL::_ndim; ++dim)
+    for(Uint q = 0; q < QD::nb_points; ++q)
+      for(Uint n = 0; n < SF::nb_nodes; ++n)
+        dNdX[dim](q,n) = row[i++];
+  for(Uint q = 0; q < QD::nb_points; ++q)
+    jacob[q] = row[i++];
+  for(Uint q = 0; q < QD::nb_points; ++q)
+    wj[q] = row[i++];
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////
 
 template<typename SF,typename QD, typename PHYS>
 void SchemeBase<SF, QD,PHYS>::sol_gradients_at_qdpoint(const Uint q)
@@ -0,0 +1,135 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for the geometry cache of the RDM schemes"
+
+#include <cmath>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/FindComponents.hpp"
+
+#include "Mesh/CDomain.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CSimpleMeshGenerator.hpp"
+#include "Mesh/Field.hpp"
+#include "Mesh/Geometry.hpp"
+
+#include "Solver/CModel.hpp"
+
+#include "RDM/CellTerm.hpp"
+#include "RDM/DomainDiscretization.hpp"
+#include "RDM/RDSolver.hpp"
+#include "RDM/SteadyExplicit.hpp"
+#include "RDM/Tags.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Mesh;
+using namespace CF::Solver;
+using namespace CF::RDM;
+
+/// @todo create a library for support of the utests
+/// @todo move this to a class that all utests global fixtures must inherit from
+struct CoreInit {
+
+  /// global initiate
+  CoreInit()
+  {
+    using namespace boost::unit_test::framework;
+    Core::instance().initiate( master_test_suite().argc, master_test_suite().argv);
+  }
+
+  /// global tear-down
+  ~CoreInit()
+  {
+    Core::instance().terminate();
+  }
+
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// zeros the residual and wave speed, then applies the cell term
+std::vector<Real> compute_residual( RDSolver& solver, CellTerm& term )
+{
+  Field& residual   = solver.fields().get_child( RDM::Tags::residual()   ).follow()->as_type<Field>();
+  Field& wave_speed = solver.fields().get_child( RDM::Tags::wave_speed() ).follow()->as_type<Field>();
+
+  for( Uint n = 0; n < residual.size(); ++n )
+  {
+    residual[n][0]   = 0.;
+    wave_speed[n][0] = 0.;
+  }
+
+  term.execute();
+
+  std::vector<Real> result( residual.size() );
+  for( Uint n = 0; n < residual.size(); ++n )
+    result[n] = residual[n][0];
+  return result;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_GLOBAL_FIXTURE( CoreInit );
+
+BOOST_AUTO_TEST_SUITE( cache_geometry_test_suite )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( residual_with_and_without_cache )
+{
+  SteadyExplicit& wizard = Core::instance().root().create_component<SteadyExplicit>("Wizard");
+  CModel& model = wizard.create_model( "Model", "CF.Physics.Scalar.Scalar2D" );
+  RDSolver& solver = find_component<RDSolver>(model);
+
+  // rectangle with the nodes moved, so that the jacobians differ between elements and quadrature points
+
+  CMesh& mesh = find_component<CDomain>(model).create_component<CMesh>("mesh");
+  CSimpleMeshGenerator::create_rectangle( mesh, 2., 1., 8, 4 );
+  CTable<Real>& coords = mesh.geometry().coordinates();
+  for( Uint n = 0; n < coords.size(); ++n )
+    coords[n][YY] += 0.05 * std::sin( 3. * coords[n][XX] ) * coords[n][YY];
+
+  solver.configure_option( RDM::Tags::update_vars(), std::string("LinearAdv2D") );
+  solver.configure_option( RDM::Tags::mesh(), mesh.uri() );
+
+  Field& solution = solver.fields().get_child( RDM::Tags::solution() ).follow()->as_type<Field>();
+  for( Uint n = 0; n < solution.size(); ++n )
+    solution[n][0] = std::sin( coords[n][XX] ) * std::cos( 2. * coords[n][YY] );
+
+  std::vector<URI> regions( 1, mesh.topology().uri() );
+  CellTerm& term = solver.domain_discretization().create_cell_term( "CF.RDM.Schemes.LDA", "INTERNAL", regions );
+
+  const std::vector<Real> computed = compute_residual( solver, term );
+  BOOST_CHECK( find_components_recursively_with_tag< CTable<Real> >( mesh.topology(), Mesh::Tags::geometry_cache() ).empty() );
+
+  // the first execution fills the cache, the second only reads it
+
+  term.configure_option( "cache_geometry", true );
+
+  const std::vector<Real> filled = compute_residual( solver, term );
+  BOOST_CHECK( !find_components_recursively_with_tag< CTable<Real> >( mesh.topology(), Mesh::Tags::geometry_cache() ).empty() );
+
+  const std::vector<Real> cached = compute_residual( solver, term );
+
+  BOOST_REQUIRE_EQUAL( filled.size(), computed.size() );
+  BOOST_REQUIRE_EQUAL( cached.size(), computed.size() );
+  for( Uint n = 0; n < computed.size(); ++n )
+  {
+    BOOST_CHECK_SMALL( filled[n] - computed[n], 1e-12 );
+    BOOST_CHECK_SMALL( cached[n] - computed[n], 1e-12 );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
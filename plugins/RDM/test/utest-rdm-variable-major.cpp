@@ -0,0 +1,173 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for the RDM updates on variable major fields"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/CActionDirector.hpp"
+
+#include "Mesh/CDomain.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CSimpleMeshGenerator.hpp"
+#include "Mesh/Field.hpp"
+#include "Mesh/FieldGroup.hpp"
+
+#include "Solver/CModel.hpp"
+
+#include "RDM/IterativeSolver.hpp"
+#include "RDM/RDSolver.hpp"
+#include "RDM/SteadyExplicit.hpp"
+#include "RDM/UnsteadyExplicit.hpp"
+#include "RDM/Tags.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Mesh;
+using namespace CF::Solver;
+using namespace CF::RDM;
+
+/// @todo create a library for support of the utests
+/// @todo move this to a class that all utests global fixtures must inherit from
+struct CoreInit {
+
+  /// global initiate
+  CoreInit()
+  {
+    using namespace boost::unit_test::framework;
+    Core::instance().initiate( master_test_suite().argc, master_test_suite().argv);
+  }
+
+  /// global tear-down
+  ~CoreInit()
+  {
+    Core::instance().terminate();
+  }
+
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// the field the solver links under the given tag
+Field& solver_field( RDSolver& solver, const std::string& tag )
+{
+  return solver.fields().get_child( tag ).follow()->as_type<Field>();
+}
+
+/// fills the fields read by the update with values that differ per node and variable
+void fill_fields( RDSolver& solver, const std::string& scale_tag )
+{
+  Field& solution = solver_field( solver, RDM::Tags::solution() );
+  Field& residual = solver_field( solver, RDM::Tags::residual() );
+  Field& scale    = solver_field( solver, scale_tag );
+
+  for( Uint n = 0; n < solution.size(); ++n )
+  {
+    for( Uint v = 0; v < solution.row_size(); ++v )
+    {
+      solution[n][v] = 1. + 0.1 * n + v;
+      residual[n][v] = 0.01 * ( n % 7 ) - 0.02 * v;
+    }
+    scale[n][0] = 1. + 0.5 * ( n % 3 );
+  }
+}
+
+/// executes the update step and the residual norm,
+/// returns the updated solution row by row followed by the norm
+std::vector<Real> update( RDSolver& solver )
+{
+  IterativeSolver& iterative_solver = solver.iterative_solver();
+
+  Component& cnorm = iterative_solver.post_actions().get_child("ComputeNorm");
+  cnorm.configure_option("Field", solver.fields().get_child( RDM::Tags::residual() ).follow()->uri() );
+
+  iterative_solver.update().get_child("Step").as_type<CAction>().execute();
+  cnorm.as_type<CAction>().execute();
+
+  Field& solution = solver_field( solver, RDM::Tags::solution() );
+
+  std::vector<Real> result;
+  for( Uint n = 0; n < solution.size(); ++n )
+    for( Uint v = 0; v < solution.row_size(); ++v )
+      result.push_back( solution[n][v] );
+  result.push_back( cnorm.property("norm").value<Real>() );
+  return result;
+}
+
+/// updates the row major solution, then the same solution stored variable by variable
+void check_layouts( RDSolver& solver, const std::string& scale_tag )
+{
+  Field& solution = solver_field( solver, RDM::Tags::solution() );
+  BOOST_REQUIRE( solution.row_size() > 1 );
+
+  fill_fields( solver, scale_tag );
+  const std::vector<Real> row_major = update( solver );
+
+  solution.field_group().configure_option( "layout", std::string("variable_major") );
+
+  BOOST_CHECK_EQUAL( solution.layout(), Field::VARIABLE_MAJOR );
+  BOOST_CHECK_EQUAL( solver_field( solver, RDM::Tags::residual() ).layout(), Field::VARIABLE_MAJOR );
+
+  fill_fields( solver, scale_tag );
+  const std::vector<Real> variable_major = update( solver );
+
+  BOOST_REQUIRE_EQUAL( variable_major.size(), row_major.size() );
+  for( Uint i = 0; i < row_major.size(); ++i )
+    BOOST_CHECK_CLOSE( variable_major[i], row_major[i], 1e-10 );
+
+  solution.field_group().configure_option( "layout", std::string("row_major") );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_GLOBAL_FIXTURE( CoreInit );
+
+BOOST_AUTO_TEST_SUITE( variable_major_test_suite )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( forward_euler )
+{
+  SteadyExplicit& wizard = Core::instance().root().create_component<SteadyExplicit>("SteadyWizard");
+  CModel& model = wizard.create_model( "SteadyModel", "CF.Physics.Scalar.ScalarSys2D" );
+  RDSolver& solver = find_component<RDSolver>(model);
+
+  CMesh& mesh = find_component<CDomain>(model).create_component<CMesh>("mesh");
+  CSimpleMeshGenerator::create_rectangle( mesh, 2., 1., 8, 4 );
+
+  solver.configure_option( RDM::Tags::update_vars(), std::string("LinearAdvSys2D") );
+  solver.configure_option( RDM::Tags::mesh(), mesh.uri() );
+
+  check_layouts( solver, RDM::Tags::wave_speed() );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( runge_kutta )
+{
+  UnsteadyExplicit& wizard = Core::instance().root().create_component<UnsteadyExplicit>("UnsteadyWizard");
+  CModel& model = wizard.create_model( "UnsteadyModel", "CF.Physics.Scalar.ScalarSys2D" );
+  RDSolver& solver = find_component<RDSolver>(model);
+
+  CMesh& mesh = find_component<CDomain>(model).create_component<CMesh>("mesh");
+  CSimpleMeshGenerator::create_rectangle( mesh, 2., 1., 8, 4 );
+
+  solver.configure_option( RDM::Tags::update_vars(), std::string("LinearAdvSys2D") );
+  solver.configure_option( RDM::Tags::mesh(), mesh.uri() );
+
+  // the last step of a first order scheme updates the solution itself
+  solver.iterative_solver().configure_property( "iteration", solver.properties().value<Uint>("rkorder") );
+
+  check_layouts( solver, RDM::Tags::dual_area() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,86 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_RiemannSolvers_RiemannSolverT_hpp
+#define CF_RiemannSolvers_RiemannSolverT_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Math/MatrixTypes.hpp"
+
+namespace CF {
+namespace RiemannSolvers {
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Riemann solver for a batch of faces, specialized at compile time on the scheme,
+/// which fixes the number of equations and dimensions.
+/// The SCHEME type provides
+/// @code
+///   enum { neqs = ..., ndim = ... };
+///   template < typename SV, typename GV, typename FV >
+///   void solve(const SV& left, const SV& right, const GV& unit_normal, FV& flux, Real& wave_speed) const;
+/// @endcode
+/// which is inlined in the loop over the faces, on fixed size vectors.
+/// @note No flux evaluation calls it yet. The only face flux loop, in SFDM,
+///       is disabled until it moves to the current Physics API.
+template < typename SCHEME >
+class RiemannSolverT
+{
+public: // typedefs
+
+  enum { neqs = SCHEME::neqs };
+  enum { ndim = SCHEME::ndim };
+
+  typedef Eigen::Matrix<Real, neqs, 1> SolV;
+  typedef Eigen::Matrix<Real, ndim, 1> GeoV;
+
+public: // functions
+
+  RiemannSolverT( const SCHEME& scheme = SCHEME() ) : m_scheme(scheme) {}
+
+  const SCHEME& scheme() const { return m_scheme; }
+
+  /// Solve the Riemann problems of nb_faces faces
+  /// @param [in]  left        nb_faces states of neqs values on the side the normals point away from
+  /// @param [in]  right       nb_faces states of neqs values on the side the normals point to
+  /// @param [in]  normals     nb_faces normals of ndim values, with the area of the face as length
+  /// @param [out] flux        nb_faces fluxes of neqs values, through the whole face
+  /// @param [out] wave_speeds nb_faces largest absolute wave speeds, multiplied with the area of the face
+  void solve( const Uint nb_faces,
+              const Real* left, const Real* right, const Real* normals,
+              Real* flux, Real* wave_speeds ) const
+  {
+    GeoV unit_normal;
+    for (Uint f=0; f<nb_faces; ++f)
+    {
+      const Eigen::Map<const SolV> left_state ( left    + f*neqs );
+      const Eigen::Map<const SolV> right_state( right   + f*neqs );
+      const Eigen::Map<const GeoV> normal     ( normals + f*ndim );
+      Eigen::Map<SolV> face_flux( flux + f*neqs );
+
+      const Real area = normal.norm();
+      unit_normal = normal / area;
+      m_scheme.solve(left_state, right_state, unit_normal, face_flux, wave_speeds[f]);
+      face_flux *= area;
+      wave_speeds[f] *= area;
+    }
+  }
+
+private: // data
+
+  SCHEME m_scheme;
+
+}; // RiemannSolverT
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // RiemannSolvers
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_RiemannSolvers_RiemannSolverT_hpp
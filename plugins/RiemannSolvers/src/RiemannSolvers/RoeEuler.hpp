@@ -0,0 +1,118 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_RiemannSolvers_RoeEuler_hpp
+#define CF_RiemannSolvers_RoeEuler_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include "Math/MatrixTypes.hpp"
+
+namespace CF {
+namespace RiemannSolvers {
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Roe flux for the Euler equations in conservative variables (rho, rho.u, ..., rho.E),
+/// in closed form: the dissipation is the sum over the waves of |eigenvalue| * wave strength * right eigenvector,
+/// so that the eigenvector matrices are never formed or multiplied.
+/// To be used as scheme of RiemannSolverT.
+template < int NDIM >
+class RoeEuler
+{
+public: // typedefs
+
+  enum { ndim = NDIM };
+  enum { neqs = NDIM+2 };
+
+  enum { Rho = 0, RhoE = NDIM+1 }; ///< the momentum is stored in between
+
+  typedef Eigen::Matrix<Real, ndim, 1> GeoV;
+
+public: // functions
+
+  /// @param gamma specific heat ratio, 1.4 for air as in Physics::NavierStokes
+  RoeEuler( const Real gamma = 1.4 ) : m_gamma_minus_1(gamma-1.) {}
+
+  /// Roe flux through a face
+  /// @param [in]  n          unit normal, pointing from left to right
+  /// @param [out] wave_speed largest absolute eigenvalue of the Roe average
+  template < typename SV, typename GV, typename FV >
+  void solve(const SV& left, const SV& right, const GV& n, FV& flux, Real& wave_speed) const
+  {
+    // primitive variables on both sides
+
+    const Real rho_L = left[Rho];
+    const GeoV u_L = left.template segment<NDIM>(1) / rho_L;
+    const Real p_L = m_gamma_minus_1 * ( left[RhoE] - 0.5 * rho_L * u_L.squaredNorm() );
+    const Real H_L = ( left[RhoE] + p_L ) / rho_L;
+    const Real un_L = u_L.dot(n);
+
+    const Real rho_R = right[Rho];
+    const GeoV u_R = right.template segment<NDIM>(1) / rho_R;
+    const Real p_R = m_gamma_minus_1 * ( right[RhoE] - 0.5 * rho_R * u_R.squaredNorm() );
+    const Real H_R = ( right[RhoE] + p_R ) / rho_R;
+    const Real un_R = u_R.dot(n);
+
+    // Roe average
+
+    const Real sqrt_rho_L = std::sqrt(rho_L);
+    const Real sqrt_rho_R = std::sqrt(rho_R);
+    const Real weight = 1. / ( sqrt_rho_L + sqrt_rho_R );
+
+    const Real rho = sqrt_rho_L * sqrt_rho_R;
+    const GeoV u = ( sqrt_rho_L * u_L + sqrt_rho_R * u_R ) * weight;
+    const Real H = ( sqrt_rho_L * H_L + sqrt_rho_R * H_R ) * weight;
+    const Real half_q2 = 0.5 * u.squaredNorm();
+    const Real a2 = m_gamma_minus_1 * ( H - half_q2 );
+    const Real a = std::sqrt(a2);
+    const Real un = u.dot(n);
+
+    // wave strengths of the acoustic waves, and of the entropy and shear waves
+
+    const Real dp = p_R - p_L;
+    const Real dun = un_R - un_L;
+    const GeoV du = u_R - u_L;
+    const Real alpha_minus = ( dp - rho * a * dun ) / ( 2. * a2 );
+    const Real alpha_plus  = ( dp + rho * a * dun ) / ( 2. * a2 );
+    const Real alpha_0     = ( rho_R - rho_L ) - dp / a2;
+
+    const Real c_minus = 0.5 * std::abs(un - a) * alpha_minus;
+    const Real c_plus  = 0.5 * std::abs(un + a) * alpha_plus;
+    const Real c_0     = 0.5 * std::abs(un)     * alpha_0;
+    const Real c_shear = 0.5 * std::abs(un)     * rho;
+
+    // central part, the average of the physical fluxes
+
+    flux[Rho] = 0.5 * ( rho_L * un_L + rho_R * un_R );
+    flux.template segment<NDIM>(1) = 0.5 * ( rho_L * un_L * u_L + rho_R * un_R * u_R + ( p_L + p_R ) * n );
+    flux[RhoE] = 0.5 * ( rho_L * H_L * un_L + rho_R * H_R * un_R );
+
+    // upwind part
+
+    flux[Rho] -= c_minus + c_0 + c_plus;
+    flux.template segment<NDIM>(1) -= c_minus * ( u - a * n ) + c_0 * u + c_plus * ( u + a * n ) + c_shear * ( du - dun * n );
+    flux[RhoE] -= c_minus * ( H - a * un ) + c_0 * half_q2 + c_plus * ( H + a * un ) + c_shear * ( u.dot(du) - un * dun );
+
+    wave_speed = std::abs(un) + a;
+  }
+
+private: // data
+
+  Real m_gamma_minus_1;
+
+}; // RoeEuler
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // RiemannSolvers
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_RiemannSolvers_RoeEuler_hpp
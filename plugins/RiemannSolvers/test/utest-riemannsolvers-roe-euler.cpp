@@ -0,0 +1,139 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for CF::RiemannSolvers::RoeEuler"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Math/Defs.hpp"
+
+#include "Physics/NavierStokes/Cons2D.hpp"
+
+#include "RiemannSolvers/RiemannSolverT.hpp"
+#include "RiemannSolvers/RoeEuler.hpp"
+
+using namespace CF;
+using namespace CF::RiemannSolvers;
+using namespace CF::Physics::NavierStokes;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Roe flux with the eigen structure of the flux jacobian of Cons2D, in the Roe averaged state
+NavierStokes2D::SolV reference_roe_flux(const NavierStokes2D::SolV& left, const NavierStokes2D::SolV& right, const NavierStokes2D::GeoV& normal)
+{
+  const NavierStokes2D::GeoV coords = NavierStokes2D::GeoV::Zero();
+  const NavierStokes2D::SolM grad_vars = NavierStokes2D::SolM::Zero();
+
+  NavierStokes2D::Properties p_L, p_R, p_roe;
+  Cons2D::compute_properties(coords, left,  grad_vars, p_L);
+  Cons2D::compute_properties(coords, right, grad_vars, p_R);
+
+  // conservative state with the Roe averaged velocity and enthalpy
+  const Real sqrt_rho_L = std::sqrt(p_L.rho);
+  const Real sqrt_rho_R = std::sqrt(p_R.rho);
+  const Real rho = sqrt_rho_L*sqrt_rho_R;
+  const Real u = (sqrt_rho_L*p_L.u + sqrt_rho_R*p_R.u) / (sqrt_rho_L + sqrt_rho_R);
+  const Real v = (sqrt_rho_L*p_L.v + sqrt_rho_R*p_R.v) / (sqrt_rho_L + sqrt_rho_R);
+  const Real H = (sqrt_rho_L*p_L.H + sqrt_rho_R*p_R.H) / (sqrt_rho_L + sqrt_rho_R);
+  const Real P = p_L.gamma_minus_1/p_L.gamma * rho * (H - 0.5*(u*u+v*v));
+  NavierStokes2D::SolV roe_state;
+  roe_state << rho, rho*u, rho*v, rho*H - P;
+  Cons2D::compute_properties(coords, roe_state, grad_vars, p_roe);
+
+  Eigen::Matrix<Real,4,4> Rv, Lv;
+  NavierStokes2D::SolV Dv;
+  Cons2D::flux_jacobian_eigen_structure(p_roe, normal, Rv, Lv, Dv);
+
+  Eigen::Matrix<Real,4,2> F_L, F_R;
+  Cons2D::flux(p_L, F_L);
+  Cons2D::flux(p_R, F_R);
+
+  return 0.5*(F_L + F_R)*normal - 0.5*Rv*Dv.cwiseAbs().asDiagonal()*Lv*(right-left);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( RiemannSolvers_RoeEuler_Suite )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( closed_form_matches_eigen_structure )
+{
+  NavierStokes2D::SolV left, right;
+  left  << 1.0,  0.3, -0.2, 2.5;
+  right << 0.6, -0.1,  0.4, 1.7;
+  NavierStokes2D::GeoV normal;
+  normal << 0.6, 0.8;
+
+  const NavierStokes2D::SolV reference = reference_roe_flux(left, right, normal);
+
+  RoeEuler<2> roe;
+  NavierStokes2D::SolV flux;
+  Real wave_speed;
+  roe.solve(left, right, normal, flux, wave_speed);
+
+  BOOST_CHECK_SMALL( (flux - reference).norm() , 1e-12 );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( consistency_3d )
+{
+  // equal states give the physical flux
+  Eigen::Matrix<Real,5,1> state;
+  state << 1.2, 0.4, -0.3, 0.2, 3.1;
+  Eigen::Matrix<Real,3,1> normal;
+  normal << 0., 0.6, 0.8;
+
+  const Real rho = state[0];
+  const Eigen::Matrix<Real,3,1> u = state.segment<3>(1) / rho;
+  const Real P = 0.4 * (state[4] - 0.5*rho*u.squaredNorm());
+  const Real un = u.dot(normal);
+  Eigen::Matrix<Real,5,1> physical_flux;
+  physical_flux[0] = rho*un;
+  physical_flux.segment<3>(1) = rho*un*u + P*normal;
+  physical_flux[4] = (state[4] + P)*un;
+
+  RoeEuler<3> roe;
+  Eigen::Matrix<Real,5,1> flux;
+  Real wave_speed;
+  roe.solve(state, state, normal, flux, wave_speed);
+
+  BOOST_CHECK_SMALL( (flux - physical_flux).norm() , 1e-12 );
+  BOOST_CHECK_CLOSE( wave_speed , std::abs(un) + std::sqrt(1.4*P/rho) , 1e-10 );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( batch_of_faces )
+{
+  // the same face twice, with different areas
+  const Real left[]    = { 1.0,  0.3, -0.2, 2.5,   1.0,  0.3, -0.2, 2.5 };
+  const Real right[]   = { 0.6, -0.1,  0.4, 1.7,   0.6, -0.1,  0.4, 1.7 };
+  const Real normals[] = { 0.6, 0.8,   1.2, 1.6 };
+  Real flux[8];
+  Real wave_speeds[2];
+
+  RiemannSolverT< RoeEuler<2> > riemann_solver;
+  riemann_solver.solve(2, left, right, normals, flux, wave_speeds);
+
+  for (Uint i=0; i<4; ++i)
+    BOOST_CHECK_CLOSE( flux[4+i] , 2.*flux[i] , 1e-10 );
+  BOOST_CHECK_CLOSE( wave_speeds[1] , 2.*wave_speeds[0] , 1e-10 );
+
+  NavierStokes2D::SolV left_state(left), right_state(right);
+  NavierStokes2D::GeoV normal(normals);
+  const NavierStokes2D::SolV reference = reference_roe_flux(left_state, right_state, normal);
+  for (Uint i=0; i<4; ++i)
+    BOOST_CHECK_SMALL( flux[i] - reference[i] , 1e-12 );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -9,6 +9,8 @@
 #include "Common/CBuilder.hpp"
 #include "Common/CGroupActions.hpp"
 #include "Common/CGroup.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/Foreach.hpp"
 
 #include "Mesh/CMesh.hpp"
 #include "Mesh/Field.hpp"
@@ -34,7 +36,9 @@ ComponentBuilder<RK, CAction, LibRungeKutta> RK_builder;
 
 RK::RK ( const std::string& name  )
   : Solver::Action(name),
-    m_stages(4u)
+    m_stages(4u),
+    m_freeze_options_version(0),
+    m_freeze_options_resolved(false)
 {
   properties()["brief"] = std::string("Runge Kutta differential equation solver");
   properties()["description"] = std::string("Solves the differential equation using Runge Kutta method");
@@ -54,15 +58,18 @@ RK::RK ( const std::string& name  )
 
   options().add_option(OptionComponent<Field>::create(FlowSolver::Tags::solution(), &m_solution))
       ->description("Solution")
-      ->pretty_name("Solution");
+      ->pretty_name("Solution")
+      ->attach_trigger( boost::bind( &RK::config_update, this) );
 
   options().add_option(OptionComponent<Field>::create(FlowSolver::Tags::residual(), &m_residual))
       ->description("Residual")
-      ->pretty_name("Residual");
+      ->pretty_name("Residual")
+      ->attach_trigger( boost::bind( &RK::config_update, this) );
 
   options().add_option(OptionComponent<Field>::create(FlowSolver::Tags::update_coeff(), &m_update_coeff))
       ->description("Update Coefficient")
-      ->pretty_name("Update Coefficient");
+      ->pretty_name("Update Coefficient")
+      ->attach_trigger( boost::bind( &RK::config_update, this) );
 
   m_for_each_stage = create_static_component_ptr<CGroup>("1_for_each_stage");
   m_for_each_stage->mark_basic();
@@ -83,6 +90,54 @@ RK::~RK()
 {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+void RK::config_update()
+{
+  if (is_null(m_update))
+    return;
+
+  if (!m_solution.expired())
+    m_update->configure_option("solution",m_solution.lock()->uri());
+  if (!m_solution_backup.expired())
+    m_update->configure_option("solution_backup",m_solution_backup.lock()->uri());
+  if (!m_residual.expired())
+    m_update->configure_option("residual",m_residual.lock()->uri());
+  if (!m_update_coeff.expired())
+    m_update->configure_option("update_coeff",m_update_coeff.lock()->uri());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RK::collect_freeze_options(Component& component)
+{
+  // same selection as Component::configure_option_recursively: the option with the name, and the options with the tag
+  foreach_container((const std::string& name) (const Option::Ptr& option), component.options())
+  {
+    if ((name == "freeze_update_coeff" || option->has_tag("freeze_update_coeff")) && !option->has_tag("norecurse"))
+      m_freeze_options.push_back(option);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RK::freeze_update_coeff(const bool freeze)
+{
+  // the options are looked up again only when components were added or removed
+  if (!m_freeze_options_resolved || m_freeze_options_version != Component::tree_version())
+  {
+    m_freeze_options.clear();
+    collect_freeze_options(*m_pre_update);
+    boost_foreach(Component& component, find_components_recursively(*m_pre_update))
+      collect_freeze_options(component);
+    m_freeze_options_version = Component::tree_version();
+    m_freeze_options_resolved = true;
+  }
+
+  boost_foreach(const Option::Ptr& option, m_freeze_options)
+    option->change_value(freeze);
+}
+
 void RK::config_stages()
 {
   m_alpha.resize(m_stages);
@@ -158,24 +213,21 @@ void RK::execute()
   if (m_solution.expired()) throw SetupError (FromHere(), "solution was not set");
 
   if ( m_solution_backup.expired() )  // backup not created --> create field
+  {
     m_solution_backup = m_solution.lock()->field_group().create_field("solution_backup", m_solution.lock()->descriptor()).as_ptr<Field>();
+    config_update();
+  }
 
   const Field& U  = *m_solution.lock();
   Field&       U0 = *m_solution_backup.lock();
 
-  /// @todo put this in triggers of own config options
-  m_update->configure_option("solution",m_solution.lock()->uri());
-  m_update->configure_option("solution_backup",m_solution_backup.lock()->uri());
-  m_update->configure_option("residual",m_residual.lock()->uri());
-  m_update->configure_option("update_coeff",m_update_coeff.lock()->uri());
-
   /// 1) backup solution and time
   U0 = U;
 
   const Real T0 = m_time.lock()->current_time();
 
   /// For every stage of the Runge Kutta scheme
-  m_pre_update->configure_option_recursively("freeze_update_coeff",false);
+  freeze_update_coeff(false);
   for (Uint k=0; k<m_stages; ++k)
   {
     /// - Set the time for this stage (notice that at first stage time is not modified since m_gamma[0] = 0)
@@ -185,7 +237,7 @@ void RK::execute()
     m_pre_update->execute();
 
     /// - Freeze update_coeff for following stages
-    if (k==0) m_pre_update->configure_option_recursively("freeze_update_coeff",true);
+    if (k==0) freeze_update_coeff(true);
 
     /// - Update solution
     ///   @f[ U^{k+1} = (1-\alpha_k)\ U^0 + \alpha_k \ U^k + \beta_k H \ R(U^k) @f]
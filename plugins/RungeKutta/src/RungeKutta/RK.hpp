@@ -59,6 +59,15 @@ private:
 
   void config_stages();
 
+  /// Configure the fields of the update
+  void config_update();
+
+  /// Set the option "freeze_update_coeff" of all pre update actions
+  void freeze_update_coeff(const bool freeze);
+
+  /// Add the options of component named or tagged "freeze_update_coeff" to m_freeze_options
+  void collect_freeze_options(Common::Component& component);
+
 private:
 
   Uint m_stages;
@@ -80,6 +89,14 @@ private:
   std::vector<Real> m_beta;
   std::vector<Real> m_gamma;
 
+  /// options "freeze_update_coeff" of the pre update actions
+  std::vector<Common::Option::Ptr> m_freeze_options;
+
+  /// Component::tree_version() when m_freeze_options was looked up
+  Uint m_freeze_options_version;
+
+  bool m_freeze_options_resolved;
+
 };
 
 ////////////////////////////////////////////////////////////////////////////////
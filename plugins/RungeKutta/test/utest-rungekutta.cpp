@@ -14,6 +14,8 @@
 #include "Common/Core.hpp"
 #include "Common/CRoot.hpp"
 #include "Common/CEnv.hpp"
+#include "Common/CAction.hpp"
+#include "Common/OptionT.hpp"
 
 #include "Math/Defs.hpp"
 #include "Mesh/CSimpleMeshGenerator.hpp"
@@ -32,6 +34,36 @@ using namespace CF::Mesh;
 
 //////////////////////////////////////////////////////////////////////////////
 
+/// Pre update action counting the executions where the update coefficient may be computed.
+/// Its option is only tagged "freeze_update_coeff", as RK must find options by tag too.
+class CountUnfrozen : public CAction
+{
+public:
+
+  typedef boost::shared_ptr<CountUnfrozen> Ptr;
+
+  CountUnfrozen(const std::string& name) : CAction(name), m_frozen(false), m_count(0)
+  {
+    options().add_option(OptionT<bool>::create("frozen", m_frozen))
+        ->description("Skip the computation")
+        ->link_to(&m_frozen);
+    option("frozen").add_tag("freeze_update_coeff");
+  }
+
+  static std::string type_name() { return "CountUnfrozen"; }
+
+  virtual void execute()
+  {
+    if (!m_frozen)
+      ++m_count;
+  }
+
+  bool m_frozen;
+  Uint m_count;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE( RiemannSolvers_Suite )
 
 //////////////////////////////////////////////////////////////////////////////
@@ -63,6 +95,21 @@ BOOST_AUTO_TEST_CASE( test_RK )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( test_RK_freeze_tagged_option )
+{
+  CAction& rk4 = Core::instance().root().get_child("RK4").as_type<CAction>();
+  CountUnfrozen& counter = rk4.access_component("1_for_each_stage/1_pre_update_actions").create_component<CountUnfrozen>("counter");
+
+  // only the first of the 4 stages computes the update coefficient
+  rk4.execute();
+  BOOST_CHECK_EQUAL(counter.m_count, 1u);
+
+  rk4.execute();
+  BOOST_CHECK_EQUAL(counter.m_count, 2u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 ////////////////////////////////////////////////////////////////////////////////
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -131,7 +131,7 @@ void LinearSolver::execute()
   
   VariablesDescriptor& descriptor = find_component_with_tag<VariablesDescriptor>(physics().variable_manager(), UFEM::Tags::solution());
   
-  m_implementation->m_lss.lock()->resize(descriptor.size() * mesh().topology().geometry().size());
+  m_implementation->m_lss.lock()->resize(mesh(), descriptor.size());
   CSimpleSolver::execute();
 }
 
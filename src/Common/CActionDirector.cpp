@@ -23,15 +23,32 @@ ComponentBuilder < CActionDirector, CAction, LibCommon > CActionDirector_Builder
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-CActionDirector::CActionDirector(const std::string& name): CAction(name)
+CActionDirector::CActionDirector(const std::string& name) :
+  CAction(name),
+  m_plan_version(0),
+  m_compiled(false)
 {
   m_options.add_option< OptionArrayT<std::string> >("ActionOrder", std::vector<std::string>())
-      ->description("Names of the actions to execute in sequence");
+      ->description("Names of the actions to execute in sequence")
+      ->attach_trigger( boost::bind( &CActionDirector::trigger_action_order, this ) );
 }
 
 
 void CActionDirector::execute()
 {
+  if(!m_compiled || m_plan_version != tree_version())
+    compile();
+
+  for(Uint i = 0; i != m_plan.size(); ++i)
+    m_plan[i]->execute();
+}
+
+
+void CActionDirector::compile()
+{
+  m_compiled = false;
+  m_plan.clear();
+
   Option& actions_prop = option("ActionOrder");
   std::vector<std::string> actions; actions_prop.put_value(actions);
 
@@ -51,8 +68,17 @@ void CActionDirector::execute()
     if(is_null(action))
       throw SetupError(FromHere(), "Component with name " + action_name + " is not an action in " + uri().string());
 
-    action->execute();
+    m_plan.push_back(action);
   }
+
+  m_plan_version = tree_version();
+  m_compiled = true;
+}
+
+
+void CActionDirector::trigger_action_order()
+{
+  m_compiled = false;
 }
 
 
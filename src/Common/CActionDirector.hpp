@@ -20,6 +20,8 @@ namespace Common {
 
 /// Executes a series of actions, configured through a list of names for the actions to execute
 /// Actions are passed through the "ActionOrder" option and will be executed in the order they are listed
+/// The names are resolved once, and only resolved again when the option changes or
+/// the component trees changed since (see Component::tree_version()).
 class Common_API CActionDirector : public CAction {
 
 public: // typedefs
@@ -49,11 +51,29 @@ public: // functions
   /// Overload taking a shared pointer
   CActionDirector& append(const CAction::Ptr& action);
 
+  /// Resolve the names of the "ActionOrder" option into the list of actions to execute.
+  /// Called by execute() when needed.
+  /// @throw SetupError if a name does not refer to an action
+  void compile();
+
 protected:
   /// Called when an action is added. The default implementation does nothing,
   /// derived classes may override this to complete the configuration of added actions
   /// Only invoked when the action was not already a child of this director.
   virtual void on_action_added(CAction& action);
+
+private:
+
+  /// Invalidates the list of actions
+  void trigger_action_order();
+
+  /// actions to execute, in order
+  std::vector<CAction::Ptr> m_plan;
+
+  /// Component::tree_version() when m_plan was resolved
+  Uint m_plan_version;
+
+  bool m_compiled;
 };
 
 /// Allow growing of the list of actions using the shift left operator:
@@ -4,12 +4,16 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <boost/assign/list_of.hpp>
+
 #include "Common/Signal.hpp"
 #include "Common/OptionT.hpp"
 #include "Common/CBuilder.hpp"
 #include "Common/LibCommon.hpp"
 #include "Common/LogLevel.hpp"
 #include "Common/Log.hpp"
+#include "Common/Core.hpp"
+#include "Common/ThreadPool.hpp"
 #include "Common/CEnv.hpp"
 
 namespace CF {
@@ -101,6 +105,30 @@ CEnv::CEnv ( const std::string& name) : Component ( name )
       ->mark_basic()
       ->attach_trigger(boost::bind(&CEnv::trigger_log_level,this));
 
+  m_options.add_option< OptionT<Uint> >("nb_threads", 1u)
+      ->pretty_name("Number of Threads")
+      ->description("Number of threads of the thread pool, per process. 0 takes the number of hardware threads")
+      ->mark_basic()
+      ->attach_trigger(boost::bind(&CEnv::trigger_nb_threads,this));
+
+  m_options.add_option< OptionT<bool> >("pin_threads", false)
+      ->pretty_name("Pin Threads")
+      ->description("If true, every thread of the thread pool is bound to one core")
+      ->attach_trigger(boost::bind(&CEnv::trigger_pin_threads,this));
+
+  m_options.add_option< OptionT<std::string> >("numa_policy", std::string("none"))
+      ->pretty_name("NUMA Policy")
+      ->description("Placement of shared data in memory [none, first_touch]. With first_touch, data is initialized by the threads that use it")
+      ->attach_trigger(boost::bind(&CEnv::trigger_numa_policy,this));
+  option("numa_policy").restricted_list() = boost::assign::list_of
+      (std::string("none"))
+      (std::string("first_touch"));
+
+  m_options.add_option< OptionT<bool> >("huge_pages", false)
+      ->pretty_name("Huge Pages")
+      ->description("If true, data placed with the first_touch NUMA policy is backed by huge pages, if the system supports them")
+      ->attach_trigger(boost::bind(&CEnv::trigger_huge_pages,this));
+
   trigger_log_level();
 
   // signals
@@ -179,5 +207,34 @@ void CEnv::trigger_log_level()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void CEnv::trigger_nb_threads()
+{
+  Core::instance().thread_pool().set_nb_threads(option("nb_threads").value<Uint>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CEnv::trigger_pin_threads()
+{
+  Core::instance().thread_pool().set_pin_threads(option("pin_threads").value<bool>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CEnv::trigger_numa_policy()
+{
+  const std::string policy = option("numa_policy").value<std::string>();
+  Core::instance().thread_pool().set_numa_policy( policy == "first_touch" ? ThreadPool::NUMA_FIRST_TOUCH : ThreadPool::NUMA_NONE );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CEnv::trigger_huge_pages()
+{
+  Core::instance().thread_pool().set_huge_pages(option("huge_pages").value<bool>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 } // Common
 } // CF
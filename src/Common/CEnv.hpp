@@ -55,6 +55,14 @@ private: // functions
 
   void trigger_log_level();
 
+  void trigger_nb_threads();
+
+  void trigger_pin_threads();
+
+  void trigger_numa_policy();
+
+  void trigger_huge_pages();
+
 }; // CEnv
 
 ////////////////////////////////////////////////////////////////////////////////
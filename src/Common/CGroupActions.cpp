@@ -19,18 +19,36 @@ ComponentBuilder < CGroupActions, CAction, LibCommon > CGroupActions_Builder;
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-CGroupActions::CGroupActions ( const std::string& name ) :  CAction(name) {}
+CGroupActions::CGroupActions ( const std::string& name ) :
+  CAction(name),
+  m_plan_version(0),
+  m_compiled(false)
+{
+}
 
 
 void CGroupActions::execute()
 {
+  if (!m_compiled || m_plan_version != tree_version())
+    compile();
+
   // call all actions and action links inside this component
 
+  for (Uint i=0; i<m_plan.size(); ++i)
+    m_plan[i]->execute();
+}
+
+
+void CGroupActions::compile()
+{
+  m_plan.clear();
   boost_foreach(Component& child, children())
   {
     if (CAction::Ptr action = child.follow()->as_ptr<CAction>())
-      action->execute();
+      m_plan.push_back(action);
   }
+  m_plan_version = tree_version();
+  m_compiled = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
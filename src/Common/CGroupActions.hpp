@@ -20,6 +20,8 @@ namespace Common {
 ///
 /// Contained actions must be of a derived type CAction, or of the type CLink, which
 /// points to a derived CAction type.
+/// The actions to execute are resolved once, and only resolved again when the component
+/// trees changed since (see Component::tree_version()).
 ///
 /// @author Willem Deconinck
 class Common_API CGroupActions : public CAction {
@@ -42,6 +44,20 @@ public: // functions
   /// execute the action
   virtual void execute ();
 
+  /// Resolve the contained actions and links into the list of actions to execute.
+  /// Called by execute() when needed.
+  void compile();
+
+private: // data
+
+  /// actions to execute, in order
+  std::vector<CAction::Ptr> m_plan;
+
+  /// Component::tree_version() when m_plan was resolved
+  Uint m_plan_version;
+
+  bool m_compiled;
+
 };
 
 /////////////////////////////////////////////////////////////////////////////////////
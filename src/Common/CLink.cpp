@@ -68,6 +68,7 @@ CLink& CLink::link_to ( Component::Ptr lnkto )
     throw SetupError(FromHere(), "Cannot link a CLink to another CLink");
 
   m_link_component = lnkto;
+  tree_changed();
   return *this;
 }
 
@@ -78,6 +79,7 @@ CLink& CLink::link_to ( Component& lnkto )
     throw SetupError(FromHere(), "Cannot link a CLink to another CLink");
 
   m_link_component = lnkto.self();
+  tree_changed();
   return *this;
 }
 
@@ -88,6 +90,7 @@ CLink& CLink::link_to ( Component const& lnkto )
     throw SetupError(FromHere(), "Cannot link a CLink to another CLink");
 
   m_link_component = boost::const_pointer_cast<Component>(lnkto.self());
+  tree_changed();
   return *this;
 }
 
@@ -125,6 +125,12 @@ public: // functions
   /// @return the iterator with key and value, the end() iterator is returned
   ///         if no match is found
   const_iterator find(const key_type& key) const;
+
+  /// Find the first iterator with a key not less than the given KEY
+  /// @param[in] key  key to be looked-up
+  /// @pre Before using lower_bound() the CMap has to be sorted with sort_keys()
+  /// @return the first iterator with key >= given key, the end() iterator if none
+  const_iterator lower_bound(const key_type& key) const;
   
   /// Erase the given iterator from the map
   /// @param[in] itr The iterator to delete
@@ -368,6 +374,16 @@ inline typename CMap<KEY,DATA>::const_iterator CMap<KEY,DATA>::find(const key_ty
 
 //////////////////////////////////////////////////////////////////////////////
 
+template <typename KEY, typename DATA>
+inline typename CMap<KEY,DATA>::const_iterator CMap<KEY,DATA>::lower_bound(const key_type& key) const
+{
+  cf_assert_desc ("Trying to sort CMap is not allowed in lower_bound() \"const\". use sort_keys() apriori", m_sorted );
+
+  return std::lower_bound(begin(),end(),key,Compare());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 template <typename KEY, typename DATA> 
 inline bool CMap<KEY,DATA>::exists(const key_type& key)
 {
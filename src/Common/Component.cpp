@@ -8,6 +8,8 @@
 #include <boost/tokenizer.hpp>
 #include <boost/regex.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/detail/atomic_count.hpp>
 
 #include "rapidxml/rapidxml.hpp"
 
@@ -37,14 +39,31 @@ namespace Common {
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+/// counter returned by Component::tree_version(), atomic since components may be created from several threads
+boost::detail::atomic_count& tree_version_counter()
+{
+  static boost::detail::atomic_count counter(0);
+  return counter;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
 Component::Component ( const std::string& name ) :
     m_name (),
     m_path (),
     m_options(),
     m_components(),
     m_dynamic_components(),
+    m_child_index(),
     m_raw_parent( nullptr ),
-    m_is_link (false)
+    m_is_link (false),
+    m_path_cache(),
+    m_path_cache_version(0),
+    m_path_cache_mutex(new boost::mutex())
 {
   // accept name
 
@@ -202,7 +221,7 @@ void Component::rename ( const std::string& name )
   /// maybe putting finally uuid's in the comps and using the root to get the path
 
   // loop on children and inform them of change in name
-  BOOST_FOREACH( CompStorage_t::value_type c, m_components )
+  BOOST_FOREACH( const CompStorage_t::value_type& c, m_components )
   {
     c.second->change_parent( this );
   }
@@ -238,6 +257,7 @@ Component& Component::add_component ( Component::Ptr subcomp )
 
   m_components[unique_name] = subcomp;           // add to all component list
   m_dynamic_components[unique_name] = subcomp;   // add to dynamic component list
+  m_child_index[unique_name] = subcomp;
 
   subcomp->change_parent( this );
 
@@ -260,6 +280,7 @@ Component& Component::add_static_component ( Component::Ptr subcomp )
   std::string unique_name = ensure_unique_name(*subcomp);
   cf_always_assert_desc("static components must always have a unique name", unique_name == subcomp->name());
   m_components[unique_name] = subcomp;
+  m_child_index[unique_name] = subcomp;
 
   raise_path_changed();
 
@@ -293,17 +314,23 @@ std::string Component::ensure_unique_name ( Component& subcomp )
 {
   const std::string name = subcomp.name();
   std::string new_name = name;
+
+  // only the names starting with the new name can match, and they are contiguous in the ordered storage
+  CompStorage_t::const_iterator it = m_components.lower_bound(name);
+  if ( it == m_components.end() || !boost::algorithm::starts_with(it->first,name) )
+    return new_name;
+
   boost::regex e(name+"(_[0-9]+)?");
-  BOOST_FOREACH(CompStorage_t::value_type subcomp_pair, m_components)
+  for( ; it != m_components.end() && boost::algorithm::starts_with(it->first,name); ++it )
   {
-    if (boost::regex_match(subcomp_pair.first,e))
+    if (boost::regex_match(it->first,e))
     {
       Uint count = 1;
 
       new_name = name + "_" + to_str(count);
 
       // make sure constructed name does not exist
-      while ( m_components.find(new_name) != m_components.end() )
+      while ( m_child_index.find(new_name) != m_child_index.end() )
       {
         ++count;
         new_name = name  + "_" + to_str(count);
@@ -338,6 +365,7 @@ Component::Ptr Component::remove_component ( const std::string& name )
     // remove from the list of all components
     Component::CompStorage_t::iterator citr = m_components.find(name);
     m_components.erase(citr);
+    m_child_index.erase(name);
 
     comp->change_parent( NULL );                   // set parent to invalid
 
@@ -436,8 +464,8 @@ void Component::complete_path ( URI& path ) const
 
 Component& Component::get_child(const std::string& name) const
 {
-  const CompStorage_t::const_iterator found = m_components.find(name);
-  if(found != m_components.end())
+  const CompIndex_t::const_iterator found = m_child_index.find(name);
+  if(found != m_child_index.end())
     return *found->second;
   else
     throw ValueNotFound( FromHere(), "Component with name " + name + " was not found inside component " + uri().string() );
@@ -445,24 +473,24 @@ Component& Component::get_child(const std::string& name) const
 
 Component::Ptr Component::get_child_ptr(const std::string& name)
 {
-  const CompStorage_t::iterator found = m_components.find(name);
-  if(found != m_components.end())
+  const CompIndex_t::iterator found = m_child_index.find(name);
+  if(found != m_child_index.end())
     return found->second;
   return Ptr();
 }
 
 Component::ConstPtr Component::get_child_ptr(const std::string& name) const
 {
-  const CompStorage_t::const_iterator found = m_components.find(name);
-  if(found != m_components.end())
+  const CompIndex_t::const_iterator found = m_child_index.find(name);
+  if(found != m_child_index.end())
     return found->second;
   return ConstPtr();
 }
 
 Component::Ptr Component::get_child_ptr_checked(const std::string& name)
 {
-  const CompStorage_t::iterator found = m_components.find(name);
-  if(found != m_components.end())
+  const CompIndex_t::iterator found = m_child_index.find(name);
+  if(found != m_child_index.end())
     return found->second;
   else
     throw ValueNotFound( FromHere(), "Component with name " + name + " was not found inside component " + uri().string() );
@@ -470,8 +498,8 @@ Component::Ptr Component::get_child_ptr_checked(const std::string& name)
 
 Component::ConstPtr Component::get_child_ptr_checked(const std::string& name) const
 {
-  const CompStorage_t::const_iterator found = m_components.find(name);
-  if(found != m_components.end())
+  const CompIndex_t::const_iterator found = m_child_index.find(name);
+  if(found != m_child_index.end())
     return found->second;
   else
     throw ValueNotFound( FromHere(), "Component with name " + name + " was not found inside component " + uri().string() );
@@ -507,7 +535,7 @@ void Component::change_parent ( Component* new_parent )
   m_raw_parent = new_parent;
 
   // modify the children
-  BOOST_FOREACH( CompStorage_t::value_type c, m_components )
+  BOOST_FOREACH( const CompStorage_t::value_type& c, m_components )
   {
     c.second->change_parent( this );
   }
@@ -551,7 +579,10 @@ Component& Component::access_component ( const URI& path ) const
 
 Component::Ptr Component::access_component_ptr ( const URI& path )
 {
-  Component::Ptr comp;
+  Component::Ptr comp = cached_component(path);
+  if (is_not_null(comp))
+    return comp;
+
   if (!m_root.expired())  // root is available. This is a faster method.
   {
     URI lpath = path;
@@ -591,12 +622,17 @@ Component::Ptr Component::access_component_ptr ( const URI& path )
     }
     comp = look_comp;
   }
+  if (is_not_null(comp))
+    cache_component(path, comp);
   return comp;
 }
 
 Component::ConstPtr Component::access_component_ptr ( const URI& path ) const
 {
-  Component::ConstPtr comp;
+  Component::ConstPtr comp = cached_component(path);
+  if (is_not_null(comp))
+    return comp;
+
   if (!m_root.expired())  // root is available. This is a faster method.
   {
     URI lpath = path;
@@ -636,11 +672,43 @@ Component::ConstPtr Component::access_component_ptr ( const URI& path ) const
     }
     comp = look_comp;
   }
+  if (is_not_null(comp))
+    cache_component(path, boost::const_pointer_cast<Component>(comp));
   return comp;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
+Component::Ptr Component::cached_component ( const URI& path ) const
+{
+  const Uint version = tree_version();
+
+  boost::mutex::scoped_lock lock(*m_path_cache_mutex);
+
+  if (m_path_cache_version != version)
+  {
+    m_path_cache.clear();
+    m_path_cache_version = version;
+    return Ptr();
+  }
+
+  const PathCache_t::const_iterator found = m_path_cache.find(path.path());
+  if (found != m_path_cache.end())
+    return found->second.lock();
+  return Ptr();
+}
+
+void Component::cache_component ( const URI& path, const Ptr& comp ) const
+{
+  boost::mutex::scoped_lock lock(*m_path_cache_mutex);
+
+  // the tree may have changed while the path was resolved
+  if (m_path_cache_version == tree_version())
+    m_path_cache[path.path()] = comp;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 Component::Ptr Component::access_component_ptr_checked (const URI& path )
 {
   Component::Ptr comp = access_component_ptr(path);
@@ -1027,11 +1095,26 @@ void Component::signal_signature( SignalArgs & args )
 
 void Component::raise_path_changed ()
 {
+  tree_changed();
   raise_event("tree_updated");
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+Uint Component::tree_version()
+{
+  return static_cast<Uint>(tree_version_counter());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Component::tree_changed()
+{
+  ++tree_version_counter();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
 void Component::raise_event ( const std::string & name )
 {
   if( !m_root.expired() )
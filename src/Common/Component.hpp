@@ -16,6 +16,7 @@
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/iterator/iterator_facade.hpp>
 #include <boost/range.hpp>
+#include <boost/unordered_map.hpp>
 
 #include "Common/Assertions.hpp"
 
@@ -25,6 +26,8 @@
 #include "Common/ConnectionManager.hpp"
 #include "Common/URI.hpp"
 
+namespace boost { class mutex; }
+
 namespace CF {
 namespace Common {
 
@@ -91,6 +94,12 @@ private: // typedef
   /// type for storing the sub components
   typedef std::map < std::string , Component::Ptr > CompStorage_t;
 
+  /// type for looking up the sub components by name, next to the ordered storage
+  typedef boost::unordered_map < std::string , Component::Ptr > CompIndex_t;
+
+  /// type for the cache of resolved paths
+  typedef boost::unordered_map < std::string , boost::weak_ptr<Component> > PathCache_t;
+
 public: // functions
 
   /// Get the class name
@@ -181,6 +190,10 @@ public: // functions
   /// checks if the child component with name is static
   bool is_child_static ( const std::string& name ) const;
 
+  /// Number of structural changes of the component trees: components added, removed, renamed or moved,
+  /// and links changed. Lookups of components can be cached, and resolved again when this number changes.
+  static Uint tree_version();
+
   /// Access the name of the component
   std::string name () const { return m_name.path(); }
   /// Rename the component
@@ -464,6 +477,13 @@ private: // helper functions
   /// insures the sub component has a unique name within this component
   std::string ensure_unique_name ( Component& subcomp );
 
+  /// Component to which a path was resolved before, if the tree did not change since
+  /// @return null if the path is not in the cache
+  Ptr cached_component ( const URI& path ) const;
+
+  /// Remember the component a path was resolved to, until the tree changes
+  void cache_component ( const URI& path, const Ptr& comp ) const;
+
   /// writes the underlying component tree to the xml node
   /// @param node            xml node to write
   /// @param put_all_content If @c false, options and properties are not put
@@ -510,6 +530,8 @@ protected: // data
   CompStorage_t m_components;
   /// list of dynamic sub-components
   CompStorage_t m_dynamic_components;
+  /// hashed index of m_components
+  CompIndex_t m_child_index;
   /// pointer to the root of this tree
   boost::weak_ptr<CRoot> m_root;
   /// pointer to parent, naked pointer because of static components
@@ -517,10 +539,20 @@ protected: // data
   /// is this a link component
   bool m_is_link;
 
+private: // data
+
+  /// components resolved by access_component_ptr(), valid while tree_version() equals m_path_cache_version
+  mutable PathCache_t m_path_cache;
+  mutable Uint m_path_cache_version;
+  /// protects m_path_cache, since lookups may happen concurrently
+  boost::shared_ptr<boost::mutex> m_path_cache_mutex;
+
 protected: // functions
 
   /// raise event that the path has changed
   void raise_path_changed();
+  /// increments tree_version(), invalidating cached component lookups
+  static void tree_changed();
   /// raise event an event with a given name
   void raise_event(const std::string & name );
 
@@ -537,63 +569,66 @@ protected: // functions
 /// - Using Component::begin() and Component::end() iterates on only 1 deeper level
 /// - Using Component::recursive_begin() and Component::recursive_end() iterates
 /// on all deeper levels recursively. Iterating will then linearize the tree.
+///
+/// The components are collected once when the begin iterator is made, and all copies
+/// of the iterator share them, so that adding or removing components while iterating
+/// is allowed. End iterators hold no components, so the iterator only moves forward.
 
 template<class T>
 class ComponentIterator :
     public boost::iterator_facade<ComponentIterator<T>,  // iterator
                                   T,                     // Value
-                                  boost::bidirectional_traversal_tag, // search direction
+                                  boost::forward_traversal_tag, // search direction
                                   T&                     // return type of dereference
                                  >
 {
-  typedef boost::iterator_facade<ComponentIterator<T>,
-                                 T,
-                                 boost::random_access_traversal_tag,
-                                 T&> BaseT;
 public:
 
-  typedef typename BaseT::difference_type difference_type;
+  /// type of the shared storage of the components
+  typedef boost::shared_ptr< const std::vector<boost::shared_ptr<T> > > StoragePtr;
 
-  /// Construct an iterator over the given set of components.
-  /// If endIterator is true, the iterator is intialized
-  /// at the end of the range, otherwise at the beginning.
+  /// Construct an end iterator, equal to the end of any range
+  ComponentIterator() : m_position(0) {}
+
+  /// Construct an iterator over the given set of components, at the given position.
+  /// The components are copied, once for all copies of this iterator.
   explicit ComponentIterator(const std::vector<boost::shared_ptr<T> >& vec,
                              const Uint startPosition)
+          : m_vec(new std::vector<boost::shared_ptr<T> >(vec)), m_position(startPosition) {}
+
+  /// Construct an iterator over components that are shared with other iterators
+  explicit ComponentIterator(const StoragePtr& vec,
+                             const Uint startPosition)
           : m_vec(vec), m_position(startPosition) {}
 
 private:
   friend class boost::iterator_core_access;
   template <class> friend class ComponentIterator;
 
-  template <typename T2>
-  bool equal(ComponentIterator<T2> const& other) const { return (m_position == other.m_position); }
+  Uint size() const { return m_vec ? m_vec->size() : 0u; }
 
-  void increment()
-  {
-    cf_assert(m_position != m_vec.size());
-    ++m_position;
-  }
+  bool at_end() const { return m_position == size(); }
 
-  void decrement()
+  template <typename T2>
+  bool equal(ComponentIterator<T2> const& other) const
   {
-    cf_assert(m_position != 0);
-    --m_position;
+    if ( at_end() || other.at_end() )
+      return at_end() == other.at_end();
+    return m_position == other.m_position;
   }
 
-  void advance(const difference_type n) { m_position += n; }
-
-  template <typename T2>
-  difference_type distance_to(ComponentIterator<T2> const& other) const
+  void increment()
   {
-    return other.m_position - m_position;
+    cf_assert(m_position != size());
+    ++m_position;
   }
 
 public:
 
   /// dereferencing
-  T& dereference() const { return *m_vec[m_position]; }
+  T& dereference() const { return *(*m_vec)[m_position]; }
   /// Get a shared pointer to the referenced object
-  boost::shared_ptr<T> get() const { return m_vec[m_position]; }
+  boost::shared_ptr<T> get() const { return (*m_vec)[m_position]; }
   /// Compatibility with boost filtered_iterator interface,
   /// so base() can be used transparently on all ranges
   ComponentIterator<T>& base() { return *this; }
@@ -601,7 +636,7 @@ public:
   const ComponentIterator<T>& base() const { return *this; }
 
 private:
-  std::vector<boost::shared_ptr<T> > m_vec;
+  StoragePtr m_vec;
   Uint m_position;
 };
 
@@ -757,17 +792,25 @@ inline void Component::put_components<Component>(std::vector<boost::shared_ptr<C
 template<typename ComponentT>
 inline ComponentIterator<ComponentT> Component::make_iterator(const bool begin, const bool recursive)
 {
-  std::vector<boost::shared_ptr<ComponentT> > vec;
-  put_components<ComponentT>(vec, recursive);
-  return ComponentIterator<ComponentT>(vec, begin ? 0 : vec.size());
+  if(!begin)
+    return ComponentIterator<ComponentT>();
+  boost::shared_ptr< std::vector<boost::shared_ptr<ComponentT> > > vec(new std::vector<boost::shared_ptr<ComponentT> >());
+  if(!recursive)
+    vec->reserve(m_components.size());
+  put_components<ComponentT>(*vec, recursive);
+  return ComponentIterator<ComponentT>(vec, 0);
 }
 
 template<typename ComponentT>
 inline ComponentIterator<ComponentT const> Component::make_iterator(const bool begin, const bool recursive) const
 {
-  std::vector<boost::shared_ptr<ComponentT const> > vec;
-  put_components<ComponentT>(vec, recursive);
-  return ComponentIterator<ComponentT const>(vec, begin ? 0 : vec.size());
+  if(!begin)
+    return ComponentIterator<ComponentT const>();
+  boost::shared_ptr< std::vector<boost::shared_ptr<ComponentT const> > > vec(new std::vector<boost::shared_ptr<ComponentT const> >());
+  if(!recursive)
+    vec->reserve(m_components.size());
+  put_components<ComponentT>(*vec, recursive);
+  return ComponentIterator<ComponentT const>(vec, 0);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -21,6 +21,7 @@
 #include "Common/CFactories.hpp"
 #include "Common/CRoot.hpp"
 #include "Common/CEnv.hpp"
+#include "Common/ThreadPool.hpp"
 
 #include "Common/BuildInfo.hpp"
 #include "Common/CodeProfiler.hpp"
@@ -65,12 +66,14 @@ Core::Core()
   // these are critical to library object registration
 
   m_environment   = allocate_component<CEnv>( "Environment" );
+  m_thread_pool   = allocate_component<ThreadPool>( "ThreadPool" );
   m_libraries     = allocate_component<CLibraries>( "Libraries" );
   m_factories     = allocate_component<CFactories>( "Factories" );
 
   // this types must be registered immedietly on creation,
   // registration could be defered to after the Core has been inialized.
   RegistTypeInfo<CEnv,LibCommon>();
+  RegistTypeInfo<ThreadPool,LibCommon>();
   RegistTypeInfo<CLibraries,LibCommon>();
   RegistTypeInfo<CFactories,LibCommon>();
 
@@ -82,6 +85,7 @@ Core::Core()
   // but ownership is shared with Core, so they get destroyed in ~Core()
   /// @todo should these be static components?
   m_root->add_component( m_environment ).mark_basic();
+  m_root->add_component( m_thread_pool ).mark_basic();
   m_root->add_component( m_libraries ).mark_basic();
   m_root->add_component( m_factories ).mark_basic();
 
@@ -169,6 +173,14 @@ Common::CEnv& Core::environment() const
 
 ////////////////////////////////////////////////////////////////////////////////
 
+Common::ThreadPool& Core::thread_pool() const
+{
+  cf_assert(m_thread_pool != nullptr);
+  return *m_thread_pool;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 Common::CLibraries&  Core::libraries() const
 {
   cf_assert(m_libraries != nullptr);
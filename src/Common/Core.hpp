@@ -27,6 +27,7 @@ namespace Common {
   class CLibraries;
   class CFactories;
   class NetworkInfo;
+  class ThreadPool;
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -67,6 +68,10 @@ public: // methods
   /// @pre Core does not need to be initialized before
   Common::CEnv& environment() const;
 
+  /// Gets the ThreadPool, configured through the options of the CEnv
+  /// @pre Core does not need to be initialized before
+  Common::ThreadPool& thread_pool() const;
+
   /// Gets the CLibraries
   /// @pre Core does not need to be initialized before
   Common::CLibraries& libraries() const;
@@ -116,6 +121,8 @@ private: // data
   boost::shared_ptr< Common::BuildInfo >    m_build_info;
   /// the CEnv unique object
   boost::shared_ptr< Common::CEnv >         m_environment;
+  /// the ThreadPool unique object
+  boost::shared_ptr< Common::ThreadPool >   m_thread_pool;
   /// the CLibraries unique object
   boost::shared_ptr< Common::CLibraries >   m_libraries;
   /// the CFactories unique object
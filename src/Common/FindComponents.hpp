@@ -108,8 +108,8 @@ struct ComponentIteratorRange : //public iterator_range<typename T::const_iterat
   {}
 
   ComponentIteratorRange ( const std::vector< boost::shared_ptr<T> >& vec )
-    : Base ( iterator( Predicate() , ComponentIterator<T>(vec,0),          ComponentIterator<T>(vec,vec.size()) ) ,
-             iterator( Predicate() , ComponentIterator<T>(vec,vec.size()), ComponentIterator<T>(vec,vec.size()) ) )
+    : Base ( iterator( Predicate() , ComponentIterator<T>(vec,0), ComponentIterator<T>() ) ,
+             iterator( Predicate() , ComponentIterator<T>(),      ComponentIterator<T>() ) )
   {}
 
   bool operator==( const ComponentIteratorRange& rhs )  { return equal( rhs) ; }
@@ -6,11 +6,14 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <set>
+
 #include "Common/BoostAssertions.hpp"
 #include "Common/LibCommon.hpp"
 #include "Common/FindComponents.hpp"
 #include "Common/CBuilder.hpp"
 #include "Common/Log.hpp"
+#include "Common/StringConversion.hpp"
 
 #include "Common/MPI/PE.hpp"
 #include "Common/MPI/CommPattern.hpp"
@@ -36,6 +39,29 @@ namespace Comm {
 
 Common::ComponentBuilder < CommPattern, Component, LibCommon > CommPattern_Provider;
 
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// number of patterns created in this process
+Uint& nb_patterns()
+{
+  static Uint count = 0;
+  return count;
+}
+
+/// tags of the split-phase exchanges in flight, of all patterns
+std::set<int>& tags_in_flight()
+{
+  static std::set<int> tags;
+  return tags;
+}
+
+/// number of tags reserved for the objects of one pattern
+const Uint tags_per_pattern = 64;
+
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 // Constructor & destructor
 ////////////////////////////////////////////////////////////////////////////////
@@ -48,7 +74,17 @@ CommPattern::CommPattern(const std::string& name): Component(name), m_gid(new Co
   m_sendCount(Comm::PE::instance().size(),0),
   m_sendMap(0),
   m_recvCount(Comm::PE::instance().size(),0),
-  m_recvMap(0)
+  m_recvMap(0),
+  m_sendRanks(0),
+  m_sendDisp(0),
+  m_recvRanks(0),
+  m_recvDisp(0),
+  m_sendBuffer(0),
+  m_recvBuffer(0),
+  m_requests(0),
+  m_pending(),
+  m_pattern_index(nb_patterns()++),
+  m_object_index()
 {
   //self->regist_signal ( "update" , "Executes communication patterns on all the registered data.", "" )->connect ( boost::bind ( &CommPattern2::update, self, _1 ) );
   m_isUpToDate=false;
@@ -59,6 +95,10 @@ CommPattern::CommPattern(const std::string& name): Component(name), m_gid(new Co
 
 CommPattern::~CommPattern()
 {
+  typedef std::map< std::string, PendingExchange >::value_type PendingT;
+  BOOST_FOREACH( const PendingT& pending, m_pending )
+    if ( pending.second.in_progress )
+      tags_in_flight().erase(pending.second.tag);
   if (m_gid.get()!=nullptr) m_gid->remove_tag("gid_of_"+this->name());
 }
 
@@ -75,6 +115,7 @@ void CommPattern::setup(CommWrapper::Ptr gid, std::vector<Uint>& rank)
   m_gid=gid;
   m_gid->add_tag("gid_of_"+this->name());
   if (get_child_ptr(gid->name()).get() == nullptr) add_component(gid);
+  register_object(gid->name());
 
   // sizesof datas matching
   BOOST_FOREACH( CommWrapper& pobj, find_components_recursively<CommWrapper>(*this) )
@@ -113,6 +154,7 @@ void CommPattern::setup(CommWrapper::Ptr gid, boost::multi_array<Uint,1>& rank)
   m_gid=gid;
   m_gid->add_tag("gid_of_"+this->name());
   if (get_child_ptr(gid->name()).get() == nullptr) add_component(gid);
+  register_object(gid->name());
 
   // sizesof datas matching
   BOOST_FOREACH( CommWrapper& pobj, find_components_recursively<CommWrapper>(*this) )
@@ -151,6 +193,15 @@ void CommPattern::setup()
 {
 
   {  // begin fast
+  // the pattern may not change under a split-phase synchronization
+  synchronize_end_all();
+  // the message tags only match if every rank created the patterns and inserted their objects in the same order
+  const Uint order[2] = { m_pattern_index, (Uint)m_object_index.size() };
+  Uint lowest[2], highest[2];
+  Comm::PE::instance().all_reduce(Comm::min(),order,2,lowest);
+  Comm::PE::instance().all_reduce(Comm::max(),order,2,highest);
+  if (lowest[0]!=highest[0] || lowest[1]!=highest[1])
+    throw Common::ShouldNotBeHere(FromHere(),"Commpattern '" + name() + "' was created or had its parallel objects inserted in a different order on the ranks.");
   // get stuff
   const CPint irank=(CPint)Comm::PE::instance().rank();
   const CPint nproc=(CPint)Comm::PE::instance().size();
@@ -223,6 +274,9 @@ void CommPattern::setup()
 //PECheckPoint(100,"-- step 4 --:");
 //PEProcessSortedExecute(-1,PEDebugVector(m_sendMap,m_sendMap.size()));
 
+  delete[] gid;
+  setup_neighbours();
+
   return;
   } // end fast
 
@@ -322,6 +376,7 @@ PEProcessSortedExecute(-1,PEDebugVector(dist_rankupdatable,dist_rankupdatable.si
 
 void CommPattern::synchronize_all()
 {
+  synchronize_end_all();
   BOOST_FOREACH( CommWrapper& pobj, find_components_recursively<CommWrapper>(*this) )
   {
     synchronize_this(pobj);
@@ -333,11 +388,78 @@ void CommPattern::synchronize_all()
 void CommPattern::synchronize( const std::string& name )
 {
   CommWrapper& pobj = get_child(name).as_type<CommWrapper>();
+  synchronize_end(name);
   synchronize_this(pobj);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void CommPattern::synchronize_begin( const std::string& name )
+{
+  const CommWrapper& pobj = get_child(name).as_type<CommWrapper>();
+  if ( !pobj.needs_update() )
+    return;
+
+  // a previous exchange of the same data must be finished before its buffers are reused
+  synchronize_end(name);
+
+  PendingExchange& exchange = m_pending[name];
+  const int item_size = pobj.size_of()*pobj.stride();
+  // +1 for avoiding zero sized buffers
+  const Uint send_size = m_sendMap.size()*item_size+1;
+  const Uint recv_size = m_recvMap.size()*item_size+1;
+  if (exchange.send_buffer.size()<send_size) exchange.send_buffer.resize(send_size);
+  if (exchange.recv_buffer.size()<recv_size) exchange.recv_buffer.resize(recv_size);
+  exchange.requests.resize(m_requests.size());
+
+  exchange.tag = tag(name);
+  if ( !tags_in_flight().insert(exchange.tag).second )
+    throw Common::ShouldNotBeHere(FromHere(),"Synchronization of '" + name + "' in commpattern '" + this->name()
+                                  + "' started while another one with message tag " + to_str(exchange.tag) + " is in progress.");
+
+  pobj.pack(&exchange.send_buffer[0],m_sendMap);
+  if ( !exchange.requests.empty() )
+    post_exchange(item_size,&exchange.send_buffer[0],&exchange.recv_buffer[0],&exchange.requests[0],exchange.tag);
+  exchange.in_progress=true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CommPattern::synchronize_end( const std::string& name )
+{
+  std::map< std::string, PendingExchange >::iterator it = m_pending.find(name);
+  if ( it == m_pending.end() || !it->second.in_progress )
+    return;
+
+  PendingExchange& exchange = it->second;
+  if ( !exchange.requests.empty() )
+    MPI_CHECK_RESULT(MPI_Waitall, ((int)exchange.requests.size(), &exchange.requests[0], MPI_STATUSES_IGNORE));
+  exchange.in_progress=false;
+  tags_in_flight().erase(exchange.tag);
+
+  const CommWrapper& pobj = get_child(name).as_type<CommWrapper>();
+  pobj.unpack(&exchange.recv_buffer[0],m_recvMap);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CommPattern::synchronize_end_all()
+{
+  typedef std::map< std::string, PendingExchange >::value_type PendingT;
+  BOOST_FOREACH( PendingT& pending, m_pending )
+    synchronize_end(pending.first);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool CommPattern::is_synchronizing( const std::string& name ) const
+{
+  std::map< std::string, PendingExchange >::const_iterator it = m_pending.find(name);
+  return it != m_pending.end() && it->second.in_progress;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void CommPattern::synchronize_this( const CommWrapper& pobj )
 {
 
@@ -348,25 +470,131 @@ void CommPattern::synchronize_this( const CommWrapper& pobj )
   {
 //      PEProcessSortedExecute(-1,std::cout << PERank << "   sync -> " <<  pobj.name() << "\n" << std::flush; );
 
-      char* snd_data = (char*)pobj.pack(m_sendMap);
+    const int item_size = pobj.size_of()*pobj.stride();
+    reserve_buffers(item_size);
+
+    pobj.pack(&m_sendBuffer[0],m_sendMap);
 
-      char* rcv_data = Comm::PE::instance().all_to_all(snd_data,
-                                                      &m_sendCount[0],
-                                                      (char*)0,
-                                                      &m_recvCount[0],
-                                                      pobj.size_of()*pobj.stride());
+    const int object_tag = tag(pobj.name());
+    if ( tags_in_flight().count(object_tag) )
+      throw Common::ShouldNotBeHere(FromHere(),"Synchronization of '" + pobj.name() + "' in commpattern '" + name()
+                                    + "' while another one with message tag " + to_str(object_tag) + " is in progress.");
 
-      pobj.unpack(rcv_data,m_recvMap);
+    // point-to-point exchange restricted to the neighbours
+    if ( !m_requests.empty() )
+    {
+      post_exchange(item_size,&m_sendBuffer[0],&m_recvBuffer[0],&m_requests[0],object_tag);
+      MPI_CHECK_RESULT(MPI_Waitall, ((int)m_requests.size(), &m_requests[0], MPI_STATUSES_IGNORE));
+    }
 
-      /// @todo avoid this allocation and deallocation of buffers
-      ///       remember that in explicit synchronize is called frequently
-      delete[] snd_data;
-      delete[] rcv_data;
+    pobj.unpack(&m_recvBuffer[0],m_recvMap);
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void CommPattern::setup_neighbours()
+{
+  const CPint nproc=(CPint)Comm::PE::instance().size();
+  const CPint irank=(CPint)Comm::PE::instance().rank();
+
+  m_sendRanks.resize(0);
+  m_sendDisp.resize(0);
+  m_recvRanks.resize(0);
+  m_recvDisp.resize(0);
+
+  // displacements follow the rank ordering of m_sendMap and m_recvMap
+  CPint send_disp=0;
+  CPint recv_disp=0;
+  for (CPint rank=0; rank<nproc; ++rank)
+  {
+    if (m_sendCount[rank]>0 && rank!=irank)
+    {
+      m_sendRanks.push_back(rank);
+      m_sendDisp.push_back(send_disp);
+    }
+    if (m_recvCount[rank]>0 && rank!=irank)
+    {
+      m_recvRanks.push_back(rank);
+      m_recvDisp.push_back(recv_disp);
+    }
+    send_disp+=std::max(m_sendCount[rank],0);
+    recv_disp+=std::max(m_recvCount[rank],0);
+  }
+
+  m_requests.resize(m_sendRanks.size()+m_recvRanks.size());
+
+  // (re)size the buffers for the largest data already registered
+  int item_size=0;
+  BOOST_FOREACH( CommWrapper& pobj, find_components_recursively<CommWrapper>(*this) )
+    if ( pobj.needs_update() )
+      item_size=std::max(item_size,pobj.size_of()*pobj.stride());
+  m_sendBuffer.resize(0);
+  m_recvBuffer.resize(0);
+  reserve_buffers(item_size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CommPattern::reserve_buffers( const int item_size )
+{
+  // +1 for avoiding zero sized buffers
+  const Uint send_size = m_sendMap.size()*item_size+1;
+  const Uint recv_size = m_recvMap.size()*item_size+1;
+  if (m_sendBuffer.size()<send_size) m_sendBuffer.resize(send_size);
+  if (m_recvBuffer.size()<recv_size) m_recvBuffer.resize(recv_size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CommPattern::post_exchange( const int item_size, char* send_buffer, char* recv_buffer, MPI_Request* requests, const int tag )
+{
+  const Comm::Communicator comm = Comm::PE::instance().communicator();
+  MPI_Request* request = requests;
+  for (Uint i=0; i<m_recvRanks.size(); ++i, ++request)
+  {
+    const CPint rank = m_recvRanks[i];
+    MPI_CHECK_RESULT(MPI_Irecv, (recv_buffer+m_recvDisp[i]*item_size, m_recvCount[rank]*item_size, MPI_BYTE, rank, tag, comm, request));
+  }
+  for (Uint i=0; i<m_sendRanks.size(); ++i, ++request)
+  {
+    const CPint rank = m_sendRanks[i];
+    MPI_CHECK_RESULT(MPI_Isend, (send_buffer+m_sendDisp[i]*item_size, m_sendCount[rank]*item_size, MPI_BYTE, rank, tag, comm, request));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CommPattern::register_object( const std::string& name )
+{
+  if ( m_object_index.find(name) == m_object_index.end() )
+    m_object_index.insert( std::make_pair(name, (Uint)m_object_index.size()) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int CommPattern::tag( const std::string& name ) const
+{
+  std::map< std::string, Uint >::const_iterator it = m_object_index.find(name);
+  if ( it == m_object_index.end() )
+    throw Common::ValueNotFound(FromHere(),"Parallel object '" + name + "' was not inserted in commpattern '" + this->name() + "'.");
+
+  // the standard guarantees tags up to 32767, larger ones depend on MPI_TAG_UB
+  static int max_tag = 0;
+  if ( max_tag == 0 )
+  {
+    int* tag_ub = nullptr;
+    int flag = 0;
+    MPI_CHECK_RESULT(MPI_Comm_get_attr, (Comm::PE::instance().communicator(), MPI_TAG_UB, &tag_ub, &flag));
+    max_tag = ( flag && is_not_null(tag_ub) ) ? *tag_ub : 32767;
+  }
+
+  // tag 0 stays for the other communications on the communicator
+  return 1 + (int)( ( m_pattern_index*tags_per_pattern + it->second ) % (Uint)max_tag );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void CommPattern::add(Uint gid, Uint rank)
 {
   if (m_isFreeze) throw Common::ShouldNotBeHere(FromHere(),"Wanted to add nodes to commpattern '" + name() + "' which is freezed.");
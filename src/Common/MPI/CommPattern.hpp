@@ -113,6 +113,7 @@ public:
   {
     typename CommWrapperPtr<T>::Ptr ow = create_component_ptr< CommWrapperPtr<T> >(name);
     ow->setup(data,stride,needs_update);
+    register_object(name);
   }
 
   /// register data coming from pointer to naked pointer
@@ -124,6 +125,7 @@ public:
   {
     typename CommWrapperPtr<T>::Ptr ow = create_component_ptr< CommWrapperPtr<T> >(name);
     ow->setup(data,stride,needs_update);
+    register_object(name);
   }
 
   /// register data coming from std::vector by reference
@@ -134,6 +136,7 @@ public:
   {
     typename CommWrapperVector<T>::Ptr ow = create_component_ptr< CommWrapperVector<T> >(name);
     ow->setup(data,stride,needs_update);
+    register_object(name);
   }
 
   /// register data coming from pointer to std::vector
@@ -144,6 +147,7 @@ public:
   {
     typename CommWrapperVector<T>::Ptr ow = create_component_ptr< CommWrapperVector<T> >(name);
     ow->setup(data,stride,needs_update);
+    register_object(name);
   }
 
   /// register data coming from std::vector wrapped into weak_ptr (also works with shared_ptr)
@@ -154,6 +158,7 @@ public:
   {
     typename CommWrapperVectorWeakPtr<T>::Ptr ow = create_component_ptr< CommWrapperVectorWeakPtr<T> >(name);
     ow->setup(data,stride,needs_update);
+    register_object(name);
   }
 
   /// register data coming from std::vector wrapped into weak_ptr (also works with shared_ptr)
@@ -164,6 +169,7 @@ public:
   {
     CommWrapperMArray<T,2>& ow = create_component< CommWrapperMArray<T,2> >(name);
     ow.setup(data,needs_update);
+    register_object(name);
   }
 
   /// register data coming from std::vector wrapped into weak_ptr (also works with shared_ptr)
@@ -174,6 +180,7 @@ public:
   {
     CommWrapperMArray<T,1>& ow = create_component< CommWrapperMArray<T,1> >(name);
     ow.setup(data,needs_update);
+    register_object(name);
   }
 
 
@@ -208,6 +215,8 @@ public:
   /// build and/or modify communication pattern - only incorporate actual buffers
   /// this function sets actually up the communication pattern
   /// beware: interprocess communication heavy
+  /// all ranks must create their commpatterns and insert their parallel objects in the same order,
+  /// since the message tags derive from these orders, this is checked here
   void setup();
 
   /// synchronize the all parallel objects
@@ -217,6 +226,24 @@ public:
   /// @param name the name of the parallel object
   void synchronize( const std::string& name );
 
+  /// start the synchronization of the parallel object designated by its name, without waiting for it
+  /// the updatable part of the data is packed immediately, the ghost part is only valid after synchronize_end
+  /// this allows to overlap the communication with work that does not need the ghost data
+  /// @param name the name of the parallel object
+  void synchronize_begin( const std::string& name );
+
+  /// complete the synchronization started by synchronize_begin
+  /// does nothing if there is no synchronization in progress for the object
+  /// @param name the name of the parallel object
+  void synchronize_end( const std::string& name );
+
+  /// complete all synchronizations started by synchronize_begin
+  void synchronize_end_all();
+
+  /// check if a synchronization started by synchronize_begin is still in progress
+  /// @param name the name of the parallel object
+  bool is_synchronizing( const std::string& name ) const;
+
   /// add element to the commpattern
   /// when all changes done, all needs to be committed by calling setup
   /// if global id is not on current rank, then a ghost is automatically created on current rank
@@ -266,6 +293,33 @@ protected: // helper function
   /// usefull for reusing in the different synchronize functions
   void synchronize_this ( const CommWrapper& pobj );
 
+  /// collects the neighbouring ranks (non-zero send or receive counts) and their displacements
+  /// called at the end of setup, only the neighbours take part in the exchange of synchronize
+  void setup_neighbours();
+
+  /// grows the persistent send and receive buffers so that they can hold items of given size
+  /// buffers are never shrinked, so after the first synchronization of the largest registered data no more allocation happens
+  /// @param item_size size of one item in bytes (size_of()*stride() of the CommWrapper)
+  void reserve_buffers( const int item_size );
+
+  /// posts the non-blocking receives and sends towards the neighbours
+  /// @param item_size size of one item in bytes (size_of()*stride() of the CommWrapper)
+  /// @param send_buffer packed data to send, ordered as m_sendMap
+  /// @param recv_buffer buffer to receive into, ordered as m_recvMap
+  /// @param requests array of m_recvRanks.size()+m_sendRanks.size() requests
+  /// @param tag message tag of the exchange, see tag()
+  void post_exchange( const int item_size, char* send_buffer, char* recv_buffer, MPI_Request* requests, const int tag );
+
+  /// message tag for the exchanges of a parallel object, derived from the index of this pattern
+  /// and the index of the object within it, so that exchanges in flight at the same time do not match each other's messages
+  /// all ranks derive the same tag because patterns are created and their objects inserted collectively, see setup()
+  /// @param name the name of the parallel object
+  int tag( const std::string& name ) const;
+
+  /// assigns the index of a parallel object, from which its message tag is derived, in the order of registration
+  /// @param name the name of the parallel object
+  void register_object( const std::string& name );
+
 private:
 
   /// @name PROPERTIES
@@ -311,6 +365,47 @@ private:
   /// this is the map of receiveing communication pattern
   std::vector< CPint > m_recvMap;
 
+  /// ranks to which this process sends (ranks with non-zero m_sendCount)
+  std::vector< CPint > m_sendRanks;
+
+  /// item displacements into the send buffer, for each rank in m_sendRanks
+  std::vector< CPint > m_sendDisp;
+
+  /// ranks from which this process receives (ranks with non-zero m_recvCount)
+  std::vector< CPint > m_recvRanks;
+
+  /// item displacements into the receive buffer, for each rank in m_recvRanks
+  std::vector< CPint > m_recvDisp;
+
+  /// persistent send buffer, shared by all registered data
+  std::vector< char > m_sendBuffer;
+
+  /// persistent receive buffer, shared by all registered data
+  std::vector< char > m_recvBuffer;
+
+  /// requests of the non-blocking point-to-point communication
+  std::vector< MPI_Request > m_requests;
+
+  /// buffers and requests of a split-phase synchronization, they live between synchronize_begin and synchronize_end
+  /// kept per registered data so that several objects can be in flight at the same time
+  struct PendingExchange {
+    PendingExchange() : in_progress(false), tag(0) {}
+    std::vector< char > send_buffer;
+    std::vector< char > recv_buffer;
+    std::vector< MPI_Request > requests;
+    bool in_progress;
+    int tag;
+  };
+
+  /// split-phase synchronizations, by name of the parallel object
+  std::map< std::string, PendingExchange > m_pending;
+
+  /// index of this pattern among the patterns created in this process
+  Uint m_pattern_index;
+
+  /// index of the parallel objects, in the order of their registration
+  std::map< std::string, Uint > m_object_index;
+
 }; // CommPattern
 
 ////////////////////////////////////////////////////////////////////////////////////////////
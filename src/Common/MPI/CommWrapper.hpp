@@ -58,6 +58,11 @@ class Common_API CommWrapper : public Component {
     /// @return pointer to the newly allocated data which is of size size_of()*stride()*map.size()
     virtual const void* pack(std::vector<int>& map) const = 0;
 
+    /// extraction of sub-data from data wrapped by the objectwrapper into a preallocated buffer, pattern specified by map
+    /// @param buf pointer to a buffer of at least size_of()*stride()*map.size() bytes
+    /// @param map vector of map
+    virtual void pack(void* buf, std::vector<int>& map) const = 0;
+
     /// extraction of data from the wrapped object, returned memory is a copy, not a view
     /// @return pointer to the newly allocated data which is of size size_of()*stride()*size()
     virtual const void* pack() const = 0;
@@ -168,12 +173,21 @@ template<typename T> class CommWrapperPtr: public CommWrapper{
       if (m_data==nullptr) throw CF::Common::BadPointer(FromHere(),name()+": Data expired.");
       T* tbuf=new T[map.size()*m_stride+1];
       if ( tbuf == nullptr ) throw CF::Common::NotEnoughMemory(FromHere(),name()+": Could not allocate temporary buffer.");
+      pack((void*)tbuf,map);
+      return (void*)tbuf;
+    }
+
+    /// extraction of sub-data from data wrapped by the objectwrapper into a preallocated buffer, pattern specified by map
+    /// @param buf pointer to a buffer of at least size_of()*stride()*map.size() bytes
+    /// @param map vector of map
+    virtual void pack(void* buf, std::vector<int>& map) const
+    {
+      if (m_data==nullptr) throw CF::Common::BadPointer(FromHere(),name()+": Data expired.");
       T* data=&(*m_data)[0];
       std::vector<int>::iterator imap=map.begin();
-      for (T* itbuf=tbuf; imap!=map.end(); imap++)
+      for (T* itbuf=(T*)buf; imap!=map.end(); imap++)
         for (int i=0; i<(int)m_stride; i++)
           *itbuf++=data[*imap*m_stride + i];
-      return (void*)tbuf;
     }
 
     /// extraction of data from the wrapped object, returned memory is a copy, not a view
@@ -297,11 +311,20 @@ template<typename T> class CommWrapperVector: public CommWrapper{
       if (m_data==nullptr) throw CF::Common::BadPointer(FromHere(),name()+": Data expired.");
       T* tbuf=new T[map.size()*m_stride+1];
       if ( tbuf == nullptr ) throw CF::Common::NotEnoughMemory(FromHere(),name()+": Could not allocate temporary buffer.");
+      pack((void*)tbuf,map);
+      return (void*)tbuf;
+    }
+
+    /// extraction of sub-data from data wrapped by the objectwrapper into a preallocated buffer, pattern specified by map
+    /// @param buf pointer to a buffer of at least size_of()*stride()*map.size() bytes
+    /// @param map vector of map
+    virtual void pack(void* buf, std::vector<int>& map) const
+    {
+      if (m_data==nullptr) throw CF::Common::BadPointer(FromHere(),name()+": Data expired.");
       std::vector<int>::iterator imap=map.begin();
-      for (T* itbuf=tbuf; imap!=map.end(); imap++)
+      for (T* itbuf=(T*)buf; imap!=map.end(); imap++)
         for (int i=0; i<(int)m_stride; i++)
           *itbuf++=(*m_data)[*imap*m_stride + i];
-      return (void*)tbuf;
     }
 
     /// extraction of data from the wrapped object, returned memory is a copy, not a view
@@ -414,12 +437,21 @@ template<typename T> class CommWrapperVectorWeakPtr: public CommWrapper{
       if (m_data.expired()) throw CF::Common::BadPointer(FromHere(),name()+": Data expired.");
       T* tbuf=new T[map.size()*m_stride+1];
       if ( tbuf == nullptr ) throw CF::Common::NotEnoughMemory(FromHere(),name()+": Could not allocate temporary buffer.");
+      pack((void*)tbuf,map);
+      return (void*)tbuf;
+    }
+
+    /// extraction of sub-data from data wrapped by the objectwrapper into a preallocated buffer, pattern specified by map
+    /// @param buf pointer to a buffer of at least size_of()*stride()*map.size() bytes
+    /// @param map vector of map
+    virtual void pack(void* buf, std::vector<int>& map) const
+    {
+      if (m_data.expired()) throw CF::Common::BadPointer(FromHere(),name()+": Data expired.");
       boost::shared_ptr< std::vector<T> > sp=m_data.lock();
       std::vector<int>::iterator imap=map.begin();
-      for (T* itbuf=tbuf; imap!=map.end(); imap++)
+      for (T* itbuf=(T*)buf; imap!=map.end(); imap++)
         for (int i=0; i<(int)m_stride; i++)
           *itbuf++=(*sp)[*imap*m_stride + i];
-      return (void*)tbuf;
     }
 
     /// extraction of data from the wrapped object, returned memory is a copy, not a view
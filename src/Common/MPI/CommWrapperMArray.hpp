@@ -80,13 +80,21 @@ class CommWrapperMArray<T,1>: public CommWrapper{
       if ( is_null(m_data) ) throw CF::Common::BadPointer(FromHere(),name()+": Data expired.");
       T* tbuf=new T[map.size()*m_stride+1];
       if ( tbuf == nullptr ) throw CF::Common::NotEnoughMemory(FromHere(),name()+": Could not allocate temporary buffer.");
-      T* itbuf=tbuf;
+      pack((void*)tbuf,map);
+      return (void*)tbuf;
+    }
 
+    /// extraction of sub-data from data wrapped by the objectwrapper into a preallocated buffer, pattern specified by map
+    /// @param buf pointer to a buffer of at least size_of()*stride()*map.size() bytes
+    /// @param map vector of map
+    virtual void pack(void* buf, std::vector<int>& map) const
+    {
+      if ( is_null(m_data) ) throw CF::Common::BadPointer(FromHere(),name()+": Data expired.");
+      T* itbuf=(T*)buf;
       boost_foreach( int local_idx, map)
       {
         *itbuf++ = (*m_data)[local_idx];
       }
-      return (void*)tbuf;
     }
 
     /// extraction of data from the wrapped object, returned memory is a copy, not a view
@@ -196,14 +204,23 @@ class CommWrapperMArray<T,2>: public CommWrapper{
       if ( is_null(m_data) ) throw CF::Common::BadPointer(FromHere(),name()+": Data expired.");
       T* tbuf=new T[map.size()*m_stride+1];
       if ( tbuf == nullptr ) throw CF::Common::NotEnoughMemory(FromHere(),name()+": Could not allocate temporary buffer.");
-      T* itbuf=tbuf;
+      pack((void*)tbuf,map);
+      return (void*)tbuf;
+    }
+
+    /// extraction of sub-data from data wrapped by the objectwrapper into a preallocated buffer, pattern specified by map
+    /// @param buf pointer to a buffer of at least size_of()*stride()*map.size() bytes
+    /// @param map vector of map
+    virtual void pack(void* buf, std::vector<int>& map) const
+    {
+      if ( is_null(m_data) ) throw CF::Common::BadPointer(FromHere(),name()+": Data expired.");
+      T* itbuf=(T*)buf;
       boost_foreach( int local_idx, map)
       {
         cf_assert(local_idx<m_data->size());
         boost_foreach( const T& val, (*m_data)[local_idx])
           *itbuf++ = val;
       }
-      return (void*)tbuf;
     }
 
     /// extraction of data from the wrapped object, returned memory is a copy, not a view
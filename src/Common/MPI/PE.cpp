@@ -84,7 +84,11 @@ void PE::init(int argc, char** args)
 
   if( !is_initialized() && !is_finalized() ) // then initialize
   {
-    MPI_CHECK_RESULT(MPI_Init,(&argc,&args));
+    // threads of the ThreadPool never communicate, only the thread that initialized MPI does
+    int provided;
+    MPI_CHECK_RESULT(MPI_Init_thread,(&argc,&args,MPI_THREAD_FUNNELED,&provided));
+    if (provided < MPI_THREAD_FUNNELED)
+      CFwarn << "MPI does not provide MPI_THREAD_FUNNELED, using more than one thread per process is not safe" << CFendl;
     //  CFinfo << "MPI (version " <<  version() << ") -- initiated" << CFendl;
   }
 
@@ -93,6 +97,16 @@ void PE::init(int argc, char** args)
 
 ////////////////////////////////////////////////////////////////////////////////
 
+int PE::thread_level() const
+{
+  int provided = MPI_THREAD_SINGLE;
+  if ( is_initialized() && !is_finalized() )
+    MPI_CHECK_RESULT(MPI_Query_thread,(&provided));
+  return provided;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void PE::finalize()
 {
   if( is_initialized() && !is_finalized() ) // then finalized
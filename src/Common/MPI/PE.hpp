@@ -95,6 +95,9 @@ public:
   /// Return the number of processes, or 1 if is_init==0.
   Uint size() const;
 
+  /// Return the level of thread support of MPI (MPI_THREAD_SINGLE if MPI is not initialized)
+  int thread_level() const;
+
   /// Sets current process status.
   /// @param status New status
   /// @todo the name WorkerStatus is inappropriate, better to name it for example ProcessStatus
@@ -0,0 +1,356 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <cstdlib>
+#include <cstring>
+
+#include <boost/cstdint.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "Common/Assertions.hpp"
+#include "Common/BasicExceptions.hpp"
+#include "Common/StringConversion.hpp"
+#include "Common/MappedFile.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Common {
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+inline bool is_space(const char c)
+{
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+inline bool is_digit(const char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+/// Powers of ten that are exact in double precision
+const double exact_powers_of_ten[] =
+{
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct MappedFile::Implementation
+{
+  boost::iostreams::mapped_file_source map;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+MappedFile::MappedFile() :
+  m_implementation(new Implementation),
+  m_begin(0),
+  m_end(0),
+  m_cur(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MappedFile::MappedFile(const boost::filesystem::path& path) :
+  m_implementation(new Implementation),
+  m_begin(0),
+  m_end(0),
+  m_cur(0)
+{
+  open(path);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MappedFile::open(const boost::filesystem::path& path)
+{
+  close();
+
+  if( !boost::filesystem::exists(path) )
+    throw FileSystemError(FromHere(), path.string() + " does not exist");
+
+  // an empty file can not be mapped
+  if( boost::filesystem::file_size(path) == 0 )
+    return;
+
+  try
+  {
+    m_implementation->map.open(path.string());
+  }
+  catch (std::exception& e)
+  {
+    throw FileSystemError(FromHere(), path.string() + " failed to open: " + e.what());
+  }
+
+  m_begin = m_implementation->map.data();
+  m_end = m_begin + m_implementation->map.size();
+  m_cur = m_begin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MappedFile::close()
+{
+  if (m_implementation->map.is_open())
+    m_implementation->map.close();
+  m_begin = m_end = m_cur = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool MappedFile::is_open() const
+{
+  return m_implementation->map.is_open();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MappedFile::seek(const Position position)
+{
+  cf_assert(position <= size());
+  m_cur = m_begin + position;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MappedFile::seek_relative(const long offset)
+{
+  cf_assert(m_cur + offset >= m_begin && m_cur + offset <= m_end);
+  m_cur += offset;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool MappedFile::get_line(std::string& line)
+{
+  if (eof())
+  {
+    line.clear();
+    return false;
+  }
+  const char* line_end = static_cast<const char*>(std::memchr(m_cur, '\n', m_end - m_cur));
+  if (line_end == 0)
+    line_end = m_end;
+  line.assign(m_cur, line_end);
+  m_cur = line_end == m_end ? m_end : line_end + 1;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MappedFile::skip_line()
+{
+  if (eof())
+    return;
+  const char* line_end = static_cast<const char*>(std::memchr(m_cur, '\n', m_end - m_cur));
+  m_cur = line_end == 0 ? m_end : line_end + 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MappedFile::skip_lines(const Uint nb_lines)
+{
+  for (Uint l=0; l<nb_lines; ++l)
+    skip_line();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MappedFile::read(char* data, const Position size)
+{
+  if (m_cur + size > m_end)
+    throw ParsingFailed(FromHere(), "Unexpected end of file while reading " + to_str(size) + " bytes");
+  std::memcpy(data, m_cur, size);
+  m_cur += size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MappedFile::skip_whitespace()
+{
+  while (m_cur != m_end && is_space(*m_cur))
+    ++m_cur;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MappedFile& MappedFile::operator>> (Uint& value)
+{
+  skip_whitespace();
+  if (m_cur != m_end && *m_cur == '+')
+    ++m_cur;
+  if (m_cur == m_end || !is_digit(*m_cur))
+    throw ParsingFailed(FromHere(), "Expected an unsigned integer at offset " + to_str(position()));
+
+  value = 0;
+  while (m_cur != m_end && is_digit(*m_cur))
+    value = 10*value + (*m_cur++ - '0');
+  return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MappedFile& MappedFile::operator>> (int& value)
+{
+  skip_whitespace();
+  bool negative = false;
+  if (m_cur != m_end && (*m_cur == '-' || *m_cur == '+'))
+    negative = (*m_cur++ == '-');
+  if (m_cur == m_end || !is_digit(*m_cur))
+    throw ParsingFailed(FromHere(), "Expected an integer at offset " + to_str(position()));
+
+  value = 0;
+  while (m_cur != m_end && is_digit(*m_cur))
+    value = 10*value + (*m_cur++ - '0');
+  if (negative)
+    value = -value;
+  return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MappedFile& MappedFile::operator>> (Real& value)
+{
+  skip_whitespace();
+  if (m_cur == m_end)
+    throw ParsingFailed(FromHere(), "Expected a real number at the end of the file");
+  value = parse_real(m_cur, m_end);
+  return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MappedFile& MappedFile::operator>> (std::string& value)
+{
+  skip_whitespace();
+  const char* word_begin = m_cur;
+  while (m_cur != m_end && !is_space(*m_cur))
+    ++m_cur;
+  value.assign(word_begin, m_cur);
+  return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Real MappedFile::parse_real(const char*& begin, const char* end)
+{
+  // Fast path: when the significant digits fit in 53 bits and the decimal
+  // exponent is at most 22, mantissa * 10^exponent is exactly one
+  // correctly rounded double operation. Anything else goes to strtod.
+
+  const char* p = begin;
+  bool negative = false;
+  if (p != end && (*p == '-' || *p == '+'))
+    negative = (*p++ == '-');
+
+  boost::uint64_t mantissa = 0;
+  Uint nb_digits = 0;
+  int exponent = 0;
+  bool exact = true;
+
+  for ( ; p != end && is_digit(*p); ++p)
+  {
+    if (nb_digits < 19)
+    {
+      mantissa = 10*mantissa + (*p - '0');
+      if (mantissa) ++nb_digits;
+    }
+    else
+    {
+      ++exponent;
+      exact = false;
+    }
+  }
+  const bool has_integer_digits = (p != begin) && is_digit(*(p-1));
+  bool has_fraction_digits = false;
+  if (p != end && *p == '.')
+  {
+    for (++p; p != end && is_digit(*p); ++p)
+    {
+      has_fraction_digits = true;
+      if (nb_digits < 19)
+      {
+        mantissa = 10*mantissa + (*p - '0');
+        if (mantissa) ++nb_digits;
+        --exponent;
+      }
+      else if (*p != '0')
+      {
+        exact = false;
+      }
+    }
+  }
+  if ( !has_integer_digits && !has_fraction_digits )
+  {
+    // not a plain decimal number, e.g. "nan" or "inf"
+    exact = false;
+  }
+  else if (p != end && (*p == 'e' || *p == 'E' || *p == 'd' || *p == 'D'))
+  {
+    const char* exponent_begin = p++;
+    bool negative_exponent = false;
+    if (p != end && (*p == '-' || *p == '+'))
+      negative_exponent = (*p++ == '-');
+    if (p != end && is_digit(*p))
+    {
+      int explicit_exponent = 0;
+      for ( ; p != end && is_digit(*p); ++p)
+        if (explicit_exponent < 100000)
+          explicit_exponent = 10*explicit_exponent + (*p - '0');
+      exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+    else
+    {
+      // the 'e' is not part of the number
+      p = exponent_begin;
+    }
+  }
+
+  if (exact && mantissa < (boost::uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
+  {
+    double result = static_cast<double>(mantissa);
+    if (exponent < 0)
+      result /= exact_powers_of_ten[-exponent];
+    else
+      result *= exact_powers_of_ten[exponent];
+    begin = p;
+    return static_cast<Real>(negative ? -result : result);
+  }
+
+  // slow path, on a null-terminated copy of the token
+  const char* token_end = begin;
+  while (token_end != end && !is_space(*token_end))
+    ++token_end;
+  std::string token(begin, token_end);
+  for (std::string::iterator c = token.begin(); c != token.end(); ++c)
+    if (*c == 'd' || *c == 'D') *c = 'e'; // Fortran exponents
+  char* parsed_end;
+  const double result = std::strtod(token.c_str(), &parsed_end);
+  if (parsed_end == token.c_str())
+    throw ParsingFailed(FromHere(), "Expected a real number, found \"" + token + "\"");
+  begin += parsed_end - token.c_str();
+  return static_cast<Real>(result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Common
+} // CF
@@ -0,0 +1,123 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Common_MappedFile_hpp
+#define CF_Common_MappedFile_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include "Common/BoostFilesystem.hpp"
+
+#include "Common/CommonAPI.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Common {
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Read-only memory mapping of a file, with a fast tokenizer for ASCII numbers.
+/// Only the pages of the file that are actually parsed are read from disk,
+/// so a process can jump to the part of a large mesh file it owns
+/// without reading the rest of it.
+/// The interface mimics the subset of std::istream used by the mesh readers.
+class Common_API MappedFile : public boost::noncopyable
+{
+public: // typedefs
+
+  typedef std::size_t Position;
+
+public: // functions
+
+  /// Constructor, the file still has to be opened
+  MappedFile();
+
+  /// Constructor, opening the file
+  MappedFile(const boost::filesystem::path& path);
+
+  /// Destructor, closing the file
+  ~MappedFile();
+
+  /// Map the file in memory and go to its beginning
+  /// @throw FileSystemError if the file can not be opened
+  void open(const boost::filesystem::path& path);
+
+  /// Unmap the file
+  void close();
+
+  bool is_open() const;
+
+  /// Size of the file in bytes
+  Position size() const { return m_end - m_begin; }
+
+  /// Current offset in the file
+  Position position() const { return m_cur - m_begin; }
+
+  /// Go to an offset in the file
+  void seek(const Position position);
+
+  /// Move the current offset forward or backward
+  void seek_relative(const long offset);
+
+  /// True when the whole file has been consumed
+  bool eof() const { return m_cur >= m_end; }
+
+  /// Read up to and excluding the next newline, which is consumed
+  /// @return false if the end of the file was already reached
+  bool get_line(std::string& line);
+
+  /// Go to the beginning of the next line
+  void skip_line();
+
+  /// Skip a number of lines
+  void skip_lines(const Uint nb_lines);
+
+  /// Raw copy of bytes, for binary file formats
+  void read(char* data, const Position size);
+
+  /// Pointer to the current position in the mapped memory
+  const char* data() const { return m_cur; }
+
+  /// @name Whitespace separated extraction
+  /// @throw ParsingFailed if no valid token is found
+  //@{
+  MappedFile& operator>> (Uint& value);
+  MappedFile& operator>> (int& value);
+  MappedFile& operator>> (Real& value);
+  MappedFile& operator>> (std::string& value);
+  //@}
+
+private: // functions
+
+  void skip_whitespace();
+
+  /// Parse a real number from [begin,end), and set begin after it
+  static Real parse_real(const char*& begin, const char* end);
+
+private: // data
+
+  /// Contains the memory mapping
+  struct Implementation;
+  boost::scoped_ptr<Implementation> m_implementation;
+
+  const char* m_begin;
+  const char* m_end;
+  const char* m_cur;
+
+}; // MappedFile
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Common
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Common_MappedFile_hpp
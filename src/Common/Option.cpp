@@ -25,7 +25,8 @@ Option::Option(const std::string & name, boost::any def)
     m_name(name),
     m_pretty_name(),
     m_description(),
-    m_separator(";")
+    m_separator(";"),
+    m_version(0)
 {
   // cf_assert_desc("The name of option ["+name+"] does not comply with coolfluid standard. "
   //                "It may not contain spaces.",
@@ -62,6 +63,7 @@ void Option::configure_option ( XmlNode& node )
   cf_assert ( node.is_valid() );
 
   this->configure(node); // update the value
+  ++m_version;
 
   // call all trigger functors
   trigger();
@@ -95,6 +97,7 @@ void Option::change_value ( const boost::any& value )
   boost::any data = value_to_data(value);
   m_value = data; // update the value
   copy_to_linked_params(data);
+  ++m_version;
     // call all trigger functors
   trigger();
 };
@@ -265,6 +265,9 @@ namespace XML { class XmlNode; }
     /// change the value of this option
     virtual void change_value ( const boost::any& value);
 
+    /// Number of times the value was changed, to detect changes without comparing values
+    Uint version() const { return m_version; }
+
     /// @brief Gives a reference to the restricted list.
     /// @return Returns a reference to the restricted list.
     std::vector<boost::any> & restricted_list() { return m_restricted_list; }
@@ -304,6 +307,8 @@ namespace XML { class XmlNode; }
     std::vector<boost::any> m_restricted_list;
     /// Option separator.
     std::string m_separator;
+    /// number of times the value was changed
+    Uint m_version;
 
   protected: // function
 
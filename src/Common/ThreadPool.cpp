@@ -0,0 +1,523 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <cstring>
+
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/thread/tss.hpp>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/CBuilder.hpp"
+#include "Common/LibCommon.hpp"
+#include "Common/Log.hpp"
+#include "Common/ThreadPool.hpp"
+
+#ifdef CF_OS_LINUX
+extern "C"
+{
+  #include <pthread.h>
+  #include <sched.h>
+  #include <sys/mman.h>
+  #include <unistd.h>
+}
+#endif
+
+namespace CF {
+namespace Common {
+
+////////////////////////////////////////////////////////////////////////////////
+
+Common::ComponentBuilder < ThreadPool, Component, LibCommon > ThreadPool_Builder;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// What a thread knows about its place in the pool
+struct ThreadState
+{
+  ThreadState( const Uint thread_index ) : index(thread_index), in_parallel(false) {}
+  Uint index;
+  bool in_parallel;
+};
+
+boost::thread_specific_ptr<ThreadState> thread_state;
+
+ThreadState& current_thread_state()
+{
+  if ( is_null(thread_state.get()) )
+    thread_state.reset( new ThreadState(0) );
+  return *thread_state;
+}
+
+/// Marks the calling thread as executing a parallel section, for the lifetime of the object
+struct ParallelSection
+{
+  ParallelSection() : state(current_thread_state()), was_in_parallel(state.in_parallel) { state.in_parallel = true; }
+  ~ParallelSection() { state.in_parallel = was_in_parallel; }
+  ThreadState& state;
+  const bool was_in_parallel;
+};
+
+/// Execute a function, returning the error message if it throws
+template < typename FunctionT >
+std::string try_execute( const FunctionT& function )
+{
+  try
+  {
+    function();
+  }
+  catch ( std::exception& e )
+  {
+    return std::string( e.what() ).empty() ? std::string("unknown error") : std::string( e.what() );
+  }
+  catch ( ... )
+  {
+    return "unknown exception";
+  }
+  return std::string();
+}
+
+/// Call of a parallel_for function for one chunk
+struct ChunkCall
+{
+  ChunkCall( const boost::function<void (Uint,Uint)>& function_in, const Uint begin_in, const Uint end_in ) :
+    function(function_in), begin(begin_in), end(end_in) {}
+  void operator()() const { function(begin,end); }
+  const boost::function<void (Uint,Uint)>& function;
+  const Uint begin;
+  const Uint end;
+};
+
+/// Writes zeros in the rows of a block of memory
+struct ZeroRows
+{
+  ZeroRows( char* data_in, const std::size_t row_bytes_in ) : data(data_in), row_bytes(row_bytes_in) {}
+  void operator()( const Uint begin, const Uint end )
+  {
+    std::memset( data + begin*row_bytes, 0, (end-begin)*row_bytes );
+  }
+  char* data;
+  const std::size_t row_bytes;
+};
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Share of the index range of a job, owned by one thread
+struct ThreadPool::Range
+{
+  boost::mutex mutex;
+  Uint next;
+  Uint end;
+};
+
+/// A parallel_for in progress
+struct ThreadPool::Job
+{
+  Job( const boost::function<void (Uint,Uint)>& function_in, const Uint nb_threads_in, const Uint grain_size_in, const bool steal_in ) :
+    function(function_in), nb_threads(nb_threads_in), ranges(new Range[nb_threads_in]), grain_size(grain_size_in), steal(steal_in),
+    nb_active(0), m_failed(false) {}
+
+  void fail( const std::string& what )
+  {
+    boost::mutex::scoped_lock lock(m_error_mutex);
+    if ( !m_failed )
+      error = what;
+    m_failed = true;
+  }
+
+  bool failed()
+  {
+    boost::mutex::scoped_lock lock(m_error_mutex);
+    return m_failed;
+  }
+
+  /// Call the function for chunk [begin,end), recording a failure
+  void operator()( const Uint begin, const Uint end )
+  {
+    const std::string what = try_execute( ChunkCall(function,begin,end) );
+    if ( !what.empty() )
+      fail( what );
+  }
+
+  boost::function<void (Uint,Uint)> function;
+  const Uint nb_threads;
+  boost::scoped_array<Range> ranges;
+  const Uint grain_size;
+  const bool steal;
+
+  /// number of workers that did not finish the job yet, protected by the mutex of the pool
+  Uint nb_active;
+
+  std::string error;
+
+private:
+
+  boost::mutex m_error_mutex;
+  bool m_failed;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+ThreadPool::ThreadPool ( const std::string& name ) :
+  Component ( name ),
+  m_nb_threads(1),
+  m_pin_threads(false),
+  m_numa_policy(NUMA_NONE),
+  m_huge_pages(false),
+  m_stop(false),
+  m_job(nullptr),
+  m_job_generation(0)
+{
+  m_properties["brief"] = std::string("Threads executing the parallel sections of this process");
+  m_properties["description"] = std::string("Configured through the options nb_threads, pin_threads, numa_policy and huge_pages of the Environment");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ThreadPool::~ThreadPool()
+{
+  stop_workers();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::set_nb_threads( const Uint nb_threads )
+{
+  if ( in_parallel_section() )
+    throw IllegalCall( FromHere(), "The number of threads of the pool can not change within a parallel section" );
+
+  m_nb_threads = nb_threads ? nb_threads : std::max( boost::thread::hardware_concurrency(), 1u );
+  start_workers();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::set_pin_threads( const bool pin_threads )
+{
+  if ( in_parallel_section() )
+    throw IllegalCall( FromHere(), "The pinning of the threads of the pool can not change within a parallel section" );
+
+  m_pin_threads = pin_threads;
+  start_workers();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Uint ThreadPool::thread_index() const
+{
+  return current_thread_state().index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool ThreadPool::in_parallel_section() const
+{
+  return current_thread_state().in_parallel;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::start_workers()
+{
+  stop_workers();
+
+  if ( m_pin_threads )
+    pin_thread(0);
+
+  // the workers may start after the first job is posted, so they get the generation of the jobs they have seen
+  for ( Uint t = 1; t < m_nb_threads; ++t )
+    m_workers.push_back( boost::shared_ptr<boost::thread>( new boost::thread( boost::bind( &ThreadPool::work, this, t, m_job_generation ) ) ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::stop_workers()
+{
+  {
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_stop = true;
+  }
+  m_work_available.notify_all();
+
+  for ( Uint t = 0; t < m_workers.size(); ++t )
+    m_workers[t]->join();
+  m_workers.clear();
+
+  boost::mutex::scoped_lock lock(m_mutex);
+  m_stop = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::pin_thread( const Uint thread_index ) const
+{
+#ifdef CF_OS_LINUX
+  const Uint nb_cores = std::max( boost::thread::hardware_concurrency(), 1u );
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(thread_index % nb_cores, &cpu_set);
+  if ( pthread_setaffinity_np( pthread_self(), sizeof(cpu_set), &cpu_set ) != 0 )
+    CFwarn << "Could not pin thread " << thread_index << " to core " << thread_index % nb_cores << CFendl;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::work( const Uint thread_index, const Uint job_generation )
+{
+  thread_state.reset( new ThreadState(thread_index) );
+  current_thread_state().in_parallel = true;
+
+  if ( m_pin_threads )
+    pin_thread(thread_index);
+
+  boost::mutex::scoped_lock lock(m_mutex);
+  Uint generation = job_generation;
+  while ( !m_stop )
+  {
+    if ( is_not_null(m_job) && m_job_generation != generation )
+    {
+      generation = m_job_generation;
+      Job& job = *m_job;
+      lock.unlock();
+      work_on_job(job,thread_index);
+      lock.lock();
+      if ( --job.nb_active == 0 )
+        m_work_done.notify_all();
+    }
+    else if ( !m_tasks.empty() )
+    {
+      const Task task = m_tasks.front();
+      m_tasks.pop_front();
+      lock.unlock();
+      execute_task(task);
+      lock.lock();
+    }
+    else
+    {
+      m_work_available.wait(lock);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::work_on_job( Job& job, const Uint thread_index )
+{
+  Range& own = job.ranges[thread_index];
+  while ( true )
+  {
+    // next chunk from the own share
+
+    Uint begin = 0, end = 0;
+    {
+      boost::mutex::scoped_lock lock(own.mutex);
+      if ( own.next < own.end )
+      {
+        begin = own.next;
+        end = std::min( own.next + job.grain_size, own.end );
+        own.next = end;
+      }
+    }
+    if ( begin != end )
+    {
+      if ( !job.failed() )
+        job(begin,end);
+      continue;
+    }
+
+    // own share is done, steal the second half of the remaining share of another thread
+
+    for ( Uint i = 1; job.steal && i < job.nb_threads && begin == end; ++i )
+    {
+      Range& victim = job.ranges[(thread_index+i) % job.nb_threads];
+      boost::mutex::scoped_lock lock(victim.mutex);
+      const Uint remaining = victim.end - victim.next;
+      if ( victim.next < victim.end && remaining > job.grain_size )
+      {
+        begin = victim.next + remaining / 2;
+        end = victim.end;
+        victim.end = begin;
+      }
+    }
+    if ( begin == end )
+      return;
+
+    boost::mutex::scoped_lock lock(own.mutex);
+    own.next = begin;
+    own.end = end;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::execute_range( const Uint begin, const Uint end, const boost::function<void (Uint,Uint)>& function, const Uint grain_size, const bool steal )
+{
+  if ( end <= begin )
+    return;
+
+  const Uint size = end - begin;
+
+  // serial execution, by this thread only
+  if ( m_nb_threads == 1 || size == 1 || in_parallel_section() )
+  {
+    ParallelSection section;
+    function(begin,end);
+    return;
+  }
+
+  Job job( function, m_nb_threads, grain_size ? grain_size : std::max( size / (8*m_nb_threads), 1u ), steal );
+  for ( Uint t = 0; t < m_nb_threads; ++t )
+  {
+    job.ranges[t].next = begin + static_cast<Uint>( static_cast<boost::uint64_t>(size) * t / m_nb_threads );
+    job.ranges[t].end  = begin + static_cast<Uint>( static_cast<boost::uint64_t>(size) * (t+1) / m_nb_threads );
+  }
+
+  {
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_job = &job;
+    ++m_job_generation;
+    job.nb_active = m_workers.size();
+  }
+  m_work_available.notify_all();
+
+  {
+    ParallelSection section;
+    work_on_job(job,0);
+  }
+
+  {
+    boost::mutex::scoped_lock lock(m_mutex);
+    while ( job.nb_active )
+      m_work_done.wait(lock);
+    m_job = nullptr;
+  }
+
+  if ( job.failed() )
+    throw ParallelError( FromHere(), "Parallel loop over [" + to_str(begin) + "," + to_str(end) + ") failed: " + job.error );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::first_touch( void* data, const Uint nb_rows, const Uint row_bytes )
+{
+  if ( m_numa_policy != NUMA_FIRST_TOUCH || m_nb_threads == 1 || in_parallel_section() )
+    return;
+
+#ifdef CF_OS_LINUX
+  const std::size_t page_size = sysconf(_SC_PAGESIZE);
+  const std::size_t nb_bytes = static_cast<std::size_t>(nb_rows) * row_bytes;
+
+  // only the pages that lie entirely in the block can be released, a few per thread at least
+  char* first_page = reinterpret_cast<char*>( ( reinterpret_cast<std::size_t>(data) + page_size - 1 ) / page_size * page_size );
+  char* last_page  = reinterpret_cast<char*>( ( reinterpret_cast<std::size_t>(data) + nb_bytes ) / page_size * page_size );
+  if ( last_page <= first_page || static_cast<std::size_t>(last_page - first_page) < 4 * m_nb_threads * page_size )
+    return;
+
+#ifdef MADV_HUGEPAGE
+  if ( m_huge_pages )
+    madvise( first_page, last_page - first_page, MADV_HUGEPAGE );
+#endif
+
+  // released pages of private memory read as zeros, and are allocated again by the thread writing them first
+  if ( madvise( first_page, last_page - first_page, MADV_DONTNEED ) != 0 )
+    return;
+
+  ZeroRows zero_rows( static_cast<char*>(data), row_bytes );
+  parallel_for_static( 0, nb_rows, zero_rows );
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::execute_task( const Task& task )
+{
+  std::string what;
+  {
+    ParallelSection section;
+    what = try_execute( task.function );
+  }
+
+  boost::mutex::scoped_lock lock(m_mutex);
+  TaskGroup& group = *task.group;
+  if ( !what.empty() && group.m_error.empty() )
+    group.m_error = what;
+  --group.m_nb_pending;
+  m_work_done.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ThreadPool::TaskGroup::TaskGroup( ThreadPool& pool ) :
+  m_pool(pool),
+  m_nb_pending(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ThreadPool::TaskGroup::~TaskGroup()
+{
+  try
+  {
+    wait();
+  }
+  catch ( ... )
+  {
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::TaskGroup::run( const boost::function<void ()>& task )
+{
+  {
+    boost::mutex::scoped_lock lock(m_pool.m_mutex);
+    m_pool.m_tasks.push_back( Task(task,*this) );
+    ++m_nb_pending;
+  }
+  m_pool.m_work_available.notify_one();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::TaskGroup::wait()
+{
+  boost::mutex::scoped_lock lock(m_pool.m_mutex);
+  while ( m_nb_pending )
+  {
+    // help with the queued tasks, which may belong to other groups, rather than sleeping
+    if ( !m_pool.m_tasks.empty() )
+    {
+      const Task task = m_pool.m_tasks.front();
+      m_pool.m_tasks.pop_front();
+      lock.unlock();
+      m_pool.execute_task(task);
+      lock.lock();
+    }
+    else
+    {
+      m_pool.m_work_done.wait(lock);
+    }
+  }
+
+  std::string error;
+  error.swap(m_error);
+  lock.unlock();
+
+  if ( !error.empty() )
+    throw ParallelError( FromHere(), "Task failed: " + error );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Common
+} // CF
@@ -0,0 +1,227 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Common_ThreadPool_hpp
+#define CF_Common_ThreadPool_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <deque>
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include "Common/Component.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Common {
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Pool of threads shared by all parts of the code that execute in parallel within one process,
+/// reachable through Core::instance().thread_pool().
+/// The threads are created once, and wait for work between parallel sections.
+/// The thread calling parallel_for() or TaskGroup::wait() takes part in the work,
+/// so a pool of n threads creates n-1 workers, and a pool of 1 thread executes everything serially.
+/// All MPI communication must be done by the thread that initialized MPI, outside of the
+/// parallel sections (see Comm::PE::init(), which requests MPI_THREAD_FUNNELED).
+/// Parallel sections started from within a parallel section are executed serially.
+/// The number of threads, their pinning to cores and the NUMA policy are configured through
+/// the options of CEnv.
+class Common_API ThreadPool : public Component
+{
+public: // typedefs
+
+  typedef boost::shared_ptr<ThreadPool> Ptr;
+  typedef boost::shared_ptr<ThreadPool const> ConstPtr;
+
+  /// Placement of the memory of data that is shared by the threads
+  enum NumaPolicy { NUMA_NONE=0, NUMA_FIRST_TOUCH=1 };
+
+public: // classes
+
+  /// Group of independent tasks, executed by the threads of the pool.
+  /// Tasks may run as soon as they are added, and wait() returns when all have been executed.
+  class Common_API TaskGroup : public boost::noncopyable
+  {
+  public:
+
+    TaskGroup( ThreadPool& pool );
+
+    /// Waits for the remaining tasks
+    ~TaskGroup();
+
+    /// Add a task to the group
+    void run( const boost::function<void ()>& task );
+
+    /// Execute tasks until all tasks of the group are done
+    /// @throw ParallelError if a task threw an exception
+    void wait();
+
+  private:
+
+    friend class ThreadPool;
+
+    ThreadPool& m_pool;
+    Uint m_nb_pending;
+    std::string m_error;
+  };
+
+public: // functions
+
+  /// Contructor
+  /// @param name of the component
+  ThreadPool ( const std::string& name );
+
+  /// Virtual destructor, stopping the threads
+  virtual ~ThreadPool();
+
+  /// Get the class name
+  static std::string type_name () { return "ThreadPool"; }
+
+  /// Number of threads executing a parallel section, including the calling thread
+  Uint nb_threads() const { return m_nb_threads; }
+
+  /// Change the number of threads. 0 takes the number of hardware threads
+  void set_nb_threads( const Uint nb_threads );
+
+  /// If true, thread i is bound to core i (modulo the number of cores), so that it stays close to the memory it touched
+  void set_pin_threads( const bool pin_threads );
+
+  bool pin_threads() const { return m_pin_threads; }
+
+  void set_numa_policy( const NumaPolicy policy ) { m_numa_policy = policy; }
+
+  NumaPolicy numa_policy() const { return m_numa_policy; }
+
+  /// If true, memory placed with first_touch() is backed by transparent huge pages where the system allows it
+  void set_huge_pages( const bool huge_pages ) { m_huge_pages = huge_pages; }
+
+  bool huge_pages() const { return m_huge_pages; }
+
+  /// Index of the calling thread in the pool: 0 for the thread that started the parallel section,
+  /// 1 to nb_threads()-1 for the workers. Meant to select per-thread work storage.
+  Uint thread_index() const;
+
+  /// True if called from within a parallel section
+  bool in_parallel_section() const;
+
+  /// Call functor(chunk_begin,chunk_end) for chunks that cover [begin,end) exactly once, in parallel.
+  /// Every thread starts with a contiguous share of the range and takes chunks of grain_size indices
+  /// from its front. A thread that runs out of work steals the second half of the remaining share of another thread.
+  /// The functor is shared by all threads.
+  /// @param grain_size number of indices per chunk, 0 for an automatic size
+  /// @throw ParallelError if the functor threw an exception in one of the threads
+  template < typename FunctorT >
+  void parallel_for( const Uint begin, const Uint end, FunctorT& functor, const Uint grain_size = 0 )
+  {
+    execute_range( begin, end, boost::function<void (Uint,Uint)>( boost::ref(functor) ), grain_size, true );
+  }
+
+  /// Call functor(share_begin,share_end) once for the initial share of every thread, without stealing,
+  /// so that thread t always processes the same indices as it starts with in parallel_for().
+  /// With the NUMA_FIRST_TOUCH policy, loops over data placed by first_touch() use this partition,
+  /// so that every thread works on the rows in the memory of its own NUMA node.
+  /// @throw ParallelError if the functor threw an exception in one of the threads
+  template < typename FunctorT >
+  void parallel_for_static( const Uint begin, const Uint end, FunctorT& functor )
+  {
+    execute_range( begin, end, boost::function<void (Uint,Uint)>( boost::ref(functor) ), end > begin ? end - begin : 1u, false );
+  }
+
+  /// With the NUMA_FIRST_TOUCH policy, move the pages of zero initialized memory to the NUMA nodes of the threads
+  /// that own the corresponding rows in parallel_for_static(), by releasing them and writing them again from those threads.
+  /// Does nothing with other policies, or if the operating system does not allow it. The placement is only
+  /// kept if the threads do not move, see set_pin_threads().
+  /// @param data      start of the memory, which must contain only zeros
+  /// @param nb_rows   number of rows, the index range of the loops that will use the memory
+  /// @param row_bytes size of one row in bytes
+  void first_touch( void* data, const Uint nb_rows, const Uint row_bytes );
+
+private: // classes
+
+  friend class TaskGroup;
+
+  struct Range;
+  struct Job;
+
+  /// A task of a TaskGroup
+  struct Task
+  {
+    Task( const boost::function<void ()>& function_in, TaskGroup& group_in ) : function(function_in), group(&group_in) {}
+    boost::function<void ()> function;
+    TaskGroup* group;
+  };
+
+private: // functions
+
+  /// Non template implementation of parallel_for
+  /// @param steal if false, every thread executes its initial share only
+  void execute_range( const Uint begin, const Uint end, const boost::function<void (Uint,Uint)>& function, const Uint grain_size, const bool steal );
+
+  /// Main loop of a worker thread
+  /// @param job_generation generation of the last job that was posted before the thread was created
+  void work( const Uint thread_index, const Uint job_generation );
+
+  /// Execute the chunks of a job, stealing from the other threads when done with its own
+  void work_on_job( Job& job, const Uint thread_index );
+
+  /// Execute one task, and signal its group
+  void execute_task( const Task& task );
+
+  /// Start the workers, after stopping the existing ones
+  void start_workers();
+
+  void stop_workers();
+
+  /// Bind the calling thread to a core
+  void pin_thread( const Uint thread_index ) const;
+
+private: // data
+
+  Uint m_nb_threads;
+
+  bool m_pin_threads;
+
+  NumaPolicy m_numa_policy;
+
+  bool m_huge_pages;
+
+  std::vector< boost::shared_ptr<boost::thread> > m_workers;
+
+  /// protects all the data below
+  boost::mutex m_mutex;
+
+  /// signals the workers that there is a new job or task, or that they must stop
+  boost::condition_variable m_work_available;
+
+  /// signals the waiting threads that a job or task is finished
+  boost::condition_variable m_work_done;
+
+  bool m_stop;
+
+  /// current parallel_for, with a generation number for the workers to execute it only once
+  Job* m_job;
+  Uint m_job_generation;
+
+  std::deque<Task> m_tasks;
+
+}; // ThreadPool
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Common
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Common_ThreadPool_hpp
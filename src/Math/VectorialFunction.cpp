@@ -4,11 +4,16 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+
 #include <boost/tokenizer.hpp>
 
 #include "Common/Log.hpp"
 #include "Common/BasicExceptions.hpp"
 #include "Common/StringConversion.hpp"
+#include "Common/Foreach.hpp"
 
 #include "Math/VectorialFunction.hpp"
 
@@ -24,12 +29,340 @@ namespace Math {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+/// Number of points evaluated at once by a Program
+const Uint block_size = 256u;
+
+typedef Real (*UnaryFunctionT)(Real);
+typedef Real (*BinaryFunctionT)(Real,Real);
+
+Real min_function(Real a, Real b) { return a < b ? a : b; }
+Real max_function(Real a, Real b) { return a > b ? a : b; }
+
+/// Function parser functions that are supported by the bytecode
+UnaryFunctionT unary_function(const std::string& name)
+{
+  if (name == "sin")   return static_cast<UnaryFunctionT>(&std::sin);
+  if (name == "cos")   return static_cast<UnaryFunctionT>(&std::cos);
+  if (name == "tan")   return static_cast<UnaryFunctionT>(&std::tan);
+  if (name == "asin")  return static_cast<UnaryFunctionT>(&std::asin);
+  if (name == "acos")  return static_cast<UnaryFunctionT>(&std::acos);
+  if (name == "atan")  return static_cast<UnaryFunctionT>(&std::atan);
+  if (name == "sinh")  return static_cast<UnaryFunctionT>(&std::sinh);
+  if (name == "cosh")  return static_cast<UnaryFunctionT>(&std::cosh);
+  if (name == "tanh")  return static_cast<UnaryFunctionT>(&std::tanh);
+  if (name == "exp")   return static_cast<UnaryFunctionT>(&std::exp);
+  if (name == "log")   return static_cast<UnaryFunctionT>(&std::log);
+  if (name == "log10") return static_cast<UnaryFunctionT>(&std::log10);
+  if (name == "sqrt")  return static_cast<UnaryFunctionT>(&std::sqrt);
+  if (name == "abs")   return static_cast<UnaryFunctionT>(&std::fabs);
+  if (name == "floor") return static_cast<UnaryFunctionT>(&std::floor);
+  if (name == "ceil")  return static_cast<UnaryFunctionT>(&std::ceil);
+  return 0;
+}
+
+BinaryFunctionT binary_function(const std::string& name)
+{
+  if (name == "pow")   return static_cast<BinaryFunctionT>(&std::pow);
+  if (name == "atan2") return static_cast<BinaryFunctionT>(&std::atan2);
+  if (name == "min")   return &min_function;
+  if (name == "max")   return &max_function;
+  return 0;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Stack based bytecode of one function. Every instruction works on blocks of points:
+/// a stack entry holds the values of block_size points, so the instructions are simple loops.
+/// Only arithmetic, powers and the common mathematical functions are supported,
+/// compile() returns false for anything else and the function parser is used instead.
+class VectorialFunction::Program
+{
+public:
+
+  Program() : m_depth(0), m_max_depth(0) {}
+
+  /// Compile the function
+  /// @return false if the function uses syntax that is not supported
+  bool compile(const std::string& function, const std::vector<std::string>& variables)
+  {
+    m_code.clear();
+    m_depth = m_max_depth = 0;
+    m_text = &function;
+    m_variables = &variables;
+    m_pos = 0;
+    if (!parse_expression())
+      return false;
+    skip_spaces();
+    return m_pos == function.size() && m_depth == 1;
+  }
+
+  /// Number of stack entries needed for the execution
+  Uint stack_size() const { return m_max_depth; }
+
+  /// Evaluate the points [begin, begin+size) of var_values, with size <= block_size
+  /// @param stack storage for stack_size()*block_size values
+  /// @param result storage for size values
+  void execute(const RealMatrix& var_values, const Uint begin, const Uint size, Real* stack, Real* result) const
+  {
+    Uint depth = 0;
+    boost_foreach(const Instruction& instruction, m_code)
+    {
+      switch (instruction.op)
+      {
+        case CONSTANT:
+        {
+          Real* r = stack + (depth++)*block_size;
+          for (Uint j=0; j<size; ++j) r[j] = instruction.value;
+          break;
+        }
+        case VARIABLE:
+        {
+          Real* r = stack + (depth++)*block_size;
+          const Real* x = var_values.data() + instruction.index*var_values.rows() + begin;
+          for (Uint j=0; j<size; ++j) r[j] = x[j];
+          break;
+        }
+        case NEG:
+        case SQUARE:
+        case UNARY_FUNCTION:
+        {
+          Real* a = stack + (depth-1)*block_size;
+          if (instruction.op == NEG)         for (Uint j=0; j<size; ++j) a[j] = -a[j];
+          else if (instruction.op == SQUARE) for (Uint j=0; j<size; ++j) a[j] *= a[j];
+          else                               for (Uint j=0; j<size; ++j) a[j] = instruction.unary(a[j]);
+          break;
+        }
+        default: // binary operations on the two entries on top of the stack
+        {
+          --depth;
+          Real* a = stack + (depth-1)*block_size;
+          const Real* b = stack + depth*block_size;
+          switch (instruction.op)
+          {
+            case ADD: for (Uint j=0; j<size; ++j) a[j] += b[j]; break;
+            case SUB: for (Uint j=0; j<size; ++j) a[j] -= b[j]; break;
+            case MUL: for (Uint j=0; j<size; ++j) a[j] *= b[j]; break;
+            case DIV: for (Uint j=0; j<size; ++j) a[j] /= b[j]; break;
+            default:  for (Uint j=0; j<size; ++j) a[j] = instruction.binary(a[j],b[j]); break;
+          }
+        }
+      }
+    }
+    cf_assert(depth == 1);
+    for (Uint j=0; j<size; ++j)
+      result[j] = stack[j];
+  }
+
+private: // types
+
+  enum OpCode { CONSTANT, VARIABLE, ADD, SUB, MUL, DIV, NEG, SQUARE, UNARY_FUNCTION, BINARY_FUNCTION };
+
+  struct Instruction
+  {
+    OpCode op;
+    Uint index;
+    Real value;
+    UnaryFunctionT unary;
+    BinaryFunctionT binary;
+  };
+
+private: // functions
+
+  void emit(const OpCode op, const Uint index = 0, const Real value = 0., UnaryFunctionT unary = 0, BinaryFunctionT binary = 0)
+  {
+    Instruction instruction = { op, index, value, unary, binary };
+    m_code.push_back(instruction);
+    if (op == CONSTANT || op == VARIABLE)
+      m_max_depth = std::max(m_max_depth, ++m_depth);
+    else if (op == ADD || op == SUB || op == MUL || op == DIV || op == BINARY_FUNCTION)
+      --m_depth;
+  }
+
+  void skip_spaces()
+  {
+    while (m_pos < m_text->size() && std::isspace((*m_text)[m_pos]))
+      ++m_pos;
+  }
+
+  /// Consume the character c if it is next
+  bool accept(const char c)
+  {
+    skip_spaces();
+    if (m_pos < m_text->size() && (*m_text)[m_pos] == c)
+    {
+      ++m_pos;
+      return true;
+    }
+    return false;
+  }
+
+  /// expression := term { ('+'|'-') term }
+  bool parse_expression()
+  {
+    if (!parse_term())
+      return false;
+    while (true)
+    {
+      if (accept('+'))      { if (!parse_term()) return false; emit(ADD); }
+      else if (accept('-')) { if (!parse_term()) return false; emit(SUB); }
+      else return true;
+    }
+  }
+
+  /// term := unary { ('*'|'/'|'%') unary }
+  bool parse_term()
+  {
+    if (!parse_unary())
+      return false;
+    while (true)
+    {
+      if (accept('*'))      { if (!parse_unary()) return false; emit(MUL); }
+      else if (accept('/')) { if (!parse_unary()) return false; emit(DIV); }
+      else if (accept('%')) { if (!parse_unary()) return false; emit(BINARY_FUNCTION,0,0.,0,static_cast<BinaryFunctionT>(&std::fmod)); }
+      else return true;
+    }
+  }
+
+  /// unary := '-' unary | power, so that -x^2 is -(x^2) as in the function parser
+  bool parse_unary()
+  {
+    if (accept('-'))
+    {
+      if (!parse_unary())
+        return false;
+      emit(NEG);
+      return true;
+    }
+    return parse_power();
+  }
+
+  /// power := primary [ '^' unary ], right associative
+  bool parse_power()
+  {
+    if (!parse_primary())
+      return false;
+    if (accept('^'))
+    {
+      const Uint exponent_begin = m_code.size();
+      if (!parse_unary())
+        return false;
+      if (m_code.size() == exponent_begin+1 && m_code.back().op == CONSTANT && m_code.back().value == 2.)
+      {
+        m_code.pop_back();
+        --m_depth;
+        emit(SQUARE);
+      }
+      else
+      {
+        emit(BINARY_FUNCTION,0,0.,0,static_cast<BinaryFunctionT>(&std::pow));
+      }
+    }
+    return true;
+  }
+
+  /// primary := number | '(' expression ')' | variable | constant | function '(' expression { ',' expression } ')'
+  bool parse_primary()
+  {
+    skip_spaces();
+    if (m_pos == m_text->size())
+      return false;
+
+    const std::string& text = *m_text;
+    const char c = text[m_pos];
+
+    if (std::isdigit(c) || c == '.')
+    {
+      const std::size_t begin = m_pos;
+      while (m_pos < text.size() && std::isdigit(text[m_pos])) ++m_pos;
+      if (m_pos < text.size() && text[m_pos] == '.') ++m_pos;
+      while (m_pos < text.size() && std::isdigit(text[m_pos])) ++m_pos;
+      if (m_pos < text.size() && (text[m_pos] == 'e' || text[m_pos] == 'E'))
+      {
+        std::size_t exponent = m_pos+1;
+        if (exponent < text.size() && (text[exponent] == '+' || text[exponent] == '-')) ++exponent;
+        if (exponent < text.size() && std::isdigit(text[exponent]))
+        {
+          m_pos = exponent;
+          while (m_pos < text.size() && std::isdigit(text[m_pos])) ++m_pos;
+        }
+      }
+      emit(CONSTANT, 0, static_cast<Real>(std::strtod(text.substr(begin,m_pos-begin).c_str(),0)));
+      return true;
+    }
+
+    if (accept('('))
+      return parse_expression() && accept(')');
+
+    if (!(std::isalpha(c) || c == '_'))
+      return false;
+
+    const std::size_t begin = m_pos;
+    while (m_pos < text.size() && (std::isalnum(text[m_pos]) || text[m_pos] == '_')) ++m_pos;
+    const std::string name = text.substr(begin,m_pos-begin);
+
+    for (Uint i=0; i<m_variables->size(); ++i)
+    {
+      if ((*m_variables)[i] == name)
+      {
+        emit(VARIABLE, i);
+        return true;
+      }
+    }
+
+    if (name == "pi")
+    {
+      emit(CONSTANT, 0, 3.1415926535897932);
+      return true;
+    }
+
+    if (UnaryFunctionT unary = unary_function(name))
+    {
+      if (!(accept('(') && parse_expression() && accept(')')))
+        return false;
+      emit(UNARY_FUNCTION, 0, 0., unary);
+      return true;
+    }
+
+    if (BinaryFunctionT binary = binary_function(name))
+    {
+      if (!(accept('(') && parse_expression() && accept(',') && parse_expression() && accept(')')))
+        return false;
+      emit(BINARY_FUNCTION, 0, 0., 0, binary);
+      return true;
+    }
+
+    return false;
+  }
+
+private: // data
+
+  std::vector<Instruction> m_code;
+
+  /// Stack depth while compiling
+  Uint m_depth;
+
+  /// Maximum stack depth
+  Uint m_max_depth;
+
+  /// Compilation state
+  const std::string* m_text;
+  const std::vector<std::string>* m_variables;
+  std::size_t m_pos;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
 VectorialFunction::VectorialFunction()
   : m_is_parsed(false),
     m_vars(""),
     m_nbvars(0),
     m_functions(0),
     m_parsers(),
+    m_programs(),
     m_result()
 {
 }
@@ -40,6 +373,7 @@ VectorialFunction::VectorialFunction( const std::string& funcs, const std::strin
     m_nbvars(0),
     m_functions(0),
     m_parsers(),
+    m_programs(),
     m_result()
 {
   functions( funcs );
@@ -65,6 +399,10 @@ void VectorialFunction::clear()
       delete_ptr(m_parsers[i]);
   }
   vector<FunctionParser*>().swap(m_parsers);
+  for(Uint i = 0; i < m_programs.size(); i++) {
+      delete_ptr(m_programs[i]);
+  }
+  vector<Program*>().swap(m_programs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -153,6 +491,13 @@ void VectorialFunction::parse()
 {
   clear();
 
+  std::vector<std::string> variable_names;
+  boost::char_separator<char> sep(",");
+  typedef boost::tokenizer<boost::char_separator<char> > tokenizer;
+  tokenizer tok (m_vars,sep);
+  for (tokenizer::iterator el=tok.begin(); el!=tok.end(); ++el)
+    variable_names.push_back(*el);
+
   for(Uint i = 0; i < m_functions.size(); ++i)
   {
     FunctionParser* ptr = new FunctionParser();
@@ -170,6 +515,11 @@ void VectorialFunction::parse()
       msg += " Vars: ["    + m_vars + "]";
       throw Common::ParsingFailed (FromHere(),msg);
     }
+
+    Program* program = new Program();
+    if (!program->compile(m_functions[i],variable_names))
+      delete_ptr(program);
+    m_programs.push_back(program);
   }
 
   m_result.resize(m_functions.size());
@@ -208,6 +558,46 @@ void VectorialFunction::evaluate( const RealVector& var_values, RealVector& ret_
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void VectorialFunction::evaluate( const RealMatrix& var_values, RealMatrix& ret_values) const
+{
+  cf_assert(m_is_parsed);
+  cf_assert(var_values.cols() == m_nbvars);
+
+  const Uint nb_points = var_values.rows();
+  ret_values.resize(nb_points,m_functions.size());
+
+  Uint stack_size = 0;
+  boost_foreach(const Program* program, m_programs)
+  {
+    if (is_not_null(program))
+      stack_size = std::max(stack_size, program->stack_size());
+  }
+  std::vector<Real> stack(stack_size*block_size);
+  std::vector<Real> point(std::max(m_nbvars,1u));
+
+  for (Uint f=0; f<m_functions.size(); ++f)
+  {
+    // the columns of ret_values are contiguous
+    Real* result = ret_values.data() + f*nb_points;
+    if (is_not_null(m_programs[f]))
+    {
+      for (Uint begin=0; begin<nb_points; begin+=block_size)
+        m_programs[f]->execute(var_values, begin, std::min(block_size,nb_points-begin), &stack[0], result+begin);
+    }
+    else
+    {
+      for (Uint p=0; p<nb_points; ++p)
+      {
+        for (Uint v=0; v<m_nbvars; ++v)
+          point[v] = var_values(p,v);
+        result[p] = m_parsers[f]->Eval(&point[0]);
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 RealVector& VectorialFunction::operator()( const VariablesT& var_values)
 {
   cf_assert(m_is_parsed);
@@ -51,6 +51,16 @@ public: // functions
   /// @param ret_value the placeholder vector for the result
   void evaluate (const RealVector& var_values, RealVector& ret_value) const;
 
+  /// Evaluate the Vectorial Function for a batch of points at once.
+  /// At parse time, the functions are also compiled into a simple bytecode that is executed
+  /// instruction by instruction over blocks of points, so every instruction is a tight loop
+  /// that the compiler can vectorize. Functions with syntax the bytecode does not support
+  /// (e.g. conditions and comparisons) are evaluated point by point with the function parser.
+  /// @param var_values values of the variables, one row per point and one column per variable
+  /// @param ret_values the placeholder for the result, one row per point and one column per function.
+  ///                   It is resized if needed.
+  void evaluate (const RealMatrix& var_values, RealMatrix& ret_values) const;
+
   /// Evaluate the Vectorial Function given the values of the variables
   /// and return it in the stored result. This function allows this class to work
   /// as a functor.
@@ -94,9 +104,14 @@ public: // functions
 
 protected: // helper functions
 
-  /// Clears the m_parsers deallocating the memory.
+  /// Clears the m_parsers and m_programs deallocating the memory.
   void clear();
 
+private: // classes
+
+  /// Bytecode version of a function, for batch evaluation
+  class Program;
+
 private: // data
 
   /// flag to indicate if the functions have been parsed
@@ -114,6 +129,9 @@ private: // data
   /// vector holding the parsers, one for each entry in the vector
   std::vector<FunctionParser*> m_parsers;
 
+  /// vector holding the bytecode of each entry in the vector, null if it could not be compiled
+  std::vector<Program*> m_programs;
+
   /// storage of the result for using the class as functor
   RealVector m_result;
 
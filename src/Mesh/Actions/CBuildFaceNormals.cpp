@@ -101,6 +101,8 @@ void CBuildFaceNormals::execute()
       CTable<Uint>& face_nb = face2cell.face_number();
       RealMatrix face_coordinates(faces.element_type().nb_nodes(),faces.element_type().dimension());
       RealVector normal(faces.element_type().dimension());
+      RealMatrix cell_coordinates;
+      RealVector cell_centroid(1);
       for (Uint face=0; face<face2cell.size(); ++face)
       {
         // The normal will be outward to the first connected element
@@ -121,9 +123,9 @@ void CBuildFaceNormals::execute()
 
         if (faces.element_type().dimensionality() == 0) // cannot compute normal from element_type
         {
-          RealVector cell_centroid(1);
-          cells.element_type().compute_centroid(cells.get_coordinates(cell_idx),cell_centroid);
-          RealVector normal(1);
+          cells.allocate_coordinates(cell_coordinates);
+          cells.put_coordinates(cell_coordinates,cell_idx);
+          cells.element_type().compute_centroid(cell_coordinates,cell_centroid);
           normal = face_coordinates.row(0) - cell_centroid;
           normal.normalize();
           face_normals[face_normals.indexes_for_element(faces,face)[0]][XX]=normal[XX];
@@ -16,6 +16,8 @@
 #include "Mesh/CSpace.hpp"
 #include "Mesh/CMesh.hpp"
 #include "Mesh/Field.hpp"
+#include "Mesh/SF/ElementTypeVisitor.hpp"
+#include "Mesh/SF/Types.hpp"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -31,6 +33,32 @@ Common::ComponentBuilder < CBuildVolume, CMeshTransformer, LibActions> CBuildVol
 
 //////////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+/// Computes the volume of each element using the fixed size coordinates of the shape function SF
+struct VolumeComputer
+{
+  VolumeComputer(const CElements& elements_in, Field& volume_in) : elements(elements_in), volume(volume_in) {}
+
+  template<typename SF>
+  void apply()
+  {
+    typename SF::NodeMatrixT coordinates;
+    for (Uint cell_idx = 0; cell_idx<elements.size(); ++cell_idx)
+    {
+      elements.put_coordinates( coordinates, cell_idx );
+      volume[volume.indexes_for_element(elements,cell_idx)[0]][0] = SF::volume( coordinates );
+    }
+  }
+
+  const CElements& elements;
+  Field& volume;
+};
+
+} // detail
+
+//////////////////////////////////////////////////////////////////////////////
+
 CBuildVolume::CBuildVolume( const std::string& name )
 : CMeshTransformer(name)
 {
@@ -76,12 +104,17 @@ void CBuildVolume::execute()
 
   boost_foreach( CElements& elements, volume.elements_range() )
   {
+    // known cell types loop without virtual calls nor allocations, others fall back to the dynamic interface
+    detail::VolumeComputer computer(elements, volume);
+    if( SF::visit_element_type<SF::CellTypes>(elements.element_type(), computer) )
+      continue;
+
     RealMatrix coordinates;  elements.allocate_coordinates(coordinates);
 
     for (Uint cell_idx = 0; cell_idx<elements.size(); ++cell_idx)
     {
       elements.put_coordinates( coordinates, cell_idx );
-      volume[cell_idx][0] = elements.element_type().compute_volume( coordinates );
+      volume[volume.indexes_for_element(elements,cell_idx)[0]][0] = elements.element_type().compute_volume( coordinates );
     }
   }
 }
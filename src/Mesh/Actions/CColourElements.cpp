@@ -0,0 +1,150 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <limits>
+
+#include "Common/CBuilder.hpp"
+
+#include "Common/FindComponents.hpp"
+#include "Common/Foreach.hpp"
+
+#include "Mesh/Actions/CColourElements.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CList.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/Geometry.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+namespace Actions {
+
+  using namespace Common;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Common::ComponentBuilder < CColourElements, CMeshTransformer, LibActions> CColourElements_Builder;
+
+//////////////////////////////////////////////////////////////////////////////
+
+CColourElements::CColourElements( const std::string& name )
+: CMeshTransformer(name)
+{
+
+  properties()["brief"] = std::string("Colour the elements such that elements of the same colour share no node");
+  std::string desc;
+  desc =
+  "  Usage: CColourElements \n\n"
+  "          Greedy colouring of every CElements of the mesh, stored as a list\n"
+  "      of colour offsets followed by the element indices grouped by colour";
+  properties()["description"] = desc;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+std::string CColourElements::brief_description() const
+{
+  return properties().value<std::string>("brief");
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+
+std::string CColourElements::help() const
+{
+  return "  " + properties().value<std::string>("brief") + "\n" +
+      properties().value<std::string>("description");
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+void CColourElements::execute()
+{
+  CMesh& mesh = *m_mesh.lock();
+
+  boost_foreach( CElements& elements, find_components_recursively<CElements>(mesh.topology()) )
+    colouring(elements,true);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CList<Uint>& CColourElements::colouring(CEntities& entities, const bool rebuild)
+{
+  CList<Uint>::Ptr coloured = find_component_ptr_with_tag<CList<Uint> >(entities,Mesh::Tags::coloured_elements());
+  if (rebuild && is_not_null(coloured))
+  {
+    entities.remove_component(*coloured);
+    coloured.reset();
+  }
+
+  if (is_null(coloured))
+  {
+    coloured = entities.create_component_ptr<CList<Uint> >(Mesh::Tags::coloured_elements());
+    coloured->add_tag(Mesh::Tags::coloured_elements());
+    coloured->properties()["brief"] = std::string("The colour offsets, followed by the element indices grouped by colour");
+
+    const Uint nb_elems = entities.size();
+    const Uint nb_nodes = entities.geometry().size();
+
+    // greedy colouring: every sweep gives the current colour to the remaining elements
+    // which do not share a node with an element that already received it
+    const Uint uncoloured = std::numeric_limits<Uint>::max();
+    std::vector<Uint> elem_colour(nb_elems,uncoloured);
+    std::vector<Uint> node_colour(nb_nodes,uncoloured);
+    std::vector<Uint> offsets(1,0);
+    std::vector<Uint> elems;
+    elems.reserve(nb_elems);
+
+    Uint nb_colours = 0;
+    while (elems.size() != nb_elems)
+    {
+      for (Uint idx=0; idx<nb_elems; ++idx)
+      {
+        if (elem_colour[idx] != uncoloured)
+          continue;
+
+        bool conflict = false;
+        boost_foreach(const Uint node, entities.get_nodes(idx))
+        {
+          if (node_colour[node] == nb_colours)
+          {
+            conflict = true;
+            break;
+          }
+        }
+        if (conflict)
+          continue;
+
+        boost_foreach(const Uint node, entities.get_nodes(idx))
+          node_colour[node] = nb_colours;
+        elem_colour[idx] = nb_colours;
+        elems.push_back(idx);
+      }
+      offsets.push_back(elems.size());
+      ++nb_colours;
+    }
+
+    coloured->resize(offsets.size()+elems.size());
+    CList<Uint>::ListT& coloured_array = coloured->array();
+    Uint cnt=0;
+    boost_foreach(const Uint offset, offsets)
+      coloured_array[cnt++] = offset;
+    boost_foreach(const Uint idx, elems)
+      coloured_array[cnt++] = idx;
+
+    coloured->properties()["nb_colours"] = nb_colours;
+  }
+  return *coloured;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+
+} // Actions
+} // Mesh
+} // CF
@@ -0,0 +1,76 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Mesh_CColourElements_hpp
+#define CF_Mesh_CColourElements_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Mesh/CMeshTransformer.hpp"
+
+#include "Mesh/Actions/LibActions.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+
+  class CEntities;
+  template <typename T> class CList;
+
+namespace Actions {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class defines a mesh transformer that colours the elements,
+/// such that elements of the same colour do not share a node.
+/// Loops that scatter into nodes can then process the elements of one colour concurrently.
+/// The colouring of every CElements is stored as a child CList<Uint> tagged Mesh::Tags::coloured_elements(),
+/// and is removed by the elements when the event "mesh_changed" is raised for their mesh.
+class Mesh_Actions_API CColourElements : public CMeshTransformer
+{
+public: // typedefs
+
+    typedef boost::shared_ptr<CColourElements> Ptr;
+    typedef boost::shared_ptr<CColourElements const> ConstPtr;
+
+public: // functions
+
+  /// constructor
+  CColourElements( const std::string& name );
+
+  /// Gets the Class name
+  static std::string type_name() { return "CColourElements"; }
+
+  /// Colour all elements of the mesh, replacing existing colourings
+  virtual void execute();
+
+  /// brief description, typically one line
+  virtual std::string brief_description() const;
+
+  /// extended help that user can query
+  virtual std::string help() const;
+
+  /// The colouring of the elements, computed if it does not exist yet.
+  /// The list first holds the nb_colours+1 offsets of the colours, followed by the element indices
+  /// grouped by colour, so the elements of colour c are at positions nb_colours+1+offset[c]
+  /// up to nb_colours+1+offset[c+1]. The elements of a colour are sorted by index.
+  /// The number of colours is stored in the property "nb_colours".
+  /// @param [in] rebuild  replace an existing colouring
+  static CList<Uint>& colouring(CEntities& entities, const bool rebuild=false);
+
+}; // end CColourElements
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Actions
+} // Mesh
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Mesh_CColourElements_hpp
@@ -185,20 +185,23 @@ void CGlobalConnectivity::execute()
 
 
   CDynTable<Uint>& nodes_glb_elem_connectivity = mesh.geometry().glb_elem_connectivity();
-  nodes_glb_elem_connectivity.resize(glb_elem_connectivity.size());
+  std::vector<Uint> row_sizes(glb_elem_connectivity.size());
+  for (Uint i=0; i<glb_elem_connectivity.size(); ++i)
+    row_sizes[i] = glb_elem_connectivity[i].size() + node2elem.connectivity().row_size(i);
+  nodes_glb_elem_connectivity.allocate(row_sizes);
   for (Uint i=0; i<glb_elem_connectivity.size(); ++i)
   {
     CDynTable<Uint>::ConstRow elems = node2elem.connectivity()[i];
-    nodes_glb_elem_connectivity[i].resize(glb_elem_connectivity[i].size() + elems.size());
+    CDynTable<Uint>::Row row = nodes_glb_elem_connectivity[i];
     cnt = 0;
     boost_foreach(const Uint e, elems)
     {
       boost::tie(elem_comp,elem_idx) = node2elem.elements().location(e);
-      nodes_glb_elem_connectivity[i][cnt++] = elem_comp->as_type<CElements>().glb_idx()[elem_idx];
+      row[cnt++] = elem_comp->as_type<CElements>().glb_idx()[elem_idx];
     }
     for (Uint j=0; j<glb_elem_connectivity[i].size(); ++j)
     {
-      nodes_glb_elem_connectivity[i][cnt++] = glb_elem_connectivity[i][j];
+      row[cnt++] = glb_elem_connectivity[i][j];
     }
 
   }
@@ -80,25 +80,36 @@ void CInitFieldFunction::execute()
 
   Field& field = *m_field.lock();
 
-  std::vector<Real> vars(3,0.);
-
-  RealVector return_val(field.row_size());
+  // The function is evaluated for batches of points at once,
+  // with one row per point in vars and values
+  const Uint batch_size = 4096u;
+  RealMatrix vars;
+  RealMatrix values;
 
   if (field.basis() == FieldGroup::Basis::POINT_BASED)
   {
     const Uint nb_pts = field.size();
     Field& coordinates = field.coordinates();
-    for ( Uint idx=0; idx!=nb_pts; ++idx)
+    for (Uint begin=0; begin<nb_pts; begin+=batch_size)
     {
-      Field::ConstRow coords = coordinates[idx];
-      for (Uint i=0; i<coords.size(); ++i)
-        vars[i] = coords[i];
+      const Uint nb_batch_pts = std::min(batch_size, nb_pts-begin);
+      if (vars.rows() != nb_batch_pts)
+        vars = RealMatrix::Zero(nb_batch_pts, DIM_3D);
+      for (Uint pt=0; pt<nb_batch_pts; ++pt)
+      {
+        Field::ConstRow coords = coordinates[begin+pt];
+        for (Uint d=0; d<coords.size(); ++d)
+          vars(pt,d) = coords[d];
+      }
 
-      m_function.evaluate(vars,return_val);
+      m_function.evaluate(vars,values);
 
-      Field::Row field_row = field[idx];
-      for (Uint i=0; i<field_row.size(); ++i)
-        field_row[i] = return_val[i];
+      for (Uint pt=0; pt<nb_batch_pts; ++pt)
+      {
+        Field::Row field_row = field[begin+pt];
+        for (Uint i=0; i<field_row.size(); ++i)
+          field_row[i] = values(pt,i);
+      }
     }
   }
   else
@@ -106,23 +117,37 @@ void CInitFieldFunction::execute()
     boost_foreach( CEntities& elements, field.entities_range() )
     {
       CSpace& space = field.space(elements);
+      const Uint nb_states = space.nb_states();
+      const Uint nb_elems = elements.size();
+      const Uint batch_nb_elems = std::max(batch_size/nb_states, 1u);
       RealMatrix coordinates;
       space.allocate_coordinates(coordinates);
 
-      for (Uint elem_idx = 0; elem_idx<elements.size(); ++elem_idx)
+      for (Uint begin=0; begin<nb_elems; begin+=batch_nb_elems)
       {
-        coordinates = space.compute_coordinates(elem_idx);
-        CConnectivity::ConstRow field_idx = field.indexes_for_element(elements,elem_idx);
-        /// for each state of the field shape function
-        for (Uint iState=0; iState<space.nb_states(); ++iState)
+        const Uint end = std::min(begin+batch_nb_elems, nb_elems);
+        const Uint nb_batch_pts = (end-begin)*nb_states;
+        if (vars.rows() != nb_batch_pts)
+          vars = RealMatrix::Zero(nb_batch_pts, DIM_3D);
+
+        /// the physical coordinates of every state of the field shape function
+        for (Uint elem_idx=begin; elem_idx<end; ++elem_idx)
+        {
+          coordinates = space.compute_coordinates(elem_idx);
+          for (Uint iState=0; iState<nb_states; ++iState)
+            for (Uint d=0; d<coordinates.cols(); ++d)
+              vars((elem_idx-begin)*nb_states+iState,d) = coordinates(iState,d);
+        }
+
+        m_function.evaluate(vars,values);
+
+        /// put the return values in the field
+        for (Uint elem_idx=begin; elem_idx<end; ++elem_idx)
         {
-          /// evaluate the function using the physical coordinates
-          for (Uint d=0; d<coordinates.cols(); ++d)
-            vars[d] = coordinates.row(iState)[d];
-          m_function.evaluate(vars,return_val);
-          /// put the return values in the field
-          for (Uint i=0; i<field.row_size(); ++i)
-            field[field_idx[iState]][i] = return_val[i];
+          CConnectivity::ConstRow field_idx = field.indexes_for_element(elements,elem_idx);
+          for (Uint iState=0; iState<nb_states; ++iState)
+            for (Uint i=0; i<field.row_size(); ++i)
+              field[field_idx[iState]][i] = values((elem_idx-begin)*nb_states+iState,i);
         }
       }
     }
@@ -0,0 +1,554 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+
+#include <boost/assign/list_of.hpp>
+#include <boost/cstdint.hpp>
+
+#include "Common/Log.hpp"
+#include "Common/CBuilder.hpp"
+#include "Common/OptionT.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/Foreach.hpp"
+
+#include "Mesh/Actions/CRenumber.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CSpace.hpp"
+#include "Mesh/CList.hpp"
+#include "Mesh/CDynTable.hpp"
+#include "Mesh/CConnectivity.hpp"
+#include "Mesh/CMeshElements.hpp"
+#include "Mesh/CFaceCellConnectivity.hpp"
+#include "Mesh/CNodeElementConnectivity.hpp"
+#include "Mesh/CNodeFaceCellConnectivity.hpp"
+#include "Mesh/Geometry.hpp"
+#include "Mesh/Field.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+namespace Actions {
+
+  using namespace Common;
+  using namespace boost::assign;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Common::ComponentBuilder < CRenumber, CMeshTransformer, LibActions> CRenumber_Builder;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Reorder blocks of stride rows of a table, starting at row offset.
+/// The new block b is the old block order[b].
+template <typename ValueT>
+void permute_rows(CTable<ValueT>& table, const std::vector<Uint>& order, const Uint offset=0, const Uint stride=1)
+{
+  const Uint row_size = table.row_size();
+  std::vector<ValueT> copy;
+  copy.reserve(order.size()*stride*row_size);
+  boost_foreach(const Uint old_block, order)
+    for (Uint s=0; s<stride; ++s)
+      for (Uint j=0; j<row_size; ++j)
+        copy.push_back(table[offset+old_block*stride+s][j]);
+
+  Uint cnt=0;
+  for (Uint i=offset; i<offset+order.size()*stride; ++i)
+    for (Uint j=0; j<row_size; ++j)
+      table[i][j] = copy[cnt++];
+}
+
+template <typename ValueT>
+void permute_rows(CList<ValueT>& list, const std::vector<Uint>& order, const Uint offset=0, const Uint stride=1)
+{
+  std::vector<ValueT> copy;
+  copy.reserve(order.size()*stride);
+  boost_foreach(const Uint old_block, order)
+    for (Uint s=0; s<stride; ++s)
+      copy.push_back(list[offset+old_block*stride+s]);
+
+  for (Uint i=0; i<copy.size(); ++i)
+    list[offset+i] = copy[i];
+}
+
+/// Orders node indices by degree, then by index
+struct ByDegree
+{
+  ByDegree(const std::vector<Uint>& degree_in) : degree(degree_in) {}
+
+  bool operator()(const Uint a, const Uint b) const
+  {
+    return degree[a] < degree[b] || ( degree[a] == degree[b] && a < b );
+  }
+
+  const std::vector<Uint>& degree;
+};
+
+/// Hilbert index of integer coordinates, with Skilling's transposed Hilbert algorithm
+boost::uint64_t hilbert_key(std::vector<boost::uint64_t>& x, const Uint bits)
+{
+  const Uint dim = x.size();
+  const boost::uint64_t m = boost::uint64_t(1) << (bits-1);
+
+  // inverse undo
+  for (boost::uint64_t q = m; q > 1; q >>= 1)
+  {
+    const boost::uint64_t p = q - 1;
+    for (Uint i=0; i<dim; ++i)
+    {
+      if (x[i] & q)
+        x[0] ^= p;
+      else
+      {
+        const boost::uint64_t t = (x[0] ^ x[i]) & p;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  for (Uint i=1; i<dim; ++i)
+    x[i] ^= x[i-1];
+  boost::uint64_t t = 0;
+  for (boost::uint64_t q = m; q > 1; q >>= 1)
+    if (x[dim-1] & q)
+      t ^= q - 1;
+  for (Uint i=0; i<dim; ++i)
+    x[i] ^= t;
+
+  // interleave the transposed bits
+  boost::uint64_t key = 0;
+  for (int b=bits-1; b>=0; --b)
+    for (Uint i=0; i<dim; ++i)
+      key = (key << 1) | ((x[i] >> b) & 1);
+  return key;
+}
+
+/// Morton index of integer coordinates
+boost::uint64_t morton_key(const std::vector<boost::uint64_t>& x, const Uint bits)
+{
+  boost::uint64_t key = 0;
+  for (int b=bits-1; b>=0; --b)
+    for (Uint i=0; i<x.size(); ++i)
+      key = (key << 1) | ((x[i] >> b) & 1);
+  return key;
+}
+
+} // anonymous namespace
+
+//////////////////////////////////////////////////////////////////////////////
+
+CRenumber::CRenumber( const std::string& name )
+: CMeshTransformer(name),
+  m_node_ordering("RCM"),
+  m_reorder_elements(true)
+{
+
+  properties()["brief"] = std::string("Renumber nodes and elements so that neighbours are close in memory");
+  std::string desc;
+  desc =
+  "  Usage: CRenumber node_ordering:string=RCM reorder_elements:bool=true \n\n"
+  "          Nodes are ordered with Reverse Cuthill-McKee, or along a Hilbert or Morton curve.\n"
+  "      Elements are sorted by their lowest node index.\n"
+  "      Renumber before the communication patterns of the mesh are set up.";
+  properties()["description"] = desc;
+
+  m_options.add_option< OptionT<std::string> >("node_ordering", m_node_ordering)
+      ->description("Algorithm ordering the nodes: RCM, Hilbert or Morton")
+      ->pretty_name("Node Ordering")
+      ->link_to(&m_node_ordering);
+  option("node_ordering").restricted_list() = list_of
+      (std::string("RCM"))
+      (std::string("Hilbert"))
+      (std::string("Morton"));
+
+  m_options.add_option< OptionT<bool> >("reorder_elements", m_reorder_elements)
+      ->description("Sort the elements by their lowest node index")
+      ->pretty_name("Reorder Elements")
+      ->link_to(&m_reorder_elements);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+std::string CRenumber::brief_description() const
+{
+  return properties().value<std::string>("brief");
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+
+std::string CRenumber::help() const
+{
+  return "  " + properties().value<std::string>("brief") + "\n" +
+      properties().value<std::string>("description");
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+void CRenumber::execute()
+{
+  CMesh& mesh = *m_mesh.lock();
+
+  m_new_index.clear();
+
+  std::vector<Uint> node_order;
+  if (m_node_ordering == "RCM")
+    rcm_order(mesh,node_order);
+  else if (m_node_ordering == "Hilbert")
+    curve_order(mesh,true,node_order);
+  else if (m_node_ordering == "Morton")
+    curve_order(mesh,false,node_order);
+  else
+    throw BadValue(FromHere(),"Unknown node ordering ["+m_node_ordering+"]");
+
+  renumber_nodes(node_order);
+
+  if (m_reorder_elements)
+  {
+    boost_foreach(CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+    {
+      // sort by lowest node index, nodes are already renumbered
+      const CConnectivity& connectivity = elements.node_connectivity();
+      std::vector< std::pair<Uint,Uint> > keys(elements.size());
+      for (Uint e=0; e<elements.size(); ++e)
+        keys[e] = std::make_pair( *std::min_element(connectivity[e].begin(),connectivity[e].end()) , e );
+      std::sort(keys.begin(),keys.end());
+
+      std::vector<Uint> elem_order(elements.size());
+      for (Uint e=0; e<elements.size(); ++e)
+        elem_order[e] = keys[e].second;
+
+      reorder_elements(elements,elem_order);
+    }
+  }
+
+  update_element_references(node_order);
+
+  boost_foreach(CEntities& entities, find_components_recursively<CEntities>(mesh.topology()))
+    entities.remove_derived_lists();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CRenumber::rcm_order(const CMesh& mesh, std::vector<Uint>& order)
+{
+  const Uint nb_nodes = mesh.geometry().size();
+
+  // node graph in compressed rows, with duplicate neighbours
+  std::vector<Uint> offsets(nb_nodes+1,0);
+  boost_foreach(const CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+  {
+    const Uint nb_elem_nodes = elements.node_connectivity().row_size();
+    boost_foreach(CConnectivity::ConstRow nodes, elements.node_connectivity().array())
+      boost_foreach(const Uint node, nodes)
+        offsets[node+1] += nb_elem_nodes-1;
+  }
+  for (Uint n=0; n<nb_nodes; ++n)
+    offsets[n+1] += offsets[n];
+
+  std::vector<Uint> adjacency(offsets[nb_nodes]);
+  std::vector<Uint> fill(offsets.begin(),offsets.end()-1);
+  boost_foreach(const CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+  {
+    boost_foreach(CConnectivity::ConstRow nodes, elements.node_connectivity().array())
+      boost_foreach(const Uint node, nodes)
+        boost_foreach(const Uint neighbour, nodes)
+          if (neighbour != node)
+            adjacency[fill[node]++] = neighbour;
+  }
+
+  // the degree is the number of distinct neighbours, which are moved to the front of each row
+  std::vector<Uint> degree(nb_nodes);
+  for (Uint n=0; n<nb_nodes; ++n)
+  {
+    std::vector<Uint>::iterator begin = adjacency.begin()+offsets[n];
+    std::sort(begin,adjacency.begin()+offsets[n+1]);
+    degree[n] = std::unique(begin,adjacency.begin()+offsets[n+1]) - begin;
+  }
+
+  // breadth first search from the lowest degree node of every connected part
+  std::vector<Uint> by_degree(nb_nodes);
+  for (Uint n=0; n<nb_nodes; ++n)
+    by_degree[n] = n;
+  std::sort(by_degree.begin(),by_degree.end(),ByDegree(degree));
+
+  std::vector<bool> visited(nb_nodes,false);
+  std::vector<Uint> neighbours;
+  order.clear();
+  order.reserve(nb_nodes);
+  Uint seed=0;
+  while (order.size() != nb_nodes)
+  {
+    while (visited[by_degree[seed]])
+      ++seed;
+
+    Uint head = order.size();
+    order.push_back(by_degree[seed]);
+    visited[by_degree[seed]] = true;
+    while (head != order.size())
+    {
+      const Uint node = order[head++];
+      neighbours.clear();
+      for (Uint k=offsets[node]; k<offsets[node]+degree[node]; ++k)
+      {
+        if (!visited[adjacency[k]])
+        {
+          visited[adjacency[k]] = true;
+          neighbours.push_back(adjacency[k]);
+        }
+      }
+      std::sort(neighbours.begin(),neighbours.end(),ByDegree(degree));
+      order.insert(order.end(),neighbours.begin(),neighbours.end());
+    }
+  }
+
+  std::reverse(order.begin(),order.end());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CRenumber::curve_order(const CMesh& mesh, const bool hilbert, std::vector<Uint>& order)
+{
+  const Field& coordinates = mesh.geometry().coordinates();
+  const Uint nb_nodes = coordinates.size();
+  const Uint dim = coordinates.row_size();
+
+  // bits per coordinate, such that the key fits in 64 bits
+  const Uint bits = dim == DIM_3D ? 21 : 31;
+
+  order.resize(nb_nodes);
+  if (nb_nodes == 0)
+    return;
+
+  // bounding box
+  std::vector<Real> min(coordinates[0].begin(),coordinates[0].end());
+  std::vector<Real> max(min);
+  for (Uint n=1; n<nb_nodes; ++n)
+  {
+    for (Uint d=0; d<dim; ++d)
+    {
+      min[d] = std::min(min[d],coordinates[n][d]);
+      max[d] = std::max(max[d],coordinates[n][d]);
+    }
+  }
+
+  const Real resolution = static_cast<Real>( (boost::uint64_t(1) << bits) - 1 );
+  std::vector< std::pair<boost::uint64_t,Uint> > keys(nb_nodes);
+  std::vector<boost::uint64_t> x(dim);
+  for (Uint n=0; n<nb_nodes; ++n)
+  {
+    for (Uint d=0; d<dim; ++d)
+    {
+      const Real extent = max[d]-min[d];
+      x[d] = extent > 0. ? static_cast<boost::uint64_t>( (coordinates[n][d]-min[d]) / extent * resolution ) : 0;
+    }
+    keys[n] = std::make_pair( hilbert && dim > DIM_1D ? hilbert_key(x,bits) : morton_key(x,bits) , n );
+  }
+  std::sort(keys.begin(),keys.end());
+
+  for (Uint n=0; n<nb_nodes; ++n)
+    order[n] = keys[n].second;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CRenumber::renumber_nodes(const std::vector<Uint>& order)
+{
+  CMesh& mesh = *m_mesh.lock();
+  Geometry& geometry = mesh.geometry();
+  const Uint nb_nodes = order.size();
+
+  std::vector<Uint> new_index(nb_nodes);
+  for (Uint n=0; n<nb_nodes; ++n)
+    new_index[order[n]] = n;
+
+  // rows of the geometry: coordinates and other fields, global indices and ranks
+  boost_foreach(Field& field, geometry.fields())
+    permute_rows(field,order);
+  boost_foreach(CList<Uint>& list, find_components<CList<Uint> >(geometry))
+    if (list.size() == nb_nodes)
+      permute_rows(list,order);
+
+  CDynTable<Uint>& glb_elem_connectivity = geometry.glb_elem_connectivity();
+  if (glb_elem_connectivity.size() == nb_nodes)
+  {
+    const CDynTable<Uint>::ValuesT values = glb_elem_connectivity.values();
+    const CDynTable<Uint>::OffsetsT offsets = glb_elem_connectivity.offsets();
+    std::vector<Uint> row_sizes(nb_nodes);
+    for (Uint n=0; n<nb_nodes; ++n)
+      row_sizes[n] = offsets[order[n]+1]-offsets[order[n]];
+    glb_elem_connectivity.allocate(row_sizes);
+    for (Uint n=0; n<nb_nodes; ++n)
+      std::copy(values.begin()+offsets[order[n]],values.begin()+offsets[order[n]+1],glb_elem_connectivity[n].begin());
+  }
+
+  // node indices in the element connectivities
+  boost_foreach(CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+  {
+    if (&elements.geometry() != &geometry)
+      continue;
+    boost_foreach(CConnectivity::Row nodes, elements.node_connectivity().array())
+      boost_foreach(Uint& node, nodes)
+        node = new_index[node];
+  }
+
+  // lists of used nodes
+  boost_foreach(CList<Uint>& used_nodes, find_components_recursively_with_tag<CList<Uint> >(mesh.topology(),Mesh::Tags::nodes_used()))
+  {
+    CList<Uint>::ListT& nodes = used_nodes.array();
+    boost_foreach(Uint& node, nodes)
+      node = new_index[node];
+    std::sort(nodes.begin(),nodes.end());
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CRenumber::reorder_elements(CElements& elements, const std::vector<Uint>& order)
+{
+  const Uint nb_elems = order.size();
+  if (nb_elems == 0)
+    return;
+
+  std::vector<Uint>& new_index = m_new_index[&elements];
+  new_index.resize(nb_elems);
+  for (Uint e=0; e<nb_elems; ++e)
+    new_index[order[e]] = e;
+
+  permute_rows(elements.glb_idx(),order);
+  permute_rows(elements.rank(),order);
+
+  // spaces, either with a connectivity table or as a contiguous block of element based fields
+  boost_foreach(CSpace& space, find_components_recursively<CSpace>(elements))
+  {
+    if (space.is_bound_to_fields() && space.bound_fields().basis() != FieldGroup::Basis::POINT_BASED)
+    {
+      FieldGroup& field_group = space.bound_fields();
+      const Uint start = space.indexes_for_element(0)[0];
+      const Uint nb_states = space.nb_states();
+      boost_foreach(Field& field, field_group.fields())
+        permute_rows(field,order,start,nb_states);
+      permute_rows(field_group.glb_idx(),order,start,nb_states);
+      permute_rows(field_group.rank(),order,start,nb_states);
+    }
+    else if (space.connectivity().size() == nb_elems)
+    {
+      permute_rows(space.connectivity(),order);
+    }
+  }
+
+  // cell to face connectivity
+  if (CConnectivity::Ptr face_connectivity = find_component_ptr_with_name<CConnectivity>(elements,"face_connectivity"))
+  {
+    if (face_connectivity->size() == nb_elems)
+      permute_rows(*face_connectivity,order);
+  }
+
+  // face to cell connectivity of these faces
+  boost_foreach(CFaceCellConnectivity& face_cell_connectivity, find_components<CFaceCellConnectivity>(elements))
+  {
+    if (face_cell_connectivity.size() != nb_elems)
+      continue;
+    permute_rows(face_cell_connectivity.connectivity(),order);
+    permute_rows(face_cell_connectivity.face_number(),order);
+    permute_rows(face_cell_connectivity.is_bdry_face(),order);
+    m_new_index[&face_cell_connectivity] = new_index;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CRenumber::update_element_references(const std::vector<Uint>& node_order)
+{
+  CMesh& mesh = *m_mesh.lock();
+
+  boost_foreach(CFaceCellConnectivity& face_cell_connectivity, find_components_recursively<CFaceCellConnectivity>(mesh))
+  {
+    if (face_cell_connectivity.size() == 0)
+      continue;
+    const CUnifiedData& lookup = face_cell_connectivity.lookup();
+    CTable<Uint>& connectivity = face_cell_connectivity.connectivity();
+    for (Uint f=0; f<connectivity.size(); ++f)
+    {
+      // boundary faces only have the first cell
+      const Uint nb_cells = face_cell_connectivity.is_bdry_face()[f] ? 1 : connectivity.row_size();
+      for (Uint c=0; c<nb_cells; ++c)
+        connectivity[f][c] = renumbered(lookup,connectivity[f][c]);
+    }
+  }
+
+  boost_foreach(CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+  {
+    if (CConnectivity::Ptr face_connectivity = find_component_ptr_with_name<CConnectivity>(elements,"face_connectivity"))
+    {
+      boost_foreach(CConnectivity::Row faces, face_connectivity->array())
+        boost_foreach(Uint& face, faces)
+          face = renumbered(mesh.elements(),face);
+    }
+  }
+
+  boost_foreach(CNodeElementConnectivity& node_element_connectivity, find_components_recursively<CNodeElementConnectivity>(mesh))
+    renumber_dyn_table(node_element_connectivity.connectivity(),node_element_connectivity.elements(),node_order);
+
+  boost_foreach(CNodeFaceCellConnectivity& node_face_connectivity, find_components_recursively<CNodeFaceCellConnectivity>(mesh))
+    renumber_dyn_table(node_face_connectivity.connectivity(),node_face_connectivity.face_cell_connectivity(),node_order);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+Uint CRenumber::renumbered(const CUnifiedData& lookup, const Uint unified_idx) const
+{
+  if (unified_idx >= lookup.size())
+    return unified_idx;
+
+  Uint component_idx, local_idx;
+  boost::tie(component_idx,local_idx) = lookup.location_idx(unified_idx);
+  const Component& component = lookup.component(component_idx);
+
+  std::map<const Component*, std::vector<Uint> >::const_iterator it = m_new_index.find(&component);
+  if (it == m_new_index.end())
+    return unified_idx;
+  return lookup.unified_idx(component,it->second[local_idx]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CRenumber::renumber_dyn_table(CDynTable<Uint>& table, const CUnifiedData& lookup, const std::vector<Uint>& node_order) const
+{
+  const Uint nb_rows = table.size();
+  const bool node_rows = nb_rows == node_order.size();
+
+  const CDynTable<Uint>::ValuesT values = table.values();
+  const CDynTable<Uint>::OffsetsT offsets = table.offsets();
+  std::vector<Uint> row_sizes(nb_rows);
+  for (Uint i=0; i<nb_rows; ++i)
+  {
+    const Uint old_row = node_rows ? node_order[i] : i;
+    row_sizes[i] = offsets[old_row+1]-offsets[old_row];
+  }
+  table.allocate(row_sizes);
+  for (Uint i=0; i<nb_rows; ++i)
+  {
+    const Uint old_row = node_rows ? node_order[i] : i;
+    CDynTable<Uint>::Row row = table[i];
+    for (Uint j=0; j<row.size(); ++j)
+      row[j] = renumbered(lookup,values[offsets[old_row]+j]);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+
+} // Actions
+} // Mesh
+} // CF
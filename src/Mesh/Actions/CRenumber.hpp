@@ -0,0 +1,109 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Mesh_CRenumber_hpp
+#define CF_Mesh_CRenumber_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Mesh/CMeshTransformer.hpp"
+
+#include "Mesh/Actions/LibActions.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+
+  class CElements;
+  class CUnifiedData;
+  template <typename T> class CDynTable;
+
+namespace Actions {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class defines a mesh transformer that renumbers the nodes and the elements
+/// of a mesh, so that nodes and elements close in the mesh are close in memory.
+/// The nodes are ordered with the Reverse Cuthill-McKee algorithm on the node graph,
+/// or along a Hilbert or Morton space-filling curve through the coordinates.
+/// The elements of every CElements are then sorted by their lowest node index.
+/// All tables indexed by nodes or elements are updated accordingly:
+/// geometry fields, global indices and ranks, connectivities, element based fields
+/// and face-cell connectivities.
+/// @note renumber before the communication patterns of the mesh are set up
+class Mesh_Actions_API CRenumber : public CMeshTransformer
+{
+public: // typedefs
+
+    typedef boost::shared_ptr<CRenumber> Ptr;
+    typedef boost::shared_ptr<CRenumber const> ConstPtr;
+
+public: // functions
+
+  /// constructor
+  CRenumber( const std::string& name );
+
+  /// Gets the Class name
+  static std::string type_name() { return "CRenumber"; }
+
+  virtual void execute();
+
+  /// brief description, typically one line
+  virtual std::string brief_description() const;
+
+  /// extended help that user can query
+  virtual std::string help() const;
+
+  /// Order of the nodes by the Reverse Cuthill-McKee algorithm, on the graph of nodes sharing an element
+  /// @param [out] order  the old index of every new node index
+  static void rcm_order(const CMesh& mesh, std::vector<Uint>& order);
+
+  /// Order of the nodes along a space-filling curve through the coordinates
+  /// @param [in]  hilbert  Hilbert curve if true, Morton (Z-order) curve otherwise
+  /// @param [out] order    the old index of every new node index
+  static void curve_order(const CMesh& mesh, const bool hilbert, std::vector<Uint>& order);
+
+private: // functions
+
+  /// Apply the node order to the geometry and to the tables holding node indices
+  void renumber_nodes(const std::vector<Uint>& order);
+
+  /// Apply an element order to the tables with one row per element
+  void reorder_elements(CElements& elements, const std::vector<Uint>& order);
+
+  /// Update the tables holding unified element indices, and apply the node order to those with one row per node
+  void update_element_references(const std::vector<Uint>& node_order);
+
+  /// New unified index of a unified index in a lookup, using the new indices of the reordered components
+  Uint renumbered(const CUnifiedData& lookup, const Uint unified_idx) const;
+
+  /// Apply the node order to the rows and the new element indices to the entries
+  void renumber_dyn_table(CDynTable<Uint>& table, const CUnifiedData& lookup, const std::vector<Uint>& node_order) const;
+
+private: // data
+
+  /// Algorithm to order the nodes
+  std::string m_node_ordering;
+
+  /// Sort the elements by their lowest node index
+  bool m_reorder_elements;
+
+  /// New row index of every old row, of each component whose rows were reordered
+  std::map<const Common::Component*, std::vector<Uint> > m_new_index;
+
+}; // end CRenumber
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Actions
+} // Mesh
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Mesh_CRenumber_hpp
@@ -0,0 +1,327 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+
+#include <boost/tuple/tuple.hpp>
+
+#include "Common/Core.hpp"
+#include "Common/Foreach.hpp"
+#include "Common/Log.hpp"
+#include "Common/CBuilder.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/OptionT.hpp"
+#include "Common/OptionComponent.hpp"
+#include "Common/ThreadPool.hpp"
+
+#include "Math/Consts.hpp"
+#include "Mesh/CBoundingBoxTree.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CTable.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/ElementType.hpp"
+#include "Mesh/Geometry.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+
+  using namespace Common;
+  using namespace Math::Consts;
+
+////////////////////////////////////////////////////////////////////////////////
+
+CF::Common::ComponentBuilder < CBoundingBoxTree, Component, LibMesh > CBoundingBoxTree_Builder;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Maximum depth of the tree, far beyond the depth of a median split of any Uint number of elements
+const Uint max_depth = 64;
+
+/// Orders unified element indices by the coordinate of their centre along one axis
+struct CentreLess
+{
+  CentreLess(const std::vector<Real>& centres, const Uint dim, const Uint axis) :
+    m_centres(centres), m_dim(dim), m_axis(axis) {}
+
+  bool operator()(const Uint a, const Uint b) const
+  {
+    return m_centres[m_dim*a+m_axis] < m_centres[m_dim*b+m_axis];
+  }
+
+  const std::vector<Real>& m_centres;
+  const Uint m_dim;
+  const Uint m_axis;
+};
+
+} // anonymous namespace
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Functor locating a chunk of the points of find_unified_elements(), executed by the threads of the pool
+struct CBoundingBoxTree::Worker
+{
+  Worker(const CBoundingBoxTree& tree_in, const RealMatrix& coordinates_in, std::vector<Uint>& unified_elems_in) :
+    tree(tree_in), coordinates(coordinates_in), unified_elems(unified_elems_in) {}
+
+  void operator()(const Uint begin, const Uint end)
+  {
+    RealVector point(coordinates.cols());
+    RealMatrix elem_coordinates;
+    for (Uint i=begin; i<end; ++i)
+    {
+      point = coordinates.row(i);
+      if (!tree.locate(point, elem_coordinates, unified_elems[i]))
+        unified_elems[i] = not_found();
+    }
+  }
+
+  const CBoundingBoxTree& tree;
+  const RealMatrix& coordinates;
+  std::vector<Uint>& unified_elems;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+CBoundingBoxTree::CBoundingBoxTree( const std::string& name )
+  : Component(name), m_dim(0), m_nb_elems_per_leaf(8)
+{
+  m_options.add_option(OptionComponent<CMesh>::create("mesh", &m_mesh))
+      ->description("Mesh to create the tree from")
+      ->pretty_name("Mesh")
+      ->mark_basic();
+
+  m_options.add_option< OptionT<Uint> >( "nb_elems_per_leaf", m_nb_elems_per_leaf )
+      ->description("The maximum number of elements in a leaf of the tree")
+      ->pretty_name("Number of Elements per Leaf")
+      ->link_to(&m_nb_elems_per_leaf);
+
+  m_elements = create_component_ptr<CUnifiedData>("elements");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CBoundingBoxTree::create_tree()
+{
+  if (m_mesh.expired())
+    throw SetupError(FromHere(), "Option \"mesh\" has not been configured");
+  create_tree(*m_mesh.lock());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CBoundingBoxTree::create_tree(const CMesh& mesh)
+{
+  m_dim = mesh.geometry().coordinates().row_size();
+  const Uint box_size = 2*m_dim;
+
+  m_elements->reset();
+  boost_foreach (const CElements& elements, find_components_recursively_with_filter<CElements>(mesh,IsElementsVolume()))
+    m_elements->add(elements);
+
+  const Uint nb_elems = m_elements->size();
+
+  // bounding box and centre of every element, in the unified numbering
+
+  std::vector<Real> boxes(box_size*nb_elems);
+  std::vector<Real> centres(m_dim*nb_elems);
+  Uint unified_idx=0;
+  boost_foreach (const CElements& elements, find_components_recursively_with_filter<CElements>(mesh,IsElementsVolume()))
+  {
+    RealMatrix coordinates;
+    elements.allocate_coordinates(coordinates);
+    for (Uint elem_idx=0; elem_idx<elements.size(); ++elem_idx, ++unified_idx)
+    {
+      elements.put_coordinates(coordinates,elem_idx);
+      Real* box = &boxes[box_size*unified_idx];
+      Real extent = 0.;
+      for (Uint d=0; d<m_dim; ++d)
+      {
+        box[d]       = coordinates.col(d).minCoeff();
+        box[m_dim+d] = coordinates.col(d).maxCoeff();
+        centres[m_dim*unified_idx+d] = 0.5*(box[d]+box[m_dim+d]);
+        extent = std::max(extent, box[m_dim+d]-box[d]);
+      }
+      // points on a face of the element must not be rejected by the box because of round-off
+      const Real tolerance = 1e-8*extent;
+      for (Uint d=0; d<m_dim; ++d)
+      {
+        box[d]       -= tolerance;
+        box[m_dim+d] += tolerance;
+      }
+    }
+  }
+
+  // top-down construction, splitting every node at the median centre along its longest side
+
+  m_element_order.resize(nb_elems);
+  for (Uint e=0; e<nb_elems; ++e)
+    m_element_order[e] = e;
+
+  m_nodes.clear();
+  m_node_boxes.clear();
+  const Uint leaf_size = std::max(m_nb_elems_per_leaf, 1u);
+  const Node root = {0u, nb_elems, 0u};
+  m_nodes.push_back(root);
+  m_node_boxes.resize(box_size);
+
+  std::vector<Uint> work(1, 0u);
+  Uint depth = 0;
+  std::vector<Uint> node_depth(1, 0u);
+  while (!work.empty())
+  {
+    const Uint node_idx = work.back();
+    work.pop_back();
+    const Uint begin = m_nodes[node_idx].begin;
+    const Uint end   = m_nodes[node_idx].end;
+    depth = std::max(depth, node_depth[node_idx]);
+
+    Real* node_box = &m_node_boxes[box_size*node_idx];
+    RealVector centre_min(m_dim), centre_max(m_dim);
+    for (Uint d=0; d<m_dim; ++d)
+    {
+      node_box[d]       = real_max();  node_box[m_dim+d] = -real_max();
+      centre_min[d]     = real_max();  centre_max[d]     = -real_max();
+    }
+    for (Uint i=begin; i<end; ++i)
+    {
+      const Uint e = m_element_order[i];
+      for (Uint d=0; d<m_dim; ++d)
+      {
+        node_box[d]       = std::min(node_box[d],       boxes[box_size*e+d]);
+        node_box[m_dim+d] = std::max(node_box[m_dim+d], boxes[box_size*e+m_dim+d]);
+        centre_min[d] = std::min(centre_min[d], centres[m_dim*e+d]);
+        centre_max[d] = std::max(centre_max[d], centres[m_dim*e+d]);
+      }
+    }
+
+    if (end-begin <= leaf_size || node_depth[node_idx]+1 >= max_depth)
+      continue;
+
+    Uint axis=0;
+    for (Uint d=1; d<m_dim; ++d)
+    {
+      if (centre_max[d]-centre_min[d] > centre_max[axis]-centre_min[axis])
+        axis=d;
+    }
+    const Uint mid = begin + (end-begin)/2;
+    std::nth_element(m_element_order.begin()+begin, m_element_order.begin()+mid, m_element_order.begin()+end,
+                     CentreLess(centres,m_dim,axis));
+
+    const Uint children = m_nodes.size();
+    m_nodes[node_idx].children = children;
+    const Node left  = {begin, mid, 0u};
+    const Node right = {mid,   end, 0u};
+    m_nodes.push_back(left);
+    m_nodes.push_back(right);
+    m_node_boxes.resize(box_size*m_nodes.size());
+    node_depth.push_back(node_depth[node_idx]+1);
+    node_depth.push_back(node_depth[node_idx]+1);
+    work.push_back(children+1);
+    work.push_back(children);
+  }
+
+  // element boxes in tree order, so that a leaf reads a contiguous block
+
+  m_element_boxes.resize(box_size*nb_elems);
+  for (Uint i=0; i<nb_elems; ++i)
+    std::copy(boxes.begin()+box_size*m_element_order[i], boxes.begin()+box_size*(m_element_order[i]+1),
+              m_element_boxes.begin()+box_size*i);
+
+  CFinfo << "Bounding box tree: " << nb_elems << " elements in " << m_nodes.size() << " nodes of depth " << depth << CFendl;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool CBoundingBoxTree::locate(const RealVector& target_coord, RealMatrix& elem_coordinates, Uint& unified_idx) const
+{
+  cf_assert(target_coord.size() == static_cast<int>(m_dim));
+
+  if (m_nodes.empty() || m_element_order.empty())
+    return false;
+
+  Uint stack[max_depth+1];
+  Uint stack_size = 0;
+  stack[stack_size++] = 0;
+  while (stack_size)
+  {
+    const Uint node_idx = stack[--stack_size];
+    if (!box_contains(m_node_boxes,node_idx,target_coord))
+      continue;
+
+    const Node& node = m_nodes[node_idx];
+    if (node.children)
+    {
+      stack[stack_size++] = node.children+1;
+      stack[stack_size++] = node.children;
+      continue;
+    }
+
+    for (Uint i=node.begin; i<node.end; ++i)
+    {
+      if (!box_contains(m_element_boxes,i,target_coord))
+        continue;
+
+      const boost::tuple<const Component&,Uint> location = m_elements->location_v2(m_element_order[i]);
+      // only CElements are added to m_elements
+      const CElements& elements = static_cast<const CElements&>(boost::get<0>(location));
+      elements.allocate_coordinates(elem_coordinates);
+      elements.put_coordinates(elem_coordinates,boost::get<1>(location));
+      if (elements.element_type().is_coord_in_element(target_coord,elem_coordinates))
+      {
+        unified_idx = m_element_order[i];
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool CBoundingBoxTree::find_unified_element(const RealVector& target_coord, Uint& unified_idx) const
+{
+  RealMatrix elem_coordinates;
+  return locate(target_coord,elem_coordinates,unified_idx);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+boost::tuple<CElements::ConstPtr,Uint> CBoundingBoxTree::find_element(const RealVector& target_coord) const
+{
+  Uint unified_idx;
+  if (find_unified_element(target_coord,unified_idx))
+  {
+    Component::ConstPtr component;
+    Uint elem_idx;
+    boost::tie(component,elem_idx) = m_elements->location(unified_idx);
+    return boost::make_tuple(component->as_ptr<CElements>(),elem_idx);
+  }
+  return boost::make_tuple(CElements::ConstPtr(), 0u);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CBoundingBoxTree::find_unified_elements(const RealMatrix& coordinates, std::vector<Uint>& unified_elems) const
+{
+  cf_assert(coordinates.cols() == static_cast<int>(m_dim));
+
+  const Uint nb_points = coordinates.rows();
+  unified_elems.resize(nb_points);
+
+  // the points are located independently, by the threads of the pool
+  Worker worker(*this, coordinates, unified_elems);
+  Core::instance().thread_pool().parallel_for(0, nb_points, worker);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Mesh
+} // CF
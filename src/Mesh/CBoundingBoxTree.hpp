@@ -0,0 +1,143 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Mesh_CBoundingBoxTree_hpp
+#define CF_Mesh_CBoundingBoxTree_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <limits>
+
+#include <boost/tuple/tuple.hpp>
+
+#include "Common/Component.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CUnifiedData.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+
+  class CMesh;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Point location in the volume elements of a mesh, using a bounding volume hierarchy
+/// of the element bounding boxes.
+/// Unlike the uniform bins of COcttree, the tree adapts to the element sizes: every node is
+/// split at the median of the element centres along its longest side, until a leaf holds at most
+/// "nb_elems_per_leaf" elements. Strongly graded meshes therefore give neither empty nor overloaded
+/// leaves, and a point is never missed because its element lies further than a fixed number of bins away.
+/// The nodes and boxes are stored in flat arrays, and the queries do not allocate, so that many points
+/// can be located at once (see find_unified_elements()), optionally by several threads.
+class Mesh_API CBoundingBoxTree : public Common::Component
+{
+public: // typedefs
+
+  typedef boost::shared_ptr<CBoundingBoxTree> Ptr;
+  typedef boost::shared_ptr<CBoundingBoxTree const> ConstPtr;
+
+public: // functions
+  /// constructor
+  CBoundingBoxTree( const std::string& name );
+
+  /// Gets the Class name
+  static std::string type_name() { return "CBoundingBoxTree"; }
+
+  /// Build the tree for the volume elements of the configured mesh
+  void create_tree();
+
+  /// Build the tree for the volume elements of a given mesh
+  void create_tree(const CMesh& mesh);
+
+  /// Find one single element in which the given coordinate resides.
+  /// @param target_coord [in] the given coordinate
+  /// @return the elements region, and the local index in this region,
+  ///         or a null pointer if the coordinate is outside the mesh
+  boost::tuple<CElements::ConstPtr,Uint> find_element(const RealVector& target_coord) const;
+
+  /// Find one single element in which the given coordinate resides.
+  /// @param target_coord [in]  the given coordinate
+  /// @param unified_idx  [out] index of the element in unified_elements()
+  /// @return false if the coordinate is outside the mesh
+  bool find_unified_element(const RealVector& target_coord, Uint& unified_idx) const;
+
+  /// Locate many points at once, in parallel by the threads of the pool (see Common::ThreadPool)
+  /// @param coordinates   [in]  one point per row
+  /// @param unified_elems [out] index in unified_elements() of the element of each point,
+  ///                            or not_found() for the points outside the mesh
+  void find_unified_elements(const RealMatrix& coordinates, std::vector<Uint>& unified_elems) const;
+
+  /// The volume elements of the mesh, in the unified numbering returned by the queries
+  const CUnifiedData& unified_elements() const { return *m_elements; }
+
+  /// Index returned by find_unified_elements() for points outside the mesh
+  static Uint not_found() { return std::numeric_limits<Uint>::max(); }
+
+private: // classes
+
+  /// Node of the tree, with its elements in m_element_order[begin,end).
+  /// The children of a node are consecutive, the first one at index "children",
+  /// which is 0 for a leaf since the root is never a child.
+  struct Node
+  {
+    Uint begin;
+    Uint end;
+    Uint children;
+  };
+
+  struct Worker;
+
+private: // functions
+
+  /// Locate a point, with the coordinates buffer of the calling thread
+  bool locate(const RealVector& target_coord, RealMatrix& elem_coordinates, Uint& unified_idx) const;
+
+  /// Check if a point is inside a box stored at a given offset in a flat array of boxes
+  bool box_contains(const std::vector<Real>& boxes, const Uint box_idx, const RealVector& coord) const
+  {
+    const Real* box = &boxes[2*m_dim*box_idx];
+    for (Uint d=0; d<m_dim; ++d)
+    {
+      if (coord[d] < box[d] || coord[d] > box[m_dim+d])
+        return false;
+    }
+    return true;
+  }
+
+private: // data
+
+  boost::weak_ptr<CMesh> m_mesh;
+
+  Uint m_dim;
+
+  Uint m_nb_elems_per_leaf;
+
+  CUnifiedData::Ptr m_elements;
+
+  /// Nodes of the tree, the root first
+  std::vector<Node> m_nodes;
+
+  /// Bounding box of every node, as dim minima followed by dim maxima
+  std::vector<Real> m_node_boxes;
+
+  /// Bounding box of every element, in the order of m_element_order
+  std::vector<Real> m_element_boxes;
+
+  /// Unified element indices, sorted so that the elements of every node are contiguous
+  std::vector<Uint> m_element_order;
+
+}; // end CBoundingBoxTree
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Mesh
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Mesh_CBoundingBoxTree_hpp
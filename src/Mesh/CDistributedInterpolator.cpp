@@ -0,0 +1,323 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/Foreach.hpp"
+#include "Common/Log.hpp"
+#include "Common/CBuilder.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/StringConversion.hpp"
+#include "Common/MPI/PE.hpp"
+
+#include "Math/Consts.hpp"
+#include "Mesh/CDistributedInterpolator.hpp"
+#include "Mesh/CBoundingBoxTree.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CTable.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CSpace.hpp"
+#include "Mesh/Field.hpp"
+#include "Mesh/FieldGroup.hpp"
+#include "Mesh/ElementType.hpp"
+#include "Mesh/Geometry.hpp"
+#include "Mesh/ShapeFunction.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+
+  using namespace Common;
+  using namespace Math::Consts;
+
+////////////////////////////////////////////////////////////////////////////////
+
+CF::Common::ComponentBuilder < CDistributedInterpolator, CInterpolator, LibMesh > CDistributedInterpolator_Builder;
+
+//////////////////////////////////////////////////////////////////////////////
+
+CDistributedInterpolator::CDistributedInterpolator( const std::string& name )
+  : CInterpolator(name), m_dim(0)
+{
+  m_properties["brief"] = std::string("Interpolates between meshes with different partitions, using the shape functions of the source field");
+
+  m_tree = create_component_ptr<CBoundingBoxTree>("bounding_box_tree");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CDistributedInterpolator::construct_internal_storage(const CMesh& source)
+{
+  if (m_source_mesh == source.as_ptr<CMesh>())
+    return;
+
+  m_source_mesh = source.as_ptr<CMesh>();
+  m_dim = source.geometry().coordinates().row_size();
+  m_tree->create_tree(source);
+
+  // bounding box of the local part, slightly enlarged for points on its boundary
+  std::vector<Real> box(2*m_dim);
+  for (Uint d=0; d<m_dim; ++d)
+  {
+    box[d]       =  real_max();
+    box[m_dim+d] = -real_max();
+  }
+  boost_foreach(CTable<Real>::ConstRow coords, source.geometry().coordinates().array())
+  {
+    for (Uint d=0; d<m_dim; ++d)
+    {
+      box[d]       = std::min(box[d],       coords[d]);
+      box[m_dim+d] = std::max(box[m_dim+d], coords[d]);
+    }
+  }
+  for (Uint d=0; d<m_dim; ++d)
+  {
+    const Real tolerance = 1e-8*std::max(box[m_dim+d]-box[d], 0.);
+    box[d]       -= tolerance;
+    box[m_dim+d] += tolerance;
+  }
+
+  if (Comm::PE::instance().is_active())
+    Comm::PE::instance().all_gather(box, m_partition_boxes);
+  else
+    m_partition_boxes = box;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void CDistributedInterpolator::interpolate_field_from_to(const Field& source, Field& target)
+{
+  if (is_null(m_source_mesh))
+    throw SetupError(FromHere(), "No source mesh, construct_internal_storage() must be called first");
+  if (source.row_size() != target.row_size())
+    throw BadValue(FromHere(), "Source field " + source.uri().string() + " has row size " + to_str(source.row_size())
+                   + ", target field " + target.uri().string() + " has row size " + to_str(target.row_size()));
+
+  std::vector<Real> points;
+  std::vector<Uint> rows;
+  gather_target_points(target, points, rows);
+
+  const Uint nb_points = rows.size();
+  const Uint row_size = target.row_size();
+  const Uint stride = row_size+1;
+
+  // for every target point, the interpolated values preceded by a flag telling if it was found
+  std::vector<Real> results(stride*nb_points, 0.);
+
+  if ( !Comm::PE::instance().is_active() || Comm::PE::instance().size() == 1 )
+  {
+    evaluate(source, points, results);
+  }
+  else
+  {
+    const Uint nb_procs = Comm::PE::instance().size();
+
+    // send every point to all processes whose part of the source mesh may contain it
+
+    std::vector< std::vector<Uint> > sent_points(nb_procs);
+    for (Uint p=0; p<nb_points; ++p)
+    {
+      for (Uint proc=0; proc<nb_procs; ++proc)
+      {
+        const Real* box = &m_partition_boxes[2*m_dim*proc];
+        bool inside = true;
+        for (Uint d=0; d<m_dim && inside; ++d)
+          inside = points[m_dim*p+d] >= box[d] && points[m_dim*p+d] <= box[m_dim+d];
+        if (inside)
+          sent_points[proc].push_back(p);
+      }
+    }
+
+    std::vector<Real> send_coords;
+    std::vector<int> send_n(nb_procs);
+    for (Uint proc=0; proc<nb_procs; ++proc)
+    {
+      send_n[proc] = sent_points[proc].size();
+      boost_foreach(const Uint p, sent_points[proc])
+        send_coords.insert(send_coords.end(), points.begin()+m_dim*p, points.begin()+m_dim*(p+1));
+    }
+
+    std::vector<Real> recv_coords;
+    std::vector<int> recv_n(nb_procs, -1);
+    Comm::PE::instance().all_to_all(send_coords, send_n, recv_coords, recv_n, m_dim);
+
+    // evaluate the points received from all processes, and send the values back in the same order
+
+    std::vector<Real> recv_values;
+    evaluate(source, recv_coords, recv_values);
+
+    std::vector<Real> send_values;
+    std::vector<int> values_n(nb_procs, -1);
+    Comm::PE::instance().all_to_all(recv_values, recv_n, send_values, values_n, stride);
+
+    // take the values of the first process that found the point
+
+    Uint idx = 0;
+    for (Uint proc=0; proc<nb_procs; ++proc)
+    {
+      boost_foreach(const Uint p, sent_points[proc])
+      {
+        const Real* values = &send_values[stride*idx++];
+        if (values[0] != 0. && results[stride*p] == 0.)
+          std::copy(values, values+stride, results.begin()+stride*p);
+      }
+    }
+  }
+
+  Uint nb_not_found = 0;
+  for (Uint p=0; p<nb_points; ++p)
+  {
+    if (results[stride*p] == 0.)
+    {
+      ++nb_not_found;
+      continue;
+    }
+    for (Uint j=0; j<row_size; ++j)
+      target[rows[p]][j] = results[stride*p+1+j];
+  }
+
+  if (nb_not_found)
+    CFwarn << nb_not_found << " of " << nb_points << " points of " << target.uri().string()
+           << " are outside the source mesh and are not interpolated" << CFendl;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void CDistributedInterpolator::gather_target_points(const Field& target, std::vector<Real>& points, std::vector<Uint>& rows) const
+{
+  points.clear();
+  rows.clear();
+
+  const Field& coordinates = target.coordinates();
+  if (target.basis() == FieldGroup::Basis::POINT_BASED)
+  {
+    if (coordinates.row_size() != m_dim)
+      throw BadValue(FromHere(), "Target mesh of dimension " + to_str(coordinates.row_size()) + " and source mesh of dimension " + to_str(m_dim));
+    rows.reserve(target.size());
+    points.reserve(m_dim*target.size());
+    for (Uint row=0; row<target.size(); ++row)
+    {
+      rows.push_back(row);
+      for (Uint d=0; d<m_dim; ++d)
+        points.push_back(coordinates[row][d]);
+    }
+  }
+  else
+  {
+    // the points of the space of every element, which for P0 is the centroid
+    RealMatrix elem_coordinates;
+    boost_foreach(const CElements& elements, find_components_recursively<CElements>(target.topology()))
+    {
+      const CSpace& space = target.space(elements);
+      space.allocate_coordinates(elem_coordinates);
+      if (elem_coordinates.cols() != m_dim)
+        throw BadValue(FromHere(), "Target mesh of dimension " + to_str((Uint)elem_coordinates.cols()) + " and source mesh of dimension " + to_str(m_dim));
+      for (Uint elem_idx=0; elem_idx<elements.size(); ++elem_idx)
+      {
+        CConnectivity::ConstRow field_indexes = target.indexes_for_element(elements,elem_idx);
+        space.put_coordinates(elem_coordinates,elem_idx);
+        for (Uint i=0; i<field_indexes.size(); ++i)
+        {
+          rows.push_back(field_indexes[i]);
+          for (Uint d=0; d<m_dim; ++d)
+            points.push_back(elem_coordinates(i,d));
+        }
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void CDistributedInterpolator::evaluate(const Field& source, const std::vector<Real>& points, std::vector<Real>& values) const
+{
+  const Uint nb_points = points.size()/m_dim;
+  const Uint row_size = source.row_size();
+  const Uint stride = row_size+1;
+  values.assign(stride*nb_points, 0.);
+
+  RealMatrix coordinates(nb_points, m_dim);
+  for (Uint p=0; p<nb_points; ++p)
+    for (Uint d=0; d<m_dim; ++d)
+      coordinates(p,d) = points[m_dim*p+d];
+
+  std::vector<Uint> unified_elems;
+  m_tree->find_unified_elements(coordinates, unified_elems);
+
+  RealVector coord(m_dim);
+  RealVector mapped_coord;
+  RealMatrix nodes;
+  RealRowVector sf_values;
+  Component::ConstPtr component;
+  Uint elem_idx;
+  for (Uint p=0; p<nb_points; ++p)
+  {
+    if (unified_elems[p] == CBoundingBoxTree::not_found())
+      continue;
+
+    boost::tie(component,elem_idx) = m_tree->unified_elements().location(unified_elems[p]);
+    const CElements& elements = component->as_type<CElements>();
+    const ElementType& etype = elements.element_type();
+
+    coord = coordinates.row(p);
+    elements.allocate_coordinates(nodes);
+    elements.put_coordinates(nodes,elem_idx);
+    if (!compute_mapped_coordinates(etype, nodes, coord, mapped_coord))
+      continue;
+
+    // the values of the source field follow from the shape function of its own space
+    source.space(elements).shape_function().put_value(mapped_coord, sf_values);
+    CConnectivity::ConstRow field_indexes = source.indexes_for_element(elements,elem_idx);
+    cf_assert(sf_values.size() == static_cast<int>(field_indexes.size()));
+
+    Real* result = &values[stride*p];
+    result[0] = 1.;
+    for (Uint n=0; n<field_indexes.size(); ++n)
+    {
+      Field::ConstRow source_row = source[field_indexes[n]];
+      for (Uint j=0; j<row_size; ++j)
+        result[1+j] += sf_values[n]*source_row[j];
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+bool CDistributedInterpolator::compute_mapped_coordinates(const ElementType& etype, const RealMatrix& nodes, const RealVector& coord, RealVector& mapped_coord) const
+{
+  const Uint dimensionality = etype.dimensionality();
+  if (dimensionality != m_dim)
+    return false;
+
+  const ShapeFunction& sf = etype.shape_function();
+  RealRowVector sf_values;
+  RealMatrix sf_gradient;
+  RealVector residual(m_dim);
+
+  const Real tolerance = 1e-12 * std::max(1., (nodes.colwise().maxCoeff() - nodes.colwise().minCoeff()).maxCoeff());
+
+  // Newton iterations on x(mapped_coord) = coord, exact in one step for linear elements
+  mapped_coord.setZero(dimensionality);
+  for (Uint iter=0; iter<20; ++iter)
+  {
+    sf.put_value(mapped_coord, sf_values);
+    residual = coord - (sf_values * nodes).transpose();
+    if (residual.norm() <= tolerance)
+      return true;
+
+    sf.put_gradient(mapped_coord, sf_gradient);
+    const RealMatrix jacobian = sf_gradient * nodes;
+    mapped_coord += jacobian.transpose().fullPivLu().solve(residual);
+  }
+  sf.put_value(mapped_coord, sf_values);
+  residual = coord - (sf_values * nodes).transpose();
+  return residual.norm() <= 1e3*tolerance;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Mesh
+} // CF
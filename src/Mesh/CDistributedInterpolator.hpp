@@ -0,0 +1,89 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Mesh_CDistributedInterpolator_hpp
+#define CF_Mesh_CDistributedInterpolator_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Mesh/CInterpolator.hpp"
+#include "Mesh/CElements.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+
+  class CBoundingBoxTree;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Interpolation between meshes that are partitioned independently.
+/// Every point of the target field is sent to the processes whose part of the source mesh
+/// has a bounding box containing it. These locate the point in their elements, evaluate the
+/// source field with the shape functions of its space in that element, and send the values back,
+/// so that the whole interpolation takes a single exchange of points and values.
+/// Target points that are not inside any source element keep their values.
+/// Without parallel environment, the same is done on the local meshes only.
+class Mesh_API CDistributedInterpolator : public CInterpolator
+{
+public: // typedefs
+
+  typedef boost::shared_ptr<CDistributedInterpolator> Ptr;
+  typedef boost::shared_ptr<CDistributedInterpolator const> ConstPtr;
+
+public: // functions
+  /// constructor
+  CDistributedInterpolator( const std::string& name );
+
+  /// Gets the Class name
+  static std::string type_name() { return "CDistributedInterpolator"; }
+
+  /// Build the search tree of the local source elements, and gather the bounding boxes of all parts of the source mesh
+  /// @param source [in] the mesh from which interpolation will occur
+  virtual void construct_internal_storage(const CMesh& source);
+
+  /// Interpolate from one source field to target field
+  /// @param source [in] the source field
+  /// @param target [out] the target field
+  virtual void interpolate_field_from_to(const Field& source, Field& target);
+
+private: // functions
+
+  /// Gather the target points, and the rows of the target field they correspond to
+  void gather_target_points(const Field& target, std::vector<Real>& points, std::vector<Uint>& rows) const;
+
+  /// Evaluate the source field in given points, for the ones that are inside a local source element
+  /// @param points [in]  dim coordinates per point
+  /// @param values [out] for every point a flag (1 if found, 0 if not) followed by the row of interpolated values
+  void evaluate(const Field& source, const std::vector<Real>& points, std::vector<Real>& values) const;
+
+  /// Compute the mapped coordinates of a point in an element, by Newton iterations on the geometric shape function
+  /// @return false if the iterations did not converge
+  bool compute_mapped_coordinates(const ElementType& etype, const RealMatrix& nodes, const RealVector& coord, RealVector& mapped_coord) const;
+
+private: // data
+
+  boost::shared_ptr<CMesh const> m_source_mesh;
+
+  Uint m_dim;
+
+  /// Point location in the local source elements
+  boost::shared_ptr<CBoundingBoxTree> m_tree;
+
+  /// Bounding box of the source mesh on every process, as dim minima followed by dim maxima
+  std::vector<Real> m_partition_boxes;
+
+}; // end CDistributedInterpolator
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Mesh
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Mesh_CDistributedInterpolator_hpp
@@ -29,10 +29,16 @@ Common::ComponentBuilder < CDynTable<std::string>, Component, LibMesh > CDynTabl
 
 std::ostream& operator<<(std::ostream& os, CDynTable<bool>::ConstRow row)
 {
-  print_vector(os, row);
+  // print the values as bool, not as characters
+  print_vector(os, std::vector<bool>(row.begin(),row.end()));
   return os;
 }
 
+std::ostream& operator<<(std::ostream& os, CDynTable<bool>::Row row)
+{
+  return os << CDynTable<bool>::ConstRow(row.begin(),row.end());
+}
+
 std::ostream& operator<<(std::ostream& os, CDynTable<Uint>::ConstRow row)
 {
   print_vector(os, row);
@@ -63,9 +69,9 @@ std::ostream& operator<<(std::ostream& os, const CDynTable<bool>& table)
 {
 	if (table.size())
 		os << "\n";
-  Uint i=0;
-  boost_foreach(CDynTable<bool>::ConstRow row, table.array())
+  for (Uint i=0; i<table.size(); ++i)
 	{
+    CDynTable<bool>::ConstRow row = table[i];
 		os << "  " << i << ":  ";
 		if (row.size() == 0)
 			os << "~";
@@ -75,7 +81,6 @@ std::ostream& operator<<(std::ostream& os, const CDynTable<bool>& table)
 			os << entry << " ";
 		}
 		os << "\n";
-    ++i;
 	}
 	return os;
 }
@@ -84,9 +89,9 @@ std::ostream& operator<<(std::ostream& os, const CDynTable<Uint>& table)
 {
 	if (table.size())
 		os << "\n";
-  Uint i=0;
-  boost_foreach(CDynTable<Uint>::ConstRow row, table.array())
+  for (Uint i=0; i<table.size(); ++i)
   {
+    CDynTable<Uint>::ConstRow row = table[i];
 		os << "  " << i << ":  ";
 		if (row.size() == 0)
 			os << "~";
@@ -96,7 +101,6 @@ std::ostream& operator<<(std::ostream& os, const CDynTable<Uint>& table)
 				os << entry << " ";
 		}
 		os << "\n";
-    ++i;
 	}
 	return os;
 }
@@ -105,9 +109,9 @@ std::ostream& operator<<(std::ostream& os, const CDynTable<int>& table)
 {
 	if (table.size())
 		os << "\n";
-  Uint i=0;
-  boost_foreach(CDynTable<int>::ConstRow row, table.array())
+  for (Uint i=0; i<table.size(); ++i)
   {
+    CDynTable<int>::ConstRow row = table[i];
 		os << "  " << i << ":  ";
 		if (row.size() == 0)
 			os << "~";
@@ -117,7 +121,6 @@ std::ostream& operator<<(std::ostream& os, const CDynTable<int>& table)
 				os << entry << " ";
 		}
 		os << "\n";
-    ++i;
 	}
 	return os;
 }
@@ -126,9 +129,9 @@ std::ostream& operator<<(std::ostream& os, const CDynTable<Real>& table)
 {
 	if (table.size())
 		os << "\n";
-  Uint i=0;
-  boost_foreach(CDynTable<Real>::ConstRow row, table.array())
+  for (Uint i=0; i<table.size(); ++i)
   {
+    CDynTable<Real>::ConstRow row = table[i];
 		os << "  " << i << ":  ";
 		if (row.size() == 0)
 			os << "~";
@@ -138,7 +141,6 @@ std::ostream& operator<<(std::ostream& os, const CDynTable<Real>& table)
 				os << entry << " ";
 		}
 		os << "\n";
-    ++i;
 	}
 	return os;
 }
@@ -147,9 +149,9 @@ std::ostream& operator<<(std::ostream& os, const CDynTable<std::string>& table)
 {
 	if (table.size())
 		os << "\n";
-  Uint i=0;
-  boost_foreach(CDynTable<std::string>::ConstRow row, table.array())
+  for (Uint i=0; i<table.size(); ++i)
   {
+    CDynTable<std::string>::ConstRow row = table[i];
 		os << "  " << i << ":  ";
 		if (row.size() == 0)
 			os << "~";
@@ -159,7 +161,6 @@ std::ostream& operator<<(std::ostream& os, const CDynTable<std::string>& table)
 				os << entry << " ";
 		}
 		os << "\n";
-    ++i;
 	}
 	return os;
 }
@@ -10,6 +10,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <deque>
+#include <map>
+
+#include <boost/range/iterator_range.hpp>
+
 #include "Common/Component.hpp"
 #include "Common/StringConversion.hpp"
 #include "Common/Foreach.hpp"
@@ -25,7 +29,21 @@ namespace Mesh {
 template <typename T>
 class DynArrayBufferT;
 
+/// Type in which a CDynTable<T> stores its values.
+/// bool is stored as unsigned char, because std::vector<bool> packs its values in bits
+/// and its iterators return proxies, so rows could not hand out references to the values.
+template <typename T> struct DynTableValue { typedef T type; };
+template <> struct DynTableValue<bool> { typedef unsigned char type; };
+
 /// Component holding a connectivity table with variable row-size per row
+/// The table is stored in compressed sparse row (CSR) format: one array holding the
+/// values of all rows contiguously, and one array of size()+1 offsets where
+/// the rows start. Rows are accessed as views (ranges) into the values array.
+/// @note Changing the size of a single row shifts all following rows.
+///       Tables are best filled by counts-then-fill, using allocate() with the
+///       size of every row, or through a Buffer which compacts all changes at once.
+/// @note A row view is invalidated when the table is resized.
+/// @note A CDynTable<bool> stores its values as unsigned char, see DynTableValue.
 /// @author Willem Deconinck
 template<typename T>
 class Mesh_API CDynTable : public Common::Component {
@@ -34,88 +52,126 @@ public:
   typedef boost::shared_ptr<CDynTable> Ptr;
   typedef boost::shared_ptr<CDynTable const> ConstPtr;
 
-  typedef std::vector< std::vector<T> > ArrayT;
+  typedef typename DynTableValue<T>::type ValueT;
+  typedef std::vector<ValueT> ValuesT;
+  typedef std::vector<Uint> OffsetsT;
   typedef DynArrayBufferT<T> Buffer;
-  typedef std::vector<T>& Row;
-  typedef const std::vector<T>& ConstRow;
+  typedef boost::iterator_range<typename ValuesT::iterator> Row;
+  typedef boost::iterator_range<typename ValuesT::const_iterator> ConstRow;
 
   /// Contructor
   /// @param name of the component
-  CDynTable ( const std::string& name ) : Component(name) { }
+  CDynTable ( const std::string& name ) : Component(name), m_offsets(1,0u) { }
 
   ~CDynTable () {}
 
   /// Get the class name
   static std::string type_name () { return "CDynTable<"+Common::class_name<T>()+">"; }
 
-  Uint size() const { return m_array.size(); }
+  Uint size() const { return m_offsets.size()-1; }
 
+  /// Resize the number of rows. New rows are empty.
   void resize(const Uint new_size)
   {
-    Uint difference = new_size - size();
-    if (difference > 0)
+    if (new_size < size())
     {
-      for (Uint i=0; i<difference; ++i)
-        m_array.push_back(std::vector<T>());
+      m_values.resize(m_offsets[new_size]);
+      m_offsets.resize(new_size+1);
     }
     else
     {
-      difference = -difference;
-      for (Uint i=0; i<difference; ++i)
-        m_array.pop_back();
+      m_offsets.resize(new_size+1,m_offsets.back());
     }
   }
 
-  Uint row_size(const Uint i) const {return m_array[i].size();}
+  /// Allocate the table for given row sizes, discarding the current content.
+  /// The rows can then be filled through operator[].
+  /// @param [in] row_sizes  the size of every row
+  template<typename VectorT>
+  void allocate(const VectorT& row_sizes)
+  {
+    OffsetsT offsets(row_sizes.size()+1);
+    offsets[0] = 0;
+    for (Uint i=0; i<row_sizes.size(); ++i)
+      offsets[i+1] = offsets[i] + row_sizes[i];
+    m_offsets.swap(offsets);
+    ValuesT(m_offsets.back()).swap(m_values);
+  }
 
-  void set_row_size(const Uint i, const Uint s) { m_array[i].resize(s); }
+  Uint row_size(const Uint i) const { return m_offsets[i+1]-m_offsets[i]; }
+
+  /// Change the size of one row
+  /// @note This shifts all following rows, prefer allocate() to build a table.
+  void set_row_size(const Uint i, const Uint s)
+  {
+    const Uint old_size = row_size(i);
+    if (s > old_size)
+      m_values.insert(m_values.begin()+m_offsets[i+1],s-old_size,ValueT());
+    else if (s < old_size)
+      m_values.erase(m_values.begin()+m_offsets[i]+s,m_values.begin()+m_offsets[i+1]);
+    else
+      return;
+    for (Uint j=i+1; j<m_offsets.size(); ++j)
+      m_offsets[j] = m_offsets[j] + s - old_size;
+  }
 
   Buffer create_buffer(const size_t buffersize=16384)
   {
-    return Buffer(m_array,buffersize);
+    return Buffer(*this,buffersize);
   }
 
   boost::shared_ptr<Buffer> create_buffer_ptr(const size_t buffersize=16384)
   {
-    return boost::shared_ptr<Buffer> ( new Buffer (m_array,buffersize) );
+    return boost::shared_ptr<Buffer> ( new Buffer (*this,buffersize) );
   }
 
   template<typename VectorT>
   void set_row(const Uint array_idx, const VectorT& row)
   {
     if (row.size() != row_size(array_idx))
-      m_array[array_idx].resize(row.size());
+      set_row_size(array_idx,row.size());
 
-    Uint j=0;
+    typename ValuesT::iterator it = m_values.begin()+m_offsets[array_idx];
     boost_foreach( const typename VectorT::value_type& v, row)
-      m_array[array_idx][j++] = v;
+      *it++ = v;
   }
 
   Row operator[] (const Uint idx)
   {
-    return Row(m_array[idx]);
+    return Row(m_values.begin()+m_offsets[idx],m_values.begin()+m_offsets[idx+1]);
   }
 
   ConstRow operator[] (const Uint idx) const
   {
-    return ConstRow(m_array[idx]);
+    return ConstRow(m_values.begin()+m_offsets[idx],m_values.begin()+m_offsets[idx+1]);
   }
 
-  /// @return A reference to the array data
-  ArrayT& array() { return m_array; }
+  /// @return A reference to the values of all rows, stored contiguously
+  ValuesT& values() { return m_values; }
+
+  /// @return A const reference to the values of all rows, stored contiguously
+  const ValuesT& values() const { return m_values; }
 
-  /// @return A const reference to the array data
-  const ArrayT& array() const { return m_array; }
+  /// @return A const reference to the offsets of the rows in values(), of size size()+1
+  const OffsetsT& offsets() const { return m_offsets; }
 
 private: // data
 
-  ArrayT m_array;
+  friend class DynArrayBufferT<T>;
+
+  /// values of all rows
+  ValuesT m_values;
+
+  /// start of every row in m_values, the last entry is the total number of values
+  OffsetsT m_offsets;
 
 };
 
 //////////////////////////////////////////////////////////////////////////////
 
 std::ostream& operator<<(std::ostream& os, CDynTable<bool>::ConstRow row);
+/// also for mutable rows, which would otherwise print their values as characters
+std::ostream& operator<<(std::ostream& os, CDynTable<bool>::Row row);
 std::ostream& operator<<(std::ostream& os, CDynTable<Uint>::ConstRow row);
 std::ostream& operator<<(std::ostream& os, CDynTable<int>::ConstRow row);
 std::ostream& operator<<(std::ostream& os, CDynTable<Real>::ConstRow row);
@@ -129,15 +185,17 @@ std::ostream& operator<<(std::ostream& os, const CDynTable<std::string>& table);
 
 ////////////////////////////////////////////////////////////////////////////////
 
-
+/// Buffer to add, change and remove rows of a CDynTable.
+/// Added rows are kept in separate buffers, and all changes are applied
+/// to the table at once on flush(), rebuilding the compressed storage in a single pass.
 template <typename T>
 class DynArrayBufferT
 {
 public:
   typedef boost::shared_ptr<DynArrayBufferT> Ptr;
-  typedef std::vector< std::vector<T> > Array_t;
-  typedef std::vector<T>& Row;
-  typedef const std::vector<T>& ConstRow;
+  typedef CDynTable<T> Table_t;
+  typedef typename Table_t::ValuesT ValuesT;
+  typedef typename Table_t::Row Row;
 
 private:
 
@@ -145,7 +203,7 @@ private:
   {
     Buffer() {}
     Buffer(const Uint size) { resize(size); }
-    Array_t rows;
+    std::vector<ValuesT> rows;
     std::vector<bool> is_not_empty;
     void resize(const Uint size)
     {
@@ -160,10 +218,20 @@ private:
     Uint size() const { return rows.size(); }
   };
 
+  /// Location of a row in the table, in a buffer, or in the changed rows
+  struct Source
+  {
+    Source(const ValuesT* v, const Uint r) : vector(v), row(r) {}
+    /// vector holding the row, or null if the row is a table row
+    const ValuesT* vector;
+    /// row in the table
+    Uint row;
+  };
+
 public:
 
-  DynArrayBufferT(Array_t& array, const size_t nb_rows) :
-    m_array(array),
+  DynArrayBufferT(Table_t& table, const size_t nb_rows) :
+    m_table(table),
     m_buffersize(nb_rows)
   {}
 
@@ -176,13 +244,7 @@ public:
   {
     m_buffers.resize(0);
     m_new_buffer_rows.clear();
-//    Uint idx = m_array.size();
-//    BOOST_FOREACH(Buffer& buffer, m_buffers)
-//    {
-//       buffer.reset();
-//       m_new_buffer_rows.push_back(idx++);
-//    }
-
+    m_changed_array_rows.clear();
     m_empty_array_rows.clear();
     m_empty_buffer_rows.clear();
   }
@@ -191,24 +253,25 @@ public:
   {
     using namespace Common;
     std::string str;
-    for (Uint i=0; i<m_array.size(); ++i)
+    for (Uint i=0; i<m_table.size(); ++i)
     {
       str += "    " + to_str(i) + ":    ";
+      Row row = get_row(i);
       if (is_array_row_empty(i))
       {
         str += "X   ( ";
-        for (Uint j=0; j<m_array[i].size(); ++j)
-          str += to_str(m_array[i][j]) + " ";
+        for (Uint j=0; j<row.size(); ++j)
+          str += to_str(row[j]) + " ";
         str += ")\n";
       }
       else
       {
-        for (Uint j=0; j<m_array[i].size(); ++j)
-          str += to_str(m_array[i][j]) + " ";
+        for (Uint j=0; j<row.size(); ++j)
+          str += to_str(row[j]) + " ";
         str += "\n";
       }
     }
-    Uint s=m_array.size();
+    Uint s=m_table.size();
     for (Uint b=0; b<m_buffers.size(); ++b)
     {
       str += "    ----buffer["+to_str(b)+"]----\n";
@@ -253,12 +316,23 @@ public:
   template<typename vectorType>
   void set_row(const Uint array_idx, const vectorType& row)
   {
-    Uint cummulative_size = m_array.size();
+    Uint cummulative_size = m_table.size();
     if (array_idx < cummulative_size)
     {
-      for (Uint i=0; i<row.size(); ++i)
-        m_array[array_idx][i] = row[i];
-      m_empty_array_rows.erase(std::find(m_empty_array_rows.begin(),m_empty_array_rows.end(),array_idx));
+      // rows of different size are only applied on flush
+      if (row.size() == m_table.row_size(array_idx) && !m_changed_array_rows.count(array_idx))
+      {
+        Row array_row = m_table[array_idx];
+        for (Uint i=0; i<row.size(); ++i)
+          array_row[i] = row[i];
+      }
+      else
+      {
+        m_changed_array_rows[array_idx].assign(row.begin(),row.end());
+      }
+      std::deque<Uint>::iterator empty = std::find(m_empty_array_rows.begin(),m_empty_array_rows.end(),array_idx);
+      if (empty != m_empty_array_rows.end())
+        m_empty_array_rows.erase(empty);
       return;
     }
     else
@@ -282,7 +356,7 @@ public:
 
  void rm_row(const Uint array_idx)
   {
-   Uint cummulative_size = m_array.size();
+   Uint cummulative_size = m_table.size();
    if (array_idx < cummulative_size)
    {
      m_empty_array_rows.push_back(array_idx);
@@ -307,126 +381,147 @@ public:
 
   Row get_row(const Uint idx)
   {
-    Uint cummulative_size = m_array.size();
+    Uint cummulative_size = m_table.size();
     if (idx < cummulative_size)
     {
-      return m_array[idx];
+      typename std::map<Uint, ValuesT>::iterator changed = m_changed_array_rows.find(idx);
+      if (changed != m_changed_array_rows.end())
+        return Row(changed->second.begin(),changed->second.end());
+      return m_table[idx];
     }
     else
     {
       BOOST_FOREACH(Buffer& buffer, m_buffers)
       {
         if (idx<cummulative_size+buffer.size())
-          return buffer.rows[idx-cummulative_size];
+          return Row(buffer.rows[idx-cummulative_size].begin(),buffer.rows[idx-cummulative_size].end());
         cummulative_size += buffer.size();
       }
     }
     throw Common::BadValue(FromHere(),"Trying to access index that is not allocated: ["+Common::to_str(idx)+">="+Common::to_str(cummulative_size)+"]");
-    return m_array[0];
+    return m_table[0];
   }
 
 
   void flush()
   {
+    const Uint old_array_size = m_table.size();
 
-    // get total number of allocated rows
-    Uint allocated_size = total_allocated();
-    Uint old_array_size = m_array.size();
-
-    // get total number of empty rows
-    Uint nb_emptyRows = m_empty_array_rows.size() + m_empty_buffer_rows.size() + m_new_buffer_rows.size();
-    Uint new_size = allocated_size-nb_emptyRows;
-
-    if (new_size > old_array_size)
+    // only rows appended: extend the table in place
+    if (m_empty_array_rows.empty() && m_changed_array_rows.empty())
     {
-      // make m_array bigger
-      m_array.resize(new_size);
-
-      // copy each buffer into the array
-      Uint array_idx=old_array_size;
-      BOOST_FOREACH (Buffer& buffer, m_buffers)
+      Uint nb_values = m_table.m_values.size();
+      Uint nb_rows = old_array_size;
+      BOOST_FOREACH (const Buffer& buffer, m_buffers)
       {
         for (Uint row_idx=0; row_idx<buffer.size(); ++row_idx)
         {
-          Row row = buffer.rows[row_idx];
-          if (buffer.is_not_empty[row_idx])   // for each non-empty row from all buffers
+          if (buffer.is_not_empty[row_idx])
           {
-            // first find empty rows inside the old part array
-            if (!m_empty_array_rows.empty())
-            {
-              Row empty_array_row = get_row(m_empty_array_rows.front());
-              m_empty_array_rows.pop_front();
-              empty_array_row = row;
-            }
-            else // then select the new array rows to be filled
+            nb_values += buffer.rows[row_idx].size();
+            ++nb_rows;
+          }
+        }
+      }
+      if (nb_rows != old_array_size)
+      {
+        m_table.m_values.reserve(nb_values);
+        m_table.m_offsets.reserve(nb_rows+1);
+        BOOST_FOREACH (const Buffer& buffer, m_buffers)
+        {
+          for (Uint row_idx=0; row_idx<buffer.size(); ++row_idx)
+          {
+            if (buffer.is_not_empty[row_idx])
             {
-              cf_assert(array_idx < m_array.size());
-              Row empty_array_row=m_array[array_idx++];
-              empty_array_row = row;
+              m_table.m_values.insert(m_table.m_values.end(),buffer.rows[row_idx].begin(),buffer.rows[row_idx].end());
+              m_table.m_offsets.push_back(m_table.m_values.size());
             }
           }
         }
       }
+      reset();
+      return;
     }
-    else // More rows to be removed than added, now we need to swap rows
+
+    // Every row of the new table points to its source
+    std::vector<Source> rows;
+    rows.reserve(total_allocated());
+    for (Uint i=0; i<old_array_size; ++i)
     {
-      // copy all buffer rows in the m_array
-      BOOST_FOREACH (Buffer& buffer, m_buffers)
+      typename std::map<Uint, ValuesT>::const_iterator changed = m_changed_array_rows.find(i);
+      rows.push_back( Source( changed == m_changed_array_rows.end() ? NULL : &changed->second , i ) );
+    }
+
+    // first fill the removed rows with the buffer rows, then append them
+    BOOST_FOREACH (const Buffer& buffer, m_buffers)
+    {
+      for (Uint row_idx=0; row_idx<buffer.size(); ++row_idx)
       {
-        for (Uint row_idx=0; row_idx<buffer.size(); ++row_idx)
+        if (buffer.is_not_empty[row_idx])   // for each non-empty row from all buffers
         {
-          Row row = buffer.rows[row_idx];
-          if (buffer.is_not_empty[row_idx])   // for each non-empty row from all buffers
+          if (!m_empty_array_rows.empty())
           {
-            Uint empty_array_row_idx = m_empty_array_rows.front();
+            rows[m_empty_array_rows.front()] = Source(&buffer.rows[row_idx],0);
             m_empty_array_rows.pop_front();
-            Row empty_array_row = get_row(empty_array_row_idx);
-            empty_array_row = row;
+          }
+          else
+          {
+            rows.push_back(Source(&buffer.rows[row_idx],0));
           }
         }
       }
-      Uint full_row_idx = new_size;
-      // The part of the table with rows > new_size will be deallocated
-      // The empty rows from the allocated part must be swapped with filled
-      // rows from the part that will be deallocated
-      Uint nb_empty_rows = m_empty_array_rows.size();
-      for (Uint e=0; e<nb_empty_rows; ++e)
+    }
+
+    // More rows removed than added:
+    // The part of the table with rows > new_size will be deallocated
+    // The empty rows from the allocated part must be swapped with filled
+    // rows from the part that will be deallocated
+    const Uint new_size = rows.size()-m_empty_array_rows.size();
+    Uint full_row_idx = new_size;
+    for (Uint e=0; e<m_empty_array_rows.size(); ++e)
+    {
+      Uint empty_row_idx = m_empty_array_rows[e];
+      if (empty_row_idx < new_size)
       {
-        Uint empty_row_idx = m_empty_array_rows[e];
-        // swap only necessary if the empty row is in the allocated part
-        if (empty_row_idx < new_size)
+        cf_assert(full_row_idx<rows.size());
+        while(is_array_row_empty(full_row_idx))
         {
-          // swap this empty row with a full one in the part that will be deallocated
-
-          // 1) find next full row
-          cf_assert(full_row_idx<m_array.size());
-          while(is_array_row_empty(full_row_idx))
-          {
-            full_row_idx++;
-            cf_assert(full_row_idx<m_array.size());
-          }
-
-          // 2) swap them
-          cf_assert(empty_row_idx<m_array.size());
-          m_array[empty_row_idx] = m_array[full_row_idx];
           full_row_idx++;
+          cf_assert(full_row_idx<rows.size());
         }
+        rows[empty_row_idx] = rows[full_row_idx++];
       }
+    }
+    rows.erase(rows.begin()+new_size,rows.end());
+
+    // build the compressed storage in one pass
+    typename Table_t::OffsetsT offsets(new_size+1);
+    offsets[0] = 0;
+    for (Uint i=0; i<new_size; ++i)
+      offsets[i+1] = offsets[i] + ( rows[i].vector ? rows[i].vector->size() : m_table.row_size(rows[i].row) );
 
-      // make m_array smaller
-      m_array.resize(new_size);
+    typename Table_t::ValuesT values;
+    values.reserve(offsets.back());
+    for (Uint i=0; i<new_size; ++i)
+    {
+      if (rows[i].vector)
+        values.insert(values.end(),rows[i].vector->begin(),rows[i].vector->end());
+      else
+        values.insert(values.end(),m_table.m_values.begin()+m_table.m_offsets[rows[i].row],m_table.m_values.begin()+m_table.m_offsets[rows[i].row+1]);
     }
 
+    m_table.m_offsets.swap(offsets);
+    m_table.m_values.swap(values);
+
     // clear all buffers
     reset();
-
   }
 
-  Array_t& get_appointed() { return m_array; }
+  Table_t& get_appointed() { return m_table; }
 
   Uint total_allocated()
   {
-    Uint allocated=m_array.size();
+    Uint allocated=m_table.size();
     BOOST_FOREACH(const Buffer& buffer, m_buffers)
       allocated += buffer.size();
     return allocated;
@@ -450,25 +545,22 @@ private:
 
 private:
 
-  /// reference to the object the buffer works on
-  Array_t& m_array;
+  /// reference to the table the buffer works on
+  Table_t& m_table;
 
   /// The size newly created buffers will have
   /// @note it is safe to change in the middle of buffer operations
   Uint m_buffersize;
 
-  /// buffer storage;
-  std::deque< std::vector<T> > m_buffer;
-
   /// vector of temporary buffers
   std::vector<Buffer> m_buffers;
 
+  /// table rows set with a different size, applied on flush
+  std::map<Uint, ValuesT> m_changed_array_rows;
+
   /// storage of removed array rows
   std::deque<Uint> m_empty_array_rows;
 
-  /// storage of array rows where rows can be added directly using add_row_directly
-  std::deque<Uint> m_new_array_rows;
-
   /// storage of removed buffer rows
   std::deque<Uint> m_empty_buffer_rows;
 
@@ -83,17 +83,8 @@ const CConnectivity& CElements::node_connectivity() const
 
 RealMatrix CElements::get_coordinates(const Uint elem_idx) const
 {
-  const CTable<Real>& coords_table = geometry().coordinates();
-  CConnectivity::ConstRow elem_nodes = node_connectivity()[elem_idx];
-
-  const Uint nb_nodes=elem_nodes.size();
-  const Uint dim=coords_table.row_size();
-  RealMatrix elem_coords(nb_nodes,dim);
-
-  for(Uint node = 0; node != nb_nodes; ++node)
-    for (Uint d=0; d<dim; ++d)
-      elem_coords(node,d) = coords_table[elem_nodes[node]][d];
-
+  RealMatrix elem_coords(node_connectivity().row_size(),coordinates_table().row_size());
+  put_coordinates(elem_coords,elem_idx);
   return elem_coords;
 }
 
@@ -101,16 +92,28 @@ RealMatrix CElements::get_coordinates(const Uint elem_idx) const
 
 void CElements::put_coordinates(RealMatrix& elem_coords, const Uint elem_idx) const
 {
-  const CTable<Real>& coords_table = geometry().coordinates();
+  const CTable<Real>& coords_table = coordinates_table();
   CConnectivity::ConstRow elem_nodes = node_connectivity()[elem_idx];
 
   const Uint nb_nodes=elem_coords.rows();
   const Uint dim=elem_coords.cols();
 
+  cf_assert(nb_nodes == elem_nodes.size());
+  cf_assert(dim <= coords_table.row_size());
 
   for(Uint node = 0; node != nb_nodes; ++node)
+  {
+    const CTable<Real>::ConstRow node_coords = coords_table[elem_nodes[node]];
     for (Uint d=0; d<dim; ++d)
-      elem_coords(node,d) = coords_table[elem_nodes[node]][d];
+      elem_coords(node,d) = node_coords[d];
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const CTable<Real>& CElements::coordinates_table() const
+{
+  return geometry().coordinates();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
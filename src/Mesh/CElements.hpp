@@ -13,6 +13,7 @@
 #include "Mesh/CEntities.hpp"
 #include "Mesh/ElementType.hpp"
 #include "Mesh/CConnectivity.hpp"
+#include "Mesh/ElementData.hpp"
 
 namespace CF {
   namespace Common
@@ -69,6 +70,18 @@ public: // functions
 
   virtual void put_coordinates(RealMatrix& coordinates, const Uint elem_idx) const;
 
+  /// Fill a fixed size matrix (nb_nodes x dimension) with the coordinates of the element nodes.
+  /// Unlike the RealMatrix version, this does no virtual call nor dynamic allocation,
+  /// and is meant for loops where the element type is known at compile time.
+  template <int NbNodes, int Dim>
+  void put_coordinates(Eigen::Matrix<Real,NbNodes,Dim>& coordinates, const Uint elem_idx) const
+  {
+    fill(coordinates, coordinates_table(), node_connectivity()[elem_idx]);
+  }
+
+  /// Coordinates of all the nodes of the geometry
+  const CTable<Real>& coordinates_table() const;
+
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -8,6 +8,8 @@
 
 #include <boost/assign/list_of.hpp>
 #include "Common/CLink.hpp"
+#include "Common/Core.hpp"
+#include "Common/EventHandler.hpp"
 
 #include "Common/FindComponents.hpp"
 #include "Common/StringConversion.hpp"
@@ -68,6 +70,8 @@ CEntities::CEntities ( const std::string& name ) :
   m_rank = create_static_component_ptr< CList<Uint> >("rank");
   m_rank->add_tag("rank");
 
+  Core::instance().event_handler().connect_to_event("mesh_changed", this, &CEntities::on_mesh_changed_event);
+
   regist_signal ( "create_space" )
       ->connect ( boost::bind ( &CEntities::signal_create_space, this, _1 ) )
       ->description( "Create space for other interpretations of fields (e.g. high order)" )
@@ -84,6 +88,38 @@ CEntities::~CEntities()
 
 //////////////////////////////////////////////////////////////////////////////
 
+void CEntities::on_mesh_changed_event( SignalArgs& args )
+{
+  Common::XML::SignalOptions options( args );
+
+  const std::string mesh_path = options.value<URI>("mesh_uri").string() + "/";
+  if ( uri().string().compare(0,mesh_path.size(),mesh_path) != 0 )
+    return;
+
+  remove_derived_lists();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CEntities::remove_derived_lists()
+{
+  const char* derived_tags[] = { Mesh::Tags::interior_first(), Mesh::Tags::coloured_elements() };
+  for (Uint i=0; i<2; ++i)
+  {
+    CList<Uint>::Ptr list = find_component_ptr_with_tag<CList<Uint> >(*this,derived_tags[i]);
+    if ( is_not_null(list) )
+      remove_component(*list);
+  }
+
+  std::vector<std::string> caches;
+  boost_foreach(const CTable<Real>& cache, find_components_with_tag<CTable<Real> >(*this,Mesh::Tags::geometry_cache()))
+    caches.push_back(cache.name());
+  boost_foreach(const std::string& cache, caches)
+    remove_component(cache);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void CEntities::initialize(const std::string& element_type_name)
 {
   configure_option("element_type",element_type_name);
@@ -211,6 +247,76 @@ CList<Uint>& CEntities::used_nodes(Component& parent, const bool rebuild)
 
 ////////////////////////////////////////////////////////////////////////////////
 
+CList<Uint>& CEntities::interior_first_elements(CEntities& entities, const bool rebuild)
+{
+  CList<Uint>::Ptr interior_first = find_component_ptr_with_tag<CList<Uint> >(entities,Mesh::Tags::interior_first());
+  if (rebuild && is_not_null(interior_first))
+  {
+    entities.remove_component(*interior_first);
+    interior_first.reset();
+  }
+
+  if (is_null(interior_first))
+  {
+    interior_first = entities.create_component_ptr<CList<Uint> >(Mesh::Tags::interior_first());
+    interior_first->add_tag(Mesh::Tags::interior_first());
+    interior_first->properties()["brief"] = std::string("The element indices, first those using only owned nodes, then those using ghost nodes");
+
+    const Geometry& geometry = entities.geometry();
+    const Uint nb_elems = entities.size();
+
+    std::vector<Uint> halo;
+    interior_first->resize(nb_elems);
+    CList<Uint>::ListT& elems_array = interior_first->array();
+    Uint nb_interior=0;
+    for (Uint idx=0; idx<nb_elems; ++idx)
+    {
+      bool uses_ghost = false;
+      boost_foreach(const Uint node, entities.get_nodes(idx))
+      {
+        if (geometry.is_ghost(node))
+        {
+          uses_ghost = true;
+          break;
+        }
+      }
+      if (uses_ghost)
+        halo.push_back(idx);
+      else
+        elems_array[nb_interior++] = idx;
+    }
+
+    Uint cnt=nb_interior;
+    boost_foreach(const Uint idx, halo)
+      elems_array[cnt++] = idx;
+
+    interior_first->properties()["nb_interior"] = nb_interior;
+  }
+  return *interior_first;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+CTable<Real>& CEntities::geometry_cache(CEntities& entities, const std::string& key, const Uint row_size, bool& created)
+{
+  Component::Ptr child = entities.get_child_ptr(key);
+  CTable<Real>::Ptr cache = is_not_null(child) ? child->as_ptr<CTable<Real> >() : CTable<Real>::Ptr();
+  created = is_null(cache) || cache->row_size() != row_size || cache->size() != entities.size();
+  if (created)
+  {
+    if (is_not_null(child))
+      entities.remove_component(key);
+    cache = entities.create_component_ptr<CTable<Real> >(key);
+    cache->add_tag(Mesh::Tags::geometry_cache());
+    cache->properties()["brief"] = std::string("Values per element that only depend on the geometry");
+    cache->set_row_size(row_size);
+    cache->resize(entities.size());
+  }
+  return *cache;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 Uint CEntities::size() const
 {
   throw ShouldNotBeHere( FromHere(), " This virtual function has to be overloaded. ");
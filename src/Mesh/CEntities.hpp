@@ -104,6 +104,20 @@ public: // functions
 
   static CList<Uint>& used_nodes(Component& parent, const bool rebuild=false);
 
+  /// The element indices ordered with first the interior elements, which only use
+  /// nodes owned by this rank, and then the halo elements, which use at least one ghost node.
+  /// The number of interior elements is stored in the property "nb_interior" of the list.
+  static CList<Uint>& interior_first_elements(CEntities& entities, const bool rebuild=false);
+
+  /// Table of values per element that only depend on the geometry, such as Jacobian determinants and
+  /// shape function gradients at the points of a quadrature rule, which are then not recomputed every iteration.
+  /// The tables are stored under a key identifying the shape function and the quadrature, tagged Mesh::Tags::geometry_cache(),
+  /// and are removed with the derived lists when the mesh changes.
+  /// @param [in]  key      name of the table, unique for the shape function and quadrature rule
+  /// @param [in]  row_size number of values per element
+  /// @param [out] created  true if the table did not exist yet, in which case it has one row per element that the caller must fill
+  static CTable<Real>& geometry_cache(CEntities& entities, const std::string& key, const Uint row_size, bool& created);
+
   virtual CTable<Uint>::ConstRow get_nodes(const Uint elem_idx) const;
 
   CSpace& space (const Uint space_idx) { return *m_spaces[space_idx]; }
@@ -130,6 +144,14 @@ public: // functions
 
   void signature_create_space ( Common::SignalArgs& node);
 
+  /// Remove the lists derived from the connectivity, such as the element colouring,
+  /// and the geometry caches, so that they are rebuilt when needed
+  void remove_derived_lists();
+
+  /// Triggered when the event mesh_changed is raised.
+  /// Removes the derived lists when this belongs to the changed mesh.
+  void on_mesh_changed_event ( Common::SignalArgs& args );
+
 protected: // data
 
   boost::shared_ptr<ElementType> m_element_type;
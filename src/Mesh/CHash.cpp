@@ -123,7 +123,7 @@ Uint CHash::start_idx_in_proc(const Uint proc) const
 Uint CHash::end_idx_in_proc(const Uint proc) const
 {
   Uint part_end = (proc == Comm::PE::instance().size()-1) ? m_nb_parts : m_nb_parts/Comm::PE::instance().size()*(proc+1);
-  return end_idx_in_part(part_end);
+  return end_idx_in_part(part_end-1);
 }
 
 //////////////////////////////////////////////////////////////////////////////
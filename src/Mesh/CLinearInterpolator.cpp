@@ -19,6 +19,7 @@
 
 #include "Math/Consts.hpp"
 #include "Mesh/CLinearInterpolator.hpp"
+#include "Mesh/CBoundingBoxTree.hpp"
 #include "Mesh/CMesh.hpp"
 #include "Mesh/CTable.hpp"
 #include "Mesh/CRegion.hpp"
@@ -58,6 +59,8 @@ CLinearInterpolator::CLinearInterpolator( const std::string& name )
 
   m_elements = create_component_ptr<CUnifiedData>("elements");
 
+  m_tree = create_component_ptr<CBoundingBoxTree>("bounding_box_tree");
+
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -69,6 +72,7 @@ void CLinearInterpolator::construct_internal_storage(const CMesh& source)
     m_source_mesh = source.as_ptr<CMesh>();
     create_bounding_box();
     create_octtree();
+    m_tree->create_tree(source);
   }
 }
 
@@ -86,12 +90,22 @@ void CLinearInterpolator::interpolate_field_from_to(const Field& source, Field&
     const Field& source_coords = source.coordinates();
     const Field& target_coords = target.coordinates();
 
+    // locate all target nodes at once, possibly in parallel (see option "nb_threads" of the environment)
+    RealMatrix t_nodes(target.size(),m_dim);
+    for (Uint t_node_idx=0; t_node_idx<target.size(); ++t_node_idx)
+      for (Uint d=0; d<m_dim; ++d)
+        t_nodes(t_node_idx,d) = target_coords[t_node_idx][d];
+    std::vector<Uint> s_unified_elems;
+    m_tree->find_unified_elements(t_nodes,s_unified_elems);
+
+    Component::ConstPtr component;
     for (Uint t_node_idx=0; t_node_idx<target.size(); ++t_node_idx)
     {
-      to_vector(t_node,target_coords[t_node_idx]);
-      boost::tie(s_elements,s_elm_idx) = find_element(t_node);
-      if (is_not_null(s_elements))
+      if (s_unified_elems[t_node_idx] != CBoundingBoxTree::not_found())
       {
+        to_vector(t_node,target_coords[t_node_idx]);
+        boost::tie(component,s_elm_idx) = m_tree->unified_elements().location(s_unified_elems[t_node_idx]);
+        s_elements = component->as_ptr<CElements>();
         CConnectivity::ConstRow s_field_indexes = source.indexes_for_element(*s_elements,s_elm_idx);
         std::vector<RealVector> s_nodes(s_field_indexes.size(),RealVector(m_dim));
 
@@ -473,24 +487,7 @@ void CLinearInterpolator::find_pointcloud(Uint nb_points)
 
 boost::tuple<CElements::ConstPtr,Uint> CLinearInterpolator::find_element(const RealVector& target_coord)
 {
-  if (find_point_in_octtree(target_coord,m_point_idx))
-  {
-    find_pointcloud(1);
-
-    Component::ConstPtr component;
-    Uint elem_idx;
-    boost_foreach(const Uint glb_elem_idx, m_element_cloud)
-    {
-      boost::tie(component,elem_idx)=m_elements->location(glb_elem_idx);
-      const CElements& elements = component->as_type<CElements>();
-      RealMatrix elem_coordinates = elements.get_coordinates(elem_idx);
-      if (elements.element_type().is_coord_in_element(target_coord,elem_coordinates))
-      {
-        return boost::make_tuple(elements.as_ptr<CElements>(),elem_idx);
-      }
-    }
-  }
-  return boost::make_tuple(CElements::ConstPtr(), 0u);
+  return m_tree->find_element(target_coord);
 }
 
 //////////////////////////////////////////////////////////////////////
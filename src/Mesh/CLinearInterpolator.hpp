@@ -20,6 +20,8 @@
 namespace CF {
 namespace Mesh {
 
+  class CBoundingBoxTree;
+
 //////////////////////////////////////////////////////////////////////////////
 
 /// This class defines Neutral mesh format reader
@@ -71,7 +73,7 @@ private: // functions
 	/// @param nb_points [in] the minimum number of points in the point cloud
 	void find_pointcloud(Uint nb_points);
 
-	/// Find one single element in which the given coordinate resides.
+	/// Find one single element in which the given coordinate resides, using the bounding box tree
 	/// @param target_coord [in] the given coordinate
 	/// @return the elements region, and the local coefficient in this region
 	boost::tuple<CElements::ConstPtr,Uint> find_element(const RealVector& target_coord);
@@ -115,6 +117,9 @@ private: // data
 
   std::vector<Uint> m_element_cloud;
 
+  /// Point location in the source elements, also for the points that the honeycomb misses
+  boost::shared_ptr<CBoundingBoxTree> m_tree;
+
 }; // end CLinearInterpolator
 
 ////////////////////////////////////////////////////////////////////////////////
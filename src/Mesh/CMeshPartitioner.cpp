@@ -20,6 +20,8 @@
 #include "Common/XML/Protocol.hpp"
 #include "Common/XML/SignalOptions.hpp"
 
+#include "Math/Consts.hpp"
+
 #include "Mesh/CMesh.hpp"
 #include "Mesh/CList.hpp"
 #include "Mesh/CMeshPartitioner.hpp"
@@ -190,6 +192,8 @@ void CMeshPartitioner::build_global_to_local_index(CMesh& mesh)
 
   Uint tot_nb_obj = m_lookup->size();
   m_global_to_local->reserve(tot_nb_obj);
+  const Uint start_id = m_start_id_per_part[Comm::PE::instance().rank()];
+  m_owned_to_local.assign(m_end_id_per_part[Comm::PE::instance().rank()]-start_id,Math::Consts::uint_max());
   Uint loc_idx=0;
   //CFinfo << "adding nodes to map " << CFendl;
   boost_foreach (Uint glb_idx, node_glb_idx.array())
@@ -201,6 +205,7 @@ void CMeshPartitioner::build_global_to_local_index(CMesh& mesh)
       cf_assert(glb_idx >= m_start_node_per_part[Comm::PE::instance().rank()]);
       cf_assert_desc(to_str(glb_idx)+">="+to_str(m_end_id_per_part[Comm::PE::instance().rank()]),glb_idx < m_end_id_per_part[Comm::PE::instance().rank()]);
       cf_assert_desc(to_str(glb_idx)+">="+to_str(m_end_node_per_part[Comm::PE::instance().rank()]),glb_idx < m_end_node_per_part[Comm::PE::instance().rank()]);
+      m_owned_to_local[glb_idx-start_id] = loc_idx;
     }
     else
     {
@@ -222,11 +227,15 @@ void CMeshPartitioner::build_global_to_local_index(CMesh& mesh)
       cf_assert_desc(to_str(glb_idx)+"<"+to_str(m_start_elem_per_part[Comm::PE::instance().rank()]),glb_idx >= m_start_elem_per_part[Comm::PE::instance().rank()]);
       cf_assert_desc(to_str(glb_idx)+">="+to_str(m_end_elem_per_part[Comm::PE::instance().rank()]),glb_idx < m_end_elem_per_part[Comm::PE::instance().rank()]);
       cf_assert_desc(to_str(glb_idx)+">="+to_str(m_end_id_per_part[Comm::PE::instance().rank()]),glb_idx < m_end_id_per_part[Comm::PE::instance().rank()]);
+      m_owned_to_local[glb_idx-start_id] = loc_idx;
       m_global_to_local->insert_blindly(glb_idx,loc_idx++);
       //CFinfo << "  adding element with glb " << glb_idx << CFendl;
     }
   }
 
+  cf_assert_desc("owned objects without local index",
+                 std::find(m_owned_to_local.begin(),m_owned_to_local.end(),Math::Consts::uint_max()) == m_owned_to_local.end());
+
   m_global_to_local->sort_keys();
 }
 
@@ -275,6 +284,10 @@ void CMeshPartitioner::show_changes()
 
 boost::tuple<Uint,Uint> CMeshPartitioner::location_idx(const Uint glb_obj) const
 {
+  const Uint start_id = m_start_id_per_part[Comm::PE::instance().rank()];
+  if (glb_obj >= start_id && glb_obj-start_id < m_owned_to_local.size())
+    return m_lookup->location_idx(local_of_obj(glb_obj));
+
   CMap<Uint,Uint>::const_iterator itr = m_global_to_local->find(glb_obj);
   if (itr != m_global_to_local->end() )
   {
@@ -285,9 +298,23 @@ boost::tuple<Uint,Uint> CMeshPartitioner::location_idx(const Uint glb_obj) const
 
 //////////////////////////////////////////////////////////////////////////////
 
+Uint CMeshPartitioner::local_of_obj(const Uint glb_obj) const
+{
+  const Uint start_id = m_start_id_per_part[Comm::PE::instance().rank()];
+  if (glb_obj >= start_id && glb_obj-start_id < m_owned_to_local.size())
+  {
+    const Uint loc_obj = m_owned_to_local[glb_obj-start_id];
+    cf_assert_desc("owned object "+to_str(glb_obj)+" has no local index", loc_obj != Math::Consts::uint_max());
+    return loc_obj;
+  }
+  return (*m_global_to_local)[glb_obj];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 boost::tuple<Component::Ptr,Uint> CMeshPartitioner::location(const Uint glb_obj) const
 {
-  return m_lookup->location( (*m_global_to_local)[glb_obj] );
+  return m_lookup->location( local_of_obj(glb_obj) );
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -9,6 +9,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include <boost/tuple/tuple.hpp>
 
 #include "Common/FindComponents.hpp"
@@ -116,22 +118,30 @@ protected: // functions
   bool is_elem(const Uint glb_obj) const
   {
     Uint p = part_of_obj(glb_obj);
-    return m_start_node_per_part[p] <= glb_obj && glb_obj < m_end_node_per_part[p];
+    return m_start_elem_per_part[p] <= glb_obj && glb_obj < m_end_elem_per_part[p];
   }
 
   boost::tuple<Uint,Uint> location_idx(const Uint glb_obj) const;
 
   boost::tuple<Common::Component::Ptr,Uint> location(const Uint glb_obj) const;
 
+  /// Part owning a global object index, by binary search over the part boundaries
   Uint part_of_obj(const Uint obj) const
   {
-    for (Uint p=0; p<m_end_id_per_part.size(); ++p)
-    {
-      if ( obj < m_end_id_per_part[p])
-        return p;
-    }
-    cf_assert_desc("[obj " + Common::to_str(obj)+ ">"+Common::to_str(m_end_id_per_part.back())+" Should not be here", false);
-    return 0;
+    cf_assert_desc("[obj " + Common::to_str(obj)+ ">"+Common::to_str(m_end_id_per_part.back())+" Should not be here", obj < m_end_id_per_part.back());
+    return std::upper_bound(m_end_id_per_part.begin(),m_end_id_per_part.end(),obj) - m_end_id_per_part.begin();
+  }
+
+  /// Local index in the lookup of a global object index.
+  /// Objects owned by this process are found directly, others in the global to local map.
+  Uint local_of_obj(const Uint glb_obj) const;
+
+  /// Range of the global to local map with the objects owned by a part,
+  /// which are contiguous in the sorted map
+  std::pair<Common::CMap<Uint,Uint>::const_iterator,Common::CMap<Uint,Uint>::const_iterator> objects_of_part(const Uint part) const
+  {
+    return std::make_pair(m_global_to_local->lower_bound(m_start_id_per_part[part]),
+                          m_global_to_local->lower_bound(m_end_id_per_part[part]));
   }
 
 protected: // data
@@ -153,6 +163,10 @@ private: // data
 
   Common::CMap<Uint,Uint>::Ptr m_global_to_local;
 
+  /// local index of every object owned by this process, indexed by global index - start id.
+  /// Entries not filled by build_global_to_local_index() are Math::Consts::uint_max()
+  std::vector<Uint> m_owned_to_local;
+
   std::vector<Uint> m_start_id_per_part;
   std::vector<Uint> m_end_id_per_part;
   std::vector<Uint> m_start_node_per_part;
@@ -177,10 +191,9 @@ template <typename VectorT>
 void CMeshPartitioner::list_of_objects_owned_by_part(const Uint part, VectorT& obj_list) const
 {
   Uint idx=0;
-  foreach_container((const Uint glb_obj),*m_global_to_local)
+  foreach_container((const Uint glb_obj)(const Uint loc_obj),objects_of_part(part))
   {
-    if (part_of_obj(glb_obj) == part)
-      obj_list[idx++] = glb_obj;
+    obj_list[idx++] = glb_obj;
   }
 }
 
@@ -194,25 +207,22 @@ Uint CMeshPartitioner::nb_connected_objects_in_part(const Uint part, VectorT& nb
   Uint loc_idx;
   Uint size = 0;
   Uint idx = 0;
-  foreach_container((const Uint glb_obj)(const Uint loc_obj),*m_global_to_local)
+  foreach_container((const Uint glb_obj)(const Uint loc_obj),objects_of_part(part))
   {
-    if (part_of_obj(glb_obj) == part)
+    boost::tie(comp,loc_idx) = m_lookup->location(loc_obj);
+
+    if (Geometry::Ptr nodes = comp->as_ptr<Geometry>())
+    {
+      const CDynTable<Uint>& node_to_glb_elm = nodes->glb_elem_connectivity();
+      nb_connections_per_obj[idx] = node_to_glb_elm.row_size(loc_idx);
+    }
+    else if (CElements::Ptr elements = comp->as_ptr<CElements>())
     {
-      boost::tie(comp,loc_idx) = m_lookup->location(loc_obj);
-
-      if (Geometry::Ptr nodes = comp->as_ptr<Geometry>())
-      {
-        const CDynTable<Uint>& node_to_glb_elm = nodes->glb_elem_connectivity();
-        nb_connections_per_obj[idx] = node_to_glb_elm.row_size(loc_idx);
-      }
-      else if (CElements::Ptr elements = comp->as_ptr<CElements>())
-      {
-        const CTable<Uint>& connectivity_table = elements->node_connectivity();
-        nb_connections_per_obj[idx] = connectivity_table.row_size(loc_idx);
-      }
-      size += nb_connections_per_obj[idx];
-      ++idx;
+      const CTable<Uint>& connectivity_table = elements->node_connectivity();
+      nb_connections_per_obj[idx] = connectivity_table.row_size(loc_idx);
     }
+    size += nb_connections_per_obj[idx];
+    ++idx;
   }
   cf_assert_desc(Common::to_str(idx)+"!="+Common::to_str(nb_objects_owned_by_part(part)), idx == nb_objects_owned_by_part(part));
   return size;
@@ -228,25 +238,22 @@ void CMeshPartitioner::list_of_connected_objects_in_part(const Uint part, Vector
   Uint loc_idx;
 
   Uint idx = 0;
-  foreach_container((const Uint glb_obj)(const Uint loc_obj),*m_global_to_local)
+  foreach_container((const Uint glb_obj)(const Uint loc_obj),objects_of_part(part))
   {
-    if (part_of_obj(glb_obj) == part)
+    boost::tie(comp,loc_idx) = m_lookup->location(loc_obj);
+    if (Geometry::Ptr nodes = comp->as_ptr<Geometry>())
+    {
+      const CDynTable<Uint>& node_to_glb_elm = nodes->glb_elem_connectivity();
+      boost_foreach (const Uint glb_elm , node_to_glb_elm[loc_idx])
+        connected_objects[idx++] = glb_elm;
+    }
+    else if (CElements::Ptr elements = comp->as_ptr<CElements>())
     {
-      boost::tie(comp,loc_idx) = m_lookup->location(loc_obj);
-      if (Geometry::Ptr nodes = comp->as_ptr<Geometry>())
-      {
-        const CDynTable<Uint>& node_to_glb_elm = nodes->glb_elem_connectivity();
-        boost_foreach (const Uint glb_elm , node_to_glb_elm[loc_idx])
-          connected_objects[idx++] = glb_elm;
-      }
-      else if (CElements::Ptr elements = comp->as_ptr<CElements>())
-      {
-        const CConnectivity& connectivity_table = elements->node_connectivity();
-        const CList<Uint>& glb_node_indices    = elements->geometry().glb_idx();
-
-        boost_foreach (const Uint loc_node , connectivity_table[loc_idx])
-          connected_objects[idx++] = glb_node_indices[ loc_node ];
-      }
+      const CConnectivity& connectivity_table = elements->node_connectivity();
+      const CList<Uint>& glb_node_indices    = elements->geometry().glb_idx();
+
+      boost_foreach (const Uint loc_node , connectivity_table[loc_idx])
+        connected_objects[idx++] = glb_node_indices[ loc_node ];
     }
   }
 
@@ -264,24 +271,21 @@ void CMeshPartitioner::list_of_connected_procs_in_part(const Uint part, VectorT&
   Uint loc_idx;
 
   Uint idx = 0;
-  foreach_container((const Uint glb_obj)(const Uint loc_obj),*m_global_to_local)
+  foreach_container((const Uint glb_obj)(const Uint loc_obj),objects_of_part(part))
   {
-    if (part_of_obj(glb_obj) == part)
+    boost::tie(comp,loc_idx) = m_lookup->location(loc_obj);
+    if (Geometry::Ptr nodes = comp->as_ptr<Geometry>())
+    {
+      const CDynTable<Uint>& node_to_glb_elm = nodes->glb_elem_connectivity();
+      boost_foreach (const Uint glb_elm , node_to_glb_elm[loc_idx])
+        connected_procs[idx++] = part_of_obj(glb_elm); /// @todo should be proc of obj, not part!!!
+    }
+    else if (CElements::Ptr elements = comp->as_ptr<CElements>())
     {
-      boost::tie(comp,loc_idx) = m_lookup->location(loc_obj);
-      if (Geometry::Ptr nodes = comp->as_ptr<Geometry>())
-      {
-        const CDynTable<Uint>& node_to_glb_elm = nodes->glb_elem_connectivity();
-        boost_foreach (const Uint glb_elm , node_to_glb_elm[loc_idx])
-          connected_procs[idx++] = part_of_obj(glb_elm); /// @todo should be proc of obj, not part!!!
-      }
-      else if (CElements::Ptr elements = comp->as_ptr<CElements>())
-      {
-        const CConnectivity& connectivity_table = elements->node_connectivity();
-        const CList<Uint>& glb_node_indices    = elements->geometry().glb_idx();
-        boost_foreach (const Uint loc_node , connectivity_table[loc_idx])
-          connected_procs[idx++] = part_of_obj( glb_node_indices[loc_node] ); /// @todo should be proc of obj, not part!!!
-      }
+      const CConnectivity& connectivity_table = elements->node_connectivity();
+      const CList<Uint>& glb_node_indices    = elements->geometry().glb_idx();
+      boost_foreach (const Uint loc_node , connectivity_table[loc_idx])
+        connected_procs[idx++] = part_of_obj( glb_node_indices[loc_node] ); /// @todo should be proc of obj, not part!!!
     }
   }
   std::vector<Uint> edges(m_nb_owned_obj);
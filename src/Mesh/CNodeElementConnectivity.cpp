@@ -57,7 +57,7 @@ void CNodeElementConnectivity::build_connectivity()
   set_nodes(elements().components()[0]->as_type<CElements>().geometry());
   Geometry const& nodes = *m_nodes->follow()->as_ptr<Geometry>();
 
-  // Reserve memory in m_connectivity->array()
+  // Count the entries of every row
   std::vector<Uint> connectivity_sizes(nodes.size());
   boost_foreach(Component::Ptr elements_comp, m_elements->components() )
   {
@@ -70,13 +70,10 @@ void CNodeElementConnectivity::build_connectivity()
       }
     }
   }
-  Uint i(0);
-  boost_foreach (CDynTable<Uint>::Row row, m_connectivity->array() )
-  {
-    row.reserve(connectivity_sizes[i++]);
-  }
+  m_connectivity->allocate(connectivity_sizes);
+  std::vector<Uint> filled(nodes.size(),0u);
 
-  // fill m_connectivity->array()
+  // fill the rows of m_connectivity
   Uint glb_elem_idx = 0;
   boost_foreach(Component::Ptr elements_comp, m_elements->components() )
   {
@@ -85,7 +82,7 @@ void CNodeElementConnectivity::build_connectivity()
     {
       boost_foreach (const Uint node_idx, nodes)
       {
-        m_connectivity->array()[node_idx].push_back(glb_elem_idx);
+        (*m_connectivity)[node_idx][filled[node_idx]++] = glb_elem_idx;
       }
       ++glb_elem_idx;
     }
@@ -54,7 +54,7 @@ void CNodeFaceCellConnectivity::build_connectivity()
 {
   Geometry const& nodes = *m_nodes->follow()->as_ptr<Geometry>();
   
-  // Reserve memory in m_connectivity->array()
+  // Count the entries of every row
   std::vector<Uint> connectivity_sizes(nodes.size());
   boost_foreach(Component::ConstPtr face_cell_connectivity_comp, m_face_cell_connectivity->components() )
   {
@@ -70,13 +70,10 @@ void CNodeFaceCellConnectivity::build_connectivity()
       }
     }
   }
-  Uint i(0);
-  boost_foreach (CDynTable<Uint>::Row row, m_connectivity->array() )
-  {
-    row.reserve(connectivity_sizes[i++]);
-  }
+  m_connectivity->allocate(connectivity_sizes);
+  std::vector<Uint> filled(nodes.size(),0u);
   
-  // fill m_connectivity->array()
+  // fill the rows of m_connectivity
   
   Uint glb_face_idx(0);
   boost_foreach(Component::ConstPtr face_cell_connectivity_comp, m_face_cell_connectivity->components() )
@@ -88,7 +85,7 @@ void CNodeFaceCellConnectivity::build_connectivity()
       {
         boost_foreach (const Uint node_idx, face_cell_connectivity.face_nodes(f))
         {
-          m_connectivity->array()[node_idx].push_back(glb_face_idx);
+          (*m_connectivity)[node_idx][filled[node_idx]++] = glb_face_idx;
         }
       }
     }
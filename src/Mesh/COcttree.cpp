@@ -326,6 +326,8 @@ boost::tuple<CElements::ConstPtr,Uint> COcttree::find_element(const RealVector&
 
     Component::ConstPtr component;
     Uint elem_idx;
+    // reused for all candidates, only reallocated when the number of nodes changes
+    RealMatrix elem_coordinates;
 
     gather_elements_around_idx(m_octtree_idx,0,unified_elements);
 
@@ -333,7 +335,8 @@ boost::tuple<CElements::ConstPtr,Uint> COcttree::find_element(const RealVector&
     {
       boost::tie(component,elem_idx)=m_elements->location(unif_elem_idx);
       const CElements& elements = component->as_type<CElements>();
-      const RealMatrix elem_coordinates = elements.get_coordinates(elem_idx);
+      elements.allocate_coordinates(elem_coordinates);
+      elements.put_coordinates(elem_coordinates,elem_idx);
       if (elements.element_type().is_coord_in_element(target_coord,elem_coordinates))
       {
         return boost::make_tuple(elements.as_ptr<CElements>(),elem_idx);
@@ -348,7 +351,8 @@ boost::tuple<CElements::ConstPtr,Uint> COcttree::find_element(const RealVector&
     {
       boost::tie(component,elem_idx)=m_elements->location(unif_elem_idx);
       const CElements& elements = component->as_type<CElements>();
-      const RealMatrix elem_coordinates = elements.get_coordinates(elem_idx);
+      elements.allocate_coordinates(elem_coordinates);
+      elements.put_coordinates(elem_coordinates,elem_idx);
       if (elements.element_type().is_coord_in_element(target_coord,elem_coordinates))
       {
         return boost::make_tuple(elements.as_ptr<CElements>(),elem_idx);
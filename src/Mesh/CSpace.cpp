@@ -129,7 +129,7 @@ void CSpace::put_coordinates(RealMatrix& coordinates, const Uint elem_idx) const
   {
     for (Uint j=0; j<coordinates.cols(); ++j)
     {
-      coordinates(i,j) = coordinates_field[i][j];
+      coordinates(i,j) = coordinates_field[indexes[i]][j];
     }
   }
 }
@@ -145,16 +145,8 @@ void CSpace::allocate_coordinates(RealMatrix& coordinates) const
 
 RealMatrix CSpace::get_coordinates(const Uint elem_idx) const
 {
-  CConnectivity::ConstRow indexes = indexes_for_element(elem_idx);
-  Field& coordinates_field = bound_fields().coordinates();
-  RealMatrix coordinates(indexes.size(),coordinates_field.row_size());
-  for (Uint i=0; i<coordinates.rows(); ++i)
-  {
-    for (Uint j=0; j<coordinates.cols(); ++j)
-    {
-      coordinates(i,j) = coordinates_field[i][j];
-    }
-  }
+  RealMatrix coordinates(nb_states(),bound_fields().coordinates().row_size());
+  put_coordinates(coordinates,elem_idx);
   return coordinates;
 }
 
@@ -33,7 +33,7 @@ CF::Common::ComponentBuilder < CStencilComputerOcttree, CStencilComputer, LibMes
 //////////////////////////////////////////////////////////////////////////////
 
 CStencilComputerOcttree::CStencilComputerOcttree( const std::string& name )
-  : CStencilComputer(name), m_dim(0), m_nb_elems_in_mesh(0)
+  : CStencilComputer(name), m_dim(0), m_nb_elems_in_mesh(0), m_octtree_cell(3)
 {
   option("mesh").attach_trigger(boost::bind(&CStencilComputerOcttree::configure_mesh,this));
 
@@ -50,6 +50,7 @@ void CStencilComputerOcttree::configure_mesh()
 
   m_nb_elems_in_mesh = m_mesh.lock()->topology().recursive_filtered_elements_count(IsElementsVolume());
   m_dim = m_mesh.lock()->geometry().coordinates().row_size();
+  m_centroid.resize(m_dim);
 
   m_octtree->configure_option("mesh",m_mesh.lock()->uri());
   m_octtree->create_octtree();
@@ -59,20 +60,19 @@ void CStencilComputerOcttree::configure_mesh()
 
 void CStencilComputerOcttree::compute_stencil(const Uint unified_elem_idx, std::vector<Uint>& stencil)
 {
-  std::vector<Uint> octtree_cell(3);
-  RealVector centroid(m_dim);
   Component::Ptr component;
   Uint elem_idx;
   boost::tie(component,elem_idx) = unified_elements().location(unified_elem_idx);
   CElements& elements = component->as_type<CElements>();
-  RealMatrix coordinates = elements.get_coordinates(elem_idx);
-  elements.element_type().compute_centroid(coordinates,centroid);
+  elements.allocate_coordinates(m_coordinates);
+  elements.put_coordinates(m_coordinates,elem_idx);
+  elements.element_type().compute_centroid(m_coordinates,m_centroid);
   stencil.resize(0);
-  if (m_octtree->find_octtree_cell(centroid,octtree_cell))
+  if (m_octtree->find_octtree_cell(m_centroid,m_octtree_cell))
   {
     for (Uint ring=0; stencil.size() < m_min_stencil_size; ++ring)
     {
-      m_octtree->gather_elements_around_idx(octtree_cell,ring,stencil);
+      m_octtree->gather_elements_around_idx(m_octtree_cell,ring,stencil);
       if (stencil.size() >= m_nb_elems_in_mesh )
         return;
     }
@@ -9,6 +9,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "Math/MatrixTypes.hpp"
+
 #include "Mesh/CStencilComputer.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -50,6 +52,13 @@ private: // data
   Uint m_dim;
   Uint m_nb_elems_in_mesh;
 
+  /// @name Work storage of compute_stencil(), reused for every element
+  //@{
+  RealMatrix m_coordinates;
+  RealVector m_centroid;
+  std::vector<Uint> m_octtree_cell;
+  //@}
+
 }; // end CStencilComputerOcttree
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -7,6 +7,8 @@
 #include "Common/CBuilder.hpp"
 #include "Common/StreamHelpers.hpp"
 #include "Common/Foreach.hpp"
+#include "Common/Core.hpp"
+#include "Common/ThreadPool.hpp"
 
 #include "Mesh/LibMesh.hpp"
 #include "Mesh/CTable.hpp"
@@ -28,6 +30,13 @@ Common::ComponentBuilder < CTable<std::string>, Component, LibMesh > CTable_stri
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void first_touch_table(void* data, const Uint nb_rows, const Uint row_bytes)
+{
+  Core::instance().thread_pool().first_touch(data, nb_rows, row_bytes);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 std::ostream& operator<<(std::ostream& os, const CTable<bool>::ConstRow row)
 {
   print_vector(os, row);
@@ -9,6 +9,9 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <new>
+#include <boost/type_traits/is_arithmetic.hpp>
+
 #include "Common/Component.hpp"
 
 #include "Mesh/ArrayBufferT.hpp"
@@ -21,10 +24,24 @@ namespace Mesh {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+/// Place the pages of newly allocated table storage according to the NUMA policy of the ThreadPool
+/// @see Common::ThreadPool::first_touch()
+void Mesh_API first_touch_table(void* data, const Uint nb_rows, const Uint row_bytes);
+
+////////////////////////////////////////////////////////////////////////////////
+
 /// @brief Component holding a 2 dimensional array of a templated type
 ///
 /// The internal structure is that of a boost::multi_array,
 /// so storage is contingent in memory for reducing cache missing
+///
+/// The entries are stored row by row by default. With set_column_major(true) the entries of
+/// every column are contiguous instead, so that loops over all rows of one column vectorize.
+/// Rows are still accessed through operator[], as views with a stride.
+///
+/// When the storage of a table of numbers is allocated by set_row_size() or resize(),
+/// it is distributed over the NUMA nodes of the threads that will loop over the rows,
+/// if the numa_policy of the environment is first_touch.
 //
 /// The table can be filled through a buffer. The buffer avoids
 /// the typical reallocation in a std::vector. Flushing the buffer
@@ -82,14 +99,48 @@ public: // functions
   /// @param[in] nb_cols number of columns in the table.
   void set_row_size(const Uint nb_cols)
   {
+    const bool was_empty = m_array.num_elements() == 0;
     m_array.resize(boost::extents[size()][nb_cols]);
+    if (was_empty)
+      first_touch();
   }
 
   /// Resize the array to the given number of rows
   /// @param[in] nb_rows The number of rows after resizing
   virtual void resize(const Uint nb_rows)
   {
+    const bool was_empty = m_array.num_elements() == 0;
     m_array.resize(boost::extents[nb_rows][row_size()]);
+    if (was_empty)
+      first_touch();
+  }
+
+  /// True if the entries of every column are contiguous in memory
+  bool is_column_major() const { return m_array.storage_order().ordering(0) == 0; }
+
+  /// Store the entries column by column, or row by row (the default), keeping their values
+  void set_column_major(const bool column_major)
+  {
+    if (column_major == is_column_major())
+      return;
+
+    const typename ArrayT::storage_order_type order = column_major ?
+      typename ArrayT::storage_order_type(boost::fortran_storage_order()) :
+      typename ArrayT::storage_order_type(boost::c_storage_order());
+    ArrayT reordered(boost::extents[size()][row_size()], order);
+    reordered = m_array;
+
+    // a multi_array can not be assigned an array with a different storage order, so it is constructed again in place
+    m_array.~ArrayT();
+    try
+    {
+      new (&m_array) ArrayT(reordered);
+    }
+    catch (...)
+    {
+      new (&m_array) ArrayT();
+      throw;
+    }
   }
 
   /// Modifiable access to the internal structure
@@ -188,25 +239,30 @@ public: // functions
   CTable& operator =(const CTable& U)
   {
     cf_assert(size() == U.size());
-    array() = U.array();
+    if (same_storage(U))
+      std::copy(U.m_array.data(), U.m_array.data()+U.m_array.num_elements(), m_array.data());
+    else
+      array() = U.array();
     return *this;
   }
 
   /// U = c
   CTable& operator =(const value_type& c)
   {
-    for (Uint i=0; i<size(); ++i)
-      for (Uint j=0; j<row_size(); ++j)
-        array()[i][j] = c;
+    ValueT* entries = m_array.data();
+    const Uint nb_entries = m_array.num_elements();
+    for (Uint k=0; k<nb_entries; ++k)
+      entries[k] = c;
     return *this;
   }
 
   /// U += c
   CTable& operator +=(const value_type& c)
   {
-    for (Uint i=0; i<size(); ++i)
-      for (Uint j=0; j<row_size(); ++j)
-        array()[i][j] += c;
+    ValueT* entries = m_array.data();
+    const Uint nb_entries = m_array.num_elements();
+    for (Uint k=0; k<nb_entries; ++k)
+      entries[k] += c;
     return *this;
   }
 
@@ -215,6 +271,15 @@ public: // functions
   {
     cf_assert(size() == U.size());
     cf_assert(row_size() == U.row_size());
+    if (same_storage(U))
+    {
+      ValueT* entries = m_array.data();
+      const ValueT* U_entries = U.m_array.data();
+      const Uint nb_entries = m_array.num_elements();
+      for (Uint k=0; k<nb_entries; ++k)
+        entries[k] += U_entries[k];
+      return *this;
+    }
     for (Uint i=0; i<size(); ++i)
       for (Uint j=0; j<row_size(); ++j)
         array()[i][j] += U.array()[i][j];
@@ -224,9 +289,10 @@ public: // functions
   /// U -= c
   CTable& operator -=(const value_type& c)
   {
-    for (Uint i=0; i<size(); ++i)
-      for (Uint j=0; j<row_size(); ++j)
-        array()[i][j] -= c;
+    ValueT* entries = m_array.data();
+    const Uint nb_entries = m_array.num_elements();
+    for (Uint k=0; k<nb_entries; ++k)
+      entries[k] -= c;
     return *this;
   }
 
@@ -235,6 +301,15 @@ public: // functions
   {
     cf_assert(size() == U.size());
     cf_assert(row_size() == U.row_size());
+    if (same_storage(U))
+    {
+      ValueT* entries = m_array.data();
+      const ValueT* U_entries = U.m_array.data();
+      const Uint nb_entries = m_array.num_elements();
+      for (Uint k=0; k<nb_entries; ++k)
+        entries[k] -= U_entries[k];
+      return *this;
+    }
     for (Uint i=0; i<size(); ++i)
       for (Uint j=0; j<row_size(); ++j)
         array()[i][j] -= U.array()[i][j];
@@ -244,9 +319,10 @@ public: // functions
   /// U *= c
   CTable& operator *=(const value_type& c)
   {
-    for (Uint i=0; i<size(); ++i)
-      for (Uint j=0; j<row_size(); ++j)
-        array()[i][j] *= c;
+    ValueT* entries = m_array.data();
+    const Uint nb_entries = m_array.num_elements();
+    for (Uint k=0; k<nb_entries; ++k)
+      entries[k] *= c;
     return *this;
   }
 
@@ -263,6 +339,15 @@ public: // functions
     else
     {
       cf_assert(row_size() == U.row_size()); // field must be same size
+      if (same_storage(U))
+      {
+        ValueT* entries = m_array.data();
+        const ValueT* U_entries = U.m_array.data();
+        const Uint nb_entries = m_array.num_elements();
+        for (Uint k=0; k<nb_entries; ++k)
+          entries[k] *= U_entries[k];
+        return *this;
+      }
       for (Uint i=0; i<size(); ++i)
         for (Uint j=0; j<row_size(); ++j)
           array()[i][j] *= U.array()[i][j];
@@ -273,9 +358,10 @@ public: // functions
   /// U /= c
   CTable& operator /=(const value_type& c)
   {
-    for (Uint i=0; i<size(); ++i)
-      for (Uint j=0; j<row_size(); ++j)
-        array()[i][j] /= c;
+    ValueT* entries = m_array.data();
+    const Uint nb_entries = m_array.num_elements();
+    for (Uint k=0; k<nb_entries; ++k)
+      entries[k] /= c;
     return *this;
   }
 
@@ -292,6 +378,15 @@ public: // functions
     else
     {
       cf_assert(row_size() == U.row_size()); // field must be same size
+      if (same_storage(U))
+      {
+        ValueT* entries = m_array.data();
+        const ValueT* U_entries = U.m_array.data();
+        const Uint nb_entries = m_array.num_elements();
+        for (Uint k=0; k<nb_entries; ++k)
+          entries[k] /= U_entries[k];
+        return *this;
+      }
       for (Uint i=0; i<size(); ++i)
         for (Uint j=0; j<row_size(); ++j)
           array()[i][j] /= U.array()[i][j];
@@ -323,6 +418,32 @@ public: // functions
   // friend istream& operator >> (istream& in,  CTable& U);
 
 
+private: // functions
+
+  /// True if both tables have the same shape and storage order,
+  /// so that entries at the same position in memory correspond
+  bool same_storage(const CTable& U) const
+  {
+    return size() == U.size() && row_size() == U.row_size() && is_column_major() == U.is_column_major();
+  }
+
+  /// Place the storage, which only contains zeros right after allocation.
+  /// In column major storage every column is placed by itself, with the same row partition.
+  void first_touch()
+  {
+    if (!boost::is_arithmetic<ValueT>::value || m_array.num_elements() == 0)
+      return;
+    if (is_column_major())
+    {
+      for (Uint j=0; j<row_size(); ++j)
+        first_touch_table(m_array.data()+j*size(), size(), sizeof(ValueT));
+    }
+    else
+    {
+      first_touch_table(m_array.data(), size(), row_size()*sizeof(ValueT));
+    }
+  }
+
 private: // data
 
   /// storage of the array
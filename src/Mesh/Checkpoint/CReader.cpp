@@ -0,0 +1,310 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <cstring>
+
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/classification.hpp>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/Foreach.hpp"
+#include "Common/Log.hpp"
+#include "Common/CBuilder.hpp"
+#include "Common/OptionComponent.hpp"
+#include "Common/StringConversion.hpp"
+#include "Common/MPI/PE.hpp"
+
+#include "Mesh/Checkpoint/CReader.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CMeshElements.hpp"
+#include "Mesh/Geometry.hpp"
+#include "Mesh/Field.hpp"
+#include "Mesh/FieldGroup.hpp"
+#include "Mesh/MeshMetadata.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+namespace Checkpoint {
+
+using namespace Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+Common::ComponentBuilder < Checkpoint::CReader, CMeshReader, LibCheckpoint> aCheckpointReader_Builder;
+
+//////////////////////////////////////////////////////////////////////////////
+
+CReader::CReader( const std::string& name )
+: CMeshReader(name),
+  Shared(),
+  m_dimension(0),
+  m_time(0.),
+  m_iter(0)
+{
+  m_properties["brief"] = std::string("Restores a mesh and its fields from a checkpoint file");
+
+  m_options.add_option( OptionComponent<Component>::create( "time", &m_time_component) )
+      ->description("Component of which the options \"time\" and \"iteration\" are restored (e.g. a CTime)")
+      ->pretty_name("Time");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+std::vector<std::string> CReader::get_extensions()
+{
+  std::vector<std::string> extensions;
+  extensions.push_back(".cfcp");
+  return extensions;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CReader::do_read_mesh_into(const URI& file, CMesh& mesh)
+{
+  boost::filesystem::path fp (file.path());
+  CFinfo << "Opening file " << fp.string() << CFendl;
+  m_file.open(fp);
+
+  read_header();
+
+  const Uint rank = Comm::PE::instance().is_active() ? Comm::PE::instance().rank() : 0u;
+  m_file.seek(m_block_offsets[rank]);
+
+  read_geometry(mesh);
+
+  read_elements(mesh);
+
+  mesh.elements().update();
+  mesh.update_statistics();
+
+  for (Uint g=1; g<m_field_groups.size(); ++g)
+    read_field_group(mesh, m_field_groups[g]);
+
+  if (m_file.position() != m_block_offsets[rank] + m_block_sizes[rank])
+    throw ParsingFailed(FromHere(), "Block of rank " + to_str(rank) + " in " + fp.string() + " does not have the expected size");
+
+  // time state
+
+  mesh.metadata()["time"] = m_time;
+  mesh.metadata()["iter"] = m_iter;
+  mesh.metadata()["date"] = m_date;
+  if ( !m_time_component.expired() )
+  {
+    m_time_component.lock()->configure_option("time", m_time);
+    m_time_component.lock()->configure_option("iteration", m_iter);
+  }
+
+  m_file.close();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CReader::read_header()
+{
+  char magic[sizeof(m_magic)];
+  if (m_file.size() < m_header_size)
+    throw ParsingFailed(FromHere(), "File is too small to be a checkpoint");
+  read(magic, sizeof(m_magic));
+  if (std::memcmp(magic, m_magic, sizeof(m_magic)) != 0)
+    throw ParsingFailed(FromHere(), "File is not a checkpoint");
+
+  boost::uint32_t version, byte_order_mark, uint_size, real_size;
+  read(version);
+  read(byte_order_mark);
+  read(uint_size);
+  read(real_size);
+  if (byte_order_mark != m_byte_order_mark)
+    throw NotSupported(FromHere(), "Checkpoint was written on a machine with a different byte order");
+  if (version != m_version)
+    throw NotSupported(FromHere(), "Checkpoint has format version " + to_str(version) + ", expected " + to_str(m_version));
+  if (uint_size != sizeof(Uint) || real_size != sizeof(Real))
+    throw NotSupported(FromHere(), "Checkpoint was written with Uint and Real of "
+                       + to_str(uint_size) + " and " + to_str(real_size) + " bytes, expected "
+                       + to_str(sizeof(Uint)) + " and " + to_str(sizeof(Real)) + " bytes");
+
+  const Uint nb_ranks = read_size();
+  const std::size_t metadata_size = read_size();
+  const Uint nb_procs = Comm::PE::instance().is_active() ? Comm::PE::instance().size() : 1u;
+  if (nb_ranks != nb_procs)
+    throw NotSupported(FromHere(), "Checkpoint was written by " + to_str(nb_ranks) + " processes, "
+                       "and can only be restarted on as many processes, not " + to_str(nb_procs));
+
+  m_block_offsets.resize(nb_ranks);
+  m_block_sizes.resize(nb_ranks);
+  read(&m_block_offsets[0], nb_ranks);
+  read(&m_block_sizes[0], nb_ranks);
+
+  const MappedFile::Position metadata_end = m_file.position() + metadata_size;
+
+  m_dimension = read_size();
+  read(m_time);
+  m_iter = read_size();
+  m_date = read_string();
+
+  m_field_groups.resize(read_size());
+  boost_foreach(FieldGroupInfo& field_group, m_field_groups)
+  {
+    field_group.name = read_string();
+    field_group.basis = read_string();
+    field_group.space = read_string();
+    field_group.topology = read_string();
+    field_group.fields.resize(read_size());
+    boost_foreach(FieldInfo& field, field_group.fields)
+    {
+      field.name = read_string();
+      field.description = read_string();
+      field.row_size = read_size();
+    }
+  }
+
+  if (m_field_groups.empty() || m_file.position() != metadata_end)
+    throw ParsingFailed(FromHere(), "Corrupt checkpoint header");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CReader::read_geometry(CMesh& mesh)
+{
+  Geometry& geometry = mesh.geometry();
+
+  const Uint nb_nodes = read_size();
+  mesh.initialize_nodes(nb_nodes, m_dimension);
+  read(geometry.glb_idx().array().data(), nb_nodes);
+  read_list(geometry.rank());
+
+  boost_foreach(const FieldInfo& info, m_field_groups[0].fields)
+  {
+    Component::Ptr existing = geometry.get_child_ptr(info.name);
+    Field::Ptr field = is_null(existing) ? geometry.create_field(info.name, info.description).as_ptr<Field>()
+                                         : existing->as_ptr_checked<Field>();
+    if (field->row_size() != info.row_size)
+      throw InvalidStructure(FromHere(), "Field " + field->uri().string() + " has row size " + to_str(field->row_size())
+                             + " instead of " + to_str(info.row_size));
+    read_table(*field);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CReader::read_elements(CMesh& mesh)
+{
+  const Uint nb_element_components = read_size();
+  for (Uint c=0; c<nb_element_components; ++c)
+  {
+    const std::string path = read_string();
+    const std::string entities_type = read_string();
+    const std::string element_type = read_string();
+
+    const std::string::size_type separator = path.rfind('/');
+    CRegion& region = separator == std::string::npos ? mesh.topology()
+                                                     : create_region(mesh.topology(), path.substr(0,separator));
+    const std::string name = separator == std::string::npos ? path : path.substr(separator+1);
+
+    CEntities::Ptr entities = build_component_abstract_type<CEntities>(entities_type, name);
+    region.add_component(entities);
+    entities->initialize(element_type, mesh.geometry());
+    CElements& elements = entities->as_type<CElements>();
+
+    const Uint nb_spaces = read_size();
+    for (Uint s=0; s<nb_spaces; ++s)
+    {
+      const std::string space = read_string();
+      const std::string shape_function = read_string();
+      if ( !elements.exists_space(space) )
+        elements.create_space(space, shape_function);
+    }
+
+    read_table(elements.node_connectivity());
+    read_list(elements.glb_idx());
+    read_list(elements.rank());
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CReader::read_field_group(CMesh& mesh, const FieldGroupInfo& info)
+{
+  Component::Ptr topology = mesh.self();
+  if ( !info.topology.empty() )
+  {
+    std::vector<std::string> names;
+    boost::algorithm::split(names, info.topology, boost::algorithm::is_any_of("/"));
+    boost_foreach(const std::string& name, names)
+      topology = topology->get_child_ptr_checked(name);
+  }
+
+  // The size and space connectivities follow from the elements, which are restored as they were
+  FieldGroup& field_group = mesh.create_field_group(info.name, FieldGroup::Basis::to_enum(info.basis),
+                                                    info.space, topology->as_type<CRegion>());
+
+  const Uint size = read_size();
+  if (field_group.size() == 0)
+    field_group.resize(size);
+  else if (field_group.size() != size)
+    throw InvalidStructure(FromHere(), "Field group " + field_group.uri().string() + " has size " + to_str(field_group.size())
+                           + " instead of " + to_str(size));
+  read(field_group.glb_idx().array().data(), size);
+  read_list(field_group.rank());
+
+  boost_foreach(const FieldInfo& field_info, info.fields)
+  {
+    // the coordinates of a point based space are already created with the field group
+    Component::Ptr existing = field_group.get_child_ptr(field_info.name);
+    Field::Ptr field = is_null(existing) ? field_group.create_field(field_info.name, field_info.description).as_ptr<Field>()
+                                         : existing->as_ptr_checked<Field>();
+    if (field->row_size() != field_info.row_size)
+      throw InvalidStructure(FromHere(), "Field " + field->uri().string() + " has row size " + to_str(field->row_size())
+                             + " instead of " + to_str(field_info.row_size));
+    read_table(*field);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CRegion& CReader::create_region(CRegion& topology, const std::string& path)
+{
+  std::vector<std::string> names;
+  boost::algorithm::split(names, path, boost::algorithm::is_any_of("/"));
+
+  CRegion::Ptr region = topology.as_ptr<CRegion>();
+  boost_foreach(const std::string& name, names)
+  {
+    Component::Ptr subregion = region->get_child_ptr(name);
+    region = is_null(subregion) ? region->create_component_ptr<CRegion>(name) : subregion->as_ptr_checked<CRegion>();
+  }
+  return *region;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+std::size_t CReader::read_size()
+{
+  boost::uint64_t size;
+  read(size);
+  return static_cast<std::size_t>(size);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+std::string CReader::read_string()
+{
+  const std::size_t size = read_size();
+  std::string str(m_file.data(), std::min(size, m_file.size()-m_file.position()));
+  m_file.seek_relative(static_cast<long>(str.size()));
+  if (str.size() != size)
+    throw ParsingFailed(FromHere(), "Unexpected end of file while reading a string");
+  return str;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Checkpoint
+} // Mesh
+} // CF
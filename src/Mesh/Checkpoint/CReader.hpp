@@ -0,0 +1,173 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Mesh_Checkpoint_CReader_hpp
+#define CF_Mesh_Checkpoint_CReader_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Common/MappedFile.hpp"
+
+#include "Mesh/CMeshReader.hpp"
+#include "Mesh/CList.hpp"
+#include "Mesh/CTable.hpp"
+
+#include "Mesh/Checkpoint/Shared.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+  class CRegion;
+namespace Checkpoint {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class defines the checkpoint reader.
+/// Every process maps the file in memory and reads only the header and its own block,
+/// so the mesh, its global numbering, ranks and field groups are restored exactly as they
+/// were written, without any communication or renumbering.
+/// This requires as many processes as the ones that wrote the checkpoint.
+/// The time and iteration are restored in the mesh metadata, and in the component
+/// given by the option "time" (typically a Solver::CTime), through its options "time" and "iteration".
+class Checkpoint_API CReader : public CMeshReader, public Shared
+{
+public: // typedefs
+
+  typedef boost::shared_ptr<CReader> Ptr;
+  typedef boost::shared_ptr<CReader const> ConstPtr;
+
+public: // functions
+
+  /// constructor
+  CReader( const std::string& name );
+
+  /// Gets the Class name
+  static std::string type_name() { return "CReader"; }
+
+  virtual std::string get_format() { return "Checkpoint"; }
+
+  virtual std::vector<std::string> get_extensions();
+
+private: // classes
+
+  /// Definition of a field, from the metadata record
+  struct FieldInfo
+  {
+    std::string name;
+    std::string description;
+    Uint row_size;
+  };
+
+  /// Definition of a field group, from the metadata record
+  struct FieldGroupInfo
+  {
+    std::string name;
+    std::string basis;
+    std::string space;
+    std::string topology;
+    std::vector<FieldInfo> fields;
+  };
+
+private: // functions
+
+  virtual void do_read_mesh_into(const Common::URI& path, CMesh& mesh);
+
+  /// Read the header, and check that this process can read the file
+  void read_header();
+
+  /// Read the nodes, with the other fields of the geometry
+  void read_geometry(CMesh& mesh);
+
+  /// Read the element regions of this rank
+  void read_elements(CMesh& mesh);
+
+  /// Create the field group and read its fields
+  void read_field_group(CMesh& mesh, const FieldGroupInfo& info);
+
+  /// Region at a path relative to the topology, created if necessary
+  CRegion& create_region(CRegion& topology, const std::string& path);
+
+  /// @name Binary extraction from the mapped file
+  //@{
+  template <typename T>
+  void read(T* values, const std::size_t size)
+  {
+    if (size)
+      m_file.read(reinterpret_cast<char*>(values), size*sizeof(T));
+  }
+
+  template <typename T>
+  void read(T& value) { read(&value,1u); }
+
+  std::size_t read_size();
+
+  std::string read_string();
+
+  /// Read a list, resizing it if necessary
+  template <typename T>
+  void read_list(CList<T>& list)
+  {
+    list.resize(read_size());
+    read(list.array().data(), list.size());
+  }
+
+  /// Read a table, resizing it and setting its row size if necessary
+  template <typename T>
+  void read_table(CTable<T>& table)
+  {
+    const std::size_t nb_rows = read_size();
+    const std::size_t row_size = read_size();
+    if (table.row_size() != row_size)
+      table.set_row_size(row_size);
+    table.resize(nb_rows);
+    if (!table.is_column_major())
+    {
+      read(table.array().data(), nb_rows*row_size);
+      return;
+    }
+    typename CTable<T>::ArrayT rows(boost::extents[nb_rows][row_size]);
+    read(rows.data(), nb_rows*row_size);
+    table.array() = rows;
+  }
+  //@}
+
+private: // data
+
+  /// The memory mapped file
+  Common::MappedFile m_file;
+
+  /// Offset of the block of every rank in the file
+  std::vector<boost::uint64_t> m_block_offsets;
+
+  /// Size of the block of every rank
+  std::vector<boost::uint64_t> m_block_sizes;
+
+  Uint m_dimension;
+
+  Real m_time;
+
+  Uint m_iter;
+
+  std::string m_date;
+
+  /// Field groups in the file, the geometry first
+  std::vector<FieldGroupInfo> m_field_groups;
+
+  /// Component whose time and iteration are restored
+  boost::weak_ptr<Common::Component> m_time_component;
+
+}; // end CReader
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Checkpoint
+} // Mesh
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Mesh_Checkpoint_CReader_hpp
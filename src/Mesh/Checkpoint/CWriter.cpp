@@ -0,0 +1,325 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <fstream>
+#include <limits>
+#include <set>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/Foreach.hpp"
+#include "Common/Log.hpp"
+#include "Common/CBuilder.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/MPI/PE.hpp"
+
+#include "Mesh/Checkpoint/CWriter.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CSpace.hpp"
+#include "Mesh/Geometry.hpp"
+#include "Mesh/Field.hpp"
+#include "Mesh/FieldGroup.hpp"
+#include "Mesh/MeshMetadata.hpp"
+#include "Mesh/ElementType.hpp"
+#include "Mesh/ShapeFunction.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace CF::Common;
+
+namespace CF {
+namespace Mesh {
+namespace Checkpoint {
+
+////////////////////////////////////////////////////////////////////////////////
+
+Common::ComponentBuilder < Checkpoint::CWriter, CMeshWriter, LibCheckpoint> aCheckpointWriter_Builder;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+template <typename T>
+void write_list(OutputBlock& block, const CList<T>& list)
+{
+  block.write_size(list.size());
+  block.write(list.array().data(), list.size());
+}
+
+template <typename T>
+void write_table(OutputBlock& block, const CTable<T>& table)
+{
+  block.write_size(table.size());
+  block.write_size(table.row_size());
+  if (!table.is_column_major())
+  {
+    block.write(table.array().data(), table.size()*table.row_size());
+    return;
+  }
+  // checkpoints always store the rows one after the other
+  typename CTable<T>::ArrayT rows(boost::extents[table.size()][table.row_size()]);
+  rows = table.array();
+  block.write(rows.data(), table.size()*table.row_size());
+}
+
+/// Collective write of the block of every rank at its own offset.
+/// MPI counts are int, so large blocks are written in pieces, in the same number of calls on every rank.
+void write_at_all(MPI_File file, const boost::uint64_t offset, const OutputBlock& block)
+{
+  const std::size_t max_piece_size = static_cast<std::size_t>(std::numeric_limits<int>::max());
+  const Uint nb_pieces = (block.size() + max_piece_size - 1) / max_piece_size;
+  Uint max_nb_pieces;
+  Comm::PE::instance().all_reduce(Comm::max(), &nb_pieces, 1, &max_nb_pieces);
+
+  MPI_Status status;
+  for (Uint piece=0; piece<max_nb_pieces; ++piece)
+  {
+    const std::size_t begin = std::min(piece*max_piece_size, block.size());
+    const std::size_t size = std::min(max_piece_size, block.size()-begin);
+    MPI_CHECK_RESULT(MPI_File_write_at_all, (file, static_cast<MPI_Offset>(offset+begin),
+                                             const_cast<char*>(block.data()+begin), static_cast<int>(size),
+                                             MPI_BYTE, &status));
+  }
+}
+
+} // anonymous namespace
+
+//////////////////////////////////////////////////////////////////////////////
+
+CWriter::CWriter( const std::string& name )
+: CMeshWriter(name),
+  Shared()
+{
+  m_properties["brief"] = std::string("Writes the mesh and its fields to a checkpoint file, in parallel");
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+std::vector<std::string> CWriter::get_extensions()
+{
+  std::vector<std::string> extensions;
+  extensions.push_back(".cfcp");
+  return extensions;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+void CWriter::write_from_to(const CMesh& mesh, const URI& file_path)
+{
+  m_mesh = &mesh;
+
+  select_fields();
+
+  const bool parallel = Comm::PE::instance().is_active();
+  const Uint nb_ranks = parallel ? Comm::PE::instance().size() : 1u;
+  const Uint rank     = parallel ? Comm::PE::instance().rank() : 0u;
+
+  OutputBlock block;
+  write_block(block);
+
+  OutputBlock metadata;
+  write_metadata(metadata);
+
+  // Every rank knows where every block goes, from the block sizes and the metadata size of rank 0
+
+  boost::uint64_t metadata_size = metadata.size();
+  std::vector<boost::uint64_t> block_sizes(1, block.size());
+  if (parallel)
+  {
+    Comm::PE::instance().broadcast(&metadata_size, 1, &metadata_size, 0);
+    Comm::PE::instance().all_gather(static_cast<boost::uint64_t>(block.size()), block_sizes);
+  }
+
+  std::vector<boost::uint64_t> block_offsets(nb_ranks);
+  boost::uint64_t file_size = m_header_size + 2*nb_ranks*sizeof(boost::uint64_t) + metadata_size;
+  for (Uint r=0; r<nb_ranks; ++r)
+  {
+    block_offsets[r] = file_size;
+    file_size += block_sizes[r];
+  }
+
+  OutputBlock header;
+  if (rank == 0)
+  {
+    header.write(m_magic, sizeof(m_magic));
+    header.write(m_version);
+    header.write(m_byte_order_mark);
+    header.write(static_cast<boost::uint32_t>(sizeof(Uint)));
+    header.write(static_cast<boost::uint32_t>(sizeof(Real)));
+    header.write_size(nb_ranks);
+    header.write(metadata_size);
+    cf_assert(header.size() == m_header_size);
+    header.write(&block_offsets[0], nb_ranks);
+    header.write(&block_sizes[0], nb_ranks);
+    header.write(metadata.data(), metadata.size());
+  }
+
+  const std::string path = file_path.path();
+
+  if (parallel)
+  {
+    MPI_File file;
+    MPI_CHECK_RESULT(MPI_File_open, (Comm::PE::instance().communicator(), const_cast<char*>(path.c_str()),
+                                     MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file));
+
+    // cut off what remains of an older, larger checkpoint with the same name
+    MPI_CHECK_RESULT(MPI_File_set_size, (file, static_cast<MPI_Offset>(file_size)));
+
+    if (rank == 0)
+    {
+      MPI_Status status;
+      MPI_CHECK_RESULT(MPI_File_write_at, (file, 0, const_cast<char*>(header.data()), static_cast<int>(header.size()),
+                                           MPI_BYTE, &status));
+    }
+
+    write_at_all(file, block_offsets[rank], block);
+
+    MPI_CHECK_RESULT(MPI_File_close, (&file));
+  }
+  else
+  {
+    std::ofstream file(path.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!file)
+      throw FileSystemError(FromHere(), path + " failed to open");
+    file.write(header.data(), header.size());
+    file.write(block.data(), block.size());
+    if (!file)
+      throw FileSystemError(FromHere(), "Failed to write " + path);
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+void CWriter::select_fields()
+{
+  std::set<const Field*> selected_fields;
+  boost_foreach(boost::weak_ptr<Field> field_ptr, m_fields)
+  {
+    if ( !field_ptr.expired() )
+      selected_fields.insert(field_ptr.lock().get());
+  }
+  const bool all_fields = selected_fields.empty();
+
+  m_field_groups.clear();
+  m_fields_in_group.clear();
+
+  // The geometry comes first: the coordinates are needed to restore anything else
+  const Geometry& geometry = m_mesh->geometry();
+  m_field_groups.push_back(&geometry);
+  m_fields_in_group.push_back(std::vector<const Field*>(1, &geometry.coordinates()));
+  boost_foreach(const Field& field, find_components<Field>(geometry))
+  {
+    if (&field != &geometry.coordinates() && (all_fields || selected_fields.count(&field)))
+      m_fields_in_group.back().push_back(&field);
+  }
+
+  boost_foreach(const FieldGroup& field_group, find_components<FieldGroup>(*m_mesh))
+  {
+    if (&field_group == &geometry)
+      continue;
+
+    std::vector<const Field*> fields;
+    boost_foreach(const Field& field, find_components<Field>(field_group))
+    {
+      if (all_fields || selected_fields.count(&field))
+        fields.push_back(&field);
+    }
+    if (fields.size())
+    {
+      m_field_groups.push_back(&field_group);
+      m_fields_in_group.push_back(fields);
+    }
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+void CWriter::write_metadata(OutputBlock& metadata) const
+{
+  const Uint dimension = m_mesh->dimension();
+  metadata.write_size(dimension);
+  metadata.write(m_mesh->metadata().properties().value<Real>("time"));
+  metadata.write_size(m_mesh->metadata().properties().value<Uint>("iter"));
+  metadata.write(m_mesh->metadata().properties().value_str("date"));
+
+  metadata.write_size(m_field_groups.size());
+  for (Uint g=0; g<m_field_groups.size(); ++g)
+  {
+    const FieldGroup& field_group = *m_field_groups[g];
+    metadata.write(field_group.name());
+    metadata.write(FieldGroup::Basis::to_str(field_group.basis()));
+    metadata.write(field_group.space());
+    metadata.write(relative_path(field_group.topology(), *m_mesh));
+
+    metadata.write_size(m_fields_in_group[g].size());
+    boost_foreach(const Field* field, m_fields_in_group[g])
+    {
+      metadata.write(field->name());
+      metadata.write(variables_description(*field, dimension));
+      metadata.write_size(field->row_size());
+    }
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+void CWriter::write_block(OutputBlock& block) const
+{
+  // nodes, and the other fields of the geometry
+
+  const FieldGroup& geometry = *m_field_groups[0];
+  write_list(block, geometry.glb_idx());
+  write_list(block, geometry.rank());
+  boost_foreach(const Field* field, m_fields_in_group[0])
+    write_table(block, *field);
+
+  // elements
+
+  const CRegion& topology = m_mesh->topology();
+  block.write_size(count(find_components_recursively<CElements>(topology)));
+  boost_foreach(const CElements& elements, find_components_recursively<CElements>(topology))
+  {
+    block.write(relative_path(elements, topology));
+    block.write(elements.derived_type_name());
+    block.write(elements.element_type().derived_type_name());
+
+    // spaces besides the ones created with the element type
+    std::vector<const CSpace*> spaces;
+    for (Uint s=0; elements.exists_space(s); ++s)
+    {
+      const CSpace& space = elements.space(s);
+      if (space.name() != CEntities::MeshSpaces::to_str(CEntities::MeshSpaces::SPACE0) &&
+          space.name() != CEntities::MeshSpaces::to_str(CEntities::MeshSpaces::MESH_NODES))
+        spaces.push_back(&space);
+    }
+    block.write_size(spaces.size());
+    boost_foreach(const CSpace* space, spaces)
+    {
+      block.write(space->name());
+      block.write(space->shape_function().derived_type_name());
+    }
+
+    write_table(block, elements.node_connectivity());
+    write_list(block, elements.glb_idx());
+    write_list(block, elements.rank());
+  }
+
+  // other field groups
+
+  for (Uint g=1; g<m_field_groups.size(); ++g)
+  {
+    write_list(block, m_field_groups[g]->glb_idx());
+    write_list(block, m_field_groups[g]->rank());
+    boost_foreach(const Field* field, m_fields_in_group[g])
+      write_table(block, *field);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Checkpoint
+} // Mesh
+} // CF
@@ -0,0 +1,84 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Mesh_Checkpoint_CWriter_hpp
+#define CF_Mesh_Checkpoint_CWriter_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Mesh/CMeshWriter.hpp"
+
+#include "Mesh/Checkpoint/Shared.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+  class FieldGroup;
+namespace Checkpoint {
+
+  class OutputBlock;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class defines the checkpoint writer.
+/// All processes write their own part of the mesh, in one file, with one collective
+/// MPI-IO write. Nothing is gathered on rank 0, except the size of every block.
+/// Used through WriteMesh with the extension ".cfcp", e.g. by Solver::Actions::CPeriodicWriteMesh
+/// with a file path "checkpoint-${iter}.cfcp".
+/// The geometry is always written. Other field groups are written with the selected
+/// fields only, or with all their fields if no fields are selected.
+class Checkpoint_API CWriter : public CMeshWriter, public Shared
+{
+public: // typedefs
+
+    typedef boost::shared_ptr<CWriter> Ptr;
+    typedef boost::shared_ptr<CWriter const> ConstPtr;
+
+public: // functions
+
+  /// constructor
+  CWriter( const std::string& name );
+
+  /// Gets the Class name
+  static std::string type_name() { return "CWriter"; }
+
+  virtual void write_from_to(const CMesh& mesh, const Common::URI& file);
+
+  virtual std::string get_format() { return "Checkpoint"; }
+
+  virtual std::vector<std::string> get_extensions();
+
+private: // functions
+
+  /// Select the field groups and fields to write, the geometry first
+  void select_fields();
+
+  /// Serialize the metadata record of the header
+  void write_metadata(OutputBlock& metadata) const;
+
+  /// Serialize the part of the mesh and fields of this rank
+  void write_block(OutputBlock& block) const;
+
+private: // data
+
+  /// Field groups to write
+  std::vector<const FieldGroup*> m_field_groups;
+
+  /// Fields to write, for each field group
+  std::vector< std::vector<const Field*> > m_fields_in_group;
+
+}; // end CWriter
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Checkpoint
+} // Mesh
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Mesh_Checkpoint_CWriter_hpp
@@ -0,0 +1,31 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/RegistLibrary.hpp"
+
+#include "Mesh/Checkpoint/LibCheckpoint.hpp"
+
+namespace CF {
+namespace Mesh {
+namespace Checkpoint {
+
+CF::Common::RegistLibrary<LibCheckpoint> libCheckpoint;
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LibCheckpoint::initiate_impl()
+{
+}
+
+void LibCheckpoint::terminate_impl()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Checkpoint
+} // Mesh
+} // CF
@@ -0,0 +1,88 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Mesh_Checkpoint_LibCheckpoint_hpp
+#define CF_Mesh_Checkpoint_LibCheckpoint_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Common/CLibrary.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Define the macro Checkpoint_API
+/// @note build system defines COOLFLUID_MESH_CHECKPOINT_EXPORTS when compiling Checkpoint files
+#ifdef COOLFLUID_MESH_CHECKPOINT_EXPORTS
+#   define Checkpoint_API      CF_EXPORT_API
+#   define Checkpoint_TEMPLATE
+#else
+#   define Checkpoint_API      CF_IMPORT_API
+#   define Checkpoint_TEMPLATE CF_TEMPLATE_EXTERN
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+  
+/// @brief Library for I/O of the native checkpoint format
+namespace Checkpoint {
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Class defines the native checkpoint/restart format operations
+class Checkpoint_API LibCheckpoint :
+    public Common::CLibrary
+{
+public:
+
+  typedef boost::shared_ptr<LibCheckpoint> Ptr;
+  typedef boost::shared_ptr<LibCheckpoint const> ConstPtr;
+
+  /// Constructor
+  LibCheckpoint ( const std::string& name) : Common::CLibrary(name) {   }
+
+  /// @return string of the library namespace
+  static std::string library_namespace() { return "CF.Mesh.Checkpoint"; }
+
+  /// Static function that returns the library name.
+  /// Must be implemented for CLibrary registration
+  /// @return name of the library
+  static std::string library_name() { return "Checkpoint"; }
+
+  /// Static function that returns the description of the library.
+  /// Must be implemented for CLibrary registration
+  /// @return description of the library
+
+  static std::string library_description()
+  {
+    return "This library implements a native binary checkpoint/restart format for meshes and fields.";
+  }
+
+  /// Gets the Class name
+  static std::string type_name() { return "LibCheckpoint"; }
+
+protected:
+
+  /// initiate library
+  virtual void initiate_impl();
+
+  /// terminate library
+  virtual void terminate_impl();
+
+}; // end LibCheckpoint
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Checkpoint
+} // Mesh
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Mesh_Checkpoint_LibCheckpoint_hpp
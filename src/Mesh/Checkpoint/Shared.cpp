@@ -0,0 +1,81 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/Component.hpp"
+#include "Common/StringConversion.hpp"
+
+#include "Mesh/Field.hpp"
+
+#include "Mesh/Checkpoint/Shared.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+namespace Checkpoint {
+
+using namespace Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+const char Shared::m_magic[8] = { 'C', 'F', '3', 'C', 'K', 'P', 'N', 'T' };
+
+const boost::uint32_t Shared::m_version;
+const boost::uint32_t Shared::m_byte_order_mark;
+const boost::uint64_t Shared::m_header_size;
+
+//////////////////////////////////////////////////////////////////////////////
+
+Shared::Shared()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+std::string Shared::relative_path(const Component& component, const Component& parent)
+{
+  std::string path;
+  const Component* comp = &component;
+  while (comp != &parent)
+  {
+    if ( !comp->has_parent() )
+      throw BadValue(FromHere(), component.uri().string() + " is not inside " + parent.uri().string());
+    path = path.empty() ? comp->name() : comp->name() + "/" + path;
+    comp = &comp->parent();
+  }
+  return path;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+std::string Shared::variables_description(const Field& field, const Uint dimension)
+{
+  std::string description;
+  for (Uint var=0; var<field.nb_vars(); ++var)
+  {
+    const Uint var_length = static_cast<Uint>(field.var_length(var));
+    std::string var_type;
+    if (var_length == 1u)
+      var_type = "scalar";
+    else if (var_length == dimension)
+      var_type = "vector";
+    else if (var_length == dimension*dimension)
+      var_type = "tensor";
+    else
+      throw NotSupported(FromHere(), "Variable " + field.var_name(var) + " of field " + field.uri().string()
+                                     + " has length " + to_str(var_length) + ", which is not a scalar, vector or tensor");
+
+    description += (var == 0 ? "" : ",") + field.var_name(var) + "[" + var_type + "]";
+  }
+  return description;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+} // Checkpoint
+} // Mesh
+} // CF
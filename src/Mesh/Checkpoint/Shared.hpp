@@ -0,0 +1,121 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Mesh_Checkpoint_Shared_hpp
+#define CF_Mesh_Checkpoint_Shared_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/cstdint.hpp>
+
+#include "Mesh/Checkpoint/LibCheckpoint.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Common { class Component; }
+namespace Mesh {
+  class Field;
+namespace Checkpoint {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class defines the layout of the checkpoint format, common to the reader and the writer.
+///
+/// A checkpoint is one file for all processes, made of
+/// - a header, written by rank 0:
+///   - the magic string, the format version, a byte order mark and the sizes of Uint and Real
+///   - the number of ranks that wrote the file
+///   - the size of the metadata record
+///   - the offset and size of every rank block
+///   - the metadata record: dimensions, time and iteration of the mesh,
+///     and every field group with the variables of its fields
+/// - one contiguous block per rank, with the nodes, elements and field data of that rank,
+///   in its own numbering.
+///
+/// Strings are stored as their length followed by their characters, all sizes as 64-bit unsigned integers.
+/// Data is stored in the native byte order: a checkpoint is a restart file for the machine that wrote it.
+class Checkpoint_API Shared
+{
+public:
+
+  /// constructor
+  Shared();
+
+  /// Gets the Class name
+  static std::string type_name() { return "Shared"; }
+
+protected: // functions
+
+  /// Path of a component relative to one of its parents, empty if they are the same
+  static std::string relative_path(const Common::Component& component, const Common::Component& parent);
+
+  /// Description of the variables of a field, in the syntax of Math::VariablesDescriptor::set_variables().
+  /// Unlike Math::VariablesDescriptor::description(), vectors and tensors are not expanded to scalars.
+  static std::string variables_description(const Field& field, const Uint dimension);
+
+protected: // data
+
+  /// Identification of the file format, 8 characters
+  static const char m_magic[8];
+
+  /// Version of the format, incremented on every incompatible change
+  static const boost::uint32_t m_version = 1u;
+
+  /// Reads back as a different number in a file written with a different byte order
+  static const boost::uint32_t m_byte_order_mark = 0x01020304u;
+
+  /// Size in bytes of the header before the rank table
+  static const boost::uint64_t m_header_size = 40u;
+
+}; // end Shared
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Growable byte buffer in which the records of a checkpoint are serialized
+class Checkpoint_API OutputBlock
+{
+public:
+
+  /// Append an array of plain values
+  template <typename T>
+  void write(const T* values, const std::size_t size)
+  {
+    const char* bytes = reinterpret_cast<const char*>(values);
+    m_data.insert(m_data.end(), bytes, bytes + size*sizeof(T));
+  }
+
+  /// Append one plain value
+  template <typename T>
+  void write(const T& value) { write(&value,1u); }
+
+  /// Append a string, preceded by its length
+  void write(const std::string& str) { write_size(str.size()); write(str.data(),str.size()); }
+
+  /// Append a size or count, always as a 64-bit unsigned integer
+  void write_size(const std::size_t size) { write(static_cast<boost::uint64_t>(size)); }
+
+  /// The serialized bytes
+  const char* data() const { return m_data.empty() ? 0 : &m_data[0]; }
+
+  /// Number of serialized bytes
+  std::size_t size() const { return m_data.size(); }
+
+private:
+
+  std::vector<char> m_data;
+
+}; // end OutputBlock
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Checkpoint
+} // Mesh
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Mesh_Checkpoint_Shared_hpp
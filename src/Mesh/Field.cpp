@@ -131,6 +131,40 @@ Uint Field::var_index ( const Uint var_nb ) const
 
 //////////////////////////////////////////////////////////////////////////////
 
+Eigen::Map<RealVector> Field::column(const Uint j)
+{
+  cf_assert(has_contiguous_columns());
+  cf_assert(j < row_size());
+  return Eigen::Map<RealVector>(array().data() + j*size(), size());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+Eigen::Map<const RealVector> Field::column(const Uint j) const
+{
+  cf_assert(has_contiguous_columns());
+  cf_assert(j < row_size());
+  return Eigen::Map<const RealVector>(array().data() + j*size(), size());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+Eigen::Map<RealMatrix> Field::variable(const Uint var_nb)
+{
+  cf_assert(has_contiguous_columns());
+  return Eigen::Map<RealMatrix>(array().data() + var_index(var_nb)*size(), size(), var_length(var_nb));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+Eigen::Map<const RealMatrix> Field::variable(const Uint var_nb) const
+{
+  cf_assert(has_contiguous_columns());
+  return Eigen::Map<const RealMatrix>(array().data() + var_index(var_nb)*size(), size(), var_length(var_nb));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 Field::VarType Field::var_length(const Uint var_nb) const
 {
   return (Field::VarType)descriptor().var_length(var_nb);
@@ -228,12 +262,40 @@ CommPattern& Field::parallelize()
 }
 
 
+void Field::set_layout(const Layout layout)
+{
+  if ( layout == this->layout() )
+    return;
+
+  synchronize_end();
+  set_column_major(layout == VARIABLE_MAJOR);
+
+  // the comm pattern refers to the array that was replaced
+  if ( !m_comm_pattern.expired() )
+    m_comm_pattern.lock()->get_child(name()).as_type< CommWrapperMArray<Real,2> >().setup(array(),true);
+}
+
+
 void Field::synchronize()
 {
   if ( !m_comm_pattern.expired() )
     m_comm_pattern.lock()->synchronize( name() );
 }
 
+
+void Field::synchronize_begin()
+{
+  if ( !m_comm_pattern.expired() )
+    m_comm_pattern.lock()->synchronize_begin( name() );
+}
+
+
+void Field::synchronize_end()
+{
+  if ( !m_comm_pattern.expired() )
+    m_comm_pattern.lock()->synchronize_end( name() );
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 
 void Field::set_descriptor(Math::VariablesDescriptor& descriptor)
@@ -7,6 +7,8 @@
 #ifndef CF_Mesh_Field_hpp
 #define CF_Mesh_Field_hpp
 
+#include "Math/MatrixTypes.hpp"
+
 #include "Mesh/FieldGroup.hpp"
 #include "Mesh/CTable.hpp"
 #include "Mesh/CEntities.hpp"
@@ -41,6 +43,10 @@ public: // typedefs
 
   enum VarType { SCALAR=1, VECTOR_2D=2, VECTOR_3D=3, TENSOR_2D=4, TENSOR_3D=9};
 
+  /// Storage of the values: all variables of a row together (the default),
+  /// or every variable contiguous for all rows, so that pointwise updates of the whole field vectorize
+  enum Layout { ROW_MAJOR=0, VARIABLE_MAJOR=1 };
+
 public: // functions
 
   /// Contructor
@@ -79,6 +85,27 @@ public: // functions
   /// Return the length (in number of Real values occupied in the data row) of the variable of the given var number
   VarType var_length(const Uint i=0) const;
 
+  Layout layout() const { return is_column_major() ? VARIABLE_MAJOR : ROW_MAJOR; }
+
+  /// Change the storage of the values, keeping them. Rows remain accessible through operator[].
+  /// The array is replaced, see CTable::set_column_major(). A parallel field is synchronized from the new array.
+  void set_layout(const Layout layout);
+
+  /// True if column() and variable() may be used
+  bool has_contiguous_columns() const { return is_column_major() || row_size() == 1; }
+
+  /// Values of one column for all rows
+  /// @pre has_contiguous_columns()
+  Eigen::Map<RealVector> column(const Uint j);
+
+  Eigen::Map<const RealVector> column(const Uint j) const;
+
+  /// Values of all components of one variable for all rows, one column per component
+  /// @pre has_contiguous_columns()
+  Eigen::Map<RealMatrix> variable(const Uint var_nb);
+
+  Eigen::Map<const RealMatrix> variable(const Uint var_nb) const;
+
   void set_topology(CRegion& topology);
 
   CRegion& topology() const;
@@ -115,6 +142,13 @@ public: // functions
 
   void synchronize();
 
+  /// Start the synchronization of the ghost rows, without waiting for its completion
+  /// The ghost rows may only be read after synchronize_end()
+  void synchronize_begin();
+
+  /// Complete the synchronization started by synchronize_begin(), does nothing if none is in progress
+  void synchronize_end();
+
   CUnifiedData& elements_lookup() const { return field_group().elements_lookup(); }
 
   Math::VariablesDescriptor& descriptor() const { return *m_descriptor.lock(); }
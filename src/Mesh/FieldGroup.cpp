@@ -53,6 +53,18 @@ Common::ComponentBuilder < FieldGroup, Component, LibMesh >  FieldGroup_Builder;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+/// layout of the fields of a group, from its option "layout"
+Field::Layout field_layout(const FieldGroup& group)
+{
+  return group.option("layout").value<std::string>() == "variable_major" ? Field::VARIABLE_MAJOR : Field::ROW_MAJOR;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 FieldGroup::Basis::Convert::Convert()
 {
   all_fwd = boost::assign::map_list_of
@@ -109,6 +121,15 @@ FieldGroup::FieldGroup ( const std::string& name  ) :
     ->attach_trigger ( boost::bind ( &FieldGroup::config_space,   this ) )
     ->mark_basic();
 
+  // Option "layout"
+  m_options.add_option< OptionT<std::string> >("layout", std::string("row_major"))
+    ->description("Storage of the field values: row_major keeps the variables of a row together, "
+                  "variable_major keeps the values of one variable for all rows together")
+    ->attach_trigger ( boost::bind ( &FieldGroup::config_layout,   this ) );
+  option("layout").restricted_list() =  list_of
+      (std::string("row_major"))
+      (std::string("variable_major"));
+
   // Static components
   m_topology = create_static_component_ptr<CLink>("topology");
   m_elements_lookup = create_static_component_ptr<CUnifiedData>("elements_lookup");
@@ -164,6 +185,14 @@ void FieldGroup::config_space()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void FieldGroup::config_layout()
+{
+  boost_foreach(Field& field, find_components<Field>(*this))
+    field.set_layout(field_layout(*this));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 FieldGroup::~FieldGroup()
 {
 }
@@ -208,6 +237,7 @@ Field& FieldGroup::create_field(const std::string &name, const std::string& vari
   field.set_field_group(*this);
   field.set_topology(topology());
   field.set_basis(m_basis);
+  field.set_layout(field_layout(*this));
 
   if (variables_description == "scalar_same_name")
     field.create_descriptor(name+"[scalar]",parent().as_type<CMesh>().dimension());
@@ -251,6 +281,7 @@ Field& FieldGroup::create_field(const std::string &name, Math::VariablesDescript
   field.set_field_group(*this);
   field.set_topology(topology());
   field.set_basis(m_basis);
+  field.set_layout(field_layout(*this));
   field.set_descriptor(variables_descriptor);
   field.descriptor().configure_option(Common::Tags::dimension(),parent().as_type<CMesh>().dimension());
   field.resize(m_size);
@@ -406,7 +437,27 @@ void FieldGroup::bind_space()
     entities.space(m_space).get_child("bound_fields").as_type<CLink>().link_to(*this);
 }
 
-std::size_t hash_value(const RealMatrix& coords)
+////////////////////////////////////////////////////////////////////////////////
+
+/// Values of the geometric shape function at the nodes of a space, one row per node of the space,
+/// so that the coordinates of the space nodes of an element are interpolation * element coordinates
+void compute_interpolation(const CEntities& entities, const std::string& space, RealMatrix& interpolation)
+{
+  const ShapeFunction& geometric_sf = entities.element_type().shape_function();
+  const RealMatrix& local_coordinates = entities.space(space).shape_function().local_coordinates();
+  RealRowVector values(geometric_sf.nb_nodes());
+  interpolation.resize(local_coordinates.rows(),geometric_sf.nb_nodes());
+  for (Uint node=0; node<local_coordinates.rows(); ++node)
+  {
+    geometric_sf.put_value(local_coordinates.row(node),values);
+    interpolation.row(node) = values;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename MatrixT>
+std::size_t hash_value(const Eigen::MatrixBase<MatrixT>& coords)
 {
   std::size_t seed=0;
   for (Uint i=0; i<coords.rows(); ++i)
@@ -432,20 +483,24 @@ void FieldGroup::create_connectivity_in_space()
   {
     std::set<std::size_t> points;
     RealMatrix elem_coordinates;
+    RealMatrix space_coordinates;
+    RealMatrix interpolation;
     Uint dim = DIM_0D;
 
     // step 1: collect nodes in a set
     // ------------------------------
     boost_foreach(CEntities& entities, elements_range())
     {
-      const ShapeFunction& shape_function = entities.space(m_space).shape_function();
+      compute_interpolation(entities, m_space, interpolation);
+      entities.allocate_coordinates(elem_coordinates);
+      space_coordinates.resize(interpolation.rows(),elem_coordinates.cols());
       for (Uint elem=0; elem<entities.size(); ++elem)
       {
-        elem_coordinates = entities.get_coordinates(elem);
-        for (Uint node=0; node<shape_function.nb_nodes(); ++node)
+        entities.put_coordinates(elem_coordinates,elem);
+        space_coordinates.noalias() = interpolation * elem_coordinates;
+        for (Uint node=0; node<space_coordinates.rows(); ++node)
         {
-          RealVector space_coordinates = entities.element_type().shape_function().value(shape_function.local_coordinates().row(node)) * elem_coordinates ;
-          std::size_t hash = hash_value(space_coordinates);
+          std::size_t hash = hash_value(space_coordinates.row(node));
           points.insert( hash );
         }
       }
@@ -464,16 +519,19 @@ void FieldGroup::create_connectivity_in_space()
       CConnectivity& connectivity = entities.space(m_space).connectivity();
       connectivity.set_row_size(shape_function.nb_nodes());
       connectivity.resize(entities.size());
+      compute_interpolation(entities, m_space, interpolation);
+      entities.allocate_coordinates(elem_coordinates);
+      space_coordinates.resize(interpolation.rows(),elem_coordinates.cols());
       for (Uint elem=0; elem<entities.size(); ++elem)
       {
-        elem_coordinates = entities.get_coordinates(elem);
+        entities.put_coordinates(elem_coordinates,elem);
+        space_coordinates.noalias() = interpolation * elem_coordinates;
         for (Uint node=0; node<shape_function.nb_nodes(); ++node)
         {
-          RealVector space_coordinates = entities.element_type().shape_function().value(shape_function.local_coordinates().row(node)) * elem_coordinates ;
-          std::size_t hash = hash_value(space_coordinates);
+          std::size_t hash = hash_value(space_coordinates.row(node));
           Uint idx = std::distance(points.begin(), points.find(hash));
           connectivity[elem][node] = idx;
-          coordinates.set_row(idx, space_coordinates);
+          coordinates.set_row(idx, space_coordinates.row(node));
         }
       }
     }
@@ -493,7 +551,7 @@ void FieldGroup::create_connectivity_in_space()
     // Check if this space is not already bound to another field_group
     boost_foreach(CEntities& entities, entities_range())
     {
-      if (entities.space(m_space).is_bound_to_fields() > 0)
+      if (entities.space(m_space).is_bound_to_fields() && &entities.space(m_space).bound_fields() != this)
         throw SetupError(FromHere(), "Space ["+entities.space(m_space).uri().string()+"] is already bound to\n"
                          "fields ["+entities.space(m_space).bound_fields().uri().string()+"]\nCreate a new space for field_group ["+uri().string()+"]");
     }
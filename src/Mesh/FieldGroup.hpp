@@ -145,6 +145,9 @@ private: // functions
 
   void config_type();
 
+  /// Stores the values of all fields in the configured layout
+  void config_layout();
+
   /// Triggered when the event mesh_changed
   void on_mesh_changed_event( Common::SignalArgs& args );
 
@@ -7,6 +7,8 @@
 #include <boost/foreach.hpp>
 #include <boost/tokenizer.hpp>
 
+#include <algorithm>
+
 #include "Common/Log.hpp"
 #include "Common/CBuilder.hpp"
 #include "Common/FindComponents.hpp"
@@ -47,7 +49,13 @@ CF::Common::ComponentBuilder < Gmsh::CReader, CMeshReader, LibGmsh> aGmshReader_
 
 CReader::CReader( const std::string& name )
 : CMeshReader(name),
-  Shared()
+  Shared(),
+  m_current_node(0),
+  m_binary(false),
+  m_swap_bytes(false),
+  m_elements_in_block(0),
+  m_block_element_type(0),
+  m_block_nb_tags(0)
 {
 
   // options
@@ -72,6 +80,7 @@ CReader::CReader( const std::string& name )
   std::string desc;
   desc += "This component can read in parallel.\n";
   desc += "It can also read multiple files in serial, combining them in one large mesh.\n";
+  desc += "Both the ASCII and the binary variant of the MSH 2 format are read.\n";
   desc += "Available coolfluid-element types are:\n";
   BOOST_FOREACH(const std::string& supported_type, m_supported_types)
   desc += "  - " + supported_type + "\n";
@@ -97,7 +106,7 @@ void CReader::do_read_mesh_into(const URI& file, CMesh& mesh)
   if( boost::filesystem::exists(fp) )
   {
     CFinfo <<  "Opening file " <<  fp.string() << CFendl;
-    m_file.open(fp,std::ios_base::in); // exists so open it
+    m_file.open(fp); // exists so map it in memory
   }
   else // doesnt exist so throw exception
   {
@@ -162,6 +171,7 @@ void CReader::do_read_mesh_into(const URI& file, CMesh& mesh)
 void CReader::get_file_positions()
 {
 
+  std::string mesh_format("$MeshFormat");
   std::string region_names("$PhysicalNames");
   std::string nodes("$Nodes");
   std::string elements("$Elements");
@@ -173,88 +183,127 @@ void CReader::get_file_positions()
   m_node_data_positions.clear();
   m_element_node_data_positions.clear();
 
-  int p;
-  std::string line;
-  while (!m_file.eof())
-  {
-    p = m_file.tellg();
-    getline(m_file,line);
-    if (line.find(region_names)!=std::string::npos) {
-      m_region_names_position=p;
-      m_file >> m_nb_regions;
-      m_region_list.resize(m_nb_regions);
+  m_binary = false;
+  m_swap_bytes = false;
+  m_mesh_format_position = 0;
 
-      m_nb_gmsh_elem_in_region.resize(m_nb_regions);
-      for(Uint ir = 0; ir < m_nb_regions; ++ir)
-      {
-        m_nb_gmsh_elem_in_region[ir].resize(Shared::nb_gmsh_types);
-        for(Uint type = 0; type < Shared::nb_gmsh_types; ++ type)
-           (m_nb_gmsh_elem_in_region[ir])[type] = 0;
-      }
+  // In parallel only the root scans the whole file,
+  // the other processes only read the parts they own
+  const bool parallel = Comm::PE::instance().is_active() && Comm::PE::instance().size() > 1;
+  const Uint root = 0;
 
-      std::string tempstr;
-      m_mesh_dimension = DIM_1D;
-      for(Uint ir = 0; ir < m_nb_regions; ++ir)
+  if (!parallel || Comm::PE::instance().rank() == root)
+  {
+    MappedFile::Position p;
+    std::string line;
+    while (!m_file.eof())
+    {
+      p = m_file.position();
+      m_file.get_line(line);
+      if (line.find(mesh_format)!=std::string::npos)
       {
-        m_file >> m_region_list[ir].dim;
-        m_mesh_dimension = std::max(m_region_list[ir].dim,m_mesh_dimension);
-        m_file >> m_region_list[ir].index;
-        //The original name of the region in the mesh file has quotes, we want to strip them off
-        m_file >> tempstr;
-        m_region_list[ir].name = tempstr.substr(1,tempstr.length()-2);
-        m_region_list[ir].region = create_region(m_region_list[ir].name);
+        m_mesh_format_position=p;
+        read_mesh_format();
       }
-    }
-    else if (line.find(nodes)!=std::string::npos) {
-      m_coordinates_position=p;
-      m_file >> m_total_nb_nodes;
-      //CFinfo << "The total number of nodes is " << m_total_nb_nodes << CFendl;
-    }
-    else if (line.find(elements)!=std::string::npos)
-    {
-      m_elements_position = p;
-      m_file >> m_total_nb_elements;
-      //CFinfo << "The total number of elements is " << m_total_nb_elements << CFendl;
+      else if (line.find(region_names)!=std::string::npos) {
+        m_region_names_position=p;
+        read_physical_names();
+      }
+      else if (line.find(nodes)!=std::string::npos) {
+        m_coordinates_position=p;
+        m_file >> m_total_nb_nodes;
+        //CFinfo << "The total number of nodes is " << m_total_nb_nodes << CFendl;
+        m_file.skip_line();
+        // skip the nodes: node-number x y z
+        if (m_binary)
+          m_file.seek_relative(m_total_nb_nodes*node_record_size());
+        else
+          m_file.skip_lines(m_total_nb_nodes);
+      }
+      else if (line.find(elements)!=std::string::npos)
+      {
+        m_elements_position = p;
+        m_file >> m_total_nb_elements;
+        //CFinfo << "The total number of elements is " << m_total_nb_elements << CFendl;
+        m_file.skip_line();
 
-      //Create a hash
-      m_hash = create_component_ptr<CMixedHash>("hash");
-      std::vector<Uint> num_obj(2);
-      num_obj[0] = m_total_nb_nodes;
-      num_obj[1] = m_total_nb_elements;
-      m_hash->configure_option("nb_obj",num_obj);
+        create_hash();
 
+        const CHash& elem_hash = m_hash->subhash(ELEMS);
+        const Uint nb_parts = elem_hash.option("nb_parts").value<Uint>();
+        m_element_part_positions.resize(nb_parts);
 
-      Uint elem_idx, elem_type, nb_tags, phys_tag;
+        Uint elem_idx, elem_type, phys_tag;
+        std::vector<Uint> elem_nodes;
 
-      //Let's count how many elements of each type are present
-      for(Uint ie = 0; ie < m_total_nb_elements; ++ie)
-      {
-          m_file >> elem_idx;
-          m_file >> elem_type;
-          m_file >> nb_tags;
-          m_file >> phys_tag;
+        // Store where every part starts, and which element types are present in each region
+        Uint part = 0;
+        m_elements_in_block = 0;
+        for(Uint ie = 0; ie < m_total_nb_elements; ++ie)
+        {
+          while (part < nb_parts && elem_hash.start_idx_in_part(part) == ie)
+          {
+            ElementPosition& part_position = m_element_part_positions[part++];
+            part_position.position = m_file.position();
+            part_position.elements_in_block = m_elements_in_block;
+            part_position.block_element_type = m_block_element_type;
+            part_position.block_nb_tags = m_block_nb_tags;
+          }
+          read_element(elem_idx,elem_type,phys_tag,elem_nodes);
           cf_assert(phys_tag > 0);
-          getline(m_file,line);
-          if (m_hash->subhash(ELEMS).owns(ie))
-            (m_nb_gmsh_elem_in_region[phys_tag-1])[elem_type]++;
           m_region_list[phys_tag-1].element_types.insert(elem_type);
+        }
       }
+      else if (line.find(element_data)!=std::string::npos)
+      {
+        m_element_data_positions.push_back(p);
+        if (m_binary)
+          skip_binary_data(p,false);
+      }
+      else if (line.find(element_node_data)!=std::string::npos) // before "$NodeData", which it contains
+      {
+        m_element_node_data_positions.push_back(p);
+        if (m_binary)
+          skip_binary_data(p,true);
+      }
+      else if (line.find(node_data)!=std::string::npos)
+      {
+        m_node_data_positions.push_back(p);
+        if (m_binary)
+          skip_binary_data(p,false);
+      }
+
     }
-    else if (line.find(element_data)!=std::string::npos)
-    {
-      m_element_data_positions.push_back(p);
-    }
-    else if (line.find(node_data)!=std::string::npos)
+
+    // Store where every part of the nodes starts
+    const CHash& node_hash = m_hash->subhash(NODES);
+    const Uint nb_parts = node_hash.option("nb_parts").value<Uint>();
+    m_node_part_positions.resize(nb_parts);
+    m_file.seek(m_coordinates_position);
+    m_file.skip_lines(2);
+    if (m_binary)
     {
-      m_node_data_positions.push_back(p);
+      for (Uint part=0; part<nb_parts; ++part)
+        m_node_part_positions[part] = m_file.position() + node_hash.start_idx_in_part(part)*node_record_size();
     }
-    else if (line.find(element_data)!=std::string::npos)
+    else
     {
-      m_element_node_data_positions.push_back(p);
+      Uint part = 0;
+      for (Uint n=0; n<m_total_nb_nodes; ++n)
+      {
+        while (part < nb_parts && node_hash.start_idx_in_part(part) == n)
+          m_node_part_positions[part++] = m_file.position();
+        m_file.skip_line();
+      }
+      while (part < nb_parts)
+        m_node_part_positions[part++] = m_file.position();
     }
-
   }
-  m_file.clear();
+
+  if (parallel)
+    broadcast_file_positions(root);
+
+  count_owned_elements();
 
   if (m_element_node_data_positions.size())
     CFwarn << "ElementNodeData record(s) found. The Gmsh reader has not implemented reading this record yet. They will be ignored" << CFendl;
@@ -285,6 +334,237 @@ void CReader::get_file_positions()
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+void CReader::broadcast_file_positions(const Uint root)
+{
+  // positions packed as:
+  // mesh_format region_names coordinates elements
+  // nb_element_data element_data... nb_node_data node_data... nb_element_node_data element_node_data...
+  // node_parts... element_parts(position elements_in_block block_element_type block_nb_tags)...
+  // nb_region_types (region type)...
+  std::vector<MappedFile::Position> positions;
+  const bool is_root = (Comm::PE::instance().rank() == root);
+
+  if (is_root)
+  {
+    positions.push_back(m_mesh_format_position);
+    positions.push_back(m_region_names_position);
+    positions.push_back(m_coordinates_position);
+    positions.push_back(m_elements_position);
+    positions.push_back(m_element_data_positions.size());
+    positions.insert(positions.end(),m_element_data_positions.begin(),m_element_data_positions.end());
+    positions.push_back(m_node_data_positions.size());
+    positions.insert(positions.end(),m_node_data_positions.begin(),m_node_data_positions.end());
+    positions.push_back(m_element_node_data_positions.size());
+    positions.insert(positions.end(),m_element_node_data_positions.begin(),m_element_node_data_positions.end());
+    positions.insert(positions.end(),m_node_part_positions.begin(),m_node_part_positions.end());
+    boost_foreach(const ElementPosition& part_position, m_element_part_positions)
+    {
+      positions.push_back(part_position.position);
+      positions.push_back(part_position.elements_in_block);
+      positions.push_back(part_position.block_element_type);
+      positions.push_back(part_position.block_nb_tags);
+    }
+    MappedFile::Position nb_region_types = 0;
+    boost_foreach(const RegionData& region_data, m_region_list)
+      nb_region_types += region_data.element_types.size();
+    positions.push_back(nb_region_types);
+    for(Uint ir = 0; ir < m_nb_regions; ++ir)
+    {
+      boost_foreach(const Uint etype, m_region_list[ir].element_types)
+      {
+        positions.push_back(ir);
+        positions.push_back(etype);
+      }
+    }
+  }
+
+  std::vector<MappedFile::Position> received;
+  Comm::PE::instance().broadcast(positions,received,root);
+
+  if (is_root)
+    return;
+
+  std::vector<MappedFile::Position>::const_iterator it = received.begin();
+  m_mesh_format_position = *it++;
+  m_region_names_position = *it++;
+  m_coordinates_position = *it++;
+  m_elements_position = *it++;
+  m_element_data_positions.assign(it+1,it+1+*it);
+  it += 1+*it;
+  m_node_data_positions.assign(it+1,it+1+*it);
+  it += 1+*it;
+  m_element_node_data_positions.assign(it+1,it+1+*it);
+  it += 1+*it;
+
+  // the small header sections are read by every process
+  m_file.seek(m_mesh_format_position);
+  m_file.skip_line();
+  read_mesh_format();
+
+  m_file.seek(m_region_names_position);
+  m_file.skip_line();
+  read_physical_names();
+
+  m_file.seek(m_coordinates_position);
+  m_file.skip_line();
+  m_file >> m_total_nb_nodes;
+
+  m_file.seek(m_elements_position);
+  m_file.skip_line();
+  m_file >> m_total_nb_elements;
+
+  create_hash();
+
+  const Uint nb_parts = m_hash->subhash(NODES).option("nb_parts").value<Uint>();
+  m_node_part_positions.assign(it,it+nb_parts);
+  it += nb_parts;
+  m_element_part_positions.resize(nb_parts);
+  boost_foreach(ElementPosition& part_position, m_element_part_positions)
+  {
+    part_position.position = *it++;
+    part_position.elements_in_block = *it++;
+    part_position.block_element_type = *it++;
+    part_position.block_nb_tags = *it++;
+  }
+  const MappedFile::Position nb_region_types = *it++;
+  for (Uint i=0; i<nb_region_types; ++i, it+=2)
+    m_region_list[*it].element_types.insert(*(it+1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CReader::read_mesh_format()
+{
+  std::string version;
+  Uint file_type, data_size;
+  m_file >> version >> file_type >> data_size;
+  m_file.skip_line();
+  m_binary = (file_type == 1);
+  if (m_binary)
+  {
+    if (data_size != sizeof(Real))
+      throw FileFormatError(FromHere(),"Binary Gmsh file must have data-size "+to_str(sizeof(Real))+". Found: "+to_str(data_size));
+
+    // the integer 1, to detect the endianness
+    int one;
+    m_file.read(reinterpret_cast<char*>(&one),sizeof(int));
+    if (one != 1)
+    {
+      std::reverse(reinterpret_cast<char*>(&one),reinterpret_cast<char*>(&one)+sizeof(int));
+      if (one != 1)
+        throw FileFormatError(FromHere(),"Binary Gmsh file has a corrupt $MeshFormat section");
+      m_swap_bytes = true;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CReader::read_physical_names()
+{
+  m_file >> m_nb_regions;
+  m_region_list.resize(m_nb_regions);
+
+  m_nb_gmsh_elem_in_region.resize(m_nb_regions);
+  for(Uint ir = 0; ir < m_nb_regions; ++ir)
+  {
+    m_nb_gmsh_elem_in_region[ir].resize(Shared::nb_gmsh_types);
+    for(Uint type = 0; type < Shared::nb_gmsh_types; ++ type)
+       (m_nb_gmsh_elem_in_region[ir])[type] = 0;
+  }
+
+  std::string tempstr;
+  m_mesh_dimension = DIM_1D;
+  for(Uint ir = 0; ir < m_nb_regions; ++ir)
+  {
+    m_file >> m_region_list[ir].dim;
+    m_mesh_dimension = std::max(m_region_list[ir].dim,m_mesh_dimension);
+    m_file >> m_region_list[ir].index;
+    //The original name of the region in the mesh file has quotes, we want to strip them off
+    m_file >> tempstr;
+    m_region_list[ir].name = tempstr.substr(1,tempstr.length()-2);
+    m_region_list[ir].region = create_region(m_region_list[ir].name);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CReader::create_hash()
+{
+  m_hash = create_component_ptr<CMixedHash>("hash");
+  std::vector<Uint> num_obj(2);
+  num_obj[0] = m_total_nb_nodes;
+  num_obj[1] = m_total_nb_elements;
+  m_hash->configure_option("nb_obj",num_obj);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CReader::count_owned_elements()
+{
+  const CHash& elem_hash = m_hash->subhash(ELEMS);
+  const Uint begin = elem_hash.start_idx_in_proc(Comm::PE::instance().rank());
+  const Uint end = elem_hash.end_idx_in_proc(Comm::PE::instance().rank());
+  if (begin == end)
+    return;
+
+  Uint elem_idx, elem_type, phys_tag;
+  std::vector<Uint> elem_nodes;
+
+  go_to_element(begin);
+  for(Uint ie = begin; ie < end; ++ie)
+  {
+    read_element(elem_idx,elem_type,phys_tag,elem_nodes);
+    (m_nb_gmsh_elem_in_region[phys_tag-1])[elem_type]++;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CReader::go_to_element(const Uint element_idx)
+{
+  const CHash& elem_hash = m_hash->subhash(ELEMS);
+  const Uint part = elem_hash.part_of_obj(element_idx);
+  const ElementPosition& part_position = m_element_part_positions[part];
+  m_file.seek(part_position.position);
+  m_elements_in_block = part_position.elements_in_block;
+  m_block_element_type = part_position.block_element_type;
+  m_block_nb_tags = part_position.block_nb_tags;
+
+  Uint elem_number, elem_type, phys_tag;
+  std::vector<Uint> elem_nodes;
+  for (Uint ie=elem_hash.start_idx_in_part(part); ie<element_idx; ++ie)
+    read_element(elem_number,elem_type,phys_tag,elem_nodes);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CReader::go_to_node(const Uint node_idx)
+{
+  const CHash& node_hash = m_hash->subhash(NODES);
+  const Uint part = node_hash.part_of_obj(node_idx);
+  const Uint part_begin = node_hash.start_idx_in_part(part);
+
+  if (m_binary)
+  {
+    m_file.seek(m_node_part_positions[part] + (node_idx-part_begin)*node_record_size());
+  }
+  else
+  {
+    // jump to the first node of the part, unless the node is further in the current part
+    if (m_current_node > node_idx || m_current_node < part_begin)
+    {
+      m_file.seek(m_node_part_positions[part]);
+      m_current_node = part_begin;
+    }
+    m_file.skip_lines(node_idx-m_current_node);
+  }
+  m_current_node = node_idx;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 CRegion::Ptr CReader::create_region(std::string const& relative_path)
@@ -313,158 +593,103 @@ void CReader::find_ghost_nodes()
   // Only find ghost nodes if the domain is split up
   if (option("nb_parts").value<Uint>() > 1)
   {
-    m_file.seekg(m_elements_position,std::ios::beg);
-    // skip next line
-    std::string line;
-    getline(m_file,line);
-
-    //Skip the line containing the actual number of elements
-    getline(m_file,line);
-
-
-    // read every line and store the connectivity in the correct region through the buffer
-    Uint elementNumber, elementType, nbElementNodes;
-    Uint gmsh_node_number, nb_tags, phys_tag, other_tag;
-
-    for (Uint i=0; i<m_total_nb_elements; ++i)
+    // only the owned elements are read
+    const CHash& elem_hash = m_hash->subhash(ELEMS);
+    const Uint begin = elem_hash.start_idx_in_proc(Comm::PE::instance().rank());
+    const Uint end = elem_hash.end_idx_in_proc(Comm::PE::instance().rank());
+    if (begin == end)
+      return;
+    go_to_element(begin);
+
+    // read every element and find the nodes that are not owned
+    Uint elementNumber, elementType, phys_tag;
+    std::vector<Uint> gmsh_element_nodes;
+
+    for (Uint i=begin; i<end; ++i)
     {
-      if (m_total_nb_elements > 100000)
-      {
-        if(i%(m_total_nb_elements/20)==0)
-          CFinfo << 100*i/m_total_nb_elements << "% " << CFendl;
-      }
+      read_element(elementNumber,elementType,phys_tag,gmsh_element_nodes);
 
-      if (m_hash->subhash(ELEMS).owns(i))
+      // check if element nodes are ghost
+      for (Uint j=0; j<gmsh_element_nodes.size(); ++j)
       {
-
-        // element description
-        m_file >> elementNumber >> elementType;
-//        CFinfo << "element: " << elementNumber << CFendl;
-        nbElementNodes = Shared::m_nodes_in_gmsh_elem[elementType];
-
-        m_file >> nb_tags;
-        m_file >> phys_tag;
-        for(Uint itag = 0; itag < (nb_tags-1); ++itag)
-            m_file >> other_tag;
-
-        // check if element nodes are ghost
-        std::vector<Uint> gmsh_element_nodes(nbElementNodes);
-        for (Uint j=0; j<nbElementNodes; ++j)
+        const Uint gmsh_node = gmsh_element_nodes[j]-1;
+        if (!m_hash->subhash(NODES).owns(gmsh_node))
         {
-          m_file >> gmsh_element_nodes[j];
-          --gmsh_element_nodes[j];
-          if (!m_hash->subhash(NODES).owns(gmsh_element_nodes[j]))
-          {
-            m_ghost_nodes.insert(gmsh_element_nodes[j]);
-//            CFinfo << "ghost node: " << gmsh_element_nodes[j] +1 << CFendl;
-          }
+          m_ghost_nodes.insert(gmsh_node);
+//          CFinfo << "ghost node: " << gmsh_node +1 << CFendl;
         }
       }
-      // finish the line
-      getline(m_file,line);
     }
-    getline(m_file,line);  // ENDOFSECTION
   }
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
-void CReader::read_coordinates()
+void CReader::read_node(const Uint node_idx, const Uint coord_idx, const Uint rank)
 {
-  m_file.seekg(m_coordinates_position,std::ios::beg);
+  Geometry& nodes = m_mesh->geometry();
+
+  go_to_node(node_idx);
 
-  // Find the region which has the highest dimensionality present in the mesh:
-  Uint master_region = 0;
-  while((m_region_list[master_region].dim != m_mesh_dimension) && (master_region < m_nb_regions))
+  // Gmsh always stores 3 coordinates, even for 2D meshes
+  Real coords[3];
+  if (m_binary)
   {
-     master_region++;
+    int node_number;
+    read_binary(&node_number,1);
+    read_binary(coords,3);
   }
+  else
+  {
+    Uint node_number;
+    m_file >> node_number >> coords[0] >> coords[1] >> coords[2];
+    m_file.skip_line();
+  }
+  ++m_current_node;
 
-  Geometry& nodes = m_mesh->geometry();
-
-  Uint part = option("part").value<Uint>();
-  Uint nodes_start_idx = nodes.size();
-  nodes.resize(nodes_start_idx + m_hash->subhash(NODES).nb_objects_in_part(part) + m_ghost_nodes.size());
+  nodes.rank()[coord_idx] = rank;
+  m_node_idx_gmsh_to_cf[node_idx]=coord_idx;
+  for (Uint dim=0; dim<m_mesh_dimension; ++dim)
+    nodes.coordinates()[coord_idx][dim] = coords[dim];
+}
 
-  std::string line;
-  //Skip the line with keyword '$Nodes':
-  getline(m_file,line);
-  // skip one line, which says how many (total) nodes are  present in the mesh
-  getline(m_file,line);
+//////////////////////////////////////////////////////////////////////////////
 
+void CReader::read_coordinates()
+{
+  Geometry& nodes = m_mesh->geometry();
 
-  // declare and allocate one coordinate row
-//  std::vector<Real> rowVector(m_mesh_dimension);
+  Uint part = option("part").value<Uint>();
+  const CHash& node_hash = m_hash->subhash(NODES);
+  const Uint begin = node_hash.start_idx_in_proc(Comm::PE::instance().rank());
+  const Uint end = node_hash.end_idx_in_proc(Comm::PE::instance().rank());
 
-  std::set<Uint>::const_iterator it;
+  Uint nodes_start_idx = nodes.size();
+  nodes.resize(nodes_start_idx + end-begin + m_ghost_nodes.size());
 
+  // The nodes are stored in increasing gmsh index: the ghost nodes before the
+  // owned nodes, the owned nodes, and the ghost nodes after the owned nodes.
+  // Ghost nodes get the rank of the part owning them.
+  m_current_node = m_total_nb_nodes; // unknown
   Uint coord_idx=nodes_start_idx;
+  std::set<Uint>::const_iterator ghost = m_ghost_nodes.begin();
+  for ( ; ghost != m_ghost_nodes.end() && *ghost < begin; ++ghost)
+    read_node(*ghost,coord_idx++,node_hash.part_of_obj(*ghost));
 
-  for (Uint node_idx=0; node_idx<m_total_nb_nodes; ++node_idx)
+  for (Uint node_idx=begin; node_idx<end; ++node_idx)
   {
     if (m_total_nb_nodes > 100000)
     {
-      if(node_idx%(m_total_nb_nodes/20)==0)
+      if((node_idx-begin)%(m_total_nb_nodes/20)==0)
         CFinfo << 100*node_idx/m_total_nb_nodes << "% " << CFendl;
     }
-    getline(m_file,line);
-
-    if (m_hash->subhash(NODES).owns(node_idx))
-    {
-      nodes.rank()[coord_idx] = part;
-      m_node_idx_gmsh_to_cf[node_idx]=coord_idx;
-      std::stringstream ss(line);
-      Uint nodeNumber;
-      ss >> nodeNumber;
-      for (Uint dim=0; dim<m_mesh_dimension; ++dim)
-        ss >> nodes.coordinates()[coord_idx][dim];
-      if(m_mesh_dimension < DIM_3D) getline(ss,line); //Gmsh always stores 3 coordinates, even for 2D meshes
-      coord_idx++;
-    }
-    else
-    {
-      it = m_ghost_nodes.find(node_idx);
-      if (it != m_ghost_nodes.end())
-      {
-        // add global node index
-        nodes.rank()[coord_idx] = m_hash->subhash(NODES).part_of_obj(node_idx);
-        m_node_idx_gmsh_to_cf[node_idx]=coord_idx;
-        std::stringstream ss(line);
-        Uint nodeNumber;
-        ss >> nodeNumber;
-//        CFinfo << "reading ghostnode " << nodeNumber;
-        for (Uint dim=0; dim<m_mesh_dimension; ++dim)
-        ss >> nodes.coordinates()[coord_idx][dim];
-//        CFinfo << "    (" << nodes.coordinates()[coord_idx][0] << " , " << nodes.coordinates()[coord_idx][1] << ")" << CFendl;
-        if(m_mesh_dimension < DIM_3D) getline(ss, line);
-
-        coord_idx++;
-      }
-      else
-      {
-//        getline(m_file,line);
-      }
-    }
-
-
-  } //loop over nodes
-
-
-
-  /*
-  CFinfo << "Printing all nodal coordinates:" << CFendl;
-  for(Uint i = 0; i < m_total_nb_nodes; ++i)
-  {
-      CFinfo << "\t";
-      for(Uint dim = 0; dim < m_mesh_dimension; ++dim)
-        {
-            CFinfo << nodes.coordinates()[i][dim] << " ";
-        }
-      CFinfo << CFendl;
+    read_node(node_idx,coord_idx++,part);
   }
-  */
 
-  getline(m_file,line);
+  for ( ; ghost != m_ghost_nodes.end(); ++ghost)
+    read_node(*ghost,coord_idx++,node_hash.part_of_obj(*ghost));
+
+  cf_assert(coord_idx == nodes.size());
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -534,47 +759,38 @@ void CReader::read_connectivity()
 
  }
 
-   std::string etype_CF;
-   std::set<Uint>::const_iterator it;
    std::vector<Uint> cf_element;
+   std::vector<Uint> gmsh_element;
    Uint element_number, gmsh_element_type, nb_element_nodes;
-   Uint gmsh_node_number, nb_tags, phys_tag, other_tag;
-   Uint cf_node_number;
+   Uint phys_tag;
    Uint cf_idx;
 
-   m_file.seekg(m_elements_position,std::ios::beg);
-   // skip next line
-   std::string line;
-   //Re-read the line that contains the keyword '$Elements':
-   getline(m_file,line);
-   //Parse the following line (containing the actual number of elements)
-   getline(m_file,line);
-
    for(Uint ir = 0; ir < m_nb_regions; ++ir)
      for(Uint etype = 0; etype < Shared::nb_gmsh_types; ++etype)
       (m_nb_gmsh_elem_in_region[ir])[etype] = 0;
 
-  for (Uint i=0; i<m_total_nb_elements; ++i)
+  // only the owned elements are read
+  const CHash& elem_hash = m_hash->subhash(ELEMS);
+  const Uint begin = elem_hash.start_idx_in_proc(Comm::PE::instance().rank());
+  const Uint end = elem_hash.end_idx_in_proc(Comm::PE::instance().rank());
+  if (begin != end)
+    go_to_element(begin);
+
+  for (Uint i=begin; i<end; ++i)
   {
     if (m_total_nb_elements > 100000)
     {
-      if(i%(m_total_nb_elements/20)==0)
+      if((i-begin)%(m_total_nb_elements/20)==0)
         CFinfo << 100*i/m_total_nb_elements << "% " << CFendl;
     }
 
     // element description
-    m_file >> element_number >> gmsh_element_type;
+    read_element(element_number,gmsh_element_type,phys_tag,gmsh_element);
 
-    nb_element_nodes = Shared::m_nodes_in_gmsh_elem[gmsh_element_type];
+    nb_element_nodes = gmsh_element.size();
 
     // get element nodes
-    if (m_hash->subhash(ELEMS).owns(i))
     {
-      m_file >> nb_tags;
-      m_file >> phys_tag;
-      for(Uint itag = 0; itag < (nb_tags-1); ++itag)
-          m_file >> other_tag;
-
 //      CFinfo << "Reading element " << element_number << " of type " << gmsh_element_type;
 //      CFinfo << " in region " << phys_tag << " with " << nb_element_nodes << " nodes " << CFendl;
 
@@ -582,10 +798,7 @@ void CReader::read_connectivity()
       for (Uint j=0; j<nb_element_nodes; ++j)
       {
         cf_idx = m_nodes_gmsh_to_cf[gmsh_element_type][j];
-        m_file >> gmsh_node_number;
-        --gmsh_node_number;
-        cf_node_number = m_node_idx_gmsh_to_cf[gmsh_node_number];
-        cf_element[cf_idx] = cf_node_number;
+        cf_element[cf_idx] = m_node_idx_gmsh_to_cf[gmsh_element[j]-1];
       }
       elem_table_iter = conn_table_idx[phys_tag-1].find(gmsh_element_type);
       const Uint row_idx = (m_nb_gmsh_elem_in_region[phys_tag-1])[gmsh_element_type];
@@ -605,21 +818,7 @@ void CReader::read_connectivity()
       (m_nb_gmsh_elem_in_region[phys_tag-1])[gmsh_element_type]++;
 
     }
-
-    else
-    {
-//      getline(m_file,line);
-
-      for (Uint j=0; j<nb_element_nodes; ++j)
-      {
-        m_file >> gmsh_node_number;
-      }
-    }
-
-    // finish the line
-    getline(m_file,line);
   }
-  getline(m_file,line);  // ENDOFSECTION
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -645,9 +844,9 @@ void CReader::read_element_data()
 
   std::map<std::string,CReader::Field> fields;
 
-  boost_foreach(Uint element_data_position, m_element_data_positions)
+  boost_foreach(const MappedFile::Position element_data_position, m_element_data_positions)
   {
-    m_file.seekg(element_data_position,std::ios::beg);
+    m_file.seek(element_data_position);
     read_variable_header(fields);
   }
 
@@ -672,7 +871,7 @@ void CReader::read_element_data()
         CFdebug << "Reading " << field.name() << "/" << field.var_name(i) <<"["<<static_cast<Uint>(field.var_length(i))<<"]" << CFendl;
         Uint var_begin = field.var_index(i);
         Uint var_end = var_begin + static_cast<Uint>(field.var_length(i));
-        m_file.seekg(gmsh_field.file_data_positions[i]);
+        m_file.seek(gmsh_field.file_data_positions[i]);
 
 
         Uint gmsh_elem_idx;
@@ -683,9 +882,7 @@ void CReader::read_element_data()
 
         for (Uint e=0; e<gmsh_field.nb_entries; ++e)
         {
-          m_file >> gmsh_elem_idx;
-          for (d=0; d<data.size(); ++d)
-            m_file >> data[d];
+          read_data_entry(gmsh_elem_idx,data);
 
           std::map<Uint, boost::tuple<CElements::Ptr,Uint> >::iterator it = m_elem_idx_gmsh_to_cf.find(gmsh_elem_idx);
           if (it != m_elem_idx_gmsh_to_cf.end())
@@ -728,9 +925,9 @@ void CReader::read_node_data()
 
   std::map<std::string,Field> fields;
 
-  boost_foreach(Uint node_data_position, m_node_data_positions)
+  boost_foreach(const MappedFile::Position node_data_position, m_node_data_positions)
   {
-    m_file.seekg(node_data_position,std::ios::beg);
+    m_file.seek(node_data_position);
     read_variable_header(fields);
   }
 
@@ -750,7 +947,7 @@ void CReader::read_node_data()
       CFdebug << "Reading " << field.name() << "/" << field.var_name(i) <<"["<<static_cast<Uint>(field.var_length(i))<<"]" << CFendl;
       Uint var_begin = field.var_index(i);
       Uint var_end = var_begin + static_cast<Uint>(field.var_length(i));
-      m_file.seekg(gmsh_field.file_data_positions[i]);
+      m_file.seek(gmsh_field.file_data_positions[i]);
 
       Uint gmsh_node_idx;
       Uint cf_idx;
@@ -759,11 +956,10 @@ void CReader::read_node_data()
 
       for (Uint e=0; e<gmsh_field.nb_entries; ++e)
       {
-        m_file >> gmsh_node_idx;
-        for (d=0; d<data.size(); ++d)
-          m_file >> data[d];
+        read_data_entry(gmsh_node_idx,data);
 
-        std::map<Uint, Uint>::iterator it = m_node_idx_gmsh_to_cf.find(gmsh_node_idx);
+        // gmsh node numbers start at 1
+        std::map<Uint, Uint>::iterator it = m_node_idx_gmsh_to_cf.find(gmsh_node_idx-1);
         if (it != m_node_idx_gmsh_to_cf.end())
         {
           cf_idx = it->second;
@@ -799,8 +995,8 @@ void CReader::read_variable_header(std::map<std::string,Field>& fields)
   Uint var_type(0);
   Uint nb_entries(0);
 
-  //Re-read the line that contains the keyword '$Elements':
-  getline(m_file,line);
+  //Re-read the line that contains the keyword of the section:
+  m_file.skip_line();
 
   // string tags
   m_file >> nb_string_tags;
@@ -854,7 +1050,7 @@ void CReader::read_variable_header(std::map<std::string,Field>& fields)
     if (nb_integer_tags < 3)
       throw ParsingFailed(FromHere(),"Data must have 3 integer tags (time_step, field_type, nb_entries)");
   }
-  getline(m_file,line); // finish line
+  m_file.skip_line(); // finish line
 
   Field& field = fields[field_name];
   field.name=field_name;
@@ -865,9 +1061,110 @@ void CReader::read_variable_header(std::map<std::string,Field>& fields)
   field.time=field_time;
   field.time_step=field_time_step;
   field.nb_entries=nb_entries;
-  field.file_data_positions.push_back(m_file.tellg());
+  field.file_data_positions.push_back(m_file.position());
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void CReader::read_binary(T* data, const Uint size)
+{
+  m_file.read(reinterpret_cast<char*>(data),size*sizeof(T));
+  if (m_swap_bytes)
+  {
+    for (Uint i=0; i<size; ++i)
+      std::reverse(reinterpret_cast<char*>(data+i),reinterpret_cast<char*>(data+i)+sizeof(T));
+  }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+void CReader::read_element(Uint& element_number, Uint& element_type, Uint& phys_tag, std::vector<Uint>& element_nodes)
+{
+  if (m_binary)
+  {
+    // binary elements come in blocks of the same type:
+    // elm-type number-of-elements-in-block number-of-tags
+    // followed by every element: elm-number tag ... node-number ...
+    if (m_elements_in_block == 0)
+    {
+      int header[3];
+      read_binary(header,3);
+      m_block_element_type = header[0];
+      m_elements_in_block = header[1];
+      m_block_nb_tags = header[2];
+    }
+    const Uint nb_nodes = Shared::m_nodes_in_gmsh_elem[m_block_element_type];
+    m_element_record.resize(1+m_block_nb_tags+nb_nodes);
+    read_binary(&m_element_record[0],m_element_record.size());
+    --m_elements_in_block;
+
+    element_number = m_element_record[0];
+    element_type = m_block_element_type;
+    phys_tag = m_element_record[1];
+    element_nodes.assign(m_element_record.begin()+1+m_block_nb_tags,m_element_record.end());
+  }
+  else
+  {
+    // elm-number elm-type number-of-tags tag ... node-number ...
+    Uint nb_tags, other_tag;
+    m_file >> element_number >> element_type >> nb_tags >> phys_tag;
+    for(Uint itag = 1; itag < nb_tags; ++itag)
+      m_file >> other_tag;
+
+    element_nodes.resize(Shared::m_nodes_in_gmsh_elem[element_type]);
+    for (Uint j=0; j<element_nodes.size(); ++j)
+      m_file >> element_nodes[j];
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CReader::read_data_entry(Uint& idx, std::vector<Real>& data)
+{
+  if (m_binary)
+  {
+    int binary_idx;
+    read_binary(&binary_idx,1);
+    idx = binary_idx;
+    if (data.size())
+      read_binary(&data[0],data.size());
+  }
+  else
+  {
+    m_file >> idx;
+    for (Uint d=0; d<data.size(); ++d)
+      m_file >> data[d];
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CReader::skip_binary_data(const MappedFile::Position position, const bool element_node_data)
+{
+  m_file.seek(position);
+  std::map<std::string,Field> fields;
+  read_variable_header(fields);
+  const Field& field = fields.begin()->second;
+  const Uint nb_components = field.var_types[0];
+
+  if (element_node_data)
+  {
+    // elm-number number-of-nodes-per-element value ...
+    int entry[2];
+    for (Uint e=0; e<field.nb_entries; ++e)
+    {
+      read_binary(entry,2);
+      m_file.seek_relative(entry[1]*nb_components*sizeof(Real));
+    }
+  }
+  else
+  {
+    // number value ...
+    m_file.seek_relative(field.nb_entries*(sizeof(int)+nb_components*sizeof(Real)));
+  }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -12,6 +12,8 @@
 #include <set>
 #include <boost/tuple/tuple.hpp>
 
+#include "Common/MappedFile.hpp"
+
 #include "Mesh/CMeshReader.hpp"
 
 #include "Mesh/Gmsh/LibGmsh.hpp"
@@ -59,6 +61,31 @@ private: // functions
 
   void get_file_positions();
 
+  /// Send the positions found by the root to the other processes,
+  /// which then read the small header sections themselves
+  void broadcast_file_positions(const Uint root);
+
+  void read_mesh_format();
+
+  void read_physical_names();
+
+  void create_hash();
+
+  /// Count the owned elements of every type in every region
+  void count_owned_elements();
+
+  /// Put the file at an element, using the positions of the parts
+  void go_to_element(const Uint element_idx);
+
+  /// Put the file at the line or record of a node, using the positions of the parts
+  void go_to_node(const Uint node_idx);
+
+  /// Read the coordinates of one node from the file
+  void read_node(const Uint node_idx, const Uint coord_idx, const Uint rank);
+
+  /// Size of a node record in a binary $Nodes section: node-number x y z
+  static Uint node_record_size() { return sizeof(int)+3*sizeof(Real); }
+
   boost::shared_ptr<CRegion> create_region(std::string const& relative_path);
 
   void find_ghost_nodes();
@@ -71,6 +98,19 @@ private: // functions
 
   void read_node_data();
 
+  /// Read the next element record of the $Elements section, from an ASCII line or a binary block
+  void read_element(Uint& element_number, Uint& element_type, Uint& phys_tag, std::vector<Uint>& element_nodes);
+
+  /// Read the index and the values of one entry of a $NodeData or $ElementData section
+  void read_data_entry(Uint& idx, std::vector<Real>& data);
+
+  /// Skip the binary data following the header of a $NodeData, $ElementData or $ElementNodeData section
+  void skip_binary_data(const Common::MappedFile::Position position, const bool element_node_data);
+
+  /// Read binary values, swapping the bytes if the file was written with the other endianness
+  template <typename T>
+  void read_binary(T* data, const Uint size);
+
 private: // data
 
   virtual void do_read_mesh_into(const Common::URI& fp, CMesh& mesh);
@@ -82,7 +122,7 @@ private: // data
   std::map<Uint, boost::tuple<boost::shared_ptr<CElements>,Uint> > m_elem_idx_gmsh_to_cf;
   std::map<Uint, Uint> m_node_idx_gmsh_to_cf;
 
-  boost::filesystem::fstream m_file;
+  Common::MappedFile m_file;
   boost::shared_ptr<CMesh> m_mesh;
   boost::shared_ptr<CRegion> m_region;
   boost::shared_ptr<CRegion> m_tmp;
@@ -112,12 +152,41 @@ private: // data
   std::vector<std::set<Uint> > m_node_to_glb_elements;
 
   //Markers for important places in the file to be read
-  Uint m_region_names_position;
-  Uint m_coordinates_position;
-  Uint m_elements_position;
-  std::vector<Uint> m_element_data_positions;
-  std::vector<Uint> m_node_data_positions;
-  std::vector<Uint> m_element_node_data_positions;
+  Common::MappedFile::Position m_mesh_format_position;
+  Common::MappedFile::Position m_region_names_position;
+  Common::MappedFile::Position m_coordinates_position;
+  Common::MappedFile::Position m_elements_position;
+  std::vector<Common::MappedFile::Position> m_element_data_positions;
+  std::vector<Common::MappedFile::Position> m_node_data_positions;
+  std::vector<Common::MappedFile::Position> m_element_node_data_positions;
+
+  /// Position of the first node of every part of the node hash
+  std::vector<Common::MappedFile::Position> m_node_part_positions;
+
+  /// Position of the first element of a part, with the state of the binary element block it is in
+  struct ElementPosition
+  {
+    Common::MappedFile::Position position;
+    Uint elements_in_block;
+    Uint block_element_type;
+    Uint block_nb_tags;
+  };
+  /// Position of the first element of every part of the element hash
+  std::vector<ElementPosition> m_element_part_positions;
+
+  /// Index of the node at the current position in an ASCII file
+  Uint m_current_node;
+
+  /// The file is in binary format (MSH file-type 1)
+  bool m_binary;
+  /// The binary file has another endianness than this machine
+  bool m_swap_bytes;
+
+  /// State of the element block being read in a binary $Elements section
+  Uint m_elements_in_block;
+  Uint m_block_element_type;
+  Uint m_block_nb_tags;
+  std::vector<int> m_element_record;
 
 
   std::vector<std::vector<Uint> > m_nb_gmsh_elem_in_region;
@@ -134,7 +203,7 @@ private: // data
     Uint time_step;
     std::vector<Uint> var_types;
     Uint nb_entries;
-    std::vector<Uint> file_data_positions;
+    std::vector<Common::MappedFile::Position> file_data_positions;
   };
 
   void read_variable_header(std::map<std::string,Field>& fields);
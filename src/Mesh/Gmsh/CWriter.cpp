@@ -11,6 +11,7 @@
 #include "Common/MPI/PE.hpp"
 #include "Common/CBuilder.hpp"
 #include "Common/FindComponents.hpp"
+#include "Common/OptionT.hpp"
 #include "Common/StringConversion.hpp"
 #include "Common/CMap.hpp"
 
@@ -38,9 +39,13 @@ Common::ComponentBuilder < Gmsh::CWriter, CMeshWriter, LibGmsh> aGmshWriter_Buil
 //////////////////////////////////////////////////////////////////////////////
 
 CWriter::CWriter( const std::string& name )
-: CMeshWriter(name)
+: CMeshWriter(name),
+  m_binary(false)
 {
-
+  m_options.add_option< OptionT<bool> >("binary", m_binary)
+      ->description("Write the binary MSH format, which is smaller and much faster to read than ASCII")
+      ->pretty_name("Binary")
+      ->link_to(&m_binary);
 
   // gmsh types: http://www.geuz.org/gmsh/doc/texinfo/gmsh.html#MSH-ASCII-file-format
 
@@ -104,7 +109,7 @@ void CWriter::write_from_to(const CMesh& mesh, const URI& file_path)
     path = boost::filesystem::basename(path) + "_P" + to_str(Comm::PE::instance().rank()) + boost::filesystem::extension(path);
   }
 //  CFLog(VERBOSE, "Opening file " <<  path.string() << "\n");
-  file.open(path,std::ios_base::out);
+  file.open(path,std::ios_base::out | std::ios_base::binary);
   if (!file) // didn't open so throw exception
   {
      throw boost::filesystem::filesystem_error( path.string() + " failed to open",
@@ -128,12 +133,19 @@ void CWriter::write_from_to(const CMesh& mesh, const URI& file_path)
 void CWriter::write_header(std::fstream& file)
 {
   std::string version = "2";
-  Uint file_type = 0; // ASCII
-  Uint data_size = 8; // double precision
+  Uint file_type = m_binary ? 1 : 0; // ASCII or binary
+  Uint data_size = sizeof(Real); // double precision
 
   // format
   file << "$MeshFormat\n";
   file << version << " " << file_type << " " << data_size << "\n";
+  if (m_binary)
+  {
+    // the integer 1, so the reader can detect the endianness
+    const int one = 1;
+    write_binary(file,&one,1);
+    file << "\n";
+  }
   file << "$EndMeshFormat\n";
 
   m_groupnumber.clear();
@@ -183,21 +195,31 @@ void CWriter::write_coordinates(std::fstream& file)
   Uint node_number=0;
   const CTable<Real>& coordinates = m_mesh->geometry().coordinates();
   Uint gmsh_node = 1;
+  Real coords[3];
   boost_foreach( const Uint node, used_nodes.array())
   {
     to_gmsh_node.insert_blindly(node,gmsh_node++);
     CTable<Real>::ConstRow coord = coordinates[node];
-    file << ++node_number << " ";
     for (Uint d=0; d<3; d++)
+      coords[d] = d<m_mesh->dimension() ? coord[d] : 0.;
+
+    if (m_binary)
     {
-      if (d<m_mesh->dimension())
-        file << coord[d] << " ";
-      else
-        file << 0 << " ";
+      const int binary_node_number = ++node_number;
+      write_binary(file,&binary_node_number,1);
+      write_binary(file,coords,3);
+    }
+    else
+    {
+      file << ++node_number << " ";
+      for (Uint d=0; d<3; d++)
+        file << coords[d] << " ";
+      file << "\n";
     }
-    file << "\n";
   }
 
+  if (m_binary)
+    file << "\n";
   file << "$EndNodes\n";
   // restore precision
   file.precision(prec);
@@ -234,6 +256,34 @@ void CWriter::write_connectivity(std::fstream& file)
     //file << "// Region " << elements.uri().string() << "\n";
     elm_type = m_elementTypes[elements.element_type().builder_name()];
     const Uint nb_elem = elements.size();
+
+    if (m_binary)
+    {
+      if (nb_elem == 0)
+        continue;
+
+      // every CEntities is one block of elements of the same type:
+      // elm-type number-of-elements-in-block number-of-tags
+      // followed by every element: elm-number tag ... node-number ...
+      const int header[3] = { static_cast<int>(elm_type), static_cast<int>(nb_elem), static_cast<int>(number_of_tags) };
+      write_binary(file,header,3);
+
+      const Uint nb_nodes = elements.element_type().nb_nodes();
+      std::vector<int> record(1+number_of_tags+nb_nodes);
+      record[1] = group_number;
+      record[2] = 0;
+      record[3] = partition_number;
+      for (Uint e=0; e<nb_elem; ++e, ++elm_number)
+      {
+        record[0] = elm_number+1;
+        Uint n = 1+number_of_tags;
+        boost_foreach(const Uint node_idx, elements.get_nodes(e))
+          record[n++] = to_gmsh_node[node_idx];
+        write_binary(file,&record[0],record.size());
+      }
+      continue;
+    }
+
     for (Uint e=0; e<nb_elem; ++e, ++elm_number)
     {
       file << elm_number+1 << " " << elm_type << " " << number_of_tags << " " << group_number << " " << 0 << " " << partition_number;
@@ -244,6 +294,8 @@ void CWriter::write_connectivity(std::fstream& file)
       file << "\n";
     }
   }
+  if (m_binary)
+    file << "\n";
   file << "$EndElements\n";
 }
 
@@ -337,7 +389,15 @@ void CWriter::write_elem_nodal_data(std::fstream& file)
             /// write element
             for (Uint local_elm_idx = 0; local_elm_idx<local_nb_elms; ++local_elm_idx)
             {
-              file << ++elm_number << " " << nb_nodes << " ";
+              if (m_binary)
+              {
+                const int entry[2] = { static_cast<int>(++elm_number), static_cast<int>(nb_nodes) };
+                write_binary(file,entry,2);
+              }
+              else
+              {
+                file << ++elm_number << " " << nb_nodes << " ";
+              }
 
               /// set field data
               CConnectivity::ConstRow field_indexes = field_space.indexes_for_element(local_elm_idx);
@@ -362,21 +422,31 @@ void CWriter::write_elem_nodal_data(std::fstream& file)
                   data[1]=node_data[1];
                   data[3]=node_data[2];
                   data[4]=node_data[3];
-                  for (Uint idx=0; idx<datasize; ++idx)
-                    file << " " << data[idx];
                 }
                 else
                 {
+                  // a 2D vector keeps a zero third component
                   for (Uint j=0; j<var_type; ++j)
-                    file << " " << node_data[j];
-                  if (var_type == Field::VECTOR_2D)
-                    file << " " << 0.0;
+                    data[j] = node_data[j];
+                }
+
+                if (m_binary)
+                {
+                  write_binary(file,data.data(),datasize);
+                }
+                else
+                {
+                  for (Uint idx=0; idx<datasize; ++idx)
+                    file << " " << data[idx];
                 }
               }
-              file << "\n";
+              if (!m_binary)
+                file << "\n";
             }
           }
         }
+        if (m_binary)
+          file << "\n";
         file << "$EndElementNodeData\n";
         row_idx += Uint(var_type);
       }
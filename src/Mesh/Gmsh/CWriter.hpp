@@ -24,6 +24,7 @@ namespace Gmsh {
 //////////////////////////////////////////////////////////////////////////////
 
 /// This class defines Gmsh mesh format writer
+/// The mesh is written in the ASCII or, with option "binary", in the binary MSH 2 format.
 /// @author Willem Deconinck
 class Gmsh_API CWriter : public CMeshWriter
 {
@@ -58,6 +59,13 @@ private: // functions
 
   void write_elem_nodal_data(std::fstream& file);
 
+  /// Write the raw bytes of an array of ints or doubles, for the binary format
+  template <typename T>
+  void write_binary(std::fstream& file, const T* data, const Uint size)
+  {
+    file.write(reinterpret_cast<const char*>(data),size*sizeof(T));
+  }
+
 //  void write_element_data(std::fstream& file);
 
 private: // data
@@ -69,6 +77,9 @@ private: // data
   std::map<CEntities const*,Uint> m_element_start_idx;
 
   boost::shared_ptr< Common::CMap<Uint,Uint> > m_cf_2_gmsh_node;
+
+  /// Write the binary format instead of ASCII
+  bool m_binary;
 }; // end CWriter
 
 
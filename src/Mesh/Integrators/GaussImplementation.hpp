@@ -580,6 +580,8 @@ struct GaussMappedCoords
 {
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
+  static const Uint order = Order;
+
   static const Uint nb_points = GaussMappedCoordsImpl<Order, Shape>::nb_points;
 
   const typename GaussMappedCoordsImpl<Order, Shape>::CoordsT coords;
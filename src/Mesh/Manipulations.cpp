@@ -224,7 +224,8 @@ void PackUnpackNodes::pack(Comm::Buffer& buf)
 
   buf << m_nodes.coordinates()[m_idx];
 
-  buf << m_nodes.glb_elem_connectivity()[m_idx];
+  CDynTable<Uint>::ConstRow connected_elems = m_nodes.glb_elem_connectivity()[m_idx];
+  buf << std::vector<Uint>(connected_elems.begin(),connected_elems.end());
 
 //  std::cout << PERank << "packed node    glb_idx = " << val << std::endl;
 
@@ -93,7 +93,7 @@ void CReader::do_read_mesh_into(const URI& file, CMesh& mesh)
   if( boost::filesystem::exists(fp) )
   {
     CFinfo << "Opening file " <<  fp.string() << CFendl;
-    m_file.open(fp,std::ios_base::in); // exists so open it
+    m_file.open(fp); // exists so map it in memory
   }
   else // doesnt exist so throw exception
   {
@@ -103,9 +103,6 @@ void CReader::do_read_mesh_into(const URI& file, CMesh& mesh)
   // set the internal mesh pointer
   m_mesh = mesh.as_ptr<CMesh>();
 
-  // Read file once and store positions
-  get_file_positions();
-
   // Read mesh information
   read_headerData();
 
@@ -120,6 +117,9 @@ void CReader::do_read_mesh_into(const URI& file, CMesh& mesh)
   num_obj[1] = m_headerData.NELEM;
   m_hash->configure_option("nb_obj",num_obj);
 
+  // Read file once and store positions
+  get_file_positions();
+
   // Create a region component inside the mesh with the name mesh_name
   //if (option("new_api").value<bool>())
     m_region = m_mesh->topology().create_region(m_headerData.mesh_name).as_ptr<CRegion>();
@@ -171,49 +171,116 @@ void CReader::get_file_positions()
   std::string element_group("ELEMENT GROUP");
   std::string boundary_condition("BOUNDARY CONDITIONS");
 
+  const CHash& node_hash = m_hash->subhash(NODES);
+  const CHash& elem_hash = m_hash->subhash(ELEMS);
+  const Uint nb_parts = node_hash.option("nb_parts").value<Uint>();
+
   m_element_group_positions.resize(0);
   m_boundary_condition_positions.resize(0);
+  m_node_part_positions.resize(nb_parts);
+  m_element_part_positions.resize(nb_parts);
 
-  int p;
-  std::string line;
-  while (!m_file.eof())
+  // In parallel only the root scans the whole file,
+  // the other processes only read the parts they own
+  const bool parallel = Comm::PE::instance().is_active() && Comm::PE::instance().size() > 1;
+  const Uint root = 0;
+
+  // positions packed as:
+  // nodal_coordinates elements_cells nb_groups groups... nb_bcs bcs... node_parts... element_parts...
+  std::vector<MappedFile::Position> positions;
+
+  if (!parallel || Comm::PE::instance().rank() == root)
   {
-    p = m_file.tellg();
-    getline(m_file,line);
-    if (line.find(nodal_coordinates)!=std::string::npos)
-      m_nodal_coordinates_position=p;
-    else if (line.find(elements_cells)!=std::string::npos)
-      m_elements_cells_position=p;
-    else if (line.find(element_group)!=std::string::npos)
-      m_element_group_positions.push_back(p);
-    else if (line.find(boundary_condition)!=std::string::npos)
-      m_boundary_condition_positions.push_back(p);
+    MappedFile::Position p;
+    std::string line;
+    Uint elementNumber, elementType, nbElementNodes, node;
+    m_file.seek(0);
+    while (!m_file.eof())
+    {
+      p = m_file.position();
+      m_file.get_line(line);
+      if (line.find(nodal_coordinates)!=std::string::npos)
+      {
+        m_nodal_coordinates_position=p;
+
+        // one line per node
+        Uint part = 0;
+        for (Uint n=0; n<m_headerData.NUMNP; ++n)
+        {
+          while (part < nb_parts && node_hash.start_idx_in_part(part) == n)
+            m_node_part_positions[part++] = m_file.position();
+          m_file.skip_line();
+        }
+      }
+      else if (line.find(elements_cells)!=std::string::npos)
+      {
+        m_elements_cells_position=p;
+
+        // elements with many nodes continue on the next line
+        Uint part = 0;
+        for (Uint e=0; e<m_headerData.NELEM; ++e)
+        {
+          while (part < nb_parts && elem_hash.start_idx_in_part(part) == e)
+            m_element_part_positions[part++] = m_file.position();
+          m_file >> elementNumber >> elementType >> nbElementNodes;
+          for (Uint j=0; j<nbElementNodes; ++j)
+            m_file >> node;
+        }
+        m_file.skip_line();
+      }
+      else if (line.find(element_group)!=std::string::npos)
+        m_element_group_positions.push_back(p);
+      else if (line.find(boundary_condition)!=std::string::npos)
+        m_boundary_condition_positions.push_back(p);
+    }
+
+    positions.push_back(m_nodal_coordinates_position);
+    positions.push_back(m_elements_cells_position);
+    positions.push_back(m_element_group_positions.size());
+    positions.insert(positions.end(),m_element_group_positions.begin(),m_element_group_positions.end());
+    positions.push_back(m_boundary_condition_positions.size());
+    positions.insert(positions.end(),m_boundary_condition_positions.begin(),m_boundary_condition_positions.end());
+    positions.insert(positions.end(),m_node_part_positions.begin(),m_node_part_positions.end());
+    positions.insert(positions.end(),m_element_part_positions.begin(),m_element_part_positions.end());
   }
-  m_file.clear();
 
+  if (parallel)
+  {
+    std::vector<MappedFile::Position> received;
+    Comm::PE::instance().broadcast(positions,received,root);
+
+    std::vector<MappedFile::Position>::const_iterator it = received.begin();
+    m_nodal_coordinates_position = *it++;
+    m_elements_cells_position = *it++;
+    m_element_group_positions.assign(it+1,it+1+*it);
+    it += 1+*it;
+    m_boundary_condition_positions.assign(it+1,it+1+*it);
+    it += 1+*it;
+    m_node_part_positions.assign(it,it+nb_parts);
+    it += nb_parts;
+    m_element_part_positions.assign(it,it+nb_parts);
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
 void CReader::read_headerData()
 {
-  m_file.seekg(0,std::ios::beg);
+  m_file.seek(0);
 
   Uint NUMNP, NELEM, NGRPS, NBSETS, NDFCD, NDFVL;
   std::string line;
 
   // skip 2 lines
-  for (Uint i=0; i<2; ++i)
-    getline(m_file,line);
+  m_file.skip_lines(2);
 
-  m_file >> m_headerData.mesh_name;   getline(m_file,line);
+  m_file >> m_headerData.mesh_name;   m_file.skip_line();
 
   // skip 3 lines
-  for (Uint i=0; i<3; ++i)
-    getline(m_file,line);
+  m_file.skip_lines(3);
 
   // read number of points, elements, groups, sets, dimensions, velocitycomponents
-  getline(m_file,line);
+  m_file.get_line(line);
   std::stringstream ss(line);
   ss >> NUMNP >> NELEM >> NGRPS >> NBSETS >> NDFCD >> NDFVL;
 
@@ -224,7 +291,7 @@ void CReader::read_headerData()
   m_headerData.NDFCD  = NDFCD;
   m_headerData.NDFVL  = NDFVL;
 
-  getline(m_file,line);
+  m_file.skip_line();
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -236,102 +303,105 @@ void CReader::find_ghost_nodes()
   // Only find ghost nodes if the domain is split up
   if (option("nb_parts").value<Uint>() > 1)
   {
-    m_file.seekg(m_elements_cells_position,std::ios::beg);
-    // skip next line
-    std::string line;
-    getline(m_file,line);
-
+    // only the owned elements are read
+    const CHash& elem_hash = m_hash->subhash(ELEMS);
+    const Uint begin = elem_hash.start_idx_in_proc(Comm::PE::instance().rank());
+    const Uint end = elem_hash.end_idx_in_proc(Comm::PE::instance().rank());
+    if (begin == end)
+      return;
+    m_file.seek(m_element_part_positions[elem_hash.part_of_obj(begin)]);
 
-    // read every line and store the connectivity in the correct region through the buffer
-    Uint elementNumber, elementType, nbElementNodes;
-    for (Uint i=0; i<m_headerData.NELEM; ++i)
+    Uint elementNumber, elementType, nbElementNodes, neu_node;
+    for (Uint i=begin; i<end; ++i)
     {
-      if (m_headerData.NELEM > 100000)
-      {
-        if(i%(m_headerData.NELEM/20)==0)
-          CFinfo << 100*i/m_headerData.NELEM << "% " << CFendl;
-      }
+      // element description
+      m_file >> elementNumber >> elementType >> nbElementNodes;
 
-      if (m_hash->subhash(ELEMS).owns(i))
+      // check if element nodes are ghost
+      for (Uint j=0; j<nbElementNodes; ++j)
       {
-        // element description
-        m_file >> elementNumber >> elementType >> nbElementNodes;
-
-        // check if element nodes are ghost
-        std::vector<Uint> neu_element_nodes(nbElementNodes);
-        for (Uint j=0; j<nbElementNodes; ++j)
+        m_file >> neu_node;
+        if (!m_hash->subhash(NODES).owns(neu_node-1))
         {
-          m_file >> neu_element_nodes[j];
-          if (!m_hash->subhash(NODES).owns(neu_element_nodes[j]-1))
-          {
-            m_ghost_nodes.insert(neu_element_nodes[j]);
-          }
+          m_ghost_nodes.insert(neu_node);
         }
       }
-      // finish the line
-      getline(m_file,line);
     }
-    getline(m_file,line);  // ENDOFSECTION
   }
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
-void CReader::read_coordinates()
+void CReader::go_to_node(const Uint node_idx)
 {
-  m_file.seekg(m_nodal_coordinates_position,std::ios::beg);
+  const CHash& node_hash = m_hash->subhash(NODES);
+  const Uint part = node_hash.part_of_obj(node_idx);
 
-  // Create the nodes
+  // jump to the first node of the part, unless the node is further in the current part
+  if (m_current_node > node_idx || m_current_node < node_hash.start_idx_in_part(part))
+  {
+    m_file.seek(m_node_part_positions[part]);
+    m_current_node = node_hash.start_idx_in_part(part);
+  }
+  m_file.skip_lines(node_idx-m_current_node);
+  m_current_node = node_idx;
+}
+
+//////////////////////////////////////////////////////////////////////////////
 
+void CReader::read_node(const Uint node_idx, const Uint coord_idx)
+{
   Geometry& nodes = m_mesh->geometry();
 
-  nodes.resize(m_hash->subhash(NODES).nb_objects_in_part(Comm::PE::instance().rank()) + m_ghost_nodes.size());
-  std::string line;
-  // skip one line
-  getline(m_file,line);
+  go_to_node(node_idx);
+
+  nodes.rank()[coord_idx] = m_hash->subhash(NODES).part_of_obj(node_idx);
+  m_node_to_coord_idx[node_idx+1]=coord_idx;
+  Uint nodeNumber;
+  m_file >> nodeNumber;
+  for (Uint dim=0; dim<m_headerData.NDFCD; ++dim)
+    m_file >> nodes.coordinates()[coord_idx][dim];
+  m_file.skip_line();
+  ++m_current_node;
+}
 
-  // declare and allocate one coordinate row
-  std::vector<Real> rowVector(m_headerData.NDFCD);
+//////////////////////////////////////////////////////////////////////////////
 
-  std::set<Uint>::const_iterator not_found = m_ghost_nodes.end();
+void CReader::read_coordinates()
+{
+  // Create the nodes
 
+  Geometry& nodes = m_mesh->geometry();
+
+  const CHash& node_hash = m_hash->subhash(NODES);
+  const Uint begin = node_hash.start_idx_in_proc(Comm::PE::instance().rank());
+  const Uint end = node_hash.end_idx_in_proc(Comm::PE::instance().rank());
+
+  nodes.resize(end-begin + m_ghost_nodes.size());
+
+  // The nodes are stored in increasing global index: the ghost nodes before the
+  // owned nodes, the owned nodes, and the ghost nodes after the owned nodes.
+  // Ghost node numbers start at 1.
+  m_current_node = m_headerData.NUMNP; // unknown
   Uint coord_idx=0;
-  for (Uint node_idx=1; node_idx<=m_headerData.NUMNP; ++node_idx)
+  std::set<Uint>::const_iterator ghost = m_ghost_nodes.begin();
+  for ( ; ghost != m_ghost_nodes.end() && *ghost-1 < begin; ++ghost)
+    read_node(*ghost-1,coord_idx++);
+
+  for (Uint node_idx=begin; node_idx<end; ++node_idx)
   {
     if (m_headerData.NUMNP > 100000)
     {
-      if(node_idx%(m_headerData.NUMNP/20)==0)
+      if((node_idx-begin)%(m_headerData.NUMNP/20)==0)
         CFinfo << 100*node_idx/m_headerData.NUMNP << "% " << CFendl;
     }
-    getline(m_file,line);
-    if (m_hash->subhash(NODES).owns(node_idx-1))
-    {
-      nodes.rank()[coord_idx] = m_hash->subhash(NODES).part_of_obj(node_idx-1);
-      m_node_to_coord_idx[node_idx]=coord_idx;
-      std::stringstream ss(line);
-      Uint nodeNumber;
-      ss >> nodeNumber;
-      for (Uint dim=0; dim<m_headerData.NDFCD; ++dim)
-        ss >> nodes.coordinates()[coord_idx][dim];
-      coord_idx++;
-    }
-    else
-    {
-      if (m_ghost_nodes.find(node_idx) != not_found)
-      {
-        // add global node index
-        nodes.rank()[coord_idx] = m_hash->subhash(NODES).part_of_obj(node_idx-1);
-        m_node_to_coord_idx[node_idx]=coord_idx;
-        std::stringstream ss(line);
-        Uint nodeNumber;
-        ss >> nodeNumber;
-        for (Uint dim=0; dim<m_headerData.NDFCD; ++dim)
-          ss >> nodes.coordinates()[coord_idx][dim];
-        coord_idx++;
-      }
-    }
+    read_node(node_idx,coord_idx++);
   }
-  getline(m_file,line);
+
+  for ( ; ghost != m_ghost_nodes.end(); ++ghost)
+    read_node(*ghost-1,coord_idx++);
+
+  cf_assert(coord_idx == nodes.size());
 }
 
 
@@ -343,16 +413,18 @@ void CReader::read_connectivity()
   m_tmp = m_region->create_region("main").as_ptr<CRegion>();
 
   m_global_to_tmp.clear();
-  m_file.seekg(m_elements_cells_position,std::ios::beg);
 
   std::map<std::string,CElements::Ptr> elements = create_cells_in_region(*m_tmp,nodes,m_supported_types);
   std::map<std::string,CConnectivity::Buffer::Ptr> buffer = create_connectivity_buffermap(elements);
 
-  // skip next line
-  std::string line;
-  getline(m_file,line);
+  // only the owned elements are read
+  const CHash& elem_hash = m_hash->subhash(ELEMS);
+  const Uint begin = elem_hash.start_idx_in_proc(Comm::PE::instance().rank());
+  const Uint end = elem_hash.end_idx_in_proc(Comm::PE::instance().rank());
+  if (begin != end)
+    m_file.seek(m_element_part_positions[elem_hash.part_of_obj(begin)]);
 
-  // read every line and store the connectivity in the correct region through the buffer
+  // read every element and store the connectivity in the correct region through the buffer
   std::string etype_CF;
   std::vector<Uint> cf_element;
   Uint neu_node_number;
@@ -360,11 +432,11 @@ void CReader::read_connectivity()
   Uint cf_idx;
   Uint table_idx;
 
-  for (Uint i=0; i<m_headerData.NELEM; ++i)
+  for (Uint i=begin; i<end; ++i)
   {
     if (m_headerData.NELEM > 100000)
     {
-      if(i%(m_headerData.NELEM/20)==0)
+      if((i-begin)%(m_headerData.NELEM/20)==0)
         CFinfo << 100*i/m_headerData.NELEM << "% " << CFendl;
     }
 
@@ -373,32 +445,18 @@ void CReader::read_connectivity()
     m_file >> elementNumber >> elementType >> nbElementNodes;
 
     // get element nodes
-    if (m_hash->subhash(ELEMS).owns(i))
+    cf_element.resize(nbElementNodes);
+    for (Uint j=0; j<nbElementNodes; ++j)
     {
-      cf_element.resize(nbElementNodes);
-      for (Uint j=0; j<nbElementNodes; ++j)
-      {
-        cf_idx = m_nodes_neu_to_cf[elementType][j];
-        m_file >> neu_node_number;
-        cf_node_number = m_node_to_coord_idx[neu_node_number];
-        cf_element[cf_idx] = cf_node_number;
-      }
-      etype_CF = element_type(elementType,nbElementNodes);
-      table_idx = buffer[etype_CF]->add_row(cf_element);
-      m_global_to_tmp[elementNumber] = std::make_pair(elements[etype_CF],table_idx);
+      cf_idx = m_nodes_neu_to_cf[elementType][j];
+      m_file >> neu_node_number;
+      cf_node_number = m_node_to_coord_idx[neu_node_number];
+      cf_element[cf_idx] = cf_node_number;
     }
-    else
-    {
-      for (Uint j=0; j<nbElementNodes; ++j)
-      {
-        m_file >> neu_node_number;
-      }
-    }
-
-    // finish the line
-    getline(m_file,line);
+    etype_CF = element_type(elementType,nbElementNodes);
+    table_idx = buffer[etype_CF]->add_row(cf_element);
+    m_global_to_tmp[elementNumber] = std::make_pair(elements[etype_CF],table_idx);
   }
-  getline(m_file,line);  // ENDOFSECTION
 
   m_node_to_coord_idx.clear();
 
@@ -419,11 +477,11 @@ void CReader::read_groups()
 
   for (Uint g=0; g<m_headerData.NGRPS; ++g)
   {
-    m_file.seekg(m_element_group_positions[g],std::ios::beg);
+    m_file.seek(m_element_group_positions[g]);
 
     std::string ELMMAT;
     Uint NGP, NELGP, MTYP, NFLAGS, I;
-    getline(m_file,line);  // ELEMENT GROUP...
+    m_file.skip_line();  // ELEMENT GROUP...
     m_file >> line >> NGP >> line >> NELGP >> line >> MTYP >> line >> NFLAGS >> ELMMAT;
     groups[g].NGP    = NGP;
     groups[g].NELGP  = NELGP;
@@ -451,7 +509,7 @@ void CReader::read_groups()
     //    these new regions.
 
     // Read first to see howmany elements to allocate
-    int p = m_file.tellg();
+    MappedFile::Position p = m_file.position();
     Uint nb_elems_in_group = 0;
     for (Uint i=0; i<NELGP; ++i)
     {
@@ -461,7 +519,7 @@ void CReader::read_groups()
     }
     // now allocate and read again
     groups[g].ELEM.reserve(nb_elems_in_group);
-    m_file.seekg(p,std::ios::beg);
+    m_file.seek(p);
     for (Uint i=0; i<NELGP; ++i)
     {
       m_file >> I;
@@ -469,8 +527,8 @@ void CReader::read_groups()
         groups[g].ELEM.push_back(I);     // set element index
     }
 
-    getline(m_file,line);  // finish the line (read new line)
-    getline(m_file,line);  // ENDOFSECTION
+    m_file.skip_line();  // finish the line (read new line)
+    m_file.skip_line();  // ENDOFSECTION
   }
 
   // Create Region for each group
@@ -511,14 +569,14 @@ void CReader::read_boundaries()
   std::string line;
   for (Uint t=0; t<m_headerData.NBSETS; ++t) {
 
-    m_file.seekg(m_boundary_condition_positions[t],std::ios::beg);
+    m_file.seek(m_boundary_condition_positions[t]);
 
     std::string NAME;
     int ITYPE, NENTRY, NVALUES, IBCODE1, IBCODE2, IBCODE3, IBCODE4, IBCODE5;
 
     // read header
-    getline(m_file,line);  // BOUNDARY CONDITIONS...
-    getline(m_file,line);  // header
+    m_file.skip_line();  // BOUNDARY CONDITIONS...
+    m_file.get_line(line);  // header
     std::stringstream ss(line);
     ss >> NAME >> ITYPE >> NENTRY >> NVALUES >> IBCODE1 >> IBCODE2 >> IBCODE3 >> IBCODE4 >> IBCODE5;
     if (ITYPE!=1) {
@@ -567,9 +625,9 @@ void CReader::read_boundaries()
         buffer[face_type]->add_row(row);
 
       }
-      getline(m_file,line);  // finish the line (read new line)
+      m_file.skip_line();  // finish the line (read new line)
     }
-    getline(m_file,line);  // ENDOFSECTION
+    m_file.skip_line();  // ENDOFSECTION
 
   }
 }
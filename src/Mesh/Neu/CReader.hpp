@@ -9,6 +9,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "Common/MappedFile.hpp"
+
 #include "Mesh/CMeshReader.hpp"
 #include "Mesh/CTable.hpp"
 #include "Mesh/Geometry.hpp"
@@ -69,6 +71,12 @@ private: // functions
 
 	void get_file_positions();
 
+	/// Put the file at the line of a node, using the positions of the parts
+	void go_to_node(const Uint node_idx);
+
+	/// Read the coordinates of one node from the file
+	void read_node(const Uint node_idx, const Uint coord_idx);
+
 	std::string element_type(const Uint neu_type, const Uint nb_nodes);
 
 private: // data
@@ -81,7 +89,7 @@ private: // data
   // map< global index , pair< temporary table, index in temporary table > >
   std::map<Uint,Region_TableIndex_pair> m_global_to_tmp;
 
-  boost::filesystem::fstream m_file;
+  Common::MappedFile m_file;
   CMesh::Ptr m_mesh;
   CRegion::Ptr m_region;
   CRegion::Ptr m_tmp;
@@ -89,10 +97,17 @@ private: // data
 	std::set<Uint> m_ghost_nodes;
 	std::map<Uint,Uint> m_node_to_coord_idx;
 
-	Uint m_nodal_coordinates_position;
-	Uint m_elements_cells_position;
-	std::vector<Uint> m_element_group_positions;
-	std::vector<Uint> m_boundary_condition_positions;
+	Common::MappedFile::Position m_nodal_coordinates_position;
+	Common::MappedFile::Position m_elements_cells_position;
+	std::vector<Common::MappedFile::Position> m_element_group_positions;
+	std::vector<Common::MappedFile::Position> m_boundary_condition_positions;
+
+	/// Position of the first node of every part of the node hash
+	std::vector<Common::MappedFile::Position> m_node_part_positions;
+	/// Position of the first element of every part of the element hash
+	std::vector<Common::MappedFile::Position> m_element_part_positions;
+	/// Index of the node at the current position in the file
+	Uint m_current_node;
 
   struct HeaderData
   {
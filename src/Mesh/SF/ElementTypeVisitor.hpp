@@ -0,0 +1,72 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Mesh_SF_ElementTypeVisitor_hpp
+#define CF_Mesh_SF_ElementTypeVisitor_hpp
+
+#include <boost/mpl/for_each.hpp>
+#include <boost/mpl/placeholders.hpp>
+#include <boost/ref.hpp>
+#include <boost/type_traits/add_pointer.hpp>
+
+#include "Mesh/ElementType.hpp"
+
+namespace CF {
+namespace Mesh {
+namespace SF {
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Functor for boost::mpl::for_each, calling the visitor for the type that matches the element type.
+/// for_each gets pointers to the types, so the element types are never constructed.
+template<typename VisitorT>
+struct ElementTypeDispatcher
+{
+  ElementTypeDispatcher(const ElementType& etype, VisitorT& visitor) :
+    m_etype(etype),
+    m_visitor(visitor),
+    m_found(false)
+  {
+  }
+
+  template<typename SF>
+  void operator()(SF*)
+  {
+    if(m_found || !IsElementType<SF>()(m_etype))
+      return;
+    m_found = true;
+    m_visitor.template apply<SF>();
+  }
+
+  const ElementType& m_etype;
+  VisitorT& m_visitor;
+  bool m_found;
+};
+
+} // detail
+
+/// Call visitor.template apply<SF>() with SF the type of TypesT that is the concrete type of etype.
+/// This resolves the element type once, e.g. once per CElements, after which the visitor can loop over
+/// the elements using the fixed size types of SF (SF::NodeMatrixT, SF::compute_value, ...), without
+/// virtual calls nor dynamic allocations in the loop.
+/// @return false if etype is not in TypesT, in which case the visitor is not called
+template<typename TypesT, typename VisitorT>
+bool visit_element_type(const ElementType& etype, VisitorT& visitor)
+{
+  detail::ElementTypeDispatcher<VisitorT> dispatcher(etype, visitor);
+  boost::mpl::for_each< TypesT, boost::add_pointer<boost::mpl::_1> >(boost::ref(dispatcher));
+  return dispatcher.m_found;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // SF
+} // Mesh
+} // CF
+
+#endif // CF_Mesh_SF_ElementTypeVisitor_hpp
@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFHexaLagrangeP0, ShapeFunction, LibSF > SFHexaLagran
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFHexaLagrangeP0::SFHexaLagrangeP0(const std::string& name) : ShapeFunction(name)
+SFHexaLagrangeP0::SFHexaLagrangeP0(const std::string& name) : ShapeFunctionT<SFHexaLagrangeP0>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
@@ -7,7 +7,7 @@
 #ifndef CF_Mesh_SF_SFHexaLagrangeP0_hpp
 #define CF_Mesh_SF_SFHexaLagrangeP0_hpp
 
-#include "Mesh/ShapeFunction.hpp"
+#include "Mesh/SF/ShapeFunctionT.hpp"
 #include "Mesh/GeoShape.hpp"
 #include "Mesh/SF/LibSF.hpp"
 
@@ -27,7 +27,7 @@ namespace SF {
 ///             -------------
 /// Reference domain: <-1,1> x <-1,1> x <-1,1>
 /// @endverbatim
-class MESH_SF_API SFHexaLagrangeP0  : public ShapeFunction {
+class MESH_SF_API SFHexaLagrangeP0  : public ShapeFunctionT<SFHexaLagrangeP0> {
 public:
 
   static const Uint dimensionality = 3;
@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFHexaLagrangeP1, ShapeFunction, LibSF > SFHexaLagran
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFHexaLagrangeP1::SFHexaLagrangeP1(const std::string& name) : ShapeFunction(name)
+SFHexaLagrangeP1::SFHexaLagrangeP1(const std::string& name) : ShapeFunctionT<SFHexaLagrangeP1>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
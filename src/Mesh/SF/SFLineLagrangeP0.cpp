@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFLineLagrangeP0, ShapeFunction, LibSF > SFLineLagran
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFLineLagrangeP0::SFLineLagrangeP0(const std::string& name) : ShapeFunction(name)
+SFLineLagrangeP0::SFLineLagrangeP0(const std::string& name) : ShapeFunctionT<SFLineLagrangeP0>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
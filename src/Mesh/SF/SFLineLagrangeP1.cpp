@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFLineLagrangeP1, ShapeFunction, LibSF > SFLineLagran
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFLineLagrangeP1::SFLineLagrangeP1(const std::string& name) : ShapeFunction(name)
+SFLineLagrangeP1::SFLineLagrangeP1(const std::string& name) : ShapeFunctionT<SFLineLagrangeP1>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFLineLagrangeP2, ShapeFunction, LibSF > SFLineLagran
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFLineLagrangeP2::SFLineLagrangeP2(const std::string& name) : ShapeFunction(name)
+SFLineLagrangeP2::SFLineLagrangeP2(const std::string& name) : ShapeFunctionT<SFLineLagrangeP2>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFLineLagrangeP3, ShapeFunction, LibSF > SFLineLagran
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFLineLagrangeP3::SFLineLagrangeP3(const std::string& name) : ShapeFunction(name)
+SFLineLagrangeP3::SFLineLagrangeP3(const std::string& name) : ShapeFunctionT<SFLineLagrangeP3>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
@@ -7,7 +7,7 @@
 #ifndef CF_Mesh_SF_SFLineLagrangeP3_hpp
 #define CF_Mesh_SF_SFLineLagrangeP3_hpp
 
-#include "Mesh/ShapeFunction.hpp"
+#include "Mesh/SF/ShapeFunctionT.hpp"
 #include "Mesh/GeoShape.hpp"
 #include "Mesh/SF/LibSF.hpp"
 
@@ -15,7 +15,7 @@ namespace CF {
 namespace Mesh {
 namespace SF {
 
-class MESH_SF_API SFLineLagrangeP3  : public ShapeFunction {
+class MESH_SF_API SFLineLagrangeP3  : public ShapeFunctionT<SFLineLagrangeP3> {
 public:
 
   static const Uint dimensionality = 1;
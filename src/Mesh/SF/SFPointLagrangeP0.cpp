@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFPointLagrangeP0, ShapeFunction, LibSF > SFPointLagr
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFPointLagrangeP0::SFPointLagrangeP0(const std::string& name) : ShapeFunction(name)
+SFPointLagrangeP0::SFPointLagrangeP0(const std::string& name) : ShapeFunctionT<SFPointLagrangeP0>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFQuadLagrangeP0, ShapeFunction, LibSF > SFQuadLagran
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFQuadLagrangeP0::SFQuadLagrangeP0(const std::string& name) : ShapeFunction(name)
+SFQuadLagrangeP0::SFQuadLagrangeP0(const std::string& name) : ShapeFunctionT<SFQuadLagrangeP0>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFQuadLagrangeP1, ShapeFunction, LibSF > SFQuadLagran
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFQuadLagrangeP1::SFQuadLagrangeP1(const std::string& name) : ShapeFunction(name)
+SFQuadLagrangeP1::SFQuadLagrangeP1(const std::string& name) : ShapeFunctionT<SFQuadLagrangeP1>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
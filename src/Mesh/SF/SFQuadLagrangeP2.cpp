@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFQuadLagrangeP2, ShapeFunction, LibSF > SFQuadLagran
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFQuadLagrangeP2::SFQuadLagrangeP2(const std::string& name) : ShapeFunction(name)
+SFQuadLagrangeP2::SFQuadLagrangeP2(const std::string& name) : ShapeFunctionT<SFQuadLagrangeP2>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFQuadLagrangeP3, ShapeFunction, LibSF > SFQuadLagran
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFQuadLagrangeP3::SFQuadLagrangeP3(const std::string& name) : ShapeFunction(name)
+SFQuadLagrangeP3::SFQuadLagrangeP3(const std::string& name) : ShapeFunctionT<SFQuadLagrangeP3>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
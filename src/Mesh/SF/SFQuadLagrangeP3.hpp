@@ -7,7 +7,7 @@
 #ifndef CF_Mesh_SF_SFQuadLagrangeP3_hpp
 #define CF_Mesh_SF_SFQuadLagrangeP3_hpp
 
-#include "Mesh/ShapeFunction.hpp"
+#include "Mesh/SF/ShapeFunctionT.hpp"
 #include "Mesh/GeoShape.hpp"
 #include "Mesh/SF/LibSF.hpp"
 
@@ -27,7 +27,7 @@ namespace SF {
 ///             0---4---5---1
 /// Reference domain: <-1,1> x <-1,1>
 /// @endverbatim
-class MESH_SF_API SFQuadLagrangeP3  : public ShapeFunction {
+class MESH_SF_API SFQuadLagrangeP3  : public ShapeFunctionT<SFQuadLagrangeP3> {
 public:
 
   static const Uint dimensionality = 2;
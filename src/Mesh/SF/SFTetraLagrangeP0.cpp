@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFTetraLagrangeP0, ShapeFunction, LibSF > SFTetraLagr
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFTetraLagrangeP0::SFTetraLagrangeP0(const std::string& name) : ShapeFunction(name)
+SFTetraLagrangeP0::SFTetraLagrangeP0(const std::string& name) : ShapeFunctionT<SFTetraLagrangeP0>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
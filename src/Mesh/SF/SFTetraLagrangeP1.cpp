@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFTetraLagrangeP1, ShapeFunction, LibSF > SFTetraLagr
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFTetraLagrangeP1::SFTetraLagrangeP1(const std::string& name) : ShapeFunction(name)
+SFTetraLagrangeP1::SFTetraLagrangeP1(const std::string& name) : ShapeFunctionT<SFTetraLagrangeP1>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFTriagLagrangeP0, ShapeFunction, LibSF > SFTriagLagr
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFTriagLagrangeP0::SFTriagLagrangeP0(const std::string& name) : ShapeFunction(name)
+SFTriagLagrangeP0::SFTriagLagrangeP0(const std::string& name) : ShapeFunctionT<SFTriagLagrangeP0>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
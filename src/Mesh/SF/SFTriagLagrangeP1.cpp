@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFTriagLagrangeP1, ShapeFunction, LibSF > SFTriagLagr
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFTriagLagrangeP1::SFTriagLagrangeP1(const std::string& name) : ShapeFunction(name)
+SFTriagLagrangeP1::SFTriagLagrangeP1(const std::string& name) : ShapeFunctionT<SFTriagLagrangeP1>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
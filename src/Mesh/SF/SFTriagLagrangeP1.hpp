@@ -7,7 +7,7 @@
 #ifndef CF_Mesh_SF_SFTriagLagrangeP1_hpp
 #define CF_Mesh_SF_SFTriagLagrangeP1_hpp
 
-#include "Mesh/ShapeFunction.hpp"
+#include "Mesh/SF/ShapeFunctionT.hpp"
 #include "Mesh/GeoShape.hpp"
 #include "Mesh/SF/LibSF.hpp"
 
@@ -27,7 +27,7 @@ namespace SF {
 ///             0-----------1
 /// Reference domain: <0,1> x <0,1>
 /// @endverbatim
-class MESH_SF_API SFTriagLagrangeP1  : public ShapeFunction {
+class MESH_SF_API SFTriagLagrangeP1  : public ShapeFunctionT<SFTriagLagrangeP1> {
 public:
 
   static const Uint dimensionality = 2;
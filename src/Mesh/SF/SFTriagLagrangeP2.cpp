@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFTriagLagrangeP2, ShapeFunction, LibSF > SFTriagLagr
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFTriagLagrangeP2::SFTriagLagrangeP2(const std::string& name) : ShapeFunction(name)
+SFTriagLagrangeP2::SFTriagLagrangeP2(const std::string& name) : ShapeFunctionT<SFTriagLagrangeP2>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
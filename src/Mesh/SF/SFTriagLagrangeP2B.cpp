@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFTriagLagrangeP2B, ShapeFunction, LibSF > SFTriagLag
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFTriagLagrangeP2B::SFTriagLagrangeP2B(const std::string& name) : ShapeFunction(name)
+SFTriagLagrangeP2B::SFTriagLagrangeP2B(const std::string& name) : ShapeFunctionT<SFTriagLagrangeP2B>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
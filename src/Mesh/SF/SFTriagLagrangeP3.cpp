@@ -19,7 +19,7 @@ Common::ComponentBuilder < SFTriagLagrangeP3, ShapeFunction, LibSF > SFTriagLagr
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SFTriagLagrangeP3::SFTriagLagrangeP3(const std::string& name) : ShapeFunction(name)
+SFTriagLagrangeP3::SFTriagLagrangeP3(const std::string& name) : ShapeFunctionT<SFTriagLagrangeP3>(name)
 {
   m_dimensionality = dimensionality;
   m_nb_nodes = nb_nodes;
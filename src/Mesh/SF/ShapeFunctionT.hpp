@@ -0,0 +1,49 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Mesh_SF_ShapeFunctionT_hpp
+#define CF_Mesh_SF_ShapeFunctionT_hpp
+
+#include "Mesh/ShapeFunction.hpp"
+
+namespace CF {
+namespace Mesh {
+namespace SF {
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Base for the concrete shape functions, implementing the dynamic interface of ShapeFunction
+/// in terms of the static compute_value and compute_gradient of the shape function SF.
+/// SF must provide the ValueT and GradientT typedefs.
+template<typename SF>
+class ShapeFunctionT : public ShapeFunction {
+public:
+
+  ShapeFunctionT(const std::string& name) : ShapeFunction(name) {}
+
+  virtual void put_value(const RealVector& local_coord, RealRowVector& result) const
+  {
+    typename SF::ValueT values;
+    SF::compute_value(local_coord,values);
+    result = values;
+  }
+
+  virtual void put_gradient(const RealVector& local_coord, RealMatrix& result) const
+  {
+    typename SF::GradientT gradients;
+    SF::compute_gradient(local_coord,gradients);
+    result = gradients;
+  }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // SF
+} // Mesh
+} // CF
+
+#endif // CF_Mesh_SF_ShapeFunctionT_hpp
@@ -41,6 +41,20 @@ RealMatrix ShapeFunction::gradient(const RealVector& local_coord) const
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void ShapeFunction::put_value(const RealVector& local_coord, RealRowVector& result) const
+{
+  result = value(local_coord);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ShapeFunction::put_gradient(const RealVector& local_coord, RealMatrix& result) const
+{
+  result = gradient(local_coord);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 const RealMatrix& ShapeFunction::local_coordinates() const
 {
   throw Common::NotImplemented(FromHere(),"local coordinates not implemented for " + derived_type_name());
@@ -61,6 +61,12 @@ public: // functions
 
   virtual RealMatrix gradient(const RealVector& local_coord) const;
 
+  /// Compute the values in a preallocated row vector, which is not reallocated if it has the right size
+  virtual void put_value(const RealVector& local_coord, RealRowVector& result) const;
+
+  /// Compute the gradient in a preallocated matrix, which is not reallocated if it has the right size
+  virtual void put_gradient(const RealVector& local_coord, RealMatrix& result) const;
+
   virtual const RealMatrix& local_coordinates() const;
 
 protected: // data
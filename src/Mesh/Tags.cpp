@@ -18,6 +18,9 @@ const char * Tags::volume () { return "volume"; }
 const char * Tags::coordinates ()  { return "coordinates"; }
 const char * Tags::nodes ()        { return "nodes"; }
 const char * Tags::nodes_used ()   { return "nodes_used"; }
+const char * Tags::interior_first () { return "interior_first"; }
+const char * Tags::coloured_elements () { return "coloured_elements"; }
+const char * Tags::geometry_cache () { return "geometry_cache"; }
 
 const char * Tags::global_elem_indices ()  { return "gelemidx"; }
 const char * Tags::global_node_indices ()  { return "gnodeidx"; }
@@ -29,6 +29,9 @@ public:
   static const char * coordinates ();
   static const char * nodes ();
   static const char * nodes_used ();
+  static const char * interior_first ();
+  static const char * coloured_elements ();
+  static const char * geometry_cache ();
 
   static const char * global_elem_indices ();
   static const char * global_node_indices ();
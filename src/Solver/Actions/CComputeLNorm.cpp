@@ -28,64 +28,75 @@ namespace Actions {
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-void compute_L2( CTable<Real>::ArrayT& array, Real& norm )
+/// @param values the first column of the field, either contiguous or with the stride of the field rows
+template < typename VectorT >
+void compute_L2( const VectorT& values, Real& norm )
 {
   const int size = 1; // sum 1 value in each processor
 
-  Real loc_norm = 0.; // norm on local processor
+  Real loc_norm = values.squaredNorm(); // norm on local processor
   Real glb_norm = 0.; // norm summed over all processors
 
-  boost_foreach(CTable<Real>::ConstRow row, array )
-      loc_norm += row[0]*row[0];
-
   Comm::PE::instance().all_reduce( Comm::plus(), &loc_norm, size, &glb_norm );
 
   norm = std::sqrt(glb_norm);
 }
 
-void compute_L1( CTable<Real>::ArrayT& array, Real& norm )
+template < typename VectorT >
+void compute_L1( const VectorT& values, Real& norm )
 {
   const int size = 1; // sum 1 value in each processor
 
-  Real loc_norm = 0.; // norm on local processor
+  Real loc_norm = values.cwiseAbs().sum(); // norm on local processor
   Real glb_norm = 0.; // norm summed over all processors
 
-  boost_foreach(CTable<Real>::ConstRow row, array )
-      loc_norm += std::abs( row[0] );
-
   Comm::PE::instance().all_reduce( Comm::plus(), &loc_norm, size, &glb_norm );
+
+  norm = glb_norm;
 }
 
-void compute_Linf( CTable<Real>::ArrayT& array, Real& norm )
+template < typename VectorT >
+void compute_Linf( const VectorT& values, Real& norm )
 {
   const int size = 1; // sum 1 value in each processor
 
-  Real loc_norm = 0.; // norm on local processor
+  Real loc_norm = values.cwiseAbs().maxCoeff(); // norm on local processor
   Real glb_norm = 0.; // norm summed over all processors
 
-  boost_foreach(CTable<Real>::ConstRow row, array )
-      loc_norm = std::max( std::abs(row[0]), loc_norm );
-
   Comm::PE::instance().all_reduce( Comm::max(), &loc_norm, size, &glb_norm );
 
   norm = glb_norm;
 }
 
-void compute_Lp( CTable<Real>::ArrayT& array, Real& norm, Uint order )
+template < typename VectorT >
+void compute_Lp( const VectorT& values, Real& norm, Uint order )
 {
   const int size = 1; // sum 1 value in each processor
 
-  Real loc_norm = 0.; // norm on local processor
+  Real loc_norm = values.array().abs().pow( (Real)order ).sum(); // norm on local processor
   Real glb_norm = 0.; // norm summed over all processors
 
-  boost_foreach(CTable<Real>::ConstRow row, array )
-    loc_norm += std::pow( std::abs(row[0]), (int)order ) ;
-
   Comm::PE::instance().all_reduce( Comm::plus(), &loc_norm, size, &glb_norm );
 
   norm = std::pow(glb_norm, 1./order );
 }
 
+template < typename VectorT >
+void compute_norm( const VectorT& values, Real& norm, Uint order )
+{
+  switch(order) {
+
+  case 2:  compute_L2( values, norm );    break;
+
+  case 1:  compute_L1( values, norm );    break;
+
+  case 0:  compute_Linf( values, norm );  break; // consider order 0 as Linf
+
+  default: compute_Lp( values, norm, order );    break;
+
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 
 Common::ComponentBuilder < CComputeLNorm, CAction, LibActions > CComputeLNorm_Builder;
@@ -117,10 +128,9 @@ void CComputeLNorm::execute()
 {
   if ( m_field.expired() ) 	throw SetupError(FromHere(), "Field was not set");
 
-  CTable<Real>& table = *m_field.lock();
-  CTable<Real>::ArrayT& array =  m_field.lock()->array();
+  const Field& field = *m_field.lock();
 
-  const Uint nbrows = table.size();
+  const Uint nbrows = field.size();
 
   if ( !nbrows ) throw SetupError(FromHere(), "Field has empty table");
 
@@ -130,17 +140,10 @@ void CComputeLNorm::execute()
 
   // sum of all processors
 
-  switch(order) {
-
-  case 2:  compute_L2( array, norm );    break;
-
-  case 1:  compute_L1( array, norm );    break;
-
-  case 0:  compute_Linf( array, norm );  break; // consider order 0 as Linf
-
-  default: compute_Lp( array, norm, order );    break;
-
-  }
+  if ( field.has_contiguous_columns() )
+    compute_norm( field.column(0), norm, order );
+  else
+    compute_norm( Eigen::Map< const RealVector, 0, Eigen::InnerStride<> >( field.array().data(), nbrows, Eigen::InnerStride<>(field.row_size()) ), norm, order );
 
 
   if( m_options.option("Scale").value<bool>() && order )
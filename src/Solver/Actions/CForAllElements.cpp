@@ -12,6 +12,7 @@
 #include "Mesh/CElements.hpp"
 
 #include "Solver/Actions/CForAllElements.hpp"
+#include "Solver/Tags.hpp"
 
 /////////////////////////////////////////////////////////////////////////////////////
 
@@ -27,29 +28,61 @@ ComponentBuilder < CForAllElements, CLoop, LibActions > CForAllElements_builder;
 /////////////////////////////////////////////////////////////////////////////////////
 
 CForAllElements::CForAllElements ( const std::string& name ) :
-  CLoop(name)
+  CLoop(name),
+  m_plan_version(0),
+  m_compiled(false)
 {
-   
+  m_options[Tags::regions()].attach_trigger ( boost::bind ( &CForAllElements::trigger_regions, this ) );
 }
 
-void CForAllElements::execute()
+void CForAllElements::trigger_regions()
 {
+  m_compiled = false;
+}
+
+void CForAllElements::compile()
+{
+  m_loop_elements.clear();
   boost_foreach(CRegion::Ptr& region, m_loop_regions)
     boost_foreach(CElements& elements, find_components_recursively<CElements>(*region))
+      m_loop_elements.push_back(elements.as_ptr<CElements>());
+
+  m_operations.clear();
+  boost_foreach(CLoopOperation& op, find_components<CLoopOperation>(*this))
+    m_operations.push_back(op.as_ptr<CLoopOperation>());
+
+  m_plan_version = tree_version();
+  m_compiled = true;
+}
+
+void CForAllElements::execute()
+{
+  if ( !m_compiled || m_plan_version != tree_version() )
+    compile();
+
+  if ( overlaps_synchronization() )
+  {
+    // interior elements while the ghost data is in flight
+    loop_pass(INTERIOR_ELEMENTS);
+    synchronize_end();
+    loop_pass(HALO_ELEMENTS);
+  }
+  else
+  {
+    loop_pass(ALL_ELEMENTS);
+  }
+}
+
+void CForAllElements::loop_pass(const ElementsPass pass)
+{
+  boost_foreach(const CElements::Ptr& elements, m_loop_elements)
   {
     // Setup all child operations
-    boost_foreach(CLoopOperation& op, find_components<CLoopOperation>(*this))
+    boost_foreach(const CLoopOperation::Ptr& op, m_operations)
     {
-      op.set_elements(elements);
-      if (op.can_start_loop())
-      {
-        const Uint nb_elem = elements.size();
-        for ( Uint elem = 0; elem != nb_elem; ++elem )
-        {
-          op.select_loop_idx(elem);
-          op.execute();
-        }
-      }
+      op->set_elements(*elements);
+      if (op->can_start_loop())
+        loop_elements(*op,*elements,pass);
     }
   }
 }
@@ -41,6 +41,30 @@ public: // functions
 
   virtual void execute();
 
+private: // functions
+
+  /// loop all operations over the elements of one pass
+  void loop_pass(const ElementsPass pass);
+
+  /// Resolve the elements of the regions and the operations to execute on them.
+  /// Done again when the regions or the component trees change.
+  void compile();
+
+  void trigger_regions();
+
+private: // data
+
+  /// elements of the regions to loop over
+  std::vector<Mesh::CElements::Ptr> m_loop_elements;
+
+  /// operations executed on every element
+  std::vector<CLoopOperation::Ptr> m_operations;
+
+  /// Common::Component::tree_version() when the elements and operations were resolved
+  Uint m_plan_version;
+
+  bool m_compiled;
+
 };
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -11,6 +11,8 @@
 
 #include "Common/Foreach.hpp"
 #include "Common/FindComponents.hpp"
+#include "Common/OptionT.hpp"
+#include "Common/StringConversion.hpp"
 
 #include "Mesh/SF/Types.hpp"
 #include "Mesh/CRegion.hpp"
@@ -48,14 +50,20 @@ class Solver_Actions_API CForAllElementsT : public CLoop
       /// Region to loop on
       Mesh::CRegion& region;
 
-      /// Operation to perform
-      ActionT& op;
+      /// Operation to perform, one copy per thread
+      std::vector<ActionT*>& ops;
+
+      /// Elements to visit
+      const ElementsPass pass;
+
+      /// Visit the elements colour by colour
+      const bool coloured;
 
     public: // functions
 
       /// Constructor
-      ElementLooper(ActionT& operation, Mesh::CRegion& region_in )
-        : region(region_in) , op(operation)
+      ElementLooper(std::vector<ActionT*>& operations, Mesh::CRegion& region_in, const ElementsPass pass_in = ALL_ELEMENTS, const bool coloured_in = false )
+        : region(region_in) , ops(operations), pass(pass_in), coloured(coloured_in)
       {}
 
       /// Operator
@@ -64,16 +72,10 @@ class Solver_Actions_API CForAllElementsT : public CLoop
       {
         boost_foreach(Mesh::CElements& elements, Common::find_components_recursively_with_filter<Mesh::CElements>(region,IsShapeFunction<SFType>()))
         {
-          op.set_elements(elements);
-          if (op.can_start_loop())
-          {
-            const Uint nb_elem = elements.size();
-            for ( Uint elem = 0; elem != nb_elem; ++elem )
-            {
-              op.select_loop_idx(elem);
-              op.execute();
-            }
-          }
+          boost_foreach(ActionT* op, ops)
+            op->set_elements(elements);
+          if (ops[0]->can_start_loop())
+            loop_elements(ops,elements,pass,coloured);
         }
       }
 
@@ -90,10 +92,18 @@ public: // functions
   /// @param name of the component
   CForAllElementsT ( const std::string& name ) :
     CLoop(name),
-    m_action( Common::allocate_component<ActionT>(ActionT::type_name()) )
+    m_action( Common::allocate_component<ActionT>(ActionT::type_name()) ),
+    m_deterministic(false),
+    m_copied_options_version(0)
   {
     regist_typeinfo(this);
     add_static_component ( m_action );
+
+    m_options.add_option< Common::OptionT<bool> >("deterministic", m_deterministic)
+        ->description("Visit the elements colour by colour also with a single thread, "
+                      "so that the results do not depend on the number of threads")
+        ->pretty_name("Deterministic")
+        ->link_to(&m_deterministic);
   }
 
   /// Virtual destructor
@@ -117,20 +127,76 @@ public: // functions
   /// Execute the loop for all elements
   virtual void execute()
   {
+    if ( overlaps_synchronization() )
+    {
+      // interior elements while the ghost data is in flight
+      loop_pass(INTERIOR_ELEMENTS);
+      synchronize_end();
+      loop_pass(HALO_ELEMENTS);
+    }
+    else
+    {
+      loop_pass(ALL_ELEMENTS);
+    }
+  }
+
+private: // functions
+
+  /// Execute the loop for the elements of one pass
+  void loop_pass(const ElementsPass pass)
+  {
+    std::vector<ActionT*> ops = thread_actions();
+
     boost_foreach(Mesh::CRegion::Ptr& region, m_loop_regions)
     {
       CFinfo << region->uri().string() << CFendl;
-      
-      ElementLooper loop_elements(*m_action,*region);
-      boost::mpl::for_each< Mesh::SF::Types >(loop_elements);
+
+      ElementLooper looper(ops,*region,pass,m_deterministic);
+      boost::mpl::for_each< Mesh::SF::Types >(looper);
     }
   }
 
+  /// The operation for every thread of the pool, the copies are created when needed
+  /// and configured with the options of the operation when these changed
+  std::vector<ActionT*> thread_actions()
+  {
+    const Uint nb_threads = Common::Core::instance().thread_pool().nb_threads();
+    const bool options_changed = options_version(*m_action) != m_copied_options_version;
+    m_copied_options_version = options_version(*m_action);
+
+    std::vector<ActionT*> ops(1,m_action.get());
+    for (Uint t=1; t<nb_threads; ++t)
+    {
+      const std::string name = ActionT::type_name() + "_" + Common::to_str(t);
+      Common::Component::Ptr comp = get_child_ptr(name);
+      typename ActionT::Ptr copy;
+      if ( is_null(comp) )
+      {
+        copy = create_component_ptr<ActionT>(name);
+        copy_options(*m_action,*copy);
+      }
+      else
+      {
+        copy = comp->as_ptr_checked<ActionT>();
+        if ( options_changed )
+          copy_options(*m_action,*copy);
+      }
+      ops.push_back(copy.get());
+    }
+    return ops;
+  }
+
 private: // data
 
   /// Operation to perform
   typename ActionT::Ptr m_action;
 
+  /// Visit the elements colour by colour also with one thread
+  bool m_deterministic;
+
+  /// options_version() of the operation when its copies were last configured
+  Uint m_copied_options_version;
+
 };
 
 /////////////////////////////////////////////////////////////////////////////////////
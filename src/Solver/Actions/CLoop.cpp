@@ -5,13 +5,14 @@
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
 #include "Common/URI.hpp"
- 
+#include "Common/Foreach.hpp"
 
 #include "Common/OptionArray.hpp"
 
 #include "Solver/Actions/CLoop.hpp"
 
 #include "Mesh/CRegion.hpp"
+#include "Mesh/Field.hpp"
 
 /////////////////////////////////////////////////////////////////////////////////////
 
@@ -28,6 +29,71 @@ CLoop::CLoop ( const std::string& name ) :
   Solver::Action(name)
 {
   mark_basic();
+
+  std::vector< URI > dummy;
+  m_options.add_option< OptionArrayT < URI > > ("overlap_fields", dummy)
+      ->description("Fields started with Field::synchronize_begin(), which are completed after looping the interior elements and before looping the halo elements")
+      ->pretty_name("Overlap Fields")
+      ->attach_trigger ( boost::bind ( &CLoop::config_overlap_fields, this ) );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+void CLoop::config_overlap_fields()
+{
+  std::vector<URI> vec; option("overlap_fields").put_value(vec);
+
+  m_overlap_fields.clear();
+  boost_foreach(const URI field_path, vec)
+  {
+    Component& comp = access_component(field_path);
+
+    if ( Field::Ptr field = comp.as_ptr<Field>() )
+      m_overlap_fields.push_back( field );
+    else
+      throw ValueNotFound ( FromHere(), "Could not find field with path [" + field_path.path() +"]" );
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+void CLoop::synchronize_end()
+{
+  boost_foreach(boost::weak_ptr<Field> ptr, m_overlap_fields)
+  {
+    if( ptr.expired() ) continue; // skip if pointer invalid
+
+    ptr.lock()->synchronize_end();
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+void CLoop::copy_options( const Component& from, Component& to )
+{
+  for ( OptionList::const_iterator it = from.options().begin(); it != from.options().end(); ++it )
+  {
+    if ( it->first == "elements" || it->first == "loop_index" )
+      continue;
+    if ( to.options().check(it->first) )
+      to.configure_option( it->first, it->second->value() );
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+Uint CLoop::options_version( const Component& component )
+{
+  // the versions only increase, so their sum only stays the same if none changed,
+  // and every option counts once more, for options added later
+  Uint version = 0;
+  for ( OptionList::const_iterator it = component.options().begin(); it != component.options().end(); ++it )
+  {
+    if ( it->first == "elements" || it->first == "loop_index" )
+      continue;
+    version += it->second->version() + 1;
+  }
+  return version;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -7,6 +7,15 @@
 #ifndef CF_Solver_Actions_CLoop_hpp
 #define CF_Solver_Actions_CLoop_hpp
 
+#include <algorithm>
+
+#include "Common/Core.hpp"
+#include "Common/ThreadPool.hpp"
+
+#include "Mesh/CList.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/Actions/CColourElements.hpp"
+
 #include "Solver/Actions/LibActions.hpp"
 #include "Solver/Action.hpp"
 #include "Solver/Actions/CLoopOperation.hpp"
@@ -18,6 +27,7 @@ namespace CF {
   namespace Mesh
   {
     class CRegion;
+    class Field;
   }
 
 namespace Solver {
@@ -58,11 +68,173 @@ public: // functions
 
   virtual void execute() = 0;
 
+  /// Part of the elements visited in one pass of the loop
+  enum ElementsPass { ALL_ELEMENTS, INTERIOR_ELEMENTS, HALO_ELEMENTS };
+
+  /// Loop an operation over the elements of one pass.
+  /// Interior elements only use nodes owned by this rank, halo elements use at least one ghost node.
+  template < typename OperationT >
+  static void loop_elements( OperationT& op, Mesh::CElements& elements, const ElementsPass pass )
+  {
+    if ( pass == ALL_ELEMENTS )
+    {
+      const Uint nb_elem = elements.size();
+      for ( Uint elem = 0; elem != nb_elem; ++elem )
+      {
+        op.select_loop_idx(elem);
+        op.execute();
+      }
+      return;
+    }
+
+    const Mesh::CList<Uint>& order = Mesh::CEntities::interior_first_elements(elements);
+    const Uint nb_interior = order.properties().template value<Uint>("nb_interior");
+    const Uint begin = pass == INTERIOR_ELEMENTS ? 0 : nb_interior;
+    const Uint end   = pass == INTERIOR_ELEMENTS ? nb_interior : order.size();
+    for ( Uint i = begin; i != end; ++i )
+    {
+      op.select_loop_idx(order[i]);
+      op.execute();
+    }
+  }
+
+  /// Loop one operation per thread of the pool (see Common::ThreadPool) over the elements of one pass.
+  /// The elements are visited colour by colour (see Mesh::Actions::CColourElements),
+  /// so that elements executed concurrently never share a node, and the threads take
+  /// chunks of the elements of the current colour until none are left.
+  /// With the NUMA_FIRST_TOUCH policy of the pool, every thread instead visits the elements of the current colour
+  /// within its static share of the element rows (see Common::ThreadPool::parallel_for_static()), which are the rows
+  /// that Common::ThreadPool::first_touch() placed in its memory. The elements of a colour are sorted by index.
+  /// With a single operation the elements are visited in the original order, unless coloured is true.
+  /// Each node receives the contributions in the order of the colours, so the result does not
+  /// depend on the number of threads when the loop is coloured.
+  /// @param ops one operation per thread of the pool, ops[i] is executed by the thread with index i
+  template < typename OperationT >
+  static void loop_elements( std::vector<OperationT*>& ops, Mesh::CElements& elements, const ElementsPass pass, const bool coloured )
+  {
+    cf_assert( !ops.empty() );
+    if ( ops.size() == 1 && !coloured )
+    {
+      loop_elements(*ops[0],elements,pass);
+      return;
+    }
+
+    Common::ThreadPool& pool = Common::Core::instance().thread_pool();
+    cf_assert( ops.size() >= pool.nb_threads() );
+
+    // mark the elements visited by this pass
+    std::vector<bool> in_pass;
+    if ( pass != ALL_ELEMENTS )
+    {
+      const Mesh::CList<Uint>& order = Mesh::CEntities::interior_first_elements(elements);
+      const Uint nb_interior = order.properties().template value<Uint>("nb_interior");
+      in_pass.resize(elements.size(),pass == HALO_ELEMENTS);
+      for ( Uint i = 0; i != nb_interior; ++i )
+        in_pass[order[i]] = pass == INTERIOR_ELEMENTS;
+    }
+
+    const Mesh::CList<Uint>& colouring = Mesh::Actions::CColourElements::colouring(elements);
+    const Uint nb_colours = colouring.properties().template value<Uint>("nb_colours");
+
+    const Uint* elems = &colouring.array()[nb_colours+1];
+
+    if ( pool.numa_policy() == Common::ThreadPool::NUMA_FIRST_TOUCH )
+    {
+      ElementsShare<OperationT> share( pool, ops, elems, in_pass );
+      for ( Uint colour = 0; colour != nb_colours; ++colour )
+      {
+        share.colour_begin = colouring[colour];
+        share.colour_end   = colouring[colour+1];
+        pool.parallel_for_static( 0, elements.size(), share );
+      }
+      return;
+    }
+
+    ElementsChunk<OperationT> chunk( pool, ops, elems, in_pass );
+    for ( Uint colour = 0; colour != nb_colours; ++colour )
+      pool.parallel_for( colouring[colour], colouring[colour+1], chunk );
+  }
+
+  /// Configure the options of an operation with the values of another one,
+  /// as needed for the copies of an operation which are executed by the threads.
+  /// The options "elements" and "loop_index" are set by the loop itself and are not copied.
+  static void copy_options( const Common::Component& from, Common::Component& to );
+
+  /// Changes whenever one of the options copied by copy_options() changes,
+  /// so that the copies are only configured again when the original changed
+  static Uint options_version( const Common::Component& component );
+
+protected:
+
+  /// Functor executing the operation of the calling thread for a chunk of the elements of a colour
+  template < typename OperationT >
+  struct ElementsChunk
+  {
+    ElementsChunk( Common::ThreadPool& pool_in, std::vector<OperationT*>& ops_in, const Uint* elems_in, const std::vector<bool>& in_pass_in ) :
+      pool(pool_in), ops(ops_in), elems(elems_in), in_pass(in_pass_in) {}
+
+    void operator()( const Uint begin, const Uint end ) { execute( begin, end ); }
+
+    /// Execute the elements at positions [begin,end) of the colouring
+    void execute( const Uint begin, const Uint end )
+    {
+      OperationT& op = *ops[pool.thread_index()];
+      for ( Uint i = begin; i != end; ++i )
+      {
+        const Uint elem = elems[i];
+        if ( !in_pass.empty() && !in_pass[elem] )
+          continue;
+        op.select_loop_idx(elem);
+        op.execute();
+      }
+    }
+
+    Common::ThreadPool& pool;
+    std::vector<OperationT*>& ops;
+    const Uint* elems;
+    const std::vector<bool>& in_pass;
+  };
+
+  /// Functor executing the operation of the calling thread for the elements of a colour
+  /// whose index lies in a range of element rows
+  template < typename OperationT >
+  struct ElementsShare : ElementsChunk<OperationT>
+  {
+    ElementsShare( Common::ThreadPool& pool_in, std::vector<OperationT*>& ops_in, const Uint* elems_in, const std::vector<bool>& in_pass_in ) :
+      ElementsChunk<OperationT>(pool_in,ops_in,elems_in,in_pass_in), colour_begin(0), colour_end(0) {}
+
+    void operator()( const Uint rows_begin, const Uint rows_end )
+    {
+      const Uint* first = std::lower_bound( this->elems+colour_begin, this->elems+colour_end, rows_begin );
+      const Uint* last  = std::lower_bound( first, this->elems+colour_end, rows_end );
+      this->execute( first-this->elems, last-this->elems );
+    }
+
+    /// positions of the elements of the current colour in the colouring
+    Uint colour_begin;
+    Uint colour_end;
+  };
+
+protected:
+
+  /// True if the loop overlaps the synchronization of the overlap_fields with the interior elements
+  bool overlaps_synchronization() const { return !m_overlap_fields.empty(); }
+
+  /// Complete the split-phase synchronization of the overlap_fields
+  void synchronize_end();
+
+private:
+
+  void config_overlap_fields();
+
 protected:
 
   /// Regions to loop over
   std::vector<boost::shared_ptr<Mesh::CRegion> > m_loop_regions;
 
+  /// Fields whose synchronization is completed between the interior and the halo elements
+  std::vector< boost::weak_ptr<Mesh::Field> > m_overlap_fields;
+
 };
 
 /////////////////////////////////////////////////////////////////////////////////////
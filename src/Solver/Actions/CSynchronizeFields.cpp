@@ -6,6 +6,7 @@
 
 #include "Common/CBuilder.hpp"
 #include "Common/OptionArray.hpp"
+#include "Common/OptionT.hpp"
 #include "Common/Foreach.hpp"
 
 #include "Mesh/Field.hpp"
@@ -28,7 +29,8 @@ Common::ComponentBuilder < CSynchronizeFields, CAction, LibActions > CSynchroniz
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
-CSynchronizeFields::CSynchronizeFields ( const std::string& name ) : Solver::Action(name)
+CSynchronizeFields::CSynchronizeFields ( const std::string& name ) : Solver::Action(name),
+  m_split_phase(false)
 {
   mark_basic();
 
@@ -36,6 +38,12 @@ CSynchronizeFields::CSynchronizeFields ( const std::string& name ) : Solver::Act
   m_options.add_option< OptionArrayT < URI > > ("Fields", dummy)
       ->description("Fields to synchronize")
       ->attach_trigger ( boost::bind ( &CSynchronizeFields::config_fields,   this ) );
+
+  m_options.add_option< OptionT<bool> > ("split_phase", m_split_phase)
+      ->description("Only start the synchronization, ghost values are valid after synchronize_end() "
+                    "or after a loop that completes the synchronization of these fields")
+      ->pretty_name("Split Phase")
+      ->link_to(&m_split_phase);
 }
 
 
@@ -66,7 +74,22 @@ void CSynchronizeFields::execute()
   {
     if( ptr.expired() ) continue; // skip if pointer invalid
 
-    ptr.lock()->synchronize();
+    if( m_split_phase )
+      ptr.lock()->synchronize_begin();
+    else
+      ptr.lock()->synchronize();
+  }
+}
+
+
+
+void CSynchronizeFields::synchronize_end()
+{
+  boost_foreach(boost::weak_ptr<Field> ptr, m_fields)
+  {
+    if( ptr.expired() ) continue; // skip if pointer invalid
+
+    ptr.lock()->synchronize_end();
   }
 }
 
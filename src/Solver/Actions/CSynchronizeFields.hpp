@@ -42,6 +42,10 @@ public: // functions
   /// execute the action
   virtual void execute ();
 
+  /// complete the synchronizations started by execute() in split phase mode
+  /// does nothing for fields that are not being synchronized
+  void synchronize_end();
+
 private: // helper functions
 
   void config_fields();
@@ -50,6 +54,9 @@ private: // data
 
   std::vector< boost::weak_ptr<Mesh::Field> > m_fields;
 
+  /// only start the synchronization in execute()
+  bool m_split_phase;
+
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -92,6 +92,40 @@ struct BlockAssignmentOp<SystemMatrixTag, OpTagT>
     static const Uint mat_size = DataT::EMatrixSizeT::value;
     static const Uint nb_dofs = mat_size / DataT::SupportT::SF::nb_nodes;
     const Mesh::CTable<Uint>::ConstRow connectivity = data.support().element_connectivity();
+
+    // Without a stored matrix, the element matrix is passed on entry by entry
+    if(lss.is_matrix_free())
+    {
+      for(Uint row = 0; row != mat_size; ++row)
+      {
+        const Uint i_gid = connectivity[row % DataT::SupportT::SF::nb_nodes]*nb_dofs + row / DataT::SupportT::SF::nb_nodes;
+        for(Uint col = 0; col != mat_size; ++col)
+        {
+          Real value = 0.;
+          do_assign_op(OpTagT(), value, rhs(row, col));
+          lss.add_matrix_free(i_gid, connectivity[col % DataT::SupportT::SF::nb_nodes]*nb_dofs + col / DataT::SupportT::SF::nb_nodes, value);
+        }
+      }
+      return;
+    }
+
+    // With a fixed sparsity pattern, the position of each entry is known in advance
+    const Uint* offsets = lss.element_offsets(data.support().connectivity(), data.support().element_idx());
+    if(offsets)
+    {
+      for(Uint row = 0; row != mat_size; ++row)
+      {
+        const Uint i_node = row % DataT::SupportT::SF::nb_nodes;
+        const Uint i_gid = connectivity[i_node]*nb_dofs + row / DataT::SupportT::SF::nb_nodes;
+        const Uint* row_offsets = offsets + i_node*DataT::SupportT::SF::nb_nodes;
+        for(Uint col = 0; col != mat_size; ++col)
+        {
+          do_assign_op(OpTagT(), lss.at_offset(i_gid, row_offsets[col % DataT::SupportT::SF::nb_nodes] + col / DataT::SupportT::SF::nb_nodes), rhs(row, col));
+        }
+      }
+      return;
+    }
+
     for(Uint row = 0; row != mat_size; ++row)
     {
       const Uint i_gid = connectivity[row % DataT::SupportT::SF::nb_nodes]*nb_dofs + row / DataT::SupportT::SF::nb_nodes;
@@ -106,6 +106,18 @@ public:
     return m_connectivity[m_element_idx];
   }
 
+  /// Connectivity table of all elements
+  const Mesh::CTable<Uint>& connectivity() const
+  {
+    return m_connectivity;
+  }
+
+  /// Index of the current element
+  Uint element_idx() const
+  {
+    return m_element_idx;
+  }
+
   Real volume() const
   {
     return SF::volume(m_nodes);
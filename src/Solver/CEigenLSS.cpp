@@ -6,14 +6,20 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <iostream>
 #include <set>
 
+#include <boost/scoped_ptr.hpp>
+
 #include "coolfluid-packages.hpp"
 
 #ifdef CF_HAVE_TRILINOS
   #include <Epetra_SerialComm.h>
+  #include <Epetra_MpiComm.h>
   #include <Epetra_Map.h>
+  #include <Epetra_Export.h>
+  #include <Epetra_Operator.h>
   #include <Epetra_Vector.h>
   #include <Epetra_CrsMatrix.h>
 
@@ -21,6 +27,8 @@
   #include "Thyra_LinearOpWithSolveFactoryHelpers.hpp"
   #include "Thyra_EpetraThyraWrappers.hpp"
   #include "Thyra_EpetraLinearOp.hpp"
+  #include "Thyra_DefaultPreconditioner.hpp"
+  #include "Thyra_DefaultLinearOpSource.hpp"
 //  #include "Teuchos_GlobalMPISession.hpp"
   #include "Teuchos_VerboseObject.hpp"
   #include "Teuchos_XMLParameterListHelpers.hpp"
@@ -33,14 +41,23 @@
   #endif
 #endif
 
+#include "Common/BasicExceptions.hpp"
+#include "Common/CAction.hpp"
+#include "Common/FindComponents.hpp"
 #include "Common/Foreach.hpp"
 #include "Common/Log.hpp"
 #include "Common/CBuilder.hpp"
+#include "Common/OptionComponent.hpp"
+#include "Common/OptionT.hpp"
 #include "Common/OptionURI.hpp"
 #include "Common/MPI/PE.hpp"
+#include "Common/StringConversion.hpp"
 #include "Common/Timer.hpp"
 
+#include "Mesh/CElements.hpp"
+#include "Mesh/CRegion.hpp"
 #include "Mesh/Field.hpp"
+#include "Mesh/Geometry.hpp"
 
 #include "CEigenLSS.hpp"
 
@@ -53,7 +70,209 @@ using namespace CF::Mesh;
 
 CF::Common::ComponentBuilder < CEigenLSS, Common::Component, LibSolver > aCeigenLSS_Builder;
 
-CEigenLSS::CEigenLSS ( const std::string& name ) : Component ( name )
+#ifdef CF_HAVE_TRILINOS
+
+/// Epetra operator applying a matrix free CEigenLSS, or its block diagonal preconditioner
+class MatrixFreeOperator : public Epetra_Operator
+{
+public:
+  MatrixFreeOperator(CEigenLSS& lss, const Epetra_Map& map, const bool preconditioner) :
+    m_lss(lss),
+    m_map(map),
+    m_preconditioner(preconditioner),
+    m_x(lss.size()),
+    m_y(lss.size())
+  {
+  }
+
+  virtual int Apply(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const
+  {
+    const int nb_rows = m_map.NumMyElements();
+    for(int v = 0; v != X.NumVectors(); ++v)
+    {
+      std::copy(X[v], X[v] + nb_rows, m_x.data());
+      if(m_preconditioner)
+        m_lss.apply_preconditioner(m_x, m_y);
+      else
+        m_lss.apply(m_x, m_y);
+      std::copy(m_y.data(), m_y.data() + nb_rows, Y[v]);
+    }
+    return 0;
+  }
+
+  virtual int ApplyInverse(const Epetra_MultiVector&, Epetra_MultiVector&) const { return -1; }
+  virtual int SetUseTranspose(bool) { return -1; }
+  virtual bool UseTranspose() const { return false; }
+  virtual double NormInf() const { return 0.; }
+  virtual bool HasNormInf() const { return false; }
+  virtual const char* Label() const { return m_preconditioner ? "CEigenLSS block diagonal preconditioner" : "CEigenLSS matrix free operator"; }
+  virtual const Epetra_Comm& Comm() const { return m_map.Comm(); }
+  virtual const Epetra_Map& OperatorDomainMap() const { return m_map; }
+  virtual const Epetra_Map& OperatorRangeMap() const { return m_map; }
+
+private:
+  CEigenLSS& m_lss;
+  const Epetra_Map& m_map;
+  const bool m_preconditioner;
+  mutable RealVector m_x;
+  mutable RealVector m_y;
+};
+
+#endif
+
+struct CEigenLSS::Implementation
+{
+#ifdef CF_HAVE_TRILINOS
+  /// Build the Trilinos matrix with the given pattern, with all values zero
+  void build_matrix(const std::vector<Uint>& row_starts, const std::vector<Uint>& columns)
+  {
+    const int nb_rows = row_starts.size() - 1;
+    map.reset(new Epetra_Map(nb_rows, 0, comm));
+
+    std::vector<int> nnz(nb_rows);
+    for(int row = 0; row != nb_rows; ++row)
+      nnz[row] = row_starts[row+1] - row_starts[row];
+
+    matrix.reset(new Epetra_CrsMatrix(Copy, *map, &nnz[0], true));
+
+    std::vector<int> indices;
+    std::vector<Real> values;
+    for(int row = 0; row != nb_rows; ++row)
+    {
+      indices.assign(columns.begin() + row_starts[row], columns.begin() + row_starts[row+1]);
+      values.assign(nnz[row], 0.);
+      matrix->InsertGlobalValues(row, nnz[row], &values[0], &indices[0]);
+    }
+
+    matrix->FillComplete();
+  }
+
+  /// Build the matrices for a pattern distributed over the processes. All local rows, owned or not, form an
+  /// overlapping matrix, and the exporter sums them into the matrix of the owned rows that is solved for.
+  void build_distributed_matrix(const std::vector<Uint>& row_starts, const std::vector<Uint>& columns, const std::vector<Uint>& global_rows, const std::vector<bool>& owned_rows)
+  {
+    mpi_comm.reset(new Epetra_MpiComm(Comm::PE::instance().communicator()));
+
+    const int nb_rows = row_starts.size() - 1;
+    std::vector<int> gids(global_rows.begin(), global_rows.end());
+    std::vector<int> owned_gids;
+    for(int row = 0; row != nb_rows; ++row)
+    {
+      if(owned_rows[row])
+        owned_gids.push_back(gids[row]);
+    }
+
+    overlap_map.reset(new Epetra_Map(-1, nb_rows, &gids[0], 0, *mpi_comm));
+    map.reset(new Epetra_Map(-1, owned_gids.size(), owned_gids.empty() ? 0 : &owned_gids[0], 0, *mpi_comm));
+
+    std::vector<int> nnz(nb_rows);
+    for(int row = 0; row != nb_rows; ++row)
+      nnz[row] = row_starts[row+1] - row_starts[row];
+
+    overlap_matrix.reset(new Epetra_CrsMatrix(Copy, *overlap_map, &nnz[0], true));
+
+    std::vector<int> indices;
+    std::vector<Real> values;
+    for(int row = 0; row != nb_rows; ++row)
+    {
+      indices.clear();
+      for(Uint i = row_starts[row]; i != row_starts[row+1]; ++i)
+        indices.push_back(gids[columns[i]]);
+      values.assign(nnz[row], 0.);
+      overlap_matrix->InsertGlobalValues(gids[row], nnz[row], &values[0], &indices[0]);
+    }
+
+    overlap_matrix->FillComplete(*map, *map);
+
+    // The columns of the overlapping matrix are not in the local order, so keep the position of each of its entries in the local values
+    value_positions.resize(columns.size());
+    std::vector< std::pair<int, Uint> > row_columns;
+    Uint position = 0;
+    for(int row = 0; row != nb_rows; ++row)
+    {
+      row_columns.clear();
+      for(Uint i = row_starts[row]; i != row_starts[row+1]; ++i)
+        row_columns.push_back(std::make_pair(gids[columns[i]], i));
+      std::sort(row_columns.begin(), row_columns.end());
+
+      int nb_entries;
+      double* row_values;
+      int* row_indices;
+      overlap_matrix->ExtractMyRowView(row, nb_entries, row_values, row_indices);
+      for(int k = 0; k != nb_entries; ++k)
+      {
+        const int gid = overlap_matrix->ColMap().GID(row_indices[k]);
+        value_positions[position++] = std::lower_bound(row_columns.begin(), row_columns.end(), std::make_pair(gid, Uint(0)))->second;
+      }
+    }
+    cf_assert(position == columns.size());
+
+    exporter.reset(new Epetra_Export(*overlap_map, *map));
+
+    matrix.reset(new Epetra_CrsMatrix(Copy, *map, 0));
+    matrix->Export(*overlap_matrix, *exporter, Add);
+    matrix->FillComplete();
+  }
+
+  /// Copy the local values in the overlapping matrix and sum them into the owned rows
+  void fill_distributed_matrix(const std::vector<Real>& local_values)
+  {
+    Uint position = 0;
+    for(int row = 0; row != overlap_map->NumMyElements(); ++row)
+    {
+      int nb_entries;
+      double* row_values;
+      overlap_matrix->ExtractMyRowView(row, nb_entries, row_values);
+      for(int k = 0; k != nb_entries; ++k)
+        row_values[k] = local_values[value_positions[position++]];
+    }
+
+    matrix->PutScalar(0.);
+    matrix->Export(*overlap_matrix, *exporter, Add);
+  }
+
+  Epetra_SerialComm comm;
+  boost::scoped_ptr<Epetra_Map> map;
+  /// Matrix with the fixed pattern, built at the first solve and refilled in place afterwards
+  boost::scoped_ptr<Epetra_CrsMatrix> matrix;
+
+  /// @name Distributed system
+  //@{
+  boost::scoped_ptr<Epetra_MpiComm> mpi_comm;
+  /// Map of all local rows, owned or not
+  boost::scoped_ptr<Epetra_Map> overlap_map;
+  /// Local contributions to the matrix
+  boost::scoped_ptr<Epetra_CrsMatrix> overlap_matrix;
+  /// Position in the local values of each entry of overlap_matrix
+  std::vector<Uint> value_positions;
+  /// Sums the local contributions into the owned rows, and copies the solution back to all local rows
+  boost::scoped_ptr<Epetra_Export> exporter;
+  //@}
+#endif
+
+  /// Forget the solver matrix, when the pattern changes
+  void reset()
+  {
+#ifdef CF_HAVE_TRILINOS
+    matrix.reset();
+    exporter.reset();
+    overlap_matrix.reset();
+    value_positions.clear();
+    map.reset();
+    overlap_map.reset();
+    mpi_comm.reset();
+#endif
+  }
+};
+
+CEigenLSS::CEigenLSS ( const std::string& name ) : Component ( name ),
+  m_matrix_free(false),
+  m_tolerance(1e-10),
+  m_max_iterations(1000),
+  m_block_size(1),
+  m_apply_input(0),
+  m_apply_output(0),
+  m_implementation(new Implementation())
 {
   m_options.add_option< OptionURI >("config_file", URI())
       ->description("Solver config file")
@@ -61,10 +280,33 @@ CEigenLSS::CEigenLSS ( const std::string& name ) : Component ( name )
       ->mark_basic()
       ->cast_to<OptionURI>()->supported_protocol(URI::Scheme::FILE);
 
+  m_options.add_option< OptionT<bool> >("matrix_free", m_matrix_free)
+      ->description("Don't store the matrix, but apply it by executing the assembly action. Takes effect when the system is resized.")
+      ->pretty_name("Matrix Free")
+      ->link_to(&m_matrix_free);
+
+  m_options.add_option( OptionComponent<CAction>::create("assembly", &m_assembly) )
+      ->description("Action that assembles the system, executed to apply the matrix in matrix free mode")
+      ->pretty_name("Assembly");
+
+  m_options.add_option< OptionT<Real> >("tolerance", m_tolerance)
+      ->description("Relative residual at which the matrix free iterations stop, when solving without Trilinos")
+      ->pretty_name("Tolerance")
+      ->link_to(&m_tolerance);
+
+  m_options.add_option< OptionT<Uint> >("max_iterations", m_max_iterations)
+      ->description("Maximum number of matrix free iterations, when solving without Trilinos")
+      ->pretty_name("Maximum Iterations")
+      ->link_to(&m_max_iterations);
+
   if(!Comm::PE::instance().is_active())
     Comm::PE::instance().init();
 }
 
+CEigenLSS::~CEigenLSS()
+{
+}
+
 void CEigenLSS::set_config_file(const URI& path)
 {
   configure_option("config_file", path);
@@ -73,36 +315,252 @@ void CEigenLSS::set_config_file(const URI& path)
 
 void CEigenLSS::resize ( Uint nb_dofs )
 {
-  if(nb_dofs == (Uint) m_system_matrix.rows())
+  const bool sized = is_matrix_free() ? m_block_size == 1 && m_block_diagonal.size() == nb_dofs
+                                      : has_pattern() || static_cast<Uint>(m_system_matrix.rows()) == nb_dofs;
+  if(sized && nb_dofs == size())
     return;
 
-  m_system_matrix.resize(nb_dofs, nb_dofs);
+  m_block_diagonal.clear();
+  m_row_starts.clear();
+  m_columns.clear();
+  m_values.clear();
+  m_element_offsets.clear();
+  m_global_rows.clear();
+  m_owned_rows.clear();
+  m_dirichlet_bcs.clear();
+  m_pattern_mesh.reset();
+  m_implementation->reset();
+
+  if(is_matrix_free())
+  {
+    m_block_size = 1;
+    m_block_diagonal.assign(nb_dofs, 0.);
+    m_system_matrix.resize(0, 0);
+  }
+  else
+  {
+    m_system_matrix.resize(nb_dofs, nb_dofs);
+  }
   m_rhs.resize(nb_dofs);
   m_solution.resize(nb_dofs);
 
   set_zero();
 }
 
+void CEigenLSS::resize ( const CMesh& mesh, const Uint nb_dofs )
+{
+  const Uint nb_nodes = mesh.geometry().size();
+  const bool sized = is_matrix_free() ? m_block_size == nb_dofs && m_block_diagonal.size() == nb_nodes*nb_dofs*nb_dofs
+                                      : has_pattern();
+  if(sized && m_pattern_mesh.lock().get() == &mesh && size() == nb_nodes*nb_dofs)
+    return;
+
+  if(is_matrix_free())
+  {
+    if(Comm::PE::instance().is_active() && Comm::PE::instance().size() > 1)
+      throw NotSupported(FromHere(), "Matrix free system " + uri().string() + " can't be distributed over several processes");
+
+    resize(nb_nodes*nb_dofs);
+    m_block_size = nb_dofs;
+    m_block_diagonal.assign(nb_nodes*nb_dofs*nb_dofs, 0.);
+    m_pattern_mesh = mesh.as_ptr<CMesh>();
+    return;
+  }
+
+  Timer timer;
+
+  // Nodes connected to each node through the elements, including itself
+  std::vector< std::vector<Uint> > node_neighbors(nb_nodes);
+  boost_foreach(const CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+  {
+    const CTable<Uint>& connectivity = elements.node_connectivity();
+    const Uint nb_elems = connectivity.size();
+    const Uint nb_elem_nodes = connectivity.row_size();
+    for(Uint elem = 0; elem != nb_elems; ++elem)
+    {
+      const CTable<Uint>::ConstRow elem_nodes = connectivity[elem];
+      for(Uint i = 0; i != nb_elem_nodes; ++i)
+        node_neighbors[elem_nodes[i]].insert(node_neighbors[elem_nodes[i]].end(), elem_nodes.begin(), elem_nodes.end());
+    }
+  }
+  for(Uint node = 0; node != nb_nodes; ++node)
+  {
+    std::vector<Uint>& neighbors = node_neighbors[node];
+    neighbors.push_back(node);
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+  }
+
+  // Every node pair is a dense block of nb_dofs x nb_dofs entries
+  const Uint nb_rows = nb_nodes*nb_dofs;
+  m_row_starts.resize(nb_rows+1);
+  m_row_starts[0] = 0;
+  for(Uint node = 0; node != nb_nodes; ++node)
+  {
+    for(Uint i = 0; i != nb_dofs; ++i)
+      m_row_starts[node*nb_dofs+i+1] = m_row_starts[node*nb_dofs+i] + node_neighbors[node].size()*nb_dofs;
+  }
+
+  m_columns.resize(m_row_starts.back());
+  for(Uint node = 0; node != nb_nodes; ++node)
+  {
+    for(Uint i = 0; i != nb_dofs; ++i)
+    {
+      std::vector<Uint>::iterator column = m_columns.begin() + m_row_starts[node*nb_dofs+i];
+      boost_foreach(const Uint neighbor, node_neighbors[node])
+      {
+        for(Uint j = 0; j != nb_dofs; ++j)
+          *column++ = neighbor*nb_dofs+j;
+      }
+    }
+  }
+
+  // Position of the column block of each element node pair, relative to the start of the row
+  m_element_offsets.clear();
+  boost_foreach(const CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+  {
+    const CTable<Uint>& connectivity = elements.node_connectivity();
+    const Uint nb_elems = connectivity.size();
+    const Uint nb_elem_nodes = connectivity.row_size();
+    std::vector<Uint>& offsets = m_element_offsets[&connectivity];
+    offsets.resize(nb_elems*nb_elem_nodes*nb_elem_nodes);
+    std::vector<Uint>::iterator offset = offsets.begin();
+    for(Uint elem = 0; elem != nb_elems; ++elem)
+    {
+      const CTable<Uint>::ConstRow elem_nodes = connectivity[elem];
+      for(Uint i = 0; i != nb_elem_nodes; ++i)
+      {
+        const std::vector<Uint>& neighbors = node_neighbors[elem_nodes[i]];
+        for(Uint j = 0; j != nb_elem_nodes; ++j)
+          *offset++ = (std::lower_bound(neighbors.begin(), neighbors.end(), elem_nodes[j]) - neighbors.begin()) * nb_dofs;
+      }
+    }
+  }
+
+  // On more than one process, rows are numbered globally through the global node index,
+  // and only the rows of the owned nodes are solved for
+  m_global_rows.clear();
+  m_owned_rows.clear();
+  if(Comm::PE::instance().is_active() && Comm::PE::instance().size() > 1)
+  {
+    const Geometry& geometry = mesh.geometry();
+    if(geometry.glb_idx().size() != nb_nodes || geometry.rank().size() != nb_nodes)
+      throw SetupError(FromHere(), "Mesh " + mesh.uri().string() + " has no global node numbering, needed to distribute " + uri().string());
+
+    m_global_rows.resize(nb_rows);
+    m_owned_rows.resize(nb_rows);
+    for(Uint node = 0; node != nb_nodes; ++node)
+    {
+      for(Uint i = 0; i != nb_dofs; ++i)
+      {
+        m_global_rows[node*nb_dofs+i] = geometry.glb_idx()[node]*nb_dofs+i;
+        m_owned_rows[node*nb_dofs+i] = !geometry.is_ghost(node);
+      }
+    }
+  }
+
+  m_values.assign(m_columns.size(), 0.);
+  m_block_diagonal.clear();
+  m_pattern_mesh = mesh.as_ptr<CMesh>();
+  m_implementation->reset();
+
+  // The dynamic matrix is not used anymore
+  m_system_matrix.resize(0, 0);
+  m_rhs.resize(nb_rows);
+  m_solution.resize(nb_rows);
+
+  set_zero();
+
+  CFdebug << "Built sparsity pattern for " << nb_rows << " unknowns with " << m_values.size() << " non-zeros in " << timer.elapsed() << "s" << CFendl;
+}
+
+bool CEigenLSS::has_pattern() const
+{
+  return !m_row_starts.empty();
+}
+
+bool CEigenLSS::is_distributed() const
+{
+  return !m_global_rows.empty();
+}
+
+bool CEigenLSS::is_matrix_free() const
+{
+  return m_matrix_free;
+}
+
 Uint CEigenLSS::size() const
 {
-  return m_system_matrix.cols();
+  return m_rhs.size();
 }
 
 Real& CEigenLSS::at(const CF::Uint row, const CF::Uint col)
 {
-  return m_system_matrix.coeffRef(row, col);
+  if(is_matrix_free())
+    throw NotSupported(FromHere(), "Matrix free system " + uri().string() + " has no stored entries");
+
+  if(!has_pattern())
+    return m_system_matrix.coeffRef(row, col);
+
+  const std::vector<Uint>::const_iterator row_begin = m_columns.begin() + m_row_starts[row];
+  const std::vector<Uint>::const_iterator row_end = m_columns.begin() + m_row_starts[row+1];
+  const std::vector<Uint>::const_iterator column = std::lower_bound(row_begin, row_end, col);
+  if(column == row_end || *column != col)
+    throw ValueNotFound(FromHere(), "Entry (" + to_str(row) + ", " + to_str(col) + ") is not in the sparsity pattern of " + uri().string());
+
+  return m_values[column - m_columns.begin()];
+}
+
+const Uint* CEigenLSS::element_offsets(const CTable<Uint>& connectivity, const Uint element_idx) const
+{
+  const std::map<const CTable<Uint>*, std::vector<Uint> >::const_iterator offsets = m_element_offsets.find(&connectivity);
+  if(offsets == m_element_offsets.end())
+    return 0;
+
+  const Uint nb_elem_nodes = connectivity.row_size();
+  return &offsets->second[element_idx*nb_elem_nodes*nb_elem_nodes];
 }
 
 
 void CEigenLSS::set_zero()
 {
-  m_system_matrix.setZero();
+  if(is_matrix_free())
+    std::fill(m_block_diagonal.begin(), m_block_diagonal.end(), 0.);
+  else if(has_pattern())
+    std::fill(m_values.begin(), m_values.end(), 0.);
+  else
+    m_system_matrix.setZero();
+  m_dirichlet_bcs.clear();
   m_rhs.setZero();
   m_solution.setZero();
 }
 
 void CEigenLSS::set_dirichlet_bc(const CF::Uint row, const CF::Real value, const CF::Real coeff)
 {
+  // Rows shared with other processes are only complete after summing the contributions, so the condition is applied then
+  if(is_distributed())
+  {
+    m_dirichlet_bcs[row] = std::make_pair(coeff * value, coeff);
+    return;
+  }
+
+  // Without a matrix, the row is replaced each time the matrix is applied
+  if(is_matrix_free())
+  {
+    m_dirichlet_bcs[row] = std::make_pair(coeff * value, coeff);
+    m_rhs[row] = coeff * value;
+    return;
+  }
+
+  if(has_pattern())
+  {
+    const Uint row_end = m_row_starts[row+1];
+    for(Uint i = m_row_starts[row]; i != row_end; ++i)
+      m_values[i] = m_columns[i] == row ? coeff : 0.;
+    m_rhs[row] = coeff * value;
+    return;
+  }
+
   for(MatrixT::InnerIterator it(m_system_matrix, static_cast<int>(row)); it; ++it)
   {
     if(static_cast<Uint>(it.col()) != row)
@@ -146,7 +604,7 @@ void CEigenLSS::set_dirichlet_bc(const CF::Uint row, const CF::Real value, const
 
 RealVector& CEigenLSS::rhs()
 {
-  return m_rhs;
+  return m_apply_input ? m_discarded_rhs : m_rhs;
 }
 
 const RealVector& CEigenLSS::solution()
@@ -157,45 +615,122 @@ const RealVector& CEigenLSS::solution()
 
 void CEigenLSS::solve()
 {
+  if(is_matrix_free())
+  {
+    solve_matrix_free();
+    return;
+  }
+
 #ifdef CF_HAVE_TRILINOS
   Timer timer;
-  const Uint nb_rows = size();
-  cf_assert(nb_rows == m_system_matrix.outerSize());
-
-  Epetra_SerialComm comm;
-  Epetra_Map map(nb_rows, 0, comm);
-
-  Epetra_Vector ep_rhs(View, map, m_rhs.data());
-  Epetra_Vector ep_sol(View, map, m_solution.data());
+  const int nb_rows = size();
 
-  // Count non-zeros
-  std::vector<int> nnz(nb_rows, 0);
-  for(int row=0; row < nb_rows; ++row)
+  Teuchos::RCP<Epetra_CrsMatrix> epetra_A;
+  Teuchos::RCP<Epetra_Vector>    epetra_x;
+  Teuchos::RCP<Epetra_Vector>    epetra_b;
+  if(is_distributed())
   {
-    for(MatrixT::InnerIterator it(m_system_matrix, row); it; ++it)
+    Implementation& impl = *m_implementation;
+    if(!impl.matrix)
+      impl.build_distributed_matrix(m_row_starts, m_columns, m_global_rows, m_owned_rows);
+    epetra_A = Teuchos::rcpFromRef(*impl.matrix);
+
+    time_matrix_construction = timer.elapsed(); timer.restart();
+
+    // Sum the contributions of all processes to the owned rows, in a single exchange for the matrix and the RHS
+    impl.fill_distributed_matrix(m_values);
+    Epetra_Vector local_rhs(View, *impl.overlap_map, m_rhs.data());
+    epetra_b = Teuchos::rcp(new Epetra_Vector(*impl.map));
+    epetra_b->Export(local_rhs, *impl.exporter, Add);
+    epetra_x = Teuchos::rcp(new Epetra_Vector(*impl.map));
+
+    // Dirichlet conditions on the complete rows. A condition may be set by several processes sharing the node,
+    // so the number of conditions, coefficient times value and coefficient are summed and averaged.
+    Epetra_MultiVector local_bcs(*impl.overlap_map, 3);
+    for(std::map<Uint, std::pair<Real, Real> >::const_iterator bc = m_dirichlet_bcs.begin(); bc != m_dirichlet_bcs.end(); ++bc)
     {
-      ++nnz[row];
+      local_bcs[0][bc->first] = 1.;
+      local_bcs[1][bc->first] = bc->second.first;
+      local_bcs[2][bc->first] = bc->second.second;
+    }
+    Epetra_MultiVector bcs(*impl.map, 3);
+    bcs.Export(local_bcs, *impl.exporter, Add);
+    for(int row = 0; row != impl.map->NumMyElements(); ++row)
+    {
+      const Real nb_bcs = bcs[0][row];
+      if(nb_bcs == 0.)
+        continue;
+
+      const int gid = impl.map->GID(row);
+      int nb_entries;
+      double* values;
+      int* indices;
+      epetra_A->ExtractMyRowView(row, nb_entries, values, indices);
+      for(int k = 0; k != nb_entries; ++k)
+        values[k] = epetra_A->ColMap().GID(indices[k]) == gid ? bcs[2][row] / nb_bcs : 0.;
+      (*epetra_b)[row] = bcs[1][row] / nb_bcs;
     }
-    cf_assert(nnz[row]);
   }
+  else if(has_pattern())
+  {
+    // The matrix is built only once for a given pattern
+    if(!m_implementation->matrix)
+      m_implementation->build_matrix(m_row_starts, m_columns);
+    epetra_A = Teuchos::rcpFromRef(*m_implementation->matrix);
 
-  Epetra_CrsMatrix ep_A(Copy, map, &nnz[0]);
-  time_matrix_construction = timer.elapsed(); timer.restart();
+    time_matrix_construction = timer.elapsed(); timer.restart();
 
-  // Fill the matrix
-  for(int row=0; row < nb_rows; ++row)
+    // Refill the values in place. Columns in each row are sorted in both matrices.
+    for(int row = 0; row != nb_rows; ++row)
+    {
+      int nb_entries;
+      double* values;
+      epetra_A->ExtractMyRowView(row, nb_entries, values);
+      cf_assert(static_cast<Uint>(nb_entries) == m_row_starts[row+1] - m_row_starts[row]);
+      std::copy(m_values.begin() + m_row_starts[row], m_values.begin() + m_row_starts[row+1], values);
+    }
+  }
+  else
   {
-    std::vector<int> indices; indices.reserve(nnz[row]);
-    std::vector<Real> values; values.reserve(nnz[row]);
-    for(MatrixT::InnerIterator it(m_system_matrix, row); it; ++it)
+    cf_assert(nb_rows == m_system_matrix.outerSize());
+
+    Epetra_Map map(nb_rows, 0, m_implementation->comm);
+
+    // Count non-zeros
+    std::vector<int> nnz(nb_rows, 0);
+    for(int row=0; row < nb_rows; ++row)
+    {
+      for(MatrixT::InnerIterator it(m_system_matrix, row); it; ++it)
+      {
+        ++nnz[row];
+      }
+      cf_assert(nnz[row]);
+    }
+
+    epetra_A = Teuchos::rcp(new Epetra_CrsMatrix(Copy, map, &nnz[0]));
+    time_matrix_construction = timer.elapsed(); timer.restart();
+
+    // Fill the matrix
+    for(int row=0; row < nb_rows; ++row)
     {
-      indices.push_back(it.col());
-      values.push_back(it.value());
+      std::vector<int> indices; indices.reserve(nnz[row]);
+      std::vector<Real> values; values.reserve(nnz[row]);
+      for(MatrixT::InnerIterator it(m_system_matrix, row); it; ++it)
+      {
+        indices.push_back(it.col());
+        values.push_back(it.value());
+      }
+      epetra_A->InsertGlobalValues(row, nnz[row], &values[0], &indices[0]);
     }
-    ep_A.InsertGlobalValues(row, nnz[row], &values[0], &indices[0]);
+
+    epetra_A->FillComplete();
   }
 
-  ep_A.FillComplete();
+  if(!is_distributed())
+  {
+    epetra_b = Teuchos::rcp(new Epetra_Vector(View, epetra_A->RowMap(), m_rhs.data()));
+    epetra_x = Teuchos::rcp(new Epetra_Vector(View, epetra_A->RowMap(), m_solution.data()));
+  }
 
   time_matrix_fill = timer.elapsed(); timer.restart();
 
@@ -203,10 +738,6 @@ void CEigenLSS::solve()
 //BEGIN////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
-  Teuchos::RCP<Epetra_CrsMatrix> epetra_A=Teuchos::rcpFromRef(ep_A);
-  Teuchos::RCP<Epetra_Vector>    epetra_x=Teuchos::rcpFromRef(ep_sol);
-  Teuchos::RCP<Epetra_Vector>    epetra_b=Teuchos::rcpFromRef(ep_rhs);
-
   const URI config_uri = option("config_file").value<URI>();
   const std::string config_path = config_uri.path();
 
@@ -283,15 +814,25 @@ void CEigenLSS::solve()
 //END//////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
+  // Copy the solution of the owned rows to all local rows
+  if(is_distributed())
+  {
+    Epetra_Vector local_solution(View, *m_implementation->overlap_map, m_solution.data());
+    local_solution.Import(*epetra_x, *m_implementation->exporter, Insert);
+  }
+
 #else // no trilinos
 
+  if(is_distributed())
+    throw Common::NotSupported(FromHere(), "Solving a system distributed over several processes requires Trilinos");
+
 #ifdef CF_HAVE_SUPERLU
-  Eigen::SparseMatrix<Real> A(m_system_matrix);
+  Eigen::SparseMatrix<Real> A(system_matrix());
   Eigen::SparseLU<Eigen::SparseMatrix<Real>,Eigen::SuperLU> lu_of_A(A);
   if(!lu_of_A.solve(rhs(), &m_solution))
     throw Common::FailedToConverge(FromHere(), "Solution failed.");
 #else // no trilinos and no superlu
-  RealMatrix A(m_system_matrix);
+  RealMatrix A(system_matrix());
   Eigen::FullPivLU<RealMatrix> lu_of_A(A);
   m_solution = lu_of_A.solve(m_rhs);
 #endif // end ifdef superlu
@@ -300,9 +841,187 @@ void CEigenLSS::solve()
 
 }
 
+void CEigenLSS::apply(const RealVector& x, RealVector& y)
+{
+  if(m_assembly.expired())
+    throw SetupError(FromHere(), "No assembly action set for matrix free system " + uri().string());
+
+  y.resize(size());
+  y.setZero();
+  m_discarded_rhs.resize(size());
+
+  m_apply_input = &x;
+  m_apply_output = &y;
+  try
+  {
+    m_assembly.lock()->execute();
+  }
+  catch(...)
+  {
+    m_apply_input = 0;
+    m_apply_output = 0;
+    throw;
+  }
+  m_apply_input = 0;
+  m_apply_output = 0;
+
+  for(std::map<Uint, std::pair<Real, Real> >::const_iterator bc = m_dirichlet_bcs.begin(); bc != m_dirichlet_bcs.end(); ++bc)
+    y[bc->first] = bc->second.second * x[bc->first];
+}
+
+void CEigenLSS::apply_preconditioner(const RealVector& x, RealVector& y) const
+{
+  const Uint nb_rows = size();
+  y.resize(nb_rows);
+  for(Uint block_start = 0; block_start != nb_rows; block_start += m_block_size)
+  {
+    const Real* block = &m_block_inverse[block_start*m_block_size];
+    for(Uint i = 0; i != m_block_size; ++i)
+    {
+      Real result = 0.;
+      for(Uint j = 0; j != m_block_size; ++j)
+        result += block[i*m_block_size + j] * x[block_start + j];
+      y[block_start + i] = result;
+    }
+  }
+}
+
+void CEigenLSS::invert_block_diagonal()
+{
+  m_block_inverse = m_block_diagonal;
+
+  // Dirichlet rows only have their coefficient on the diagonal
+  for(std::map<Uint, std::pair<Real, Real> >::const_iterator bc = m_dirichlet_bcs.begin(); bc != m_dirichlet_bcs.end(); ++bc)
+  {
+    Real* row = &m_block_inverse[bc->first*m_block_size];
+    std::fill(row, row + m_block_size, 0.);
+    row[bc->first % m_block_size] = bc->second.second;
+  }
+
+  RealMatrix block(m_block_size, m_block_size);
+  for(Uint block_start = 0; block_start != m_block_inverse.size(); block_start += m_block_size*m_block_size)
+  {
+    for(Uint i = 0; i != m_block_size; ++i)
+      for(Uint j = 0; j != m_block_size; ++j)
+        block(i, j) = m_block_inverse[block_start + i*m_block_size + j];
+
+    // Nodes without contributions are left alone
+    Eigen::FullPivLU<RealMatrix> lu(block);
+    const RealMatrix inverse = lu.isInvertible() ? RealMatrix(lu.inverse()) : RealMatrix(RealMatrix::Identity(m_block_size, m_block_size));
+
+    for(Uint i = 0; i != m_block_size; ++i)
+      for(Uint j = 0; j != m_block_size; ++j)
+        m_block_inverse[block_start + i*m_block_size + j] = inverse(i, j);
+  }
+}
+
+void CEigenLSS::solve_matrix_free()
+{
+  Timer timer;
+
+  invert_block_diagonal();
+
+  time_matrix_construction = 0.;
+  time_matrix_fill = timer.elapsed(); timer.restart();
+
+  m_solution.setZero();
+
+#ifdef CF_HAVE_TRILINOS
+  Epetra_Map map(static_cast<int>(size()), 0, m_implementation->comm);
+  Teuchos::RCP<Epetra_Operator> epetra_A = Teuchos::rcp(new MatrixFreeOperator(*this, map, false));
+  Teuchos::RCP<Epetra_Operator> epetra_P = Teuchos::rcp(new MatrixFreeOperator(*this, map, true));
+  Teuchos::RCP<Epetra_Vector>   epetra_x = Teuchos::rcp(new Epetra_Vector(View, map, m_solution.data()));
+  Teuchos::RCP<Epetra_Vector>   epetra_b = Teuchos::rcp(new Epetra_Vector(View, map, m_rhs.data()));
+
+  const URI config_uri = option("config_file").value<URI>();
+  Stratimikos::DefaultLinearSolverBuilder linearSolverBuilder(config_uri.path());
+  linearSolverBuilder.readParameters(0);
+  Teuchos::RCP<Thyra::LinearOpWithSolveFactoryBase<double> > lowsFactory = linearSolverBuilder.createLinearSolveStrategy("");
+  lowsFactory->setVerbLevel(Teuchos::VERB_NONE);
+
+  Teuchos::RCP<const Thyra::LinearOpBase<double> > A = Thyra::epetraLinearOp( epetra_A );
+  Teuchos::RCP<const Thyra::LinearOpBase<double> > P = Thyra::epetraLinearOp( epetra_P );
+  Teuchos::RCP<Thyra::VectorBase<double> >         x = Thyra::create_Vector( epetra_x, A->domain() );
+  Teuchos::RCP<const Thyra::VectorBase<double> >   b = Thyra::create_Vector( epetra_b, A->range() );
+
+  // The iterative solver from the config file, preconditioned by the inverse of the block diagonal
+  Teuchos::RCP<Thyra::LinearOpWithSolveBase<double> > lows = lowsFactory->createOp();
+  lowsFactory->initializePreconditionedOp(Thyra::defaultLinearOpSource(A), Thyra::unspecifiedPrec(P), &*lows, Thyra::SUPPORT_SOLVE_UNSPECIFIED);
+
+  time_solver_setup = timer.elapsed(); timer.restart();
+
+  Thyra::solve(*lows, Thyra::NOTRANS, *b, &*x);
+
+  time_solve = timer.elapsed();
+  time_residual = 0.;
+
+#else // no trilinos
+
+  // Right preconditioned BiCGStab
+  const Real tolerance = m_tolerance * m_rhs.norm();
+  RealVector r = m_rhs;
+  const RealVector r0 = r;
+  RealVector p = RealVector::Zero(size());
+  RealVector v = RealVector::Zero(size());
+  RealVector y, z, s, t;
+  Real rho = 1., alpha = 1., omega = 1.;
+
+  time_solver_setup = timer.elapsed(); timer.restart();
+
+  bool converged = r.norm() <= tolerance;
+  for(Uint iteration = 0; !converged && iteration != m_max_iterations; ++iteration)
+  {
+    const Real rho_new = r0.dot(r);
+    const Real beta = (rho_new / rho) * (alpha / omega);
+    rho = rho_new;
+    p = r + beta * (p - omega * v);
+    apply_preconditioner(p, y);
+    apply(y, v);
+    alpha = rho / r0.dot(v);
+    s = r - alpha * v;
+    if(s.norm() <= tolerance)
+    {
+      m_solution += alpha * y;
+      converged = true;
+      break;
+    }
+    apply_preconditioner(s, z);
+    apply(z, t);
+    omega = t.dot(s) / t.dot(t);
+    m_solution += alpha * y + omega * z;
+    r = s - omega * t;
+    converged = r.norm() <= tolerance;
+  }
+
+  time_solve = timer.elapsed();
+  time_residual = 0.;
+
+  if(!converged)
+    throw FailedToConverge(FromHere(), "Matrix free solution of " + uri().string() + " did not converge in " + to_str(m_max_iterations) + " iterations");
+
+#endif // end ifdef trilinos
+}
+
 void CEigenLSS::print_matrix()
 {
-  std::cout << m_system_matrix << std::endl;
+  std::cout << system_matrix() << std::endl;
+}
+
+const CEigenLSS::MatrixT& CEigenLSS::system_matrix()
+{
+  if(has_pattern())
+  {
+    const Uint nb_rows = size();
+    m_system_matrix.resize(nb_rows, nb_rows);
+    m_system_matrix.reserve(m_values.size());
+    for(Uint row = 0; row != nb_rows; ++row)
+    {
+      for(Uint i = m_row_starts[row]; i != m_row_starts[row+1]; ++i)
+        m_system_matrix.coeffRef(row, m_columns[i]) = m_values[i];
+    }
+  }
+
+  return m_system_matrix;
 }
 
 
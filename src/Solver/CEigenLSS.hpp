@@ -9,25 +9,45 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <map>
+
 #define EIGEN_YES_I_KNOW_SPARSE_MODULE_IS_NOT_STABLE_YET
 #include <Eigen/Sparse>
 
+#include <boost/scoped_ptr.hpp>
+
 #include "Common/Component.hpp"
 
 #include "Math/MatrixTypes.hpp"
 
 #include "Mesh/CMesh.hpp"
+#include "Mesh/CTable.hpp"
 
 #include "LibSolver.hpp"
 
 namespace CF {
-  namespace Common { class URI; }
+  namespace Common { class URI; class CAction; }
 namespace Solver {
 
 ////////////////////////////////////////////////////////////////////////////////
 
 /// CEigenLSS component class
 /// This class stores a linear system for use by proto expressions
+///
+/// By default, the matrix is a dynamic sparse matrix in which every new entry is inserted as it is assigned.
+/// When the system is sized using a mesh, the sparsity pattern is computed once from the element connectivity
+/// and stored in compressed row format, together with the position of every element node pair in the rows.
+/// Assembly then only adds values at known positions, and the pattern and the solver matrix are reused
+/// for as long as the mesh and number of unknowns don't change.
+///
+/// On more than one process, a system sized using a mesh is distributed: each process assembles the rows of all
+/// its nodes, in local numbering, and the solver sums the contributions to the rows of the owned nodes,
+/// numbered by the global node index. After solving, the solution is available for all local nodes, including ghosts.
+///
+/// With the option "matrix_free", no matrix is stored. The action given by the option "assembly" is executed
+/// each time the product of the matrix with a vector is needed, and the element matrices are applied to that vector
+/// as they are computed. Only the diagonal blocks of the nodes are stored, as a block Jacobi preconditioner.
+/// The assembly action must therefore only assemble the system, and depend on nothing that changes while solving.
 /// @author Bart Janssens
 class Solver_API CEigenLSS : public Common::Component {
 
@@ -42,27 +62,70 @@ public: // functions
   /// @param name of the component
   CEigenLSS ( const std::string& name );
 
+  virtual ~CEigenLSS();
+
   /// Get the class name
   static std::string type_name () { return "CEigenLSS"; }    
   
   void set_config_file(const Common::URI& path);
   
-  /// Set the number of equations
+  /// Set the number of equations, using a dynamic sparse matrix. Nothing happens if the size is unchanged.
   void resize ( Uint nb_dofs );
+
+  /// Size the system for nb_dofs unknowns per node of the given mesh, and use the sparsity pattern of its elements.
+  /// Unknowns are numbered per node, i.e. node_idx*nb_dofs + dof. Nothing happens if the pattern is already built for the same mesh.
+  void resize ( const Mesh::CMesh& mesh, const Uint nb_dofs );
+
+  /// True if the matrix uses a fixed sparsity pattern, built from a mesh
+  bool has_pattern() const;
+
+  /// True if the system is distributed over several processes
+  bool is_distributed() const;
+
+  /// True if the matrix is not stored, but applied by executing the assembly action
+  bool is_matrix_free() const;
   
   /// Number of equations
   Uint size() const;
   
-  /// Access to the elements
+  /// Access to the elements. With a fixed pattern, the entry must be part of it
   Real& at(const Uint row, const Uint col);
+
+  /// Offsets of the element node pairs in the rows of the pattern, nb_nodes*nb_nodes per element, in row major order,
+  /// or null if there is no pattern for the given connectivity table.
+  /// Entry (i_node*nb_dofs+i_dof, j_node*nb_dofs+j_dof) is at at_offset(row, offsets[i*nb_nodes+j] + j_dof)
+  const Uint* element_offsets(const Mesh::CTable<Uint>& connectivity, const Uint element_idx) const;
+
+  /// Access to the entry at the given offset in a row of the pattern
+  Real& at_offset(const Uint row, const Uint offset)
+  {
+    return m_values[m_row_starts[row] + offset];
+  }
+
+  /// Contribution of an element matrix to entry (row, col), in matrix free mode.
+  /// While applying the matrix, it is multiplied with the input vector, otherwise only the diagonal node blocks are kept.
+  void add_matrix_free(const Uint row, const Uint col, const Real value)
+  {
+    if(m_apply_input)
+      (*m_apply_output)[row] += value * (*m_apply_input)[col];
+    else if(row / m_block_size == col / m_block_size)
+      m_block_diagonal[row*m_block_size + col % m_block_size] += value;
+  }
+
+  /// Compute y = A*x in matrix free mode, by executing the assembly action
+  void apply(const RealVector& x, RealVector& y);
+
+  /// Compute y = P^-1*x, with P the block diagonal of the matrix, in matrix free mode
+  void apply_preconditioner(const RealVector& x, RealVector& y) const;
   
   /// Zero the system (RHS and system matrix)
   void set_zero();
   
-  /// Set a dirichlet BC value, zeroing the corresponding row and column and adjusting the RHS
+  /// Set a dirichlet BC value, zeroing the corresponding row and column and adjusting the RHS.
+  /// For a distributed system, this is applied to the summed row, at the next solve
   void set_dirichlet_bc(const Uint row, const Real value, const Real coeff = 1.);
   
-  /// Reference to the RHS vector
+  /// Reference to the RHS vector. While applying a matrix free system, changes to it are discarded
   RealVector& rhs();
   
   /// Const access to the solution
@@ -84,6 +147,61 @@ private:
   /// System matrix
   typedef Eigen::DynamicSparseMatrix<Real, Eigen::RowMajor> MatrixT;
   MatrixT m_system_matrix;
+
+  /// Copy of the pattern values to m_system_matrix, for the solvers that need an Eigen matrix
+  const MatrixT& system_matrix();
+
+  /// Solve without storing the matrix
+  void solve_matrix_free();
+
+  /// Invert the diagonal node blocks into m_block_inverse, including the Dirichlet conditions
+  void invert_block_diagonal();
+
+  /// @name Fixed sparsity pattern, in compressed row format
+  //@{
+  /// Start of each row in m_columns and m_values, with the end of the last row appended
+  std::vector<Uint> m_row_starts;
+  /// Column indices, sorted within each row
+  std::vector<Uint> m_columns;
+  /// Matrix values
+  std::vector<Real> m_values;
+  /// Offsets of the element node pairs in the rows, for each connectivity table
+  std::map<const Mesh::CTable<Uint>*, std::vector<Uint> > m_element_offsets;
+  /// Mesh the pattern was built for
+  boost::weak_ptr<Mesh::CMesh const> m_pattern_mesh;
+  /// Global index of every local row, if the system is distributed
+  std::vector<Uint> m_global_rows;
+  /// True for the local rows that belong to this process, if the system is distributed
+  std::vector<bool> m_owned_rows;
+  /// RHS value and diagonal coefficient for the rows with a Dirichlet condition, if the system is distributed or matrix free
+  std::map<Uint, std::pair<Real, Real> > m_dirichlet_bcs;
+  //@}
+
+  /// @name Matrix free system
+  //@{
+  bool m_matrix_free;
+  /// Action that assembles the system
+  boost::weak_ptr<Common::CAction> m_assembly;
+  /// Convergence criterion and maximum number of iterations, when solving without Trilinos
+  Real m_tolerance;
+  Uint m_max_iterations;
+  /// Size of the diagonal blocks, i.e. the number of unknowns per node
+  Uint m_block_size;
+  /// Diagonal node blocks, in row major order
+  std::vector<Real> m_block_diagonal;
+  /// Inverse of the diagonal node blocks, computed before solving
+  std::vector<Real> m_block_inverse;
+  /// Vector the matrix is applied to, null when assembling
+  const RealVector* m_apply_input;
+  /// Result of applying the matrix
+  RealVector* m_apply_output;
+  /// Receives the RHS contributions while applying the matrix
+  RealVector m_discarded_rhs;
+  //@}
+
+  /// Solver data that is kept between solves
+  struct Implementation;
+  boost::scoped_ptr<Implementation> m_implementation;
   
   /// Right hand side
   RealVector m_rhs;
@@ -13,6 +13,7 @@
 
 #include "Common/CF.hpp"
 #include "Common/CActionDirector.hpp"
+#include "Common/CGroupActions.hpp"
 #include "Common/Core.hpp"
 #include "Common/CRoot.hpp"
 #include "Common/Foreach.hpp"
@@ -90,6 +91,75 @@ BOOST_AUTO_TEST_CASE(ActionDirectorStream)
   BOOST_CHECK_EQUAL(test_action3.value, 8);
 }
 
+BOOST_AUTO_TEST_CASE(ActionDirectorTreeChanges)
+{
+  CRoot& root = Core::instance().root();
+
+  CActionDirector& director = dynamic_cast<CActionDirector&>(root.get_child("director"));
+  director.configure_option("ActionOrder", std::vector<std::string>(1, "testaction"));
+
+  const Uint before = SetIntegerAction::value;
+  director.execute();
+  BOOST_CHECK_EQUAL(SetIntegerAction::value, before+1);
+
+  // the resolved actions follow the changes of the children
+  director.remove_component("testaction");
+  BOOST_CHECK_THROW(director.execute(), SetupError);
+
+  director.create_component<SetIntegerAction>("testaction");
+  director.execute();
+  BOOST_CHECK_EQUAL(SetIntegerAction::value, before+2);
+}
+
+BOOST_AUTO_TEST_CASE(ActionDirectorOptionChanges)
+{
+  CRoot& root = Core::instance().root();
+
+  CActionDirector& director = dynamic_cast<CActionDirector&>(root.get_child("director"));
+  director.create_component<SetIntegerAction>("option_action");
+  director.configure_option("ActionOrder", std::vector<std::string>(1, "testaction"));
+
+  const Uint before = SetIntegerAction::value;
+  director.execute();
+  BOOST_CHECK_EQUAL(SetIntegerAction::value, before+1);
+
+  // the resolved actions follow a new order
+  std::vector<std::string> order(2, "option_action");
+  order[1] = "testaction";
+  director.configure_option("ActionOrder", order);
+  director.execute();
+  BOOST_CHECK_EQUAL(SetIntegerAction::value, before+3);
+
+  // and a renamed child
+  director.get_child("option_action").rename("renamed_action");
+  BOOST_CHECK_THROW(director.execute(), SetupError);
+
+  order[0] = "renamed_action";
+  director.configure_option("ActionOrder", order);
+  director.execute();
+  BOOST_CHECK_EQUAL(SetIntegerAction::value, before+5);
+}
+
+BOOST_AUTO_TEST_CASE(GroupActionsTreeChanges)
+{
+  CRoot& root = Core::instance().root();
+
+  CGroupActions& group = root.create_component<CGroupActions>("group");
+  group.create_component<SetIntegerAction>("action1");
+
+  const Uint before = SetIntegerAction::value;
+  group.execute();
+  BOOST_CHECK_EQUAL(SetIntegerAction::value, before+1);
+
+  group.create_component<SetIntegerAction>("action2");
+  group.execute();
+  BOOST_CHECK_EQUAL(SetIntegerAction::value, before+3);
+
+  group.remove_component("action1");
+  group.execute();
+  BOOST_CHECK_EQUAL(SetIntegerAction::value, before+4);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -110,6 +110,30 @@ BOOST_AUTO_TEST_CASE ( test_CMap_looping )
   
 }
 
+BOOST_AUTO_TEST_CASE ( test_CMap_lower_bound )
+{
+  CMap<Uint,Uint>::Ptr map_ptr ( new CMap<Uint,Uint> ("map"));
+  CMap<Uint,Uint>& map = *map_ptr;
+
+  map.insert_blindly(7u,0u);
+  map.insert_blindly(2u,1u);
+  map.insert_blindly(5u,2u);
+  map.insert_blindly(9u,3u);
+  map.sort_keys();
+
+  const CMap<Uint,Uint>& const_map = *map_ptr;
+  BOOST_CHECK_EQUAL(const_map.lower_bound(0u)->first, 2u);
+  BOOST_CHECK_EQUAL(const_map.lower_bound(5u)->first, 5u);
+  BOOST_CHECK_EQUAL(const_map.lower_bound(6u)->first, 7u);
+  BOOST_CHECK(const_map.lower_bound(10u) == const_map.end());
+
+  // keys in [5,9)
+  Uint nb_keys(0);
+  for (CMap<Uint,Uint>::const_iterator it=const_map.lower_bound(5u); it!=const_map.lower_bound(9u); ++it)
+    ++nb_keys;
+  BOOST_CHECK_EQUAL(nb_keys, 2u);
+}
+
 BOOST_AUTO_TEST_CASE ( test_CMap_exceptions )
 {
 
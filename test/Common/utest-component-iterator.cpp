@@ -7,6 +7,8 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE "Test module for iteration over components"
 
+#include <iterator>
+
 #include <boost/test/unit_test.hpp>
 #include <boost/timer.hpp>
 
@@ -784,6 +786,32 @@ BOOST_AUTO_TEST_CASE( test_new_range )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( remove_while_iterating )
+{
+  CRoot::Ptr tree = CRoot::create("tree");
+  for (Uint i=0; i<10; ++i)
+    tree->create_component<CGroup>("group"+to_str(i)).create_component<CGroup>("subgroup");
+
+  // end iterators of the same kind compare equal, whatever range they were made for
+  BOOST_CHECK( tree->end() == root().end() );
+  BOOST_CHECK( tree->recursive_begin() != tree->recursive_end() );
+  BOOST_CHECK_EQUAL( std::distance(tree->begin(), tree->end()), 10 );
+  BOOST_CHECK_EQUAL( std::distance(tree->recursive_begin(), tree->recursive_end()), 20 );
+
+  // the components are collected when the range is made, so they can be removed while iterating
+  Uint nb_visited = 0;
+  BOOST_FOREACH( CGroup& group, find_components<CGroup>(*tree) )
+  {
+    tree->remove_component(group.name());
+    ++nb_visited;
+  }
+  BOOST_CHECK_EQUAL( nb_visited, 10u );
+  BOOST_CHECK_EQUAL( tree->count_children(), (size_t) 0 );
+  BOOST_CHECK( tree->recursive_begin() == tree->recursive_end() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE_END()
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -7,6 +7,9 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE "Test module for CF::Component"
 
+#include <algorithm>
+#include <functional>
+
 #include <boost/test/unit_test.hpp>
 
 #include <boost/foreach.hpp>
@@ -213,6 +216,76 @@ BOOST_AUTO_TEST_CASE( access_component_ptr )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( access_component_ptr_tree_changes )
+{
+  CRoot::Ptr root = CRoot::create ( "root" );
+
+  Component& dir1  = root->create_component<CGroup>("dir1");
+  Component& dir2  = dir1.create_component<CGroup>("dir2");
+  Component& dir21 = dir2.create_component<CGroup>("dir21");
+  Component& dir3  = root->create_component<CGroup>("dir3");
+
+  // resolved twice, the second time from the cache
+  BOOST_CHECK_EQUAL ( dir1.access_component_ptr( URI("cpath:dir2/dir21") ).get(), &dir21 );
+  BOOST_CHECK_EQUAL ( dir1.access_component_ptr( URI("cpath:dir2/dir21") ).get(), &dir21 );
+
+  // renamed
+  dir21.rename("dir21_renamed");
+  BOOST_CHECK ( is_null( dir1.access_component_ptr( URI("cpath:dir2/dir21") ) ) );
+  BOOST_CHECK_EQUAL ( dir1.access_component_ptr( URI("cpath:dir2/dir21_renamed") ).get(), &dir21 );
+
+  // moved
+  dir2.move_to(dir3);
+  BOOST_CHECK ( is_null( dir1.access_component_ptr( URI("cpath:dir2/dir21_renamed") ) ) );
+  BOOST_CHECK_EQUAL ( root->access_component_ptr( URI("cpath://root/dir3/dir2/dir21_renamed") ).get(), &dir21 );
+
+  // removed, and replaced by another component with the same name
+  dir2.remove_component("dir21_renamed");
+  BOOST_CHECK ( is_null( root->access_component_ptr( URI("cpath://root/dir3/dir2/dir21_renamed") ) ) );
+  Component& replacement = dir2.create_component<CGroup>("dir21_renamed");
+  BOOST_CHECK_EQUAL ( root->access_component_ptr( URI("cpath://root/dir3/dir2/dir21_renamed") ).get(), &replacement );
+
+  // child lookup by name
+  BOOST_CHECK_EQUAL ( dir2.get_child_ptr("dir21_renamed").get(), &replacement );
+  BOOST_CHECK ( is_null( dir2.get_child_ptr("dir21") ) );
+  BOOST_CHECK_EQUAL ( dir2.create_component<CGroup>("dir21_renamed").name(), std::string("dir21_renamed_1") );
+  BOOST_CHECK_EQUAL ( dir2.get_child_ptr("dir21_renamed_1")->name(), std::string("dir21_renamed_1") );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( child_index )
+{
+  CRoot::Ptr root = CRoot::create ( "root" );
+
+  Component& parent = root->create_component<CGroup>("parent");
+  Component& other  = root->create_component<CGroup>("other");
+
+  for ( Uint i = 0; i < 50; ++i )
+    parent.create_component<CGroup>("child");
+
+  parent.get_child("child_7").rename("renamed");
+  parent.remove_component("child_13");
+  parent.get_child("child_21").move_to(other);
+  parent.create_component<CGroup>("child");
+
+  // the name lookups find exactly the children stored in name order
+  std::vector<std::string> names;
+  BOOST_FOREACH( Component& child, parent.children() )
+  {
+    names.push_back( child.name() );
+    BOOST_CHECK_EQUAL ( parent.get_child_ptr( child.name() ).get(), &child );
+  }
+  BOOST_CHECK_EQUAL ( names.size(), 49u );
+  BOOST_CHECK_EQUAL ( names.size(), parent.count_children() );
+  BOOST_CHECK ( std::adjacent_find( names.begin(), names.end(), std::greater_equal<std::string>() ) == names.end() );
+
+  BOOST_CHECK ( is_not_null( parent.get_child_ptr("renamed") ) );
+  BOOST_CHECK ( is_null( parent.get_child_ptr("child_7") ) );
+  BOOST_CHECK ( is_null( parent.get_child_ptr("child_21") ) );
+  BOOST_CHECK ( is_not_null( other.get_child_ptr("child_21") ) );
+}
+
 BOOST_AUTO_TEST_CASE( move_to )
 {
   CRoot::Ptr root = CRoot::create ( "root" );
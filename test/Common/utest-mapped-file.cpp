@@ -0,0 +1,97 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for CF::Common::MappedFile"
+
+#include <cstdlib>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/BoostFilesystem.hpp"
+#include "Common/MappedFile.hpp"
+
+using namespace std;
+using namespace boost;
+using namespace CF;
+using namespace CF::Common;
+
+BOOST_AUTO_TEST_SUITE( MappedFile_TestSuite )
+
+BOOST_AUTO_TEST_CASE( tokenizer )
+{
+  const filesystem::path path("utest-mapped-file.txt");
+  {
+    filesystem::fstream file(path,std::ios_base::out);
+    file << "$Nodes\n";
+    file << "2\n";
+    file << "1 0.5 -1.25e-3 7\n";
+    file << "2 0.1 3.14159265358979 -2.5E+10\n";
+    file << "$EndNodes\n";
+    file << "-42 word";
+  }
+
+  MappedFile mapped_file(path);
+  BOOST_CHECK(mapped_file.is_open());
+  BOOST_CHECK_EQUAL(mapped_file.size(), filesystem::file_size(path));
+
+  std::string line;
+  BOOST_CHECK(mapped_file.get_line(line));
+  BOOST_CHECK_EQUAL(line, "$Nodes");
+
+  Uint nb_nodes;
+  mapped_file >> nb_nodes;
+  BOOST_CHECK_EQUAL(nb_nodes, 2u);
+  mapped_file.skip_line();
+
+  // remember where the nodes start
+  const MappedFile::Position nodes_position = mapped_file.position();
+
+  Uint node_number;
+  Real coords[3];
+  mapped_file >> node_number >> coords[0] >> coords[1] >> coords[2];
+  BOOST_CHECK_EQUAL(node_number, 1u);
+  BOOST_CHECK_EQUAL(coords[0], 0.5);
+  BOOST_CHECK_EQUAL(coords[1], -1.25e-3);
+  BOOST_CHECK_EQUAL(coords[2], 7.);
+  mapped_file.skip_line();
+
+  mapped_file >> node_number >> coords[0] >> coords[1] >> coords[2];
+  BOOST_CHECK_EQUAL(node_number, 2u);
+  // the same value as the standard library parser
+  BOOST_CHECK_EQUAL(coords[0], std::strtod("0.1",0));
+  BOOST_CHECK_EQUAL(coords[1], std::strtod("3.14159265358979",0));
+  BOOST_CHECK_EQUAL(coords[2], -2.5e10);
+  mapped_file.skip_line();
+
+  BOOST_CHECK(mapped_file.get_line(line));
+  BOOST_CHECK_EQUAL(line, "$EndNodes");
+
+  int negative;
+  std::string word;
+  mapped_file >> negative >> word;
+  BOOST_CHECK_EQUAL(negative, -42);
+  BOOST_CHECK_EQUAL(word, "word");
+  BOOST_CHECK(mapped_file.eof());
+  BOOST_CHECK(!mapped_file.get_line(line));
+
+  // jump back to the second node
+  mapped_file.seek(nodes_position);
+  mapped_file.skip_lines(1);
+  mapped_file >> node_number;
+  BOOST_CHECK_EQUAL(node_number, 2u);
+
+  // not a number
+  mapped_file.seek(0);
+  BOOST_CHECK_THROW(mapped_file >> node_number, ParsingFailed);
+
+  mapped_file.close();
+  BOOST_CHECK(!mapped_file.is_open());
+  filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -241,6 +241,15 @@ BOOST_AUTO_TEST_CASE( ObjectWrapperVector )
   for(i=0; i<32; i++) { BOOST_CHECK_EQUAL( dtesttesttesttest1[i] , 32+i ); }
   for(i=0; i<24; i++) { BOOST_CHECK_EQUAL( dtesttesttesttest2[i] , 64+i ); }
 
+  // packing into preallocated buffers
+  std::vector<double> buf1(8);
+  std::vector<double> buf2(12);
+  w1->pack(&buf1[0],map);
+  w2->pack(&buf2[0],map);
+
+  for(i=0; i<8; i++) { BOOST_CHECK_EQUAL( buf1[i] , 32+4+i ); }
+  for(i=0; i<12; i++) { BOOST_CHECK_EQUAL( buf2[i] , 64+6+i ); }
+
   delete[] dtest1;
   delete[] dtest2;
   delete[] dtesttest1;
@@ -519,6 +528,117 @@ BOOST_AUTO_TEST_CASE( commpattern_mainstream )
   for (i=0; i< 2*nproc; i++, idx++) BOOST_CHECK_EQUAL( v2[i], (double)((((i-0*nproc)/2)+1)*1000+idx+1) );
   for (   ; i< 6*nproc; i++, idx++) BOOST_CHECK_EQUAL( v2[i], (double)((((i-2*nproc)/4)+1)*1000+idx+1) );
   for (   ; i<12*nproc; i++, idx++) BOOST_CHECK_EQUAL( v2[i], (double)((((i-6*nproc)/6)+1)*1000+idx+1) );
+
+  // synchronizing again reuses the persistent buffers and must not change anything
+  pecp.synchronize("v2");
+  pecp.synchronize("v1");
+
+  idx=0;
+  for (i=0; i<  nproc; i++, idx++ ) BOOST_CHECK_EQUAL( v1[i], (int)(-((((i-0*nproc)/1)+1)*1000+idx+1)) );
+  for (   ; i<3*nproc; i++, idx++ ) BOOST_CHECK_EQUAL( v1[i], (int)(-((((i-1*nproc)/2)+1)*1000+idx+1)) );
+  for (   ; i<6*nproc; i++, idx++ ) BOOST_CHECK_EQUAL( v1[i], (int)(-((((i-3*nproc)/3)+1)*1000+idx+1)) );
+  idx=0;
+  for (i=0; i< 2*nproc; i++, idx++) BOOST_CHECK_EQUAL( v2[i], (double)((((i-0*nproc)/2)+1)*1000+idx+1) );
+  for (   ; i< 6*nproc; i++, idx++) BOOST_CHECK_EQUAL( v2[i], (double)((((i-2*nproc)/4)+1)*1000+idx+1) );
+  for (   ; i<12*nproc; i++, idx++) BOOST_CHECK_EQUAL( v2[i], (double)((((i-6*nproc)/6)+1)*1000+idx+1) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( commpattern_split_phase_synchronization )
+{
+  // general constants in this routine
+  const int nproc=Comm::PE::instance().size();
+  const int irank=Comm::PE::instance().rank();
+
+  // commpattern
+  CommPattern pecp("CommPattern");
+
+  // setup gid & rank
+  std::vector<Uint> gid;
+  std::vector<Uint> rank;
+  setupGidAndRank(gid,rank);
+  pecp.insert("gid",gid,1,false);
+
+  // additional arrays for testing
+  std::vector<int> v1;
+  for(int i=0;i<6*nproc;i++) v1.push_back(-((irank+1)*1000+i+1));
+  pecp.insert("v1",v1,1,true);
+  std::vector<double> v2;
+  for(int i=0;i<12*nproc;i++) v2.push_back((double)((irank+1)*1000+i+1));
+  pecp.insert("v2",v2,2,true);
+
+  // initial setup
+  pecp.setup(pecp.get_child_ptr("gid")->as_ptr<CommWrapper>(),rank);
+
+  // both objects in flight at the same time
+  pecp.synchronize_begin("v1");
+  pecp.synchronize_begin("v2");
+  BOOST_CHECK_EQUAL( pecp.is_synchronizing("v1") , true );
+  BOOST_CHECK_EQUAL( pecp.is_synchronizing("v2") , true );
+  BOOST_CHECK_EQUAL( pecp.is_synchronizing("gid") , false );
+
+  pecp.synchronize_end("v1");
+  pecp.synchronize_end_all();
+  BOOST_CHECK_EQUAL( pecp.is_synchronizing("v1") , false );
+  BOOST_CHECK_EQUAL( pecp.is_synchronizing("v2") , false );
+
+  // check results, same as blocking synchronization
+  Uint idx=0;
+  Uint i;
+  for (i=0; i<  nproc; i++, idx++ ) BOOST_CHECK_EQUAL( v1[i], (int)(-((((i-0*nproc)/1)+1)*1000+idx+1)) );
+  for (   ; i<3*nproc; i++, idx++ ) BOOST_CHECK_EQUAL( v1[i], (int)(-((((i-1*nproc)/2)+1)*1000+idx+1)) );
+  for (   ; i<6*nproc; i++, idx++ ) BOOST_CHECK_EQUAL( v1[i], (int)(-((((i-3*nproc)/3)+1)*1000+idx+1)) );
+  idx=0;
+  for (i=0; i< 2*nproc; i++, idx++) BOOST_CHECK_EQUAL( v2[i], (double)((((i-0*nproc)/2)+1)*1000+idx+1) );
+  for (   ; i< 6*nproc; i++, idx++) BOOST_CHECK_EQUAL( v2[i], (double)((((i-2*nproc)/4)+1)*1000+idx+1) );
+  for (   ; i<12*nproc; i++, idx++) BOOST_CHECK_EQUAL( v2[i], (double)((((i-6*nproc)/6)+1)*1000+idx+1) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( commpattern_split_phase_two_patterns )
+{
+  // general constants in this routine
+  const int nproc=Comm::PE::instance().size();
+  const int irank=Comm::PE::instance().rank();
+
+  // two commpatterns with the same layout, whose exchanges must not match each other's messages
+  CommPattern pecp1("CommPattern1");
+  CommPattern pecp2("CommPattern2");
+
+  std::vector<Uint> gid;
+  std::vector<Uint> rank;
+  setupGidAndRank(gid,rank);
+
+  std::vector<int> v1;
+  std::vector<int> v2;
+  for(int i=0;i<6*nproc;i++) v1.push_back(-((irank+1)*1000+i+1));
+  for(int i=0;i<6*nproc;i++) v2.push_back(  (irank+1)*1000+i+1 );
+
+  pecp1.insert("gid",gid,1,false);
+  pecp1.insert("v",v1,1,true);
+  pecp1.setup(pecp1.get_child_ptr("gid")->as_ptr<CommWrapper>(),rank);
+
+  pecp2.insert("gid",gid,1,false);
+  pecp2.insert("v",v2,1,true);
+  pecp2.setup(pecp2.get_child_ptr("gid")->as_ptr<CommWrapper>(),rank);
+
+  // both in flight, completed in the reverse order
+  pecp1.synchronize_begin("v");
+  pecp2.synchronize_begin("v");
+  pecp2.synchronize_end("v");
+  pecp1.synchronize_end("v");
+
+  Uint idx=0;
+  Uint i;
+  for (i=0; i<  nproc; i++, idx++ ) BOOST_CHECK_EQUAL( v1[i], (int)(-((((i-0*nproc)/1)+1)*1000+idx+1)) );
+  for (   ; i<3*nproc; i++, idx++ ) BOOST_CHECK_EQUAL( v1[i], (int)(-((((i-1*nproc)/2)+1)*1000+idx+1)) );
+  for (   ; i<6*nproc; i++, idx++ ) BOOST_CHECK_EQUAL( v1[i], (int)(-((((i-3*nproc)/3)+1)*1000+idx+1)) );
+  idx=0;
+  for (i=0; i<  nproc; i++, idx++ ) BOOST_CHECK_EQUAL( v2[i], (int)((((i-0*nproc)/1)+1)*1000+idx+1) );
+  for (   ; i<3*nproc; i++, idx++ ) BOOST_CHECK_EQUAL( v2[i], (int)((((i-1*nproc)/2)+1)*1000+idx+1) );
+  for (   ; i<6*nproc; i++, idx++ ) BOOST_CHECK_EQUAL( v2[i], (int)((((i-3*nproc)/3)+1)*1000+idx+1) );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,199 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for CF::Common::ThreadPool"
+
+#include <algorithm>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/bind.hpp>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/Core.hpp"
+#include "Common/CEnv.hpp"
+#include "Common/ThreadPool.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Counts how many times every index is visited
+struct CountVisits
+{
+  CountVisits(const Uint size) : visits(size, 0u) {}
+
+  void operator()(const Uint begin, const Uint end)
+  {
+    // every index belongs to exactly one chunk, so no two threads write the same entry
+    for (Uint i=begin; i<end; ++i)
+      ++visits[i];
+  }
+
+  std::vector<Uint> visits;
+};
+
+/// Throws when reaching a given index
+struct ThrowAt
+{
+  ThrowAt(const Uint idx) : throw_idx(idx) {}
+
+  void operator()(const Uint begin, const Uint end)
+  {
+    if (throw_idx >= begin && throw_idx < end)
+      throw BadValue(FromHere(), "failure in a thread");
+  }
+
+  Uint throw_idx;
+};
+
+/// Records which thread visits every index
+struct RecordThread
+{
+  RecordThread(ThreadPool& pool_in, const Uint size) : pool(pool_in), threads(size, 0u), nb_calls(0) {}
+
+  void operator()(const Uint begin, const Uint end)
+  {
+    for (Uint i=begin; i<end; ++i)
+      threads[i] = pool.thread_index();
+    boost::mutex::scoped_lock lock(mutex);
+    ++nb_calls;
+  }
+
+  ThreadPool& pool;
+  std::vector<Uint> threads;
+  Uint nb_calls;
+  boost::mutex mutex;
+};
+
+void set_flag(std::vector<Uint>& flags, const Uint i)
+{
+  flags[i] = 1u;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( ThreadPoolSuite )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( configure_from_environment )
+{
+  ThreadPool& pool = Core::instance().thread_pool();
+  BOOST_CHECK_EQUAL(pool.nb_threads(), 1u);
+
+  Core::instance().environment().configure_option("nb_threads", 4u);
+  BOOST_CHECK_EQUAL(pool.nb_threads(), 4u);
+
+  Core::instance().environment().configure_option("numa_policy", std::string("first_touch"));
+  BOOST_CHECK_EQUAL(pool.numa_policy(), ThreadPool::NUMA_FIRST_TOUCH);
+
+  BOOST_CHECK(!pool.in_parallel_section());
+  BOOST_CHECK_EQUAL(pool.thread_index(), 0u);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( parallel_for_visits_all )
+{
+  ThreadPool& pool = Core::instance().thread_pool();
+
+  // sizes smaller than, equal to and much larger than the number of threads
+  const Uint sizes[] = {0, 1, 4, 1000, 100003};
+  for (Uint s=0; s<5; ++s)
+  {
+    CountVisits counter(sizes[s]);
+    pool.parallel_for(0, sizes[s], counter);
+    BOOST_CHECK(std::count(counter.visits.begin(), counter.visits.end(), 1u) == static_cast<int>(sizes[s]));
+
+    CountVisits grained(sizes[s]);
+    pool.parallel_for(0, sizes[s], grained, 7);
+    BOOST_CHECK(std::count(grained.visits.begin(), grained.visits.end(), 1u) == static_cast<int>(sizes[s]));
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( parallel_for_throws )
+{
+  ThreadPool& pool = Core::instance().thread_pool();
+
+  ThrowAt thrower(9000);
+  BOOST_CHECK_THROW(pool.parallel_for(0, 10000, thrower), ParallelError);
+
+  // the pool is still usable afterwards
+  CountVisits counter(10000);
+  pool.parallel_for(0, 10000, counter);
+  BOOST_CHECK(std::count(counter.visits.begin(), counter.visits.end(), 1u) == 10000);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( task_group )
+{
+  ThreadPool& pool = Core::instance().thread_pool();
+
+  std::vector<Uint> flags(100, 0u);
+  ThreadPool::TaskGroup group(pool);
+  for (Uint i=0; i<flags.size(); ++i)
+    group.run(boost::bind(&set_flag, boost::ref(flags), i));
+  group.wait();
+
+  BOOST_CHECK(std::count(flags.begin(), flags.end(), 1u) == 100);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( parallel_for_static_shares )
+{
+  ThreadPool& pool = Core::instance().thread_pool();
+  const Uint nb_threads = pool.nb_threads();
+
+  // every thread gets exactly its own share, in one call
+  const Uint size = 1000;
+  RecordThread recorder(pool, size);
+  pool.parallel_for_static(0, size, recorder);
+  BOOST_CHECK_EQUAL(recorder.nb_calls, nb_threads);
+  for (Uint i=0; i<size; ++i)
+    BOOST_CHECK_EQUAL(recorder.threads[i], i*nb_threads/size);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( first_touch_keeps_zeros )
+{
+  ThreadPool& pool = Core::instance().thread_pool();
+  BOOST_CHECK_EQUAL(pool.numa_policy(), ThreadPool::NUMA_FIRST_TOUCH);
+
+  std::vector<Real> data(3*100000, 0.);
+  pool.first_touch(&data[0], 100000, 3*sizeof(Real));
+  BOOST_CHECK(std::count(data.begin(), data.end(), 0.) == static_cast<int>(data.size()));
+
+  data[12345] = 1.;
+  BOOST_CHECK_EQUAL(data[12345], 1.);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( resize )
+{
+  ThreadPool& pool = Core::instance().thread_pool();
+  pool.set_nb_threads(2);
+
+  CountVisits counter(1000);
+  pool.parallel_for(0, 1000, counter);
+  BOOST_CHECK(std::count(counter.visits.begin(), counter.visits.end(), 1u) == 1000);
+
+  pool.set_nb_threads(1);
+  BOOST_CHECK_EQUAL(pool.nb_threads(), 1u);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -82,6 +82,36 @@ BOOST_AUTO_TEST_CASE( function_2 )
 }
 
 
+BOOST_AUTO_TEST_CASE( batch_evaluation )
+{
+  // the last function uses a condition, which is evaluated by the function parser
+  CF::Math::VectorialFunction f ("[x+y*2-z/3][-x^2+sin(y)*cos(z)][2^-x+pow(y,1.5)][sqrt(x*x+y*y)+pi*min(x,z)][if(x<0.5,1,2)]","x,y,z");
+
+  // more points than evaluated at once by the bytecode
+  const Uint nb_points = 1000;
+  RealMatrix vars(nb_points,3);
+  for (Uint p=0; p<nb_points; ++p)
+  {
+    vars(p,0) = 0.001*p;
+    vars(p,1) = 1. + 0.002*p;
+    vars(p,2) = 0.3 + 0.0005*p;
+  }
+
+  RealMatrix values;
+  f.evaluate(vars,values);
+  BOOST_CHECK_EQUAL( values.rows(), (int)nb_points );
+  BOOST_CHECK_EQUAL( values.cols(), 5 );
+
+  RealVector point(3);
+  RealVector point_values(5);
+  for (Uint p=0; p<nb_points; ++p)
+  {
+    point = vars.row(p).transpose();
+    f.evaluate(point,point_values);
+    for (Uint i=0; i<5; ++i)
+      BOOST_CHECK_CLOSE( values(p,i), point_values[i], 1e-10 );
+  }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,134 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Tests Mesh::Actions::CColourElements"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Log.hpp"
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/EventHandler.hpp"
+#include "Common/OptionURI.hpp"
+#include "Common/XML/SignalOptions.hpp"
+
+#include "Common/FindComponents.hpp"
+
+#include "Mesh/Actions/CColourElements.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CList.hpp"
+#include "Mesh/CMeshReader.hpp"
+#include "Mesh/Geometry.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Common::XML;
+using namespace CF::Mesh;
+using namespace CF::Mesh::Actions;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct TestCColourElements_Fixture
+{
+  /// common setup for each test case
+  TestCColourElements_Fixture()
+  {
+    m_argc = boost::unit_test::framework::master_test_suite().argc;
+    m_argv = boost::unit_test::framework::master_test_suite().argv;
+  }
+
+  /// common tear-down for each test case
+  ~TestCColourElements_Fixture()
+  {
+  }
+
+  /// possibly common functions used on the tests below
+  int m_argc;
+  char** m_argv;
+
+
+  /// common values accessed by all tests goes here
+  static CMesh::Ptr mesh;
+};
+
+CMesh::Ptr TestCColourElements_Fixture::mesh = Core::instance().root().create_component_ptr<CMesh>("mesh");
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( TestCColourElements_TestSuite, TestCColourElements_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( Constructors)
+{
+  CColourElements::Ptr colour_elements = allocate_component<CColourElements>("colour_elements");
+  BOOST_CHECK_EQUAL(colour_elements->name(),"colour_elements");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( colour_elements )
+{
+  CMeshReader::Ptr meshreader = build_component_abstract_type<CMeshReader>("CF.Mesh.Neu.CReader","meshreader");
+  meshreader->read_mesh_into("quadtriag.neu",*mesh);
+
+  CColourElements::Ptr colour_elements = allocate_component<CColourElements>("colour_elements");
+  colour_elements->transform(mesh);
+
+  boost_foreach(CElements& elements, find_components_recursively<CElements>(mesh->topology()))
+  {
+    CList<Uint>::Ptr colouring = find_component_ptr_with_tag<CList<Uint> >(elements,Mesh::Tags::coloured_elements());
+    BOOST_REQUIRE( is_not_null(colouring) );
+
+    const Uint nb_colours = colouring->properties().value<Uint>("nb_colours");
+    BOOST_CHECK_EQUAL( colouring->size() , nb_colours+1+elements.size() );
+    BOOST_CHECK_EQUAL( (*colouring)[0] , 0u );
+    BOOST_CHECK_EQUAL( (*colouring)[nb_colours] , elements.size() );
+
+    // every element appears once, and elements of the same colour share no node
+    std::vector<bool> visited(elements.size(),false);
+    std::vector<Uint> node_colour(elements.geometry().size(),nb_colours);
+    for (Uint colour=0; colour<nb_colours; ++colour)
+    {
+      for (Uint i=(*colouring)[colour]; i<(*colouring)[colour+1]; ++i)
+      {
+        const Uint elem = (*colouring)[nb_colours+1+i];
+        BOOST_CHECK( !visited[elem] );
+        visited[elem] = true;
+        boost_foreach(const Uint node, elements.get_nodes(elem))
+        {
+          BOOST_CHECK( node_colour[node] != colour );
+          node_colour[node] = colour;
+        }
+      }
+    }
+
+    // the cached colouring is returned
+    BOOST_CHECK_EQUAL( &CColourElements::colouring(elements) , colouring.get() );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( invalidate_on_mesh_changed )
+{
+  SignalOptions options;
+  options.add_option< OptionURI >("mesh_uri", mesh->uri());
+  SignalArgs args = options.create_frame();
+  Core::instance().event_handler().raise_event( "mesh_changed", args);
+
+  boost_foreach(CElements& elements, find_components_recursively<CElements>(mesh->topology()))
+    BOOST_CHECK( is_null(find_component_ptr_with_tag<CList<Uint> >(elements,Mesh::Tags::coloured_elements())) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
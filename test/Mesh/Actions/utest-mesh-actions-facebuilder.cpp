@@ -18,6 +18,7 @@
 #include "Mesh/Actions/CreateSpaceP0.hpp"
 #include "Mesh/Actions/CBuildFaces.hpp"
 #include "Mesh/Actions/CBuildFaceNormals.hpp"
+#include "Mesh/Actions/CBuildVolume.hpp"
 #include "Mesh/CMeshTransformer.hpp"
 #include "Mesh/CMeshWriter.hpp"
 #include "Mesh/CMesh.hpp"
@@ -211,6 +212,29 @@ BOOST_AUTO_TEST_CASE( build_faces_rectangle )
 
 //////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( build_volume_rectangle )
+{
+  CMesh::Ptr rmesh = Core::instance().root().create_component_ptr<CMesh>("volume_mesh");
+  CSimpleMeshGenerator::create_rectangle(*rmesh, 10. , 10., 5 , 5 );
+
+  CBuildVolume::Ptr volume_builder = allocate_component<CBuildVolume>("volumebuilder");
+  volume_builder->set_mesh(rmesh);
+  volume_builder->execute();
+
+  // every cell of the 5x5 rectangle is a 2x2 square
+  Field& volume = rmesh->get_child("cells_P0").get_child(Mesh::Tags::volume()).as_type<Field>();
+  BOOST_CHECK_EQUAL(volume.size(), 25u);
+  Real total_volume = 0.;
+  for (Uint cell=0; cell<volume.size(); ++cell)
+  {
+    BOOST_CHECK_CLOSE(volume[cell][0], 4., 1e-10);
+    total_volume += volume[cell][0];
+  }
+  BOOST_CHECK_CLOSE(total_volume, 100., 1e-10);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE_END()
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,137 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Tests Mesh::Actions::CRenumber"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Log.hpp"
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+
+#include "Common/FindComponents.hpp"
+
+#include "Mesh/Actions/CRenumber.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CMeshReader.hpp"
+#include "Mesh/Geometry.hpp"
+#include "Mesh/Field.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Mesh;
+using namespace CF::Mesh::Actions;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct TestCRenumber_Fixture
+{
+  /// common setup for each test case
+  TestCRenumber_Fixture()
+  {
+    m_argc = boost::unit_test::framework::master_test_suite().argc;
+    m_argv = boost::unit_test::framework::master_test_suite().argv;
+  }
+
+  /// common tear-down for each test case
+  ~TestCRenumber_Fixture()
+  {
+  }
+
+  /// sorted coordinates of the nodes of every element, per element type
+  std::map<std::string, std::vector< std::vector<Real> > > element_coordinates(CMesh& mesh)
+  {
+    std::map<std::string, std::vector< std::vector<Real> > > coords;
+    const Field& nodes = mesh.geometry().coordinates();
+    boost_foreach(CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+    {
+      std::vector< std::vector<Real> >& elems = coords[elements.uri().path()];
+      for (Uint e=0; e<elements.size(); ++e)
+      {
+        std::vector<Real> elem;
+        boost_foreach(const Uint node, elements.node_connectivity()[e])
+          elem.insert(elem.end(),nodes[node].begin(),nodes[node].end());
+        elems.push_back(elem);
+      }
+      std::sort(elems.begin(),elems.end());
+    }
+    return coords;
+  }
+
+  /// largest difference between the indices of two nodes of an element
+  Uint bandwidth(CMesh& mesh)
+  {
+    Uint bw = 0;
+    boost_foreach(CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+    {
+      boost_foreach(CTable<Uint>::ConstRow nodes, elements.node_connectivity().array())
+        bw = std::max(bw, *std::max_element(nodes.begin(),nodes.end()) - *std::min_element(nodes.begin(),nodes.end()));
+    }
+    return bw;
+  }
+
+  /// possibly common functions used on the tests below
+  int m_argc;
+  char** m_argv;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( TestCRenumber_TestSuite, TestCRenumber_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( Constructors)
+{
+  CRenumber::Ptr renumber = allocate_component<CRenumber>("renumber");
+  BOOST_CHECK_EQUAL(renumber->name(),"renumber");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( renumber )
+{
+  const std::string orderings[] = { "RCM", "Hilbert", "Morton" };
+  for (Uint i=0; i<3; ++i)
+  {
+    CMesh::Ptr mesh = Core::instance().root().create_component_ptr<CMesh>("mesh_"+orderings[i]);
+    CMeshReader::Ptr meshreader = build_component_abstract_type<CMeshReader>("CF.Mesh.Neu.CReader","meshreader");
+    meshreader->read_mesh_into("quadtriag.neu",*mesh);
+
+    const std::map<std::string, std::vector< std::vector<Real> > > before = element_coordinates(*mesh);
+    const Uint nb_nodes = mesh->geometry().size();
+
+    CRenumber::Ptr renumber = allocate_component<CRenumber>("renumber");
+    renumber->configure_option("node_ordering",orderings[i]);
+    renumber->transform(mesh);
+
+    // the same elements, with the same nodes
+    BOOST_CHECK_EQUAL( mesh->geometry().size() , nb_nodes );
+    BOOST_CHECK( element_coordinates(*mesh) == before );
+
+    // elements are sorted by their lowest node
+    boost_foreach(CElements& elements, find_components_recursively<CElements>(mesh->topology()))
+    {
+      const CConnectivity& connectivity = elements.node_connectivity();
+      for (Uint e=1; e<elements.size(); ++e)
+        BOOST_CHECK( *std::min_element(connectivity[e-1].begin(),connectivity[e-1].end()) <=
+                     *std::min_element(connectivity[e].begin(),connectivity[e].end()) );
+    }
+
+    CFinfo << orderings[i] << " bandwidth: " << bandwidth(*mesh) << CFendl;
+
+    Core::instance().root().remove_component(*mesh);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
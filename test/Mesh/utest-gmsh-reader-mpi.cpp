@@ -53,6 +53,21 @@ struct GmshReaderMPITests_Fixture
   }
   /// possibly common functions used on the tests below
 
+  /// Check that a mesh read back from a written file has the same nodes and elements as the original
+  void check_same_mesh(const CMesh& mesh, const CMesh& read_mesh)
+  {
+    BOOST_CHECK_EQUAL( read_mesh.dimension() , mesh.dimension() );
+    BOOST_CHECK_EQUAL( read_mesh.topology().recursive_elements_count() , mesh.topology().recursive_elements_count() );
+
+    const CTable<Real>& coordinates = mesh.geometry().coordinates();
+    const CTable<Real>& read_coordinates = read_mesh.geometry().coordinates();
+    BOOST_CHECK_EQUAL( read_coordinates.size() , coordinates.size() );
+    for (Uint n=0; n<std::min(coordinates.size(),read_coordinates.size()); ++n)
+    {
+      for (Uint d=0; d<mesh.dimension(); ++d)
+        BOOST_CHECK_CLOSE( read_coordinates[n][d] , coordinates[n][d] , 1e-10 );
+    }
+  }
 
   /// common values accessed by all tests goes here
   int    m_argc;
@@ -285,6 +300,36 @@ BOOST_AUTO_TEST_CASE( read_2d_mesh_mix_p1_out )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( read_2d_mesh_mix_p1_binary )
+{
+  CMeshReader::Ptr meshreader = build_component_abstract_type<CMeshReader>("CF.Mesh.Gmsh.CReader","meshreader");
+
+  CMesh& mesh = Core::instance().root().create_component<CMesh>("mesh_2d_mix_p1_ascii");
+  meshreader->read_mesh_into("rectangle-mix-p1.msh",mesh);
+
+  CMeshWriter::Ptr mesh_writer =
+    build_component_abstract_type<CMeshWriter> ("CF.Mesh.Gmsh.CWriter", "GmshWriter" );
+  mesh_writer->configure_option("binary",true);
+  mesh_writer->write_from_to(mesh,"rectangle-mix-p1-binary.msh");
+
+  // read the binary file back, it must give the same mesh
+  CMesh& binary_mesh = Core::instance().root().create_component<CMesh>("mesh_2d_mix_p1_binary");
+  meshreader->read_mesh_into("rectangle-mix-p1-binary.msh",binary_mesh);
+
+  check_same_mesh(mesh, binary_mesh);
+
+  // the binary file must also reproduce the ASCII output
+  mesh_writer->configure_option("binary",false);
+  mesh_writer->write_from_to(binary_mesh,"rectangle-mix-p1-binary-out.msh");
+
+  CMesh& binary_out_mesh = Core::instance().root().create_component<CMesh>("mesh_2d_mix_p1_binary_out");
+  meshreader->read_mesh_into("rectangle-mix-p1-binary-out.msh",binary_out_mesh);
+
+  check_same_mesh(mesh, binary_out_mesh);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_CASE( finalize_mpi )
 {
   Core::instance().terminate();
@@ -0,0 +1,159 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for CF::Mesh::Checkpoint"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Log.hpp"
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/Foreach.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/MPI/PE.hpp"
+
+#include "Math/VariablesDescriptor.hpp"
+
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CMeshReader.hpp"
+#include "Mesh/CMeshWriter.hpp"
+#include "Mesh/Field.hpp"
+#include "Mesh/FieldGroup.hpp"
+#include "Mesh/Geometry.hpp"
+#include "Mesh/MeshMetadata.hpp"
+#include "Mesh/CList.hpp"
+#include "Mesh/CTable.hpp"
+
+#include "Tools/MeshGeneration/MeshGeneration.hpp"
+
+using namespace CF;
+using namespace CF::Mesh;
+using namespace CF::Common;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct CheckpointTests_Fixture
+{
+  /// common setup for each test case
+  CheckpointTests_Fixture()
+  {
+    m_argc = boost::unit_test::framework::master_test_suite().argc;
+    m_argv = boost::unit_test::framework::master_test_suite().argv;
+  }
+
+  /// common values accessed by all tests goes here
+  int    m_argc;
+  char** m_argv;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( CheckpointTests_TestSuite, CheckpointTests_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( init_mpi )
+{
+  Comm::PE::instance().init(m_argc,m_argv);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( write_and_restore )
+{
+  CRoot& root = Core::instance().root();
+
+  CMesh& mesh = root.create_component<CMesh>("mesh");
+  Tools::MeshGeneration::create_rectangle(mesh, 5., 5., 5, 5);
+  mesh.metadata()["time"] = 0.25;
+  mesh.metadata()["iter"] = 10u;
+
+  // a point based field with a vector variable, and an element based field
+
+  Field& solution = mesh.geometry().create_field("solution","rho[scalar],U[vector]");
+  for (Uint n=0; n<solution.size(); ++n)
+    for (Uint j=0; j<solution.row_size(); ++j)
+      solution[n][j] = n + 0.1*j;
+
+  boost_foreach(CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+    elements.create_space("elems_P0","CF.Mesh.SF.SF"+elements.element_type().shape_name()+"LagrangeP0");
+  FieldGroup& elem_fields = mesh.create_field_group("elems_P0", FieldGroup::Basis::ELEMENT_BASED);
+  Field& volume = elem_fields.create_field("volume");
+  for (Uint e=0; e<volume.size(); ++e)
+    volume[e][0] = 2.*e;
+
+  CMeshWriter::Ptr writer = build_component_abstract_type<CMeshWriter>("CF.Mesh.Checkpoint.CWriter","checkpoint_writer");
+  writer->write_from_to(mesh,"rectangle.cfcp");
+
+  CMeshReader::Ptr reader = build_component_abstract_type<CMeshReader>("CF.Mesh.Checkpoint.CReader","checkpoint_reader");
+  CMesh& restart = root.create_component<CMesh>("restart");
+  reader->read_mesh_into("rectangle.cfcp",restart);
+
+  // mesh
+
+  BOOST_CHECK_EQUAL( restart.dimension() , mesh.dimension() );
+  BOOST_CHECK_EQUAL( restart.metadata().properties().value<Real>("time") , 0.25 );
+  BOOST_CHECK_EQUAL( restart.metadata().properties().value<Uint>("iter") , 10u );
+
+  const Geometry& nodes = mesh.geometry();
+  const Geometry& restart_nodes = restart.geometry();
+  BOOST_CHECK_EQUAL( restart_nodes.size() , nodes.size() );
+  for (Uint n=0; n<nodes.size(); ++n)
+  {
+    BOOST_CHECK_EQUAL( restart_nodes.glb_idx()[n] , nodes.glb_idx()[n] );
+    BOOST_CHECK_EQUAL( restart_nodes.rank()[n] , nodes.rank()[n] );
+    for (Uint d=0; d<mesh.dimension(); ++d)
+      BOOST_CHECK_EQUAL( restart_nodes.coordinates()[n][d] , nodes.coordinates()[n][d] );
+  }
+
+  BOOST_CHECK_EQUAL( count(find_components_recursively<CElements>(restart.topology())) ,
+                     count(find_components_recursively<CElements>(mesh.topology())) );
+  boost_foreach(const CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+  {
+    const std::string path = elements.uri().path().substr(mesh.uri().path().size()+1);
+    const CElements& restart_elements = restart.access_component(URI(path)).as_type<CElements>();
+    BOOST_CHECK_EQUAL( restart_elements.element_type().derived_type_name() , elements.element_type().derived_type_name() );
+    BOOST_CHECK_EQUAL( restart_elements.size() , elements.size() );
+    for (Uint e=0; e<elements.size(); ++e)
+      for (Uint n=0; n<elements.node_connectivity().row_size(); ++n)
+        BOOST_CHECK_EQUAL( restart_elements.node_connectivity()[e][n] , elements.node_connectivity()[e][n] );
+    BOOST_CHECK_EQUAL( restart_elements.glb_idx().size() , elements.glb_idx().size() );
+    for (Uint e=0; e<elements.glb_idx().size(); ++e)
+      BOOST_CHECK_EQUAL( restart_elements.glb_idx()[e] , elements.glb_idx()[e] );
+  }
+
+  // fields
+
+  const Field& restart_solution = restart_nodes.field("solution");
+  BOOST_CHECK_EQUAL( restart_solution.descriptor().description() , solution.descriptor().description() );
+  BOOST_CHECK_EQUAL( restart_solution.var_length("U") , Field::VECTOR_2D );
+  for (Uint n=0; n<solution.size(); ++n)
+    for (Uint j=0; j<solution.row_size(); ++j)
+      BOOST_CHECK_EQUAL( restart_solution[n][j] , solution[n][j] );
+
+  const FieldGroup& restart_elem_fields = restart.get_child("elems_P0").as_type<FieldGroup>();
+  BOOST_CHECK_EQUAL( restart_elem_fields.basis() , FieldGroup::Basis::ELEMENT_BASED );
+  BOOST_CHECK_EQUAL( restart_elem_fields.size() , elem_fields.size() );
+  const Field& restart_volume = restart_elem_fields.field("volume");
+  for (Uint e=0; e<volume.size(); ++e)
+    BOOST_CHECK_EQUAL( restart_volume[e][0] , volume[e][0] );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( finalize_mpi )
+{
+  Comm::PE::instance().finalize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
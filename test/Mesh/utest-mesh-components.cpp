@@ -686,6 +686,75 @@ BOOST_AUTO_TEST_CASE ( CDynTable_test_hard )
 }
 
 
+BOOST_AUTO_TEST_CASE ( CDynTable_test_allocate )
+{
+  CDynTable<Uint> table ("table");
+
+  // counts-then-fill
+  std::vector<Uint> row_sizes = list_of(2)(0)(3);
+  table.allocate(row_sizes);
+  BOOST_CHECK_EQUAL(table.size(), 3u);
+  BOOST_CHECK_EQUAL(table.values().size(), 5u);
+  BOOST_CHECK_EQUAL(table.offsets()[2], 2u);
+  for (Uint i=0; i<table.size(); ++i)
+    for (Uint j=0; j<table.row_size(i); ++j)
+      table[i][j] = 10*i+j;
+
+  BOOST_CHECK_EQUAL(table[0][1], 1u);
+  BOOST_CHECK_EQUAL(table[2][2], 22u);
+
+  // changing a row size moves the following rows
+  table.set_row_size(1,1);
+  table[1][0] = 10;
+  BOOST_CHECK_EQUAL(table.row_size(1), 1u);
+  BOOST_CHECK_EQUAL(table[2][0], 20u);
+  BOOST_CHECK_EQUAL(table.values().size(), 6u);
+
+  // rows of different size set through a buffer are applied on flush
+  CDynTable<Uint>::Buffer buffer = table.create_buffer();
+  std::vector<Uint> row = list_of(7)(8)(9)(10);
+  buffer.set_row(0,row);
+  buffer.rm_row(1);
+  BOOST_CHECK_EQUAL(table.row_size(0), 2u);
+  buffer.flush();
+  BOOST_CHECK_EQUAL(table.size(), 2u);
+  BOOST_CHECK_EQUAL(table.row_size(0), 4u);
+  BOOST_CHECK_EQUAL(table[0][3], 10u);
+  BOOST_CHECK_EQUAL(table[1][2], 22u);
+  BOOST_CHECK_EQUAL(table.values().size(), 7u);
+
+  table.resize(1);
+  BOOST_CHECK_EQUAL(table.values().size(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE ( CDynTable_test_bool )
+{
+  CDynTable<bool> table ("table");
+
+  // rows are ranges of references to the values, also for bool
+  std::vector<Uint> row_sizes = list_of(2)(1);
+  table.allocate(row_sizes);
+  CDynTable<bool>::Row row = table[0];
+  row[1] = true;
+  boost_foreach(CDynTable<bool>::ValueT& value, table[1])
+    value = true;
+  BOOST_CHECK(!table[0][0]);
+  BOOST_CHECK(table[0][1]);
+  BOOST_CHECK(table[1][0]);
+  BOOST_CHECK_EQUAL(&table[1][0], &table.values()[2]);
+
+  CDynTable<bool>::Buffer buffer = table.create_buffer();
+  std::vector<bool> new_row = list_of(false)(true)(true);
+  buffer.add_row(new_row);
+  buffer.flush();
+  BOOST_CHECK_EQUAL(table.size(), 3u);
+  BOOST_CHECK(table[2][2]);
+
+  std::stringstream out;
+  out << table[2];
+  BOOST_CHECK_EQUAL(out.str(), "0 1 1");
+}
+
 BOOST_AUTO_TEST_CASE ( Mesh_test )
 {
   CRoot::Ptr root = CRoot::create("root");
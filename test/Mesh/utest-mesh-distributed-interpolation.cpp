@@ -0,0 +1,111 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for CF::Mesh::CDistributedInterpolator"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/Log.hpp"
+#include "Common/MPI/PE.hpp"
+
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CMeshGenerator.hpp"
+#include "Mesh/CDistributedInterpolator.hpp"
+#include "Mesh/Field.hpp"
+#include "Mesh/Geometry.hpp"
+
+using namespace CF;
+using namespace CF::Mesh;
+using namespace CF::Common;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct DistributedInterpolatorTests_Fixture
+{
+  /// common setup for each test case
+  DistributedInterpolatorTests_Fixture()
+  {
+    m_argc = boost::unit_test::framework::master_test_suite().argc;
+    m_argv = boost::unit_test::framework::master_test_suite().argv;
+  }
+
+  /// Generate a partitioned rectangle, with a linear field "f" on its nodes
+  CMesh& generate(const std::string& name, const Uint nb_cells_x, const Uint nb_cells_y)
+  {
+    CMeshGenerator::Ptr generator = build_component_abstract_type<CMeshGenerator>("CF.Mesh.CSimpleMeshGenerator",name+"_generator");
+    Core::instance().root().add_component(generator);
+    generator->configure_option("parent",Core::instance().root().uri());
+    generator->configure_option("name",name);
+    std::vector<Uint> nb_cells(2);
+    nb_cells[0] = nb_cells_x;
+    nb_cells[1] = nb_cells_y;
+    generator->configure_option("nb_cells",nb_cells);
+    generator->configure_option("lengths",std::vector<Real>(2,10.));
+    generator->execute();
+
+    CMesh& mesh = Core::instance().root().get_child(name).as_type<CMesh>();
+    mesh.geometry().create_field("f");
+    return mesh;
+  }
+
+  /// common values accessed by all tests goes here
+  int    m_argc;
+  char** m_argv;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( DistributedInterpolatorTests_TestSuite, DistributedInterpolatorTests_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( init_mpi )
+{
+  Comm::PE::instance().init(m_argc,m_argv);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( interpolate_linear_field )
+{
+  // the partitions of both meshes are different, so that target points are found on other processes
+  CMesh& source = generate("source", 5, 5);
+  CMesh& target = generate("target", 7, 4);
+
+  Field& source_f = source.geometry().field("f");
+  const Field& source_coords = source.geometry().coordinates();
+  for (Uint n=0; n<source_f.size(); ++n)
+    source_f[n][0] = 2.*source_coords[n][XX] + 3.*source_coords[n][YY] + 1.;
+
+  Field& target_f = target.geometry().field("f");
+  for (Uint n=0; n<target_f.size(); ++n)
+    target_f[n][0] = -1.;
+
+  CDistributedInterpolator::Ptr interpolator = Core::instance().root().create_component_ptr<CDistributedInterpolator>("interpolator");
+  interpolator->construct_internal_storage(source);
+  interpolator->interpolate_field_from_to(source_f, target_f);
+
+  // bilinear shape functions reproduce a linear field exactly
+  const Field& target_coords = target.geometry().coordinates();
+  for (Uint n=0; n<target_f.size(); ++n)
+    BOOST_CHECK_CLOSE( target_f[n][0] , 2.*target_coords[n][XX] + 3.*target_coords[n][YY] + 1. , 1e-8 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( finalize_mpi )
+{
+  Comm::PE::instance().finalize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
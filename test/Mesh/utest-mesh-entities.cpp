@@ -0,0 +1,91 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Tests Mesh::CEntities"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/EventHandler.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/Foreach.hpp"
+#include "Common/OptionURI.hpp"
+#include "Common/XML/SignalOptions.hpp"
+
+#include "Mesh/CElements.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CSimpleMeshGenerator.hpp"
+#include "Mesh/CTable.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Common::XML;
+using namespace CF::Mesh;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct TestCEntities_Fixture
+{
+  /// common values accessed by all tests goes here
+  static CMesh::Ptr mesh;
+};
+
+CMesh::Ptr TestCEntities_Fixture::mesh = Core::instance().root().create_component_ptr<CMesh>("mesh");
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( TestCEntities_TestSuite, TestCEntities_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( geometry_cache )
+{
+  CSimpleMeshGenerator::create_rectangle(*mesh, 4., 3., 4, 3);
+
+  boost_foreach(CElements& elements, find_components_recursively<CElements>(mesh->topology()))
+  {
+    bool created = false;
+    CTable<Real>& cache = CEntities::geometry_cache(elements,"geometry_cache_test",3u,created);
+    BOOST_CHECK( created );
+    BOOST_CHECK( cache.has_tag(Mesh::Tags::geometry_cache()) );
+    BOOST_CHECK_EQUAL( cache.size() , elements.size() );
+    BOOST_CHECK_EQUAL( cache.row_size() , 3u );
+    cache[0][0] = 1.;
+
+    // the same table is returned as long as it matches the elements
+    BOOST_CHECK_EQUAL( &CEntities::geometry_cache(elements,"geometry_cache_test",3u,created) , &cache );
+    BOOST_CHECK( !created );
+    BOOST_CHECK_EQUAL( cache[0][0] , 1. );
+
+    // another row size replaces the table
+    CTable<Real>& resized_cache = CEntities::geometry_cache(elements,"geometry_cache_test",2u,created);
+    BOOST_CHECK( created );
+    BOOST_CHECK_EQUAL( resized_cache.size() , elements.size() );
+    BOOST_CHECK_EQUAL( resized_cache.row_size() , 2u );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( invalidate_on_mesh_changed )
+{
+  SignalOptions options;
+  options.add_option< OptionURI >("mesh_uri", mesh->uri());
+  SignalArgs args = options.create_frame();
+  Core::instance().event_handler().raise_event( "mesh_changed", args);
+
+  boost_foreach(CElements& elements, find_components_recursively<CElements>(mesh->topology()))
+    BOOST_CHECK( is_null(find_component_ptr_with_tag<CTable<Real> >(elements,Mesh::Tags::geometry_cache())) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
@@ -250,6 +250,78 @@ BOOST_AUTO_TEST_CASE( FieldOperators )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( FieldLayout )
+{
+  FieldGroup& cells_P0 = m_mesh->get_child("cells_P0").as_type<FieldGroup>();
+  Field& state = cells_P0.create_field("state","rho[s],V[v],p[s]");
+  const Uint nb_rows = state.size();
+  const Uint row_size = state.row_size();
+  BOOST_CHECK_EQUAL( state.layout() , Field::ROW_MAJOR );
+
+  for (Uint i=0; i<nb_rows; ++i)
+    for (Uint j=0; j<row_size; ++j)
+      state[i][j] = 10.*i + j;
+
+  // the values are kept, and the rows are still accessible
+  state.set_layout(Field::VARIABLE_MAJOR);
+  BOOST_CHECK_EQUAL( state.layout() , Field::VARIABLE_MAJOR );
+  BOOST_CHECK( state.has_contiguous_columns() );
+  for (Uint i=0; i<nb_rows; ++i)
+    for (Uint j=0; j<row_size; ++j)
+      BOOST_CHECK_EQUAL( state[i][j] , 10.*i + j );
+
+  // every column is contiguous
+  BOOST_CHECK_EQUAL( &state[1][2] - &state[0][2] , 1 );
+  BOOST_CHECK_EQUAL( state.column(2)[1] , 12. );
+  BOOST_CHECK_EQUAL( state.variable(state.var_number("V")).cols() , state.var_length("V") );
+  BOOST_CHECK_EQUAL( state.variable(state.var_number("V"))(1,1) , 12. );
+
+  // the layout is kept when resizing, and operators mix both layouts
+  Field& state_copy = cells_P0.create_field("state_copy",state.descriptor().description());
+  state_copy.descriptor().prefix_variable_names("copy_");
+  state_copy = state;
+  state_copy += state;
+  BOOST_CHECK_EQUAL( state_copy[1][2] , 24. );
+  state -= state_copy;
+  BOOST_CHECK_EQUAL( state[1][2] , -12. );
+
+  state.resize(nb_rows+1);
+  BOOST_CHECK_EQUAL( state.layout() , Field::VARIABLE_MAJOR );
+  BOOST_CHECK_EQUAL( state[1][2] , -12. );
+
+  state.set_layout(Field::ROW_MAJOR);
+  BOOST_CHECK_EQUAL( &state[0][3] - &state[0][2] , 1 );
+  BOOST_CHECK_EQUAL( state[1][2] , -12. );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( FieldGroupLayout )
+{
+  FieldGroup& cells_P0 = m_mesh->get_child("cells_P0").as_type<FieldGroup>();
+  Field& existing = cells_P0.create_field("existing","rho[s],V[v],p[s]");
+  for (Uint i=0; i<existing.size(); ++i)
+    for (Uint j=0; j<existing.row_size(); ++j)
+      existing[i][j] = 10.*i + j;
+
+  // the fields of the group are stored in the layout of the group, keeping their values
+  cells_P0.configure_option("layout",std::string("variable_major"));
+  BOOST_CHECK_EQUAL( existing.layout() , Field::VARIABLE_MAJOR );
+  BOOST_CHECK_EQUAL( existing[1][2] , 12. );
+  BOOST_CHECK_EQUAL( existing.column(2)[1] , 12. );
+
+  Field& created = cells_P0.create_field("created","rho[s],V[v],p[s]");
+  BOOST_CHECK_EQUAL( created.layout() , Field::VARIABLE_MAJOR );
+  BOOST_CHECK_EQUAL( &created[1][0] - &created[0][0] , 1 );
+
+  cells_P0.configure_option("layout",std::string("row_major"));
+  BOOST_CHECK_EQUAL( existing.layout() , Field::ROW_MAJOR );
+  BOOST_CHECK_EQUAL( created.layout() , Field::ROW_MAJOR );
+  BOOST_CHECK_EQUAL( existing[1][2] , 12. );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE_END()
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -12,6 +12,7 @@
 #include <boost/assign/std/vector.hpp>
 
 #include "Common/Core.hpp"
+#include "Common/CEnv.hpp"
 #include "Common/Foreach.hpp"
 #include "Common/Log.hpp"
  
@@ -26,6 +27,7 @@
 #include "Mesh/Geometry.hpp"
 #include "Mesh/CMeshGenerator.hpp"
 #include "Mesh/COcttree.hpp"
+#include "Mesh/CBoundingBoxTree.hpp"
 #include "Mesh/CStencilComputerOcttree.hpp"
 
 using namespace boost;
@@ -133,6 +135,64 @@ BOOST_AUTO_TEST_CASE( Octtree_creation )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( BoundingBoxTree_find_element )
+{
+  CBoundingBoxTree::Ptr tree = Core::instance().root().create_component_ptr<CBoundingBoxTree>("bounding_box_tree");
+  tree->configure_option("mesh", find_component<CMesh>(Core::instance().root()).uri() );
+  tree->configure_option("nb_elems_per_leaf", 2u );
+  tree->create_tree();
+
+  CElements::ConstPtr elements;
+  Uint idx(0);
+  RealVector2 coord;
+
+  coord << 1. , 1. ;
+  boost::tie(elements,idx) = tree->find_element(coord);
+  BOOST_CHECK(is_not_null(elements));
+  BOOST_CHECK_EQUAL(idx,0u);
+
+  coord << 3. , 1. ;
+  boost::tie(elements,idx) = tree->find_element(coord);
+  BOOST_CHECK_EQUAL(idx,1u);
+
+  coord << 1. , 3. ;
+  boost::tie(elements,idx) = tree->find_element(coord);
+  BOOST_CHECK_EQUAL(idx,5u);
+
+  // on the corner shared by 4 elements, any of them will do
+  coord << 4. , 4. ;
+  boost::tie(elements,idx) = tree->find_element(coord);
+  BOOST_CHECK(is_not_null(elements));
+
+  coord << 11. , 1. ;
+  boost::tie(elements,idx) = tree->find_element(coord);
+  BOOST_CHECK(is_null(elements));
+
+  // batch query, by several threads, of the centres of all cells and one point outside
+  Core::instance().environment().configure_option("nb_threads", 3u );
+  RealMatrix points(26,2);
+  for (Uint j=0; j<5; ++j)
+    for (Uint i=0; i<5; ++i)
+      points.row(5*j+i) << 2.*i+1. , 2.*j+1. ;
+  points.row(25) << -1. , 5. ;
+
+  std::vector<Uint> unified_elems;
+  tree->find_unified_elements(points,unified_elems);
+  BOOST_CHECK_EQUAL(unified_elems.size(), 26u);
+  Component::ConstPtr component;
+  for (Uint p=0; p<25; ++p)
+  {
+    BOOST_CHECK(unified_elems[p] != CBoundingBoxTree::not_found());
+    boost::tie(component,idx) = tree->unified_elements().location(unified_elems[p]);
+    BOOST_CHECK_EQUAL(idx,p);
+  }
+  BOOST_CHECK_EQUAL(unified_elems[25], CBoundingBoxTree::not_found());
+
+  Core::instance().environment().configure_option("nb_threads", 1u );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE_END()
 
 ////////////////////////////////////////////////////////////////////////////////
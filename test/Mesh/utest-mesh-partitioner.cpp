@@ -0,0 +1,176 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for CF::Mesh::CMeshPartitioner"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/Foreach.hpp"
+#include "Common/MPI/PE.hpp"
+
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CMeshGenerator.hpp"
+#include "Mesh/CMeshPartitioner.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/Geometry.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Mesh;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Partitioner without graph library, giving access to the global index lookups
+class TestPartitioner : public CMeshPartitioner
+{
+public:
+
+  typedef boost::shared_ptr<TestPartitioner> Ptr;
+
+  TestPartitioner(const std::string& name) : CMeshPartitioner(name) {}
+
+  static std::string type_name() { return "TestPartitioner"; }
+
+  virtual void build_graph() {}
+
+  virtual void partition_graph() {}
+
+  using CMeshPartitioner::part_of_obj;
+  using CMeshPartitioner::is_node;
+  using CMeshPartitioner::is_elem;
+  using CMeshPartitioner::location;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct PartitionerTests_Fixture
+{
+  /// common setup for each test case
+  PartitionerTests_Fixture()
+  {
+    m_argc = boost::unit_test::framework::master_test_suite().argc;
+    m_argv = boost::unit_test::framework::master_test_suite().argv;
+  }
+
+  /// Part of a global object index, walking the part boundaries as the partitioner used to
+  Uint linear_part_of_obj(const std::vector<Uint>& end_id_per_part, const Uint obj)
+  {
+    for (Uint p=0; p<end_id_per_part.size(); ++p)
+    {
+      if ( obj < end_id_per_part[p])
+        return p;
+    }
+    return end_id_per_part.size();
+  }
+
+  /// common values accessed by all tests goes here
+  int    m_argc;
+  char** m_argv;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( PartitionerTests_TestSuite, PartitionerTests_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( init_mpi )
+{
+  Core::instance().initiate(m_argc,m_argv);
+  Comm::PE::instance().init(m_argc,m_argv);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( global_index_lookup )
+{
+  CMeshGenerator::Ptr meshgenerator = build_component_abstract_type<CMeshGenerator>("CF.Mesh.CSimpleMeshGenerator","generator");
+  meshgenerator->configure_option("parent",URI("//Root"));
+  meshgenerator->configure_option("name",std::string("rect"));
+  std::vector<Uint> nb_cells(2,7u);
+  std::vector<Real> lengths(2,7.);
+  meshgenerator->configure_option("nb_cells",nb_cells);
+  meshgenerator->configure_option("lengths",lengths);
+  meshgenerator->execute();
+  CMesh& mesh = Core::instance().root().get_child("rect").as_type<CMesh>();
+
+  build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.CGlobalNumbering","glb_numbering")->transform(mesh);
+
+  TestPartitioner::Ptr partitioner = allocate_component<TestPartitioner>("partitioner");
+  partitioner->initialize(mesh);
+
+  // part boundaries, as the partitioner computes them
+  Geometry& nodes = mesh.geometry();
+  Uint nb_owned_obj = 0;
+  for (Uint n=0; n<nodes.size(); ++n)
+  {
+    if (!nodes.is_ghost(n))
+      ++nb_owned_obj;
+  }
+  boost_foreach(CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+    nb_owned_obj += elements.size();
+
+  std::vector<Uint> nb_obj_per_part(Comm::PE::instance().size());
+  Comm::PE::instance().all_gather(nb_owned_obj, nb_obj_per_part);
+  std::vector<Uint> end_id_per_part(nb_obj_per_part.size());
+  Uint end_id = 0;
+  for (Uint p=0; p<nb_obj_per_part.size(); ++p)
+  {
+    end_id += nb_obj_per_part[p];
+    end_id_per_part[p] = end_id;
+  }
+
+  // the binary search agrees with the linear one for every object, including the part boundaries
+  for (Uint obj=0; obj<end_id; ++obj)
+    BOOST_CHECK_EQUAL(partitioner->part_of_obj(obj), linear_part_of_obj(end_id_per_part,obj));
+
+  // owned nodes are found through the direct index, ghost nodes through the global to local map
+  Component::Ptr comp;
+  Uint idx;
+  for (Uint n=0; n<nodes.size(); ++n)
+  {
+    const Uint glb_obj = nodes.glb_idx()[n];
+    boost::tie(comp,idx) = partitioner->location(glb_obj);
+    BOOST_CHECK(comp == nodes.self());
+    BOOST_CHECK_EQUAL(idx, n);
+    if (!nodes.is_ghost(n))
+    {
+      BOOST_CHECK_EQUAL(partitioner->part_of_obj(glb_obj), Comm::PE::instance().rank());
+      BOOST_CHECK(partitioner->is_node(glb_obj));
+    }
+  }
+
+  boost_foreach(CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+  {
+    for (Uint e=0; e<elements.size(); ++e)
+    {
+      const Uint glb_obj = elements.glb_idx()[e];
+      boost::tie(comp,idx) = partitioner->location(glb_obj);
+      BOOST_CHECK(comp == elements.self());
+      BOOST_CHECK_EQUAL(idx, e);
+      BOOST_CHECK_EQUAL(partitioner->part_of_obj(glb_obj), Comm::PE::instance().rank());
+      BOOST_CHECK(partitioner->is_elem(glb_obj));
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( finalize_mpi )
+{
+  Comm::PE::instance().finalize();
+  Core::instance().terminate();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
@@ -25,8 +25,13 @@
 #include "Common/FindComponents.hpp"
 
 #include "Mesh/GeoShape.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/Geometry.hpp"
 
 #include "Mesh/SF/Types.hpp"
+#include "Mesh/SF/ElementTypeVisitor.hpp"
 #include "Mesh/Tetra3D.hpp"
 
 using namespace CF;
@@ -301,6 +306,28 @@ struct CheckGradientX
 
 ////////////////////////////////////////////////////////////////////////////////
 
+/// Sums the volumes of the elements, using the fixed size types of the shape function
+struct VolumeVisitor
+{
+  VolumeVisitor(const CElements& elements_in) : elements(elements_in), volume(0.) {}
+
+  template<typename SF>
+  void apply()
+  {
+    typename SF::NodeMatrixT nodes;
+    for(Uint elem = 0; elem != elements.size(); ++elem)
+    {
+      elements.put_coordinates(nodes, elem);
+      volume += SF::volume(nodes);
+    }
+  }
+
+  const CElements& elements;
+  Real volume;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_FIXTURE_TEST_SUITE( VolumeSFSuite, VolumeSFFixture )
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -331,6 +358,53 @@ BOOST_AUTO_TEST_CASE( TestGradientX )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( VisitElementType )
+{
+  CMesh& mesh = Core::instance().root().create_component<CMesh>("visited_mesh");
+  mesh.initialize_nodes(5, 2);
+  Geometry& geometry = mesh.geometry();
+  CTable<Real>& coords = geometry.coordinates();
+  coords[0][XX] = 0.; coords[0][YY] = 0.;
+  coords[1][XX] = 1.; coords[1][YY] = 0.;
+  coords[2][XX] = 1.; coords[2][YY] = 1.;
+  coords[3][XX] = 0.; coords[3][YY] = 1.;
+  coords[4][XX] = 2.; coords[4][YY] = 0.;
+
+  CElements& quads = mesh.topology().create_region("quads").create_elements("CF.Mesh.SF.Quad2DLagrangeP1", geometry);
+  quads.node_connectivity().resize(1);
+  quads.node_connectivity()[0][0] = 0;
+  quads.node_connectivity()[0][1] = 1;
+  quads.node_connectivity()[0][2] = 2;
+  quads.node_connectivity()[0][3] = 3;
+
+  CElements& triags = mesh.topology().create_region("triags").create_elements("CF.Mesh.SF.Triag2DLagrangeP1", geometry);
+  triags.node_connectivity().resize(1);
+  triags.node_connectivity()[0][0] = 1;
+  triags.node_connectivity()[0][1] = 4;
+  triags.node_connectivity()[0][2] = 2;
+
+  VolumeVisitor quads_visitor(quads);
+  BOOST_CHECK(visit_element_type<Types>(quads.element_type(), quads_visitor));
+  BOOST_CHECK_CLOSE(quads_visitor.volume, 1., 1e-10);
+
+  VolumeVisitor triags_visitor(triags);
+  BOOST_CHECK(visit_element_type<Types>(triags.element_type(), triags_visitor));
+  BOOST_CHECK_CLOSE(triags_visitor.volume, 0.5, 1e-10);
+
+  // the fixed size coordinates are the same as the dynamic ones
+  Triag2DLagrangeP1::NodeMatrixT fixed_nodes;
+  triags.put_coordinates(fixed_nodes, 0);
+  const RealMatrix dynamic_nodes = triags.get_coordinates(0);
+  BOOST_CHECK(fixed_nodes == dynamic_nodes);
+
+  // types that are not in the list are not visited
+  VolumeVisitor unvisited(triags);
+  BOOST_CHECK(!visit_element_type< boost::mpl::vector<Quad2DLagrangeP1> >(triags.element_type(), unvisited));
+  BOOST_CHECK_EQUAL(unvisited.volume, 0.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE_END()
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -166,7 +166,7 @@ BOOST_AUTO_TEST_CASE ( test_CSetFieldValue )
 
   BOOST_CHECK(true);
 
-  boost_foreach(CCells& cells, find_components<CCells>(mesh->topology()))
+  boost_foreach(CCells& cells, find_components_recursively<CCells>(mesh->topology()))
     cells.create_space("cells_P0","CF.Mesh.SF.SF"+cells.element_type().shape_name()+"LagrangeP0");
 
   FieldGroup& cells_P0 = mesh->create_field_group("cells_P0",FieldGroup::Basis::CELL_BASED);
@@ -174,10 +174,10 @@ BOOST_AUTO_TEST_CASE ( test_CSetFieldValue )
 
 
 
-  boost_foreach(CEntities& faces, find_components_with_tag<CEntities>(mesh->topology(),Mesh::Tags::face_entity()))
+  boost_foreach(CEntities& faces, find_components_recursively_with_tag<CEntities>(mesh->topology(),Mesh::Tags::face_entity()))
     faces.create_space("faces_P0","CF.Mesh.SF.SF"+faces.element_type().shape_name()+"LagrangeP0");
 
-  FieldGroup& faces_P0 = mesh->create_field_group("cells_P0",FieldGroup::Basis::CELL_BASED);
+  FieldGroup& faces_P0 = mesh->create_field_group("faces_P0",FieldGroup::Basis::FACE_BASED);
   Field& areas = faces_P0.create_field("area");
 
 
@@ -192,7 +192,7 @@ BOOST_AUTO_TEST_CASE ( test_CSetFieldValue )
   BOOST_CHECK(true);
   compute_volume->configure_option("elements",elems.uri());
   BOOST_CHECK(true);
-  compute_volume->configure_option("LoopIndex",12u);
+  compute_volume->configure_option("loop_index",12u);
   BOOST_CHECK(true);
   compute_volume->execute();
   BOOST_CHECK(true);
@@ -254,6 +254,60 @@ BOOST_AUTO_TEST_CASE ( test_CForAllElementsT )
 
   compute_all_cell_volumes->execute();
 
+  // same loop with threads, visiting the elements colour by colour
+
+  Field& threaded_field = mesh->get_child("cells_P0").as_type<FieldGroup>().create_field("test_CForAllElementsT_threaded","var[1]");
+
+  CForAllElementsT<CComputeVolume>::Ptr threaded_cell_volumes =
+    root.create_component_ptr< CForAllElementsT<CComputeVolume> > ("threaded_cell_volumes");
+  threaded_cell_volumes->configure_option("regions",topology);
+  threaded_cell_volumes->action().configure_option("volume",threaded_field.uri());
+  Core::instance().environment().configure_option("nb_threads",4u);
+  threaded_cell_volumes->execute();
+
+  for (Uint i=0; i<field.size(); ++i)
+    BOOST_CHECK_EQUAL( threaded_field[i][0] , field[i][0] );
+
+  // the copies of the action executed by the other threads follow the options of the action
+  Field& threaded_field_2 = mesh->get_child("cells_P0").as_type<FieldGroup>().create_field("test_CForAllElementsT_threaded_2","var[1]");
+  threaded_cell_volumes->action().configure_option("volume",threaded_field_2.uri());
+  threaded_cell_volumes->execute();
+
+  for (Uint i=0; i<field.size(); ++i)
+    BOOST_CHECK_EQUAL( threaded_field_2[i][0] , field[i][0] );
+
+  // with first-touch placement every thread visits the elements of its static share of the rows
+  Field& threaded_field_3 = mesh->get_child("cells_P0").as_type<FieldGroup>().create_field("test_CForAllElementsT_threaded_3","var[1]");
+  Core::instance().environment().configure_option("numa_policy",std::string("first_touch"));
+  threaded_cell_volumes->action().configure_option("volume",threaded_field_3.uri());
+  threaded_cell_volumes->execute();
+  Core::instance().environment().configure_option("numa_policy",std::string("none"));
+  Core::instance().environment().configure_option("nb_threads",1u);
+
+  for (Uint i=0; i<field.size(); ++i)
+    BOOST_CHECK_EQUAL( threaded_field_3[i][0] , field[i][0] );
+
+  // elements of the same colour never share a node
+  boost_foreach(CElements& elements, find_components_recursively<CElements>(mesh->topology()))
+  {
+    const CList<Uint>& colouring = Mesh::Actions::CColourElements::colouring(elements);
+    const Uint nb_colours = colouring.properties().value<Uint>("nb_colours");
+    BOOST_CHECK_EQUAL( colouring[nb_colours] , elements.size() );
+
+    std::vector<Uint> node_colour(elements.geometry().size(),nb_colours);
+    for (Uint colour=0; colour<nb_colours; ++colour)
+    {
+      for (Uint i=colouring[colour]; i<colouring[colour+1]; ++i)
+      {
+        boost_foreach(const Uint node, elements.get_nodes(colouring[nb_colours+1+i]))
+        {
+          BOOST_CHECK( node_colour[node] != colour );
+          node_colour[node] = colour;
+        }
+      }
+    }
+  }
+
   std::vector<Field::Ptr> fields;
   fields.push_back(field.as_ptr<Field>());
   CMeshWriter::Ptr gmsh_writer = build_component_abstract_type<CMeshWriter>("CF.Mesh.Gmsh.CWriter","meshwriter");
@@ -0,0 +1,173 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for CF::Solver::CEigenLSS distributed over several processes"
+
+#include <cmath>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/Foreach.hpp"
+#include "Common/MPI/PE.hpp"
+
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CMeshGenerator.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CCells.hpp"
+#include "Mesh/Geometry.hpp"
+
+#include "Solver/CEigenLSS.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Mesh;
+using namespace CF::Solver;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct DistributedLSSFixture
+{
+  /// common setup for each test case
+  DistributedLSSFixture()
+  {
+    m_argc = boost::unit_test::framework::master_test_suite().argc;
+    m_argv = boost::unit_test::framework::master_test_suite().argv;
+  }
+
+  /// Line of nb_cells unit cells, partitioned over the processes. The node at x has global index x.
+  CMesh& generate_line(const std::string& name, const Uint nb_cells)
+  {
+    CMeshGenerator::Ptr generator = build_component_abstract_type<CMeshGenerator>("CF.Mesh.CSimpleMeshGenerator",name+"_generator");
+    Core::instance().root().add_component(generator);
+    generator->configure_option("parent",Core::instance().root().uri());
+    generator->configure_option("name",name);
+    generator->configure_option("nb_cells",std::vector<Uint>(1,nb_cells));
+    generator->configure_option("lengths",std::vector<Real>(1,static_cast<Real>(nb_cells)));
+    generator->execute();
+
+    CMesh& mesh = Core::instance().root().get_child(name).as_type<CMesh>();
+    Geometry& geometry = mesh.geometry();
+    for(Uint node = 0; node != geometry.size(); ++node)
+      geometry.glb_idx()[node] = static_cast<Uint>(std::floor(geometry.coordinates()[node][XX] + 0.5));
+    return mesh;
+  }
+
+  /// Assemble the Laplacian of every dof on the local cells, with a flux dof+1 at the end of the line
+  /// and the first node fixed, so that dof i of the node at x has the solution (i+1)*x
+  void assemble_laplacian(CEigenLSS& lss, const CMesh& mesh, const Uint nb_cells, const Uint nb_dofs)
+  {
+    const Geometry& geometry = mesh.geometry();
+    const CTable<Uint>& connectivity = find_component_recursively<CCells>(mesh.topology()).node_connectivity();
+
+    lss.set_zero();
+    for(Uint elem = 0; elem != connectivity.size(); ++elem)
+    {
+      const Uint* offsets = lss.element_offsets(connectivity, elem);
+      BOOST_REQUIRE(offsets);
+      for(Uint i = 0; i != 2; ++i)
+        for(Uint j = 0; j != 2; ++j)
+          for(Uint dof = 0; dof != nb_dofs; ++dof)
+            lss.at_offset(connectivity[elem][i]*nb_dofs + dof, offsets[2*i + j] + dof) += i == j ? 1. : -1.;
+    }
+
+    for(Uint node = 0; node != geometry.size(); ++node)
+    {
+      // the flux is added once, by the owner, since the RHS is summed over the processes
+      if(geometry.glb_idx()[node] == nb_cells && !geometry.is_ghost(node))
+        for(Uint dof = 0; dof != nb_dofs; ++dof)
+          lss.rhs()[node*nb_dofs + dof] = static_cast<Real>(dof+1);
+
+      // every process holding the first node sets the condition
+      if(geometry.glb_idx()[node] == 0)
+        for(Uint dof = 0; dof != nb_dofs; ++dof)
+          lss.set_dirichlet_bc(node*nb_dofs + dof, 0.);
+    }
+  }
+
+  /// common values accessed by all tests goes here
+  int    m_argc;
+  char** m_argv;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( DistributedLSSSuite, DistributedLSSFixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( init_mpi )
+{
+  Comm::PE::instance().init(m_argc,m_argv);
+  BOOST_CHECK_EQUAL(Comm::PE::instance().size(), 2u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( solve_distributed )
+{
+  const Uint nb_cells = 8;
+  CMesh& mesh = generate_line("line", nb_cells);
+  const Geometry& geometry = mesh.geometry();
+
+  CEigenLSS& lss = Core::instance().root().create_component<CEigenLSS>("LSS");
+  lss.resize(mesh, 1);
+
+  BOOST_CHECK(lss.is_distributed());
+  BOOST_CHECK(lss.has_pattern());
+  BOOST_CHECK_EQUAL(lss.size(), geometry.size());
+
+  assemble_laplacian(lss, mesh, nb_cells, 1);
+  lss.solve();
+
+  // the solution is available for all local nodes, including the ghosts
+  for(Uint node = 0; node != geometry.size(); ++node)
+    BOOST_CHECK_SMALL(lss.solution()[node] - static_cast<Real>(geometry.glb_idx()[node]), 1e-8);
+
+  // the second solve reuses the distributed matrix
+  assemble_laplacian(lss, mesh, nb_cells, 1);
+  lss.solve();
+  for(Uint node = 0; node != geometry.size(); ++node)
+    BOOST_CHECK_SMALL(lss.solution()[node] - static_cast<Real>(geometry.glb_idx()[node]), 1e-8);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( solve_distributed_blocks )
+{
+  const Uint nb_cells = 8;
+  const Uint nb_dofs = 2;
+  CMesh& mesh = Core::instance().root().get_child("line").as_type<CMesh>();
+  const Geometry& geometry = mesh.geometry();
+
+  // rows are numbered globally as glb_idx*nb_dofs + dof
+  CEigenLSS& lss = Core::instance().root().get_child("LSS").as_type<CEigenLSS>();
+  lss.resize(mesh, nb_dofs);
+  BOOST_CHECK_EQUAL(lss.size(), geometry.size()*nb_dofs);
+
+  assemble_laplacian(lss, mesh, nb_cells, nb_dofs);
+  lss.solve();
+
+  for(Uint node = 0; node != geometry.size(); ++node)
+    for(Uint dof = 0; dof != nb_dofs; ++dof)
+      BOOST_CHECK_SMALL(lss.solution()[node*nb_dofs + dof] - static_cast<Real>((dof+1)*geometry.glb_idx()[node]), 1e-8);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( finalize_mpi )
+{
+  Comm::PE::instance().finalize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,185 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for CF::Solver::CEigenLSS"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/CAction.hpp"
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/Foreach.hpp"
+
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CCells.hpp"
+#include "Mesh/Geometry.hpp"
+
+#include "Solver/CEigenLSS.hpp"
+
+#include "Tools/MeshGeneration/MeshGeneration.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Mesh;
+using namespace CF::Solver;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Assembles the Laplacian on a line mesh, with a unit flux at the end, for the matrix free system
+class LineLaplacian : public CAction
+{
+public:
+  typedef boost::shared_ptr<LineLaplacian> Ptr;
+  typedef boost::shared_ptr<LineLaplacian const> ConstPtr;
+
+  LineLaplacian(const std::string& name) : CAction(name), lss(0), mesh(0) {}
+
+  static std::string type_name() { return "LineLaplacian"; }
+
+  virtual void execute()
+  {
+    const CTable<Uint>& connectivity = find_component_recursively<CCells>(mesh->topology()).node_connectivity();
+    for(Uint elem = 0; elem != connectivity.size(); ++elem)
+      for(Uint i = 0; i != 2; ++i)
+        for(Uint j = 0; j != 2; ++j)
+          lss->add_matrix_free(connectivity[elem][i], connectivity[elem][j], i == j ? 1. : -1.);
+    lss->rhs()[lss->size() - 1] = 1.;
+  }
+
+  CEigenLSS* lss;
+  const CMesh* mesh;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( EigenLSSSuite )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( MeshPattern )
+{
+  CRoot& root = Core::instance().root();
+  CMesh& mesh = root.create_component<CMesh>("line");
+  Tools::MeshGeneration::create_line(mesh, 1., 4);
+
+  const Uint nb_dofs = 2;
+  const Uint nb_nodes = mesh.geometry().size();
+  CEigenLSS& lss = root.create_component<CEigenLSS>("LSS");
+  lss.resize(mesh, nb_dofs);
+
+  BOOST_CHECK(lss.has_pattern());
+  BOOST_CHECK_EQUAL(lss.size(), nb_nodes*nb_dofs);
+
+  // Nodes of the same element are coupled, for all dofs
+  lss.at(0, 0) = 1.;
+  lss.at(1, 2*nb_dofs+1) = 2.;
+  BOOST_CHECK_EQUAL(lss.at(0, 0), 1.);
+  BOOST_CHECK_EQUAL(lss.at(1, 2*nb_dofs+1), 2.);
+
+  // Nodes 0 and 2 are not
+  BOOST_CHECK_THROW(lss.at(0, 2*nb_dofs), ValueNotFound);
+
+  // Element offsets point to the same entries as at()
+  const CCells& cells = find_component_recursively<CCells>(mesh.topology());
+  const CTable<Uint>& connectivity = cells.node_connectivity();
+  const Uint nb_elem_nodes = connectivity.row_size();
+  for(Uint elem = 0; elem != connectivity.size(); ++elem)
+  {
+    const Uint* offsets = lss.element_offsets(connectivity, elem);
+    BOOST_REQUIRE(offsets);
+    for(Uint i = 0; i != nb_elem_nodes; ++i)
+      for(Uint j = 0; j != nb_elem_nodes; ++j)
+        for(Uint i_dof = 0; i_dof != nb_dofs; ++i_dof)
+          for(Uint j_dof = 0; j_dof != nb_dofs; ++j_dof)
+          {
+            const Uint row = connectivity[elem][i]*nb_dofs + i_dof;
+            const Uint col = connectivity[elem][j]*nb_dofs + j_dof;
+            BOOST_CHECK_EQUAL(&lss.at_offset(row, offsets[i*nb_elem_nodes + j] + j_dof), &lss.at(row, col));
+          }
+  }
+
+  // Resizing for the same mesh keeps the pattern and the values
+  lss.resize(mesh, nb_dofs);
+  BOOST_CHECK_EQUAL(lss.at(1, 2*nb_dofs+1), 2.);
+
+  lss.set_zero();
+  BOOST_CHECK_EQUAL(lss.at(1, 2*nb_dofs+1), 0.);
+}
+
+BOOST_AUTO_TEST_CASE( SolvePattern )
+{
+  CRoot& root = Core::instance().root();
+  CMesh& mesh = root.get_child("line").as_type<CMesh>();
+  CEigenLSS& lss = root.get_child("LSS").as_type<CEigenLSS>();
+
+  // Laplacian on the line, with the first node fixed: solution is linear
+  const Uint nb_dofs = 1;
+  lss.resize(mesh, nb_dofs);
+  const CCells& cells = find_component_recursively<CCells>(mesh.topology());
+  const CTable<Uint>& connectivity = cells.node_connectivity();
+  for(Uint elem = 0; elem != connectivity.size(); ++elem)
+  {
+    const Uint* offsets = lss.element_offsets(connectivity, elem);
+    for(Uint i = 0; i != 2; ++i)
+      for(Uint j = 0; j != 2; ++j)
+        lss.at_offset(connectivity[elem][i], offsets[2*i + j]) += i == j ? 1. : -1.;
+  }
+
+  const Uint last = lss.size() - 1;
+  lss.rhs()[last] = 1.;
+  lss.set_dirichlet_bc(0, 0.);
+
+  lss.solve();
+
+  for(Uint i = 0; i != lss.size(); ++i)
+    BOOST_CHECK_SMALL(lss.solution()[i] - static_cast<Real>(i), 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE( SolveMatrixFree )
+{
+  CRoot& root = Core::instance().root();
+  CMesh& mesh = root.get_child("line").as_type<CMesh>();
+
+  CEigenLSS& lss = root.create_component<CEigenLSS>("MatrixFreeLSS");
+  lss.configure_option("matrix_free", true);
+  lss.resize(mesh, 1);
+  BOOST_CHECK(lss.is_matrix_free());
+  BOOST_CHECK(!lss.has_pattern());
+  BOOST_CHECK_THROW(lss.at(0, 0), NotSupported);
+
+  LineLaplacian& assembly = root.create_component<LineLaplacian>("Assembly");
+  assembly.lss = &lss;
+  assembly.mesh = &mesh;
+  lss.configure_option("assembly", assembly.uri());
+
+  lss.set_zero();
+  assembly.execute();
+  lss.set_dirichlet_bc(0, 0.);
+
+  // Applying the matrix leaves the RHS alone
+  RealVector ones = RealVector::Ones(lss.size());
+  RealVector product;
+  lss.apply(ones, product);
+  BOOST_CHECK_EQUAL(product[0], 1.);
+  BOOST_CHECK_EQUAL(product[1], 0.);
+  BOOST_CHECK_EQUAL(product[lss.size() - 1], 0.);
+  BOOST_CHECK_EQUAL(lss.rhs()[lss.size() - 1], 1.);
+
+  lss.solve();
+
+  for(Uint i = 0; i != lss.size(); ++i)
+    BOOST_CHECK_SMALL(lss.solution()[i] - static_cast<Real>(i), 1e-8);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////